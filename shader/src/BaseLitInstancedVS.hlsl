@@ -0,0 +1,58 @@
+// BaseLitInstancedVS.hlsl
+// BaseLitVS のインスタンス描画版（RenderQueue が同じメッシュの描画をまとめるときに使う）
+// エンジン側（RenderQueue::FindInstancedShader）の前提:
+//  - InputLayout: POSITION, NORMAL, COLOR, TEXCOORD（スロット 0）
+//                 + WORLD0〜3（ワールド行列の各行）, INSTANCECOLOR（スロット 1、インスタンスごと）
+//  - VS 用 CB スロット: b1(View), b2(Proj)（World は使わない）
+//  - INSTANCECOLOR はマテリアルの Diffuse。CB のマテリアルの Diffuse は白にしてある
+// 出力は BaseLitVS と同じ形式なので、ピクセルシェーダーは BaseLitPS をそのまま使う。
+
+cbuffer CBView       : register(b1) { float4x4 gView; }
+cbuffer CBProjection : register(b2) { float4x4 gProj; }
+
+struct VSIn
+{
+    float3 posL   : POSITION;
+    float3 nrmL   : NORMAL;
+    float4 col    : COLOR;
+    float2 uv     : TEXCOORD0;
+    float4 world0 : WORLD0;
+    float4 world1 : WORLD1;
+    float4 world2 : WORLD2;
+    float4 world3 : WORLD3;
+    float4 color  : INSTANCECOLOR;
+};
+
+struct VSOut
+{
+    float4 posH  : SV_POSITION;
+    float3 posWS : TEXCOORD0;
+    float3 nrmWS : TEXCOORD1;
+    float4 col   : TEXCOORD2;
+    float2 uv    : TEXCOORD3;
+};
+
+VSOut main(VSIn v)
+{
+    VSOut o;
+
+    float4x4 world = float4x4(v.world0, v.world1, v.world2, v.world3);
+    float4 posW = mul(float4(v.posL, 1.0f), world);
+    o.posWS = posW.xyz;
+
+    // 逆転置行列の代わりに余因子行列で法線を変換する（大きさは PS で正規化される）
+    // 行列式が負（鏡像）の場合は向きを戻す
+    float3x3 cofactor = float3x3(
+        cross(v.world1.xyz, v.world2.xyz),
+        cross(v.world2.xyz, v.world0.xyz),
+        cross(v.world0.xyz, v.world1.xyz));
+    float det = dot(v.world0.xyz, cofactor[0]);
+    o.nrmWS = mul(v.nrmL, cofactor) * (det < 0.0f ? -1.0f : 1.0f);
+
+    float4 posV = mul(posW, gView);
+    o.posH = mul(posV, gProj);
+
+    o.col = v.col * v.color;
+    o.uv  = v.uv;
+    return o;
+}
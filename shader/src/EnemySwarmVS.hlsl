@@ -0,0 +1,45 @@
+// EnemySwarmVS.hlsl
+// EnemySwarm のインスタンス描画用頂点シェーダー
+// エンジン側（MeshRenderer::LoadInstancedShader）の前提:
+//  - InputLayout: POSITION, NORMAL, COLOR, TEXCOORD（スロット 0）+ INSTANCE（スロット 1、インスタンスごと）
+//  - INSTANCE.xyz = ワールド位置 / INSTANCE.w = 一様スケール（回転なし）
+//  - VS 用 CB スロット: b1(View), b2(Proj)（World は使わない）
+// 出力は BaseLitVS と同じ形式なので、ピクセルシェーダーは BaseLitPS をそのまま使う。
+
+cbuffer CBView       : register(b1) { float4x4 gView; }
+cbuffer CBProjection : register(b2) { float4x4 gProj; }
+
+struct VSIn
+{
+    float3 posL     : POSITION;
+    float3 nrmL     : NORMAL;
+    float4 col      : COLOR;
+    float2 uv       : TEXCOORD0;
+    float4 instance : INSTANCE;
+};
+
+struct VSOut
+{
+    float4 posH  : SV_POSITION;
+    float3 posWS : TEXCOORD0;
+    float3 nrmWS : TEXCOORD1;
+    float4 col   : TEXCOORD2;
+    float2 uv    : TEXCOORD3;
+};
+
+VSOut main(VSIn v)
+{
+    VSOut o;
+
+    // 一様スケール + 平行移動のみなので、法線はそのまま使える
+    float4 posW = float4(v.posL * v.instance.w + v.instance.xyz, 1.0f);
+    o.posWS = posW.xyz;
+    o.nrmWS = v.nrmL;
+
+    float4 posV = mul(posW, gView);
+    o.posH = mul(posV, gProj);
+
+    o.col = v.col;
+    o.uv  = v.uv;
+    return o;
+}
@@ -9,9 +9,11 @@ SoundManager* SoundManager::s_Instance = nullptr;
 // 初期化
 // ------------------------------------------------------------------------------
 // - グローバル参照を this に設定する
+// - 更新頻度を落とす（現状 Update は空。フェードなどを足す場合も低頻度で足りる想定）
 void SoundManager::Init()
 {
     s_Instance = this;
+    SetUpdateTier(UpdateTier::EveryNFrames, kUpdateInterval);
 }
 
 // ------------------------------------------------------------------------------
@@ -49,6 +49,7 @@ public:
     // --------------------------------------------------------------------------
     /// 初期化
     /// - グローバル参照を this に設定する
+    /// - 更新は毎フレーム不要なので、更新頻度を落とす
     void Init() override;
 
     /// 終了
@@ -93,6 +94,8 @@ public:
     float GetMasterVolume() const { return m_MasterVolume; }
 
 private:
+    static constexpr std::uint8_t kUpdateInterval = 4;  // 更新間隔（フレーム数）
+
     // --------------------------------------------------------------------------
     // 内部データ
     // --------------------------------------------------------------------------
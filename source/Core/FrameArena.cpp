@@ -0,0 +1,181 @@
+﻿#include "FrameArena.h"
+
+// システム関連
+#if defined(_WIN32)
+#include <windows.h>
+#endif
+#include <stdio.h>
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <memory>
+#include <mutex>
+#include <new>
+#if !defined(_WIN32)
+#include <functional>
+#include <thread>
+#endif
+
+namespace
+{
+    std::atomic<std::uint64_t> s_Epoch{ 1 };                // 現在の世代（BeginFrame ごとに進む）
+    std::mutex                 s_RegistryMutex;             // s_Registry の保護
+    std::vector<FrameArena*>   s_Registry;                  // 非所有：生存中のアリーナ（報告用）
+    thread_local std::unique_ptr<FrameArena> s_ThreadArena; // 所有：スレッド別アリーナ
+
+    /// 報告用のスレッド ID（Windows 以外では std::thread::id のハッシュ）
+    std::uint32_t CurrentThreadId()
+    {
+#if defined(_WIN32)
+        return static_cast<std::uint32_t>(GetCurrentThreadId());
+#else
+        return static_cast<std::uint32_t>(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+#endif
+    }
+
+    /// アリーナを作成して報告用リストへ登録する
+    FrameArena* CreateThreadArena(std::size_t capacity)
+    {
+        s_ThreadArena = std::make_unique<FrameArena>(capacity);
+
+        std::lock_guard<std::mutex> lock(s_RegistryMutex);
+        s_Registry.push_back(s_ThreadArena.get());
+        return s_ThreadArena.get();
+    }
+}
+
+// ------------------------------------------------------------------------------
+// 生成・破棄
+// ------------------------------------------------------------------------------
+FrameArena::FrameArena(std::size_t capacity)
+    : m_Capacity(capacity)
+    , m_Epoch(s_Epoch.load(std::memory_order_acquire))
+    , m_ThreadId(CurrentThreadId())
+{
+    m_Buffer = static_cast<std::byte*>(::operator new(capacity, std::align_val_t{ alignof(std::max_align_t) }));
+}
+
+// - 報告用リストから外し、フォールバック分と本体を解放する
+FrameArena::~FrameArena()
+{
+    {
+        std::lock_guard<std::mutex> lock(s_RegistryMutex);
+        s_Registry.erase(std::remove(s_Registry.begin(), s_Registry.end(), this), s_Registry.end());
+    }
+
+    Reset();
+    ::operator delete(m_Buffer, std::align_val_t{ alignof(std::max_align_t) });
+    m_Buffer = nullptr;
+}
+
+// ------------------------------------------------------------------------------
+// 確保
+// ------------------------------------------------------------------------------
+// - 先頭から align 境界へ切り上げて切り出す（ポインタを進めるだけ）
+// - 容量を超えた分はヒープから確保し、次のリセットで解放する（回数を記録）
+void* FrameArena::Allocate(std::size_t size, std::size_t align)
+{
+    SyncEpoch();
+
+    if (align <= alignof(std::max_align_t))
+    {
+        const std::size_t offset = (m_Used + align - 1) & ~(align - 1);
+        if (offset + size <= m_Capacity)
+        {
+            m_Used = offset + size;
+            m_HighWatermark = std::max(m_HighWatermark, GetUsed());
+            return m_Buffer + offset;
+        }
+    }
+
+    // 容量超過（またはアライメント過大）：ヒープへフォールバック
+    const std::size_t overflowAlign = std::max(align, alignof(std::max_align_t));
+    void* memory = ::operator new(size, std::align_val_t{ overflowAlign });
+    m_Overflow.push_back({ memory, overflowAlign });
+    m_OverflowBytes += size;
+    ++m_OverflowCount;
+    m_HighWatermark = std::max(m_HighWatermark, GetUsed());
+    return memory;
+}
+
+// ------------------------------------------------------------------------------
+// リセット
+// ------------------------------------------------------------------------------
+// - 使用量を 0 に戻す（本体は保持）
+// - フォールバック確保分は解放する
+void FrameArena::Reset()
+{
+    for (const OverflowBlock& block : m_Overflow)
+    {
+        ::operator delete(block.memory, std::align_val_t{ block.align });
+    }
+    m_Overflow.clear();
+    m_OverflowBytes = 0;
+    m_Used = 0;
+    m_Epoch = s_Epoch.load(std::memory_order_acquire);
+}
+
+// 世代が進んでいればリセットする（ワーカースレッドのアリーナ用）
+void FrameArena::SyncEpoch()
+{
+    if (m_Epoch != s_Epoch.load(std::memory_order_acquire))
+    {
+        Reset();
+    }
+}
+
+// ------------------------------------------------------------------------------
+// スレッド別アリーナ
+// ------------------------------------------------------------------------------
+// - 未作成ならワーカー用の容量で作成する
+// - 世代が古ければリセットしてから返す
+FrameArena& FrameArena::GetThreadArena()
+{
+    FrameArena* arena = s_ThreadArena.get();
+    if (!arena)
+    {
+        arena = CreateThreadArena(kWorkerThreadCapacity);
+    }
+    arena->SyncEpoch();
+    return *arena;
+}
+
+// メインスレッド用（容量大）のアリーナを作成する
+void FrameArena::InitMainThread()
+{
+    if (s_ThreadArena) return;
+    CreateThreadArena(kMainThreadCapacity);
+}
+
+// ------------------------------------------------------------------------------
+// フレーム開始
+// ------------------------------------------------------------------------------
+// - 世代を進める（ワーカーのアリーナは次回確保時にリセットされる）
+// - 呼び出しスレッド（メイン）のアリーナは即座にリセットする
+void FrameArena::BeginFrame()
+{
+    s_Epoch.fetch_add(1, std::memory_order_acq_rel);
+    GetThreadArena().Reset();
+}
+
+// ------------------------------------------------------------------------------
+// 使用量最大値の報告
+// ------------------------------------------------------------------------------
+// - 各アリーナの容量 / 1 フレーム使用量の最大値 / フォールバック回数を出力する
+// - 最大値が容量に近い、またはフォールバックが発生している場合は容量を見直すこと
+void FrameArena::ReportHighWatermarks()
+{
+    std::lock_guard<std::mutex> lock(s_RegistryMutex);
+    for (const FrameArena* arena : s_Registry)
+    {
+        char buffer[256];
+        snprintf(buffer, sizeof(buffer),
+            "[FrameArena] thread=%u capacity=%zu peak=%zu overflow=%zu\n",
+            arena->m_ThreadId, arena->m_Capacity, arena->m_HighWatermark, arena->m_OverflowCount);
+#if defined(_WIN32)
+        OutputDebugStringA(buffer);
+#else
+        fputs(buffer, stderr);
+#endif
+    }
+}
@@ -0,0 +1,142 @@
+﻿//------------------------------------------------------------------------------
+// FrameArena
+//------------------------------------------------------------------------------
+// 役割:
+// 1 フレームの間だけ使う一時データ（Collider 一覧・衝突ペア・HUD 文字列など）を
+// 線形に切り出して確保し、フレーム先頭でまとめて解放するアロケータ。
+//
+// 設計意図:
+// 毎フレーム作っては捨てる一時コンテナが汎用ヒープへ行くと、確保/解放のコストと
+// 断片化が積み重なる。ポインタを進めるだけの確保にし、解放はフレーム単位で一括に行う。
+// STL コンテナからも使えるよう FrameAllocator<T> を用意する。
+//
+// 構成:
+// - FrameArena          : 線形アリーナ本体（容量超過時はヒープへフォールバック）
+// - スレッド別アリーナ  : GetThreadArena() でスレッドごとに 1 つ（ワーカースレッド用）
+// - BeginFrame          : フレーム先頭でメインスレッドのアリーナをリセットし、世代を進める
+//                         （ワーカーのアリーナは次回確保時に世代差を見てリセットされる）
+// - FrameAllocator<T>   : STL 互換アロケータ（deallocate は何もしない）
+// - 使用量の最大値      : ReportHighWatermarks() でデバッグ出力へ報告（容量調整用）
+//
+// NOTE:
+// - 確保したメモリは「次の BeginFrame まで」しか有効でない。
+//   フレームをまたいで保持するコンテナ（前フレームの衝突ペアなど）には使わないこと
+// - vector の伸長で捨てられた古い領域は再利用されないため、事前に reserve すること
+// - アリーナは確保したスレッドに属する。別スレッドへコンテナを渡して伸長させないこと
+//------------------------------------------------------------------------------
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <string>
+
+/// 1 フレーム用の線形アリーナ
+class FrameArena
+{
+public:
+    explicit FrameArena(std::size_t capacity);
+    ~FrameArena();
+
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    // ----------------------------------------------------------------------
+    // 確保・解放
+    // ----------------------------------------------------------------------
+    /// size バイトを align 境界で確保する
+    /// - 容量を超えた場合はヒープから確保し、次のリセットで解放する
+    void* Allocate(std::size_t size, std::size_t align);
+
+    /// 使用量を 0 に戻し、フォールバック分を解放する
+    void Reset();
+
+    // ----------------------------------------------------------------------
+    // 参照
+    // ----------------------------------------------------------------------
+    std::size_t GetCapacity() const { return m_Capacity; }
+    std::size_t GetUsed() const { return m_Used + m_OverflowBytes; }
+
+    /// これまでの 1 フレーム使用量の最大値（フォールバック分を含む）
+    std::size_t GetHighWatermark() const { return m_HighWatermark; }
+
+    /// 容量超過でヒープへフォールバックした回数（累計）
+    std::size_t GetOverflowCount() const { return m_OverflowCount; }
+
+    // ----------------------------------------------------------------------
+    // スレッド別アリーナ
+    // ----------------------------------------------------------------------
+    /// 呼び出しスレッドのアリーナを取得する（未作成なら作成して登録する）
+    /// - 世代が古い場合（前フレームのまま）は、ここでリセットされる
+    static FrameArena& GetThreadArena();
+
+    /// メインスレッドのアリーナを作成する（GameManager::Init から呼ぶ）
+    static void InitMainThread();
+
+    /// フレーム開始（GameManager::Update の先頭で呼ぶ）
+    /// - メインスレッドのアリーナをリセットし、世代を進める
+    static void BeginFrame();
+
+    /// 全アリーナの使用量最大値をデバッグ出力へ報告する
+    static void ReportHighWatermarks();
+
+private:
+    /// 世代が古ければリセットする
+    void SyncEpoch();
+
+private:
+    static constexpr std::size_t kMainThreadCapacity = 1024 * 1024;    // メインスレッド用（1MB）
+    static constexpr std::size_t kWorkerThreadCapacity = 256 * 1024;   // ワーカースレッド用（256KB）
+
+    std::byte*          m_Buffer        = nullptr;  // 所有：アリーナ本体
+    std::size_t         m_Capacity      = 0;        // 容量（バイト）
+    std::size_t         m_Used          = 0;        // 使用量（バイト）
+    std::size_t         m_OverflowBytes = 0;        // フォールバック確保量（今フレーム）
+    std::size_t         m_HighWatermark = 0;        // 1 フレーム使用量の最大値
+    std::size_t         m_OverflowCount = 0;        // フォールバック回数（累計）
+    std::uint64_t       m_Epoch         = 0;        // 最後にリセットした世代
+    std::uint32_t       m_ThreadId      = 0;        // 所属スレッド（報告用）
+    /// フォールバック確保した領域（解放時にアライメント指定をそろえるため保持）
+    struct OverflowBlock
+    {
+        void*       memory;
+        std::size_t align;
+    };
+    std::vector<OverflowBlock> m_Overflow;          // 所有：フォールバック確保した領域
+};
+
+/// FrameArena を使う STL 互換アロケータ
+/// - 生成したスレッドのアリーナから確保する
+/// - deallocate は何もしない（フレーム先頭で一括解放）
+template <class T>
+class FrameAllocator
+{
+public:
+    using value_type = T;
+
+    FrameAllocator() noexcept : m_Arena(&FrameArena::GetThreadArena()) {}
+
+    template <class U>
+    FrameAllocator(const FrameAllocator<U>& other) noexcept : m_Arena(other.GetArena()) {}
+
+    T* allocate(std::size_t count)
+    {
+        return static_cast<T*>(m_Arena->Allocate(count * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T*, std::size_t) noexcept {}
+
+    FrameArena* GetArena() const noexcept { return m_Arena; }
+
+    template <class U>
+    bool operator==(const FrameAllocator<U>& other) const noexcept { return m_Arena == other.GetArena(); }
+    template <class U>
+    bool operator!=(const FrameAllocator<U>& other) const noexcept { return m_Arena != other.GetArena(); }
+
+private:
+    FrameArena* m_Arena;    // 非所有：確保先アリーナ
+};
+
+/// フレーム一時用のコンテナ
+template <class T>
+using FrameVector = std::vector<T, FrameAllocator<T>>;
+using FrameWString = std::basic_string<wchar_t, std::char_traits<wchar_t>, FrameAllocator<wchar_t>>;
@@ -0,0 +1,122 @@
+﻿#include "FrameProfiler.h"
+
+// システム関連
+#include <windows.h>
+#include <stdio.h>
+
+// 静的メンバ変数の定義
+std::int64_t  FrameProfiler::s_SectionBegin[FrameProfiler::kSectionCount] = {};
+std::int64_t  FrameProfiler::s_SectionTicks[FrameProfiler::kSectionCount] = {};
+double        FrameProfiler::s_AverageMs[FrameProfiler::kSectionCount] = {};
+std::uint64_t FrameProfiler::s_Counters[FrameProfiler::kCounterCount] = {};
+std::uint32_t FrameProfiler::s_FrameCount = 0;
+#if defined(_DEBUG)
+bool          FrameProfiler::s_ReportEnabled = true;
+#else
+bool          FrameProfiler::s_ReportEnabled = false;
+#endif
+
+namespace
+{
+    // 区間名（ProfileSection と同じ順序）
+    const char* const kSectionNames[] = { "Frame", "Update", "Collision", "Draw" };
+    // カウンタ名（ProfileCounter と同じ順序）
+    const char* const kCounterNames[] = { "GameObjects", "Enemies", "SwarmEnemies", "Colliders", "FrameArenaBytes",
+                                          "DrawCalls", "StateChanges", "UploadedBytes", "BufferUpdates",
+                                          "StatesSaved", "InstancedDraws", "CachedMeshes",
+                                          "CulledObjects", "TextLayouts" };
+
+    static_assert(sizeof(kSectionNames) / sizeof(kSectionNames[0]) == static_cast<size_t>(ProfileSection::Count),
+        "kSectionNames と ProfileSection の数が一致していない");
+    static_assert(sizeof(kCounterNames) / sizeof(kCounterNames[0]) == static_cast<size_t>(ProfileCounter::Count),
+        "kCounterNames と ProfileCounter の数が一致していない");
+
+    std::int64_t QueryTicks()
+    {
+        LARGE_INTEGER now;
+        QueryPerformanceCounter(&now);
+        return now.QuadPart;
+    }
+
+    double TicksToMs(std::int64_t ticks)
+    {
+        static const double s_MsPerTick = []()
+        {
+            LARGE_INTEGER freq;
+            QueryPerformanceFrequency(&freq);
+            return 1000.0 / static_cast<double>(freq.QuadPart);
+        }();
+        return static_cast<double>(ticks) * s_MsPerTick;
+    }
+}
+
+// ------------------------------------------------------------------------------
+// 区間計測
+// ------------------------------------------------------------------------------
+void FrameProfiler::BeginSection(ProfileSection section)
+{
+    s_SectionBegin[static_cast<std::uint32_t>(section)] = QueryTicks();
+}
+
+void FrameProfiler::EndSection(ProfileSection section)
+{
+    const std::uint32_t index = static_cast<std::uint32_t>(section);
+    s_SectionTicks[index] += QueryTicks() - s_SectionBegin[index];
+}
+
+// ------------------------------------------------------------------------------
+// カウンタ
+// ------------------------------------------------------------------------------
+void FrameProfiler::SetCounter(ProfileCounter counter, std::uint64_t value)
+{
+    s_Counters[static_cast<std::uint32_t>(counter)] = value;
+}
+
+std::uint64_t FrameProfiler::GetCounter(ProfileCounter counter)
+{
+    return s_Counters[static_cast<std::uint32_t>(counter)];
+}
+
+double FrameProfiler::GetAverageMs(ProfileSection section)
+{
+    return s_AverageMs[static_cast<std::uint32_t>(section)];
+}
+
+// ------------------------------------------------------------------------------
+// フレームの区切り
+// ------------------------------------------------------------------------------
+// - kReportInterval フレームごとに区間平均を計算する
+// - 報告が有効な場合はデバッグ出力へ 1 行で書き出す
+void FrameProfiler::EndFrame()
+{
+    if (++s_FrameCount < kReportInterval)
+        return;
+
+    for (std::uint32_t i = 0; i < kSectionCount; ++i)
+    {
+        s_AverageMs[i] = TicksToMs(s_SectionTicks[i]) / static_cast<double>(s_FrameCount);
+        s_SectionTicks[i] = 0;
+    }
+    s_FrameCount = 0;
+
+    if (!s_ReportEnabled)
+        return;
+
+    char buffer[512];
+    int length = snprintf(buffer, sizeof(buffer), "[FrameProfiler]");
+    for (std::uint32_t i = 0; i < kSectionCount && length < (int)sizeof(buffer); ++i)
+    {
+        length += snprintf(buffer + length, sizeof(buffer) - length, " %s=%.3fms", kSectionNames[i], s_AverageMs[i]);
+    }
+    for (std::uint32_t i = 0; i < kCounterCount && length < (int)sizeof(buffer); ++i)
+    {
+        length += snprintf(buffer + length, sizeof(buffer) - length, " %s=%llu", kCounterNames[i],
+            static_cast<unsigned long long>(s_Counters[i]));
+    }
+    if (length < (int)sizeof(buffer) - 1)
+    {
+        buffer[length++] = '\n';
+        buffer[length] = '\0';
+    }
+    OutputDebugStringA(buffer);
+}
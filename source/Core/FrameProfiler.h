@@ -0,0 +1,111 @@
+﻿//------------------------------------------------------------------------------
+// FrameProfiler
+//------------------------------------------------------------------------------
+// 役割:
+// フレーム内の主要区間（Update / Collision / Draw など）の処理時間と、
+// オブジェクト数などのカウンタを集計し、一定フレームごとにデバッグ出力へ報告する。
+//
+// 設計意図:
+// メモリ配置や更新方式の変更が、敵が大量に出ている場面のフレーム時間に
+// どれだけ効いたかを同じ条件で比較できるようにする。
+// 計測は QueryPerformanceCounter による区間計測のみで、外部ツールに依存しない。
+//
+// 構成:
+// - 区間計測   : ScopedSection（RAII）で Begin/End を対にする
+// - カウンタ   : SetCounter でフレームごとの値を記録（報告時は直近値）
+// - 報告       : kReportInterval フレームごとに平均値を OutputDebugStringA へ出力
+//
+// NOTE:
+// - メインスレッドからのみ呼び出すこと（スレッドセーフではない）
+// - 計測自体のオーバーヘッドは区間ごとに QPC 2 回程度
+//------------------------------------------------------------------------------
+#pragma once
+#include <cstdint>
+
+/// 計測区間
+enum class ProfileSection : std::uint32_t
+{
+    Frame,      // 1 フレーム全体（Update + Draw）
+    Update,     // GameObject 更新
+    Collision,  // 衝突判定
+    Draw,       // 描画
+    Count
+};
+
+/// 記録するカウンタ
+enum class ProfileCounter : std::uint32_t
+{
+    GameObjects,    // 生存中の GameObject 数
+    Enemies,        // 管理中のエネミー数
+    SwarmEnemies,   // EnemySwarm の敵数
+    Colliders,      // 衝突判定に参加した Collider 数
+    FrameArenaBytes,// メインスレッドの FrameArena 使用量（バイト）
+    DrawCalls,      // 描画呼び出し数
+    StateChanges,   // 描画バックエンドへ渡したステート変更数
+    UploadedBytes,  // バッファ更新で転送したバイト数
+    BufferUpdates,  // バッファ更新（UpdateBuffer / MapDiscard）の回数
+    StatesSaved,    // RenderQueue のソートで省いた状態設定の数
+    InstancedDraws, // RenderQueue がインスタンス描画にまとめたパケット数
+    CachedMeshes,   // MeshCache が持つ手続き形状の数（オブジェクト数に比例しないこと）
+    CulledObjects,  // 視錐台カリングで描画を省いた描画コンポーネントの数
+    TextLayouts,    // TextRenderer が新しく作った文字列レイアウトの数（表示値が変わらなければ 0）
+    Count
+};
+
+/// フレーム時間・カウンタの簡易プロファイラ
+class FrameProfiler
+{
+public:
+    /// 区間計測を RAII で行うヘルパー
+    class ScopedSection
+    {
+    public:
+        explicit ScopedSection(ProfileSection section) : m_Section(section) { FrameProfiler::BeginSection(section); }
+        ~ScopedSection() { FrameProfiler::EndSection(m_Section); }
+
+        ScopedSection(const ScopedSection&) = delete;
+        ScopedSection& operator=(const ScopedSection&) = delete;
+
+    private:
+        ProfileSection m_Section;
+    };
+
+    // ----------------------------------------------------------------------
+    // 計測
+    // ----------------------------------------------------------------------
+    /// 区間計測を開始する
+    static void BeginSection(ProfileSection section);
+    /// 区間計測を終了し、経過時間を加算する
+    static void EndSection(ProfileSection section);
+
+    /// カウンタ値を記録する
+    static void SetCounter(ProfileCounter counter, std::uint64_t value);
+
+    /// フレームの区切り（集計し、必要なら報告する）
+    static void EndFrame();
+
+    // ----------------------------------------------------------------------
+    // 参照
+    // ----------------------------------------------------------------------
+    /// 直近の報告区間における平均時間（ミリ秒）
+    static double GetAverageMs(ProfileSection section);
+
+    /// 直近に記録されたカウンタ値
+    static std::uint64_t GetCounter(ProfileCounter counter);
+
+    /// 報告の有効/無効（計測自体は常に行う）
+    static void SetReportEnabled(bool enabled) { s_ReportEnabled = enabled; }
+
+private:
+    static constexpr std::uint32_t kReportInterval = 120;   // 報告間隔（フレーム）
+
+    static constexpr std::uint32_t kSectionCount = static_cast<std::uint32_t>(ProfileSection::Count);
+    static constexpr std::uint32_t kCounterCount = static_cast<std::uint32_t>(ProfileCounter::Count);
+
+    static std::int64_t  s_SectionBegin[kSectionCount];     // 区間開始時のカウンタ値
+    static std::int64_t  s_SectionTicks[kSectionCount];     // 報告区間内の累積ティック
+    static double        s_AverageMs[kSectionCount];        // 直近の平均（ミリ秒）
+    static std::uint64_t s_Counters[kCounterCount];         // カウンタ値
+    static std::uint32_t s_FrameCount;                      // 報告区間内のフレーム数
+    static bool          s_ReportEnabled;                   // 報告の有効/無効
+};
@@ -1,36 +1,68 @@
 ﻿#include "main.h"
 #include "GameManager.h"
 #include "Renderer.h"
+#include "RenderQueue.h"
+#include "MeshCache.h"
+#include "ShaderCache.h"
+#include "TextureCache.h"
+#include "WicTextureDecoder.h"
+#include "FrustumCulling.h"
+#include "TextRenderer.h"
+#include "modelRenderer.h"
 #include "Scene.h"
 #include "DebugSettings.h"
 #include "Collider.h"
 #include "ColliderGroup.h"
 #include "RigidBody.h"
+#include "FrameProfiler.h"
+#include "PhysicsWorld.h"
+#include "EnemyManager.h"
+#include "EnemySwarm.h"
+#include "SceneLoader.h"
+#include "JobSystem.h"
 
 // システム関連
 #include "Audio.h"
 #include "Input.h"
 #include "HP.h"
 #include <windows.h>
-#include <unordered_set>
+#include <algorithm>
+#include "FrameArena.h"
+#include "Snapshot.h"
 
 // 静的メンバ変数の定義
 GameManager::Scene GameManager::m_CurrentScene = GameManager::Scene::Title;  // 初期シーンはタイトル
 std::vector<GameObject*> GameManager::m_SceneGameObjects;                  // 現在のシーンのGameObjectリスト
-std::set<GameManager::ColliderPair> GameManager::m_PreviousPairs;          // 前フレームの衝突ペア情報
-std::set<GameManager::ColliderPair> GameManager::m_PreviousTriggerPairs;   // 前フレームのトリガーペア情報
+std::vector<GameManager::ColliderPairKey> GameManager::m_PreviousPairs;        // 前フレームの衝突ペア情報
+std::vector<GameManager::ColliderPairKey> GameManager::m_PreviousTriggerPairs; // 前フレームのトリガーペア情報
+std::uint32_t GameManager::m_CollisionFrame = 0;                               // 衝突判定の実行回数
+#if defined(_DEBUG)
+std::vector<std::byte> GameManager::m_DebugSnapshot;                           // デバッグ用スナップショット
+#endif // _DEBUG
 
 // デバッグ用コライダー描画フラグ
 bool g_EnableColliderDebugDraw = false; // デフォルトは無効
 
+// デバッグ用群れ出現フラグ
+bool g_EnableEnemySwarm = false; // デフォルトは無効
+
 // ----------------------------------------------------------------------
 // 初期化処理
 // ----------------------------------------------------------------------
 void GameManager::Init() 
 {
+    // フレーム一時領域（メインスレッド用）
+    FrameArena::InitMainThread();
+
+    // ジョブシステム（並列更新用のワーカースレッド）
+    JobSystem::Init();
+
     // レンダラー初期化
     Renderer::Init();
 
+    // テクスチャキャッシュ（デコード用スレッドの起動）
+    TextureCache::Init(DecodeWicTexture);
+
     // オーディオシステム初期化
     Audio::InitMaster();
 
@@ -38,9 +70,14 @@ void GameManager::Init()
     Input::Init();
 
 	// 現在のシーンのゲームオブジェクトを生成
-    m_SceneGameObjects = CreateSceneObjects(m_CurrentScene);
-    // 生成したGameObjectのInitを呼び出して初期化
-    for (GameObject* gameObject : m_SceneGameObjects) gameObject->Init();
+    // NOTE: 起動時は表示中のシーンが無いので、読み込み完了を待ってそのまま差し替える
+    SceneLoader::Begin(m_CurrentScene);
+    Scene loadedScene = m_CurrentScene;
+    std::vector<GameObject*> loadedObjects;
+    if (SceneLoader::WaitAndTake(loadedScene, loadedObjects))
+    {
+        ApplyLoadedScene(loadedScene, loadedObjects);
+    }
 }
 
 // ----------------------------------------------------------------------
@@ -48,6 +85,9 @@ void GameManager::Init()
 // ----------------------------------------------------------------------
 void GameManager::Uninit() {
 
+    // 読み込み中の次シーンがあれば完了を待って破棄
+    SceneLoader::Shutdown();
+
 	// 現在のシーンのゲームオブジェクトを解放
     for (GameObject* gameObject : m_SceneGameObjects) {
         gameObject->Uninit();
@@ -55,11 +95,23 @@ void GameManager::Uninit() {
     }
     m_SceneGameObjects.clear();
 
+    // 共有している GPU リソース（モデル / 手続き形状 / シェーダー / テクスチャ）を解放
+    ModelRenderer::UnloadAll();
+    MeshCache::Uninit();
+    ShaderCache::Uninit();
+    TextureCache::Uninit();
+
     // レンダラー終了処理
 	Renderer::Uninit();
 
     // オーディオシステム終了処理
     Audio::UninitMaster();
+
+    // フレーム一時領域の使用量最大値を報告（容量調整用）
+    FrameArena::ReportHighWatermarks();
+
+    // ジョブシステム終了（ワーカーのフレーム一時領域もここで解放される）
+    JobSystem::Shutdown();
 }
 
 // ----------------------------------------------------------------------
@@ -67,16 +119,54 @@ void GameManager::Uninit() {
 // ----------------------------------------------------------------------
 void GameManager::Update(float deltaTime)
 {
+    // フレーム一時領域をリセット（前フレームの一時データはここで無効になる）
+    FrameArena::BeginFrame();
+
     // 入力状態の更新
     Input::Update();
 
+    // 更新頻度の間引き判定に使うフレーム番号を進める
+    GameObject::AdvanceUpdateFrame();
+
+    // 次シーンの読み込みが完了していれば差し替える（フレーム先頭で行い、旧シーンの処理途中では替えない）
+    {
+        Scene loadedScene;
+        std::vector<GameObject*> loadedObjects;
+        if (SceneLoader::TryTake(loadedScene, loadedObjects))
+        {
+            ApplyLoadedScene(loadedScene, loadedObjects);
+        }
+    }
+
+    // デコードが終わったテクスチャを GPU へ転送（それまでは代用テクスチャで描かれる）
+    TextureCache::Update();
+
     // 各シーンのゲームオブジェクトを更新
-    for (GameObject* gameObject : m_SceneGameObjects) {
-        gameObject->Update(deltaTime);
+    {
+        FrameProfiler::ScopedSection section(ProfileSection::Update);
+
+        // RigidBody の一括積分（GameObject の Update より前に行い、
+        // Update 内での位置補正（Ball の高さ制限など）が積分後の位置に対して効くようにする）
+        PhysicsWorld::Step(deltaTime);
+
+        for (GameObject* gameObject : m_SceneGameObjects) {
+            float objectDelta = 0.0f;
+            if (gameObject->AdvanceUpdateSchedule(deltaTime, objectDelta)) {
+                gameObject->Update(objectDelta);
+            }
+        }
+
+        // エネミーの空間インデックスへ今フレームの位置を反映する
+        // （次フレームの範囲検索はこの位置で行う。Bumper → EnemySpawner の更新順なので、
+        //   ShockWave の検索時点の敵の位置はここで反映したものと一致する）
+        EnemyManager::SyncSpatialIndex();
     }
 
     // コライダー同士の当たり判定処理
-    CheckCollisions();
+    {
+        FrameProfiler::ScopedSection section(ProfileSection::Collision);
+        CheckCollisions();
+    }
 
     // --- ゲームオーバー判定 ---
     // TODO: 現在の仕様だと、HPが0以下になった瞬間にシーンが切り替わってしまい、
@@ -102,6 +192,28 @@ void GameManager::Update(float deltaTime)
         g_EnableColliderDebugDraw = !g_EnableColliderDebugDraw;
     }
     prevDebugDraw = currDebugDraw;
+
+    // デバッグ用群れ出現フラグ切り替え（F6）
+    static bool prevSwarm = false;
+    bool currSwarm = Input::GetKeyPress(VK_F6);
+    if (currSwarm && !prevSwarm) {
+        g_EnableEnemySwarm = !g_EnableEnemySwarm;
+    }
+    prevSwarm = currSwarm;
+
+    // デバッグ用スナップショット（F5 で保存、F9 で復元）
+    static bool prevSave = false;
+    static bool prevLoad = false;
+    bool currSave = Input::GetKeyPress(VK_F5);
+    bool currLoad = Input::GetKeyPress(VK_F9);
+    if (currSave && !prevSave) {
+        SaveSnapshot(m_DebugSnapshot);
+    }
+    if (currLoad && !prevLoad && !m_DebugSnapshot.empty()) {
+        LoadSnapshot(m_DebugSnapshot);
+    }
+    prevSave = currSave;
+    prevLoad = currLoad;
 #endif // NDEBUG
 
     // シーン切り替え処理
@@ -133,6 +245,8 @@ void GameManager::Update(float deltaTime)
 // ----------------------------------------------------------------------
 void GameManager::Draw()
 {
+    FrameProfiler::ScopedSection section(ProfileSection::Draw);
+
 	Renderer::Begin(); // レンダリング開始
 
 	// シーンのゲームオブジェクトを描画
@@ -141,12 +255,44 @@ void GameManager::Draw()
     }
 
 	Renderer::End(); // レンダリング終了
+
+    // 計測用カウンタ（敵が多い場面でのフレーム時間比較に使用）
+    FrameProfiler::SetCounter(ProfileCounter::GameObjects, GameObject::GetLiveCount());
+    FrameProfiler::SetCounter(ProfileCounter::Enemies, EnemyManager::GetEnemies().size());
+    FrameProfiler::SetCounter(ProfileCounter::SwarmEnemies, EnemySwarm::GetLiveCount());
+    FrameProfiler::SetCounter(ProfileCounter::FrameArenaBytes, FrameArena::GetThreadArena().GetUsed());
+
+    const RenderStats& renderStats = Renderer::GetBackend().GetFrameStats();
+    FrameProfiler::SetCounter(ProfileCounter::DrawCalls, renderStats.drawCalls);
+    FrameProfiler::SetCounter(ProfileCounter::StateChanges, renderStats.stateChanges);
+    FrameProfiler::SetCounter(ProfileCounter::UploadedBytes, renderStats.uploadedBytes);
+    FrameProfiler::SetCounter(ProfileCounter::BufferUpdates, renderStats.bufferUpdates);
+    FrameProfiler::SetCounter(ProfileCounter::StatesSaved, RenderQueue::GetFrameStats().savedStates);
+    FrameProfiler::SetCounter(ProfileCounter::InstancedDraws, RenderQueue::GetFrameStats().instanced);
+    FrameProfiler::SetCounter(ProfileCounter::CachedMeshes, MeshCache::GetMeshCount());
+    FrameProfiler::SetCounter(ProfileCounter::CulledObjects, FrustumCulling::GetCulledCount());
+    FrameProfiler::SetCounter(ProfileCounter::TextLayouts, TextRenderer::GetFrameStats().layoutsCreated);
 }
 
 // ----------------------------------------------------------------------
 // シーン変更処理
 // ----------------------------------------------------------------------
+// - 次シーンの準備をバックグラウンドで開始するだけで、ここでは差し替えない
+// - 差し替えは準備完了後の Update 先頭で行う（それまで現在のシーンは動き続ける）
+// NOTE: 読み込み中に再度呼ばれた場合は無視する
 void GameManager::ChangeScene(Scene newScene)
+{
+    SceneLoader::Begin(newScene);
+}
+
+// ----------------------------------------------------------------------
+// 読み込み済みシーンへの差し替え
+// ----------------------------------------------------------------------
+// - 旧シーンを解放してから新シーンの Init を呼ぶ（Init 内の GPU 転送はデコード済みデータを使う）
+// - 衝突ペアの履歴は旧シーンのものなので破棄する
+// - 新シーンの Init 後、どちらのシーンでも使わない手続き形状・シェーダー・テクスチャを解放する
+//   （両シーンで使うものは旧シーン解放で参照 0 になっても残るので、作り直さない）
+void GameManager::ApplyLoadedScene(Scene newScene, std::vector<GameObject*>& newObjects)
 {
     // 旧シーン解放
     for (GameObject* gameObject : m_SceneGameObjects) {
@@ -154,16 +300,104 @@ void GameManager::ChangeScene(Scene newScene)
         delete gameObject;
     }
     m_SceneGameObjects.clear();
+    m_PreviousPairs.clear();
+    m_PreviousTriggerPairs.clear();
 
 	// 現在のシーンを更新
     m_CurrentScene = newScene;
 
 	// 新シーン初期化
-	m_SceneGameObjects = CreateSceneObjects(newScene);
+    m_SceneGameObjects.swap(newObjects);
 
     for (auto obj : m_SceneGameObjects) {
         obj->Init();
     }
+
+    MeshCache::PurgeUnused();
+    ShaderCache::PurgeUnused();
+    TextureCache::PurgeUnused();
+}
+
+// ----------------------------------------------------------------------
+// スナップショット
+// ----------------------------------------------------------------------
+// - 形式：ヘッダ → 更新フレーム番号 → シーン直下の各 GameObject（子・Component を含む）→ 衝突ペア履歴
+// - 衝突ペアは Collider ハンドルで持つ。プールの個体は Collider を作り直さないので、
+//   同じシーン内であればハンドルはそのまま有効
+// - 復元前に EnemyManager の一覧を空にし、出現中の敵は EnemyBase::ReadState で再登録させる
+// NOTE: シーン読み込み中（差し替え前）に保存 / 復元しても、差し替え後のシーンには効かない
+bool GameManager::SaveSnapshot(std::vector<std::byte>& outBuffer)
+{
+    SnapshotWriter writer(outBuffer);
+
+    SnapshotHeader header;
+    header.scene       = static_cast<std::uint32_t>(m_CurrentScene);
+    header.objectCount = static_cast<std::uint32_t>(m_SceneGameObjects.size());
+    writer.Write(header);
+    writer.Write(GameObject::GetUpdateFrame());
+
+    for (const GameObject* gameObject : m_SceneGameObjects) {
+        gameObject->WriteState(writer);
+    }
+
+    WritePairs(writer, m_PreviousPairs);
+    WritePairs(writer, m_PreviousTriggerPairs);
+    return true;
+}
+
+bool GameManager::LoadSnapshot(const std::vector<std::byte>& buffer)
+{
+    SnapshotReader reader(buffer.data(), buffer.size());
+
+    SnapshotHeader header;
+    if (!reader.Read(header) ||
+        header.magic != kSnapshotMagic ||
+        header.version != kSnapshotVersion ||
+        header.scene != static_cast<std::uint32_t>(m_CurrentScene) ||
+        header.objectCount != m_SceneGameObjects.size())
+    {
+        OutputDebugStringA("[Snapshot] header mismatch (scene / version / object count)\n");
+        return false;
+    }
+
+    std::uint32_t updateFrame = 0;
+    reader.Read(updateFrame);
+    GameObject::SetUpdateFrame(updateFrame);
+
+    EnemyManager::ClearEnemies();
+
+    for (GameObject* gameObject : m_SceneGameObjects) {
+        gameObject->ReadState(reader);
+        if (reader.IsFailed()) break;
+    }
+
+    if (!ReadPairs(reader, m_PreviousPairs) ||
+        !ReadPairs(reader, m_PreviousTriggerPairs) ||
+        !reader.IsAtEnd())
+    {
+        OutputDebugStringA("[Snapshot] restore failed (object layout mismatch)\n");
+        return false;
+    }
+    return true;
+}
+
+// - 件数 → キー列（ソート済みのまま書くので、読み戻し後もそのまま二分探索に使える）
+void GameManager::WritePairs(SnapshotWriter& writer, const std::vector<ColliderPairKey>& pairs)
+{
+    writer.Write(static_cast<std::uint32_t>(pairs.size()));
+    writer.WriteBytes(pairs.data(), pairs.size() * sizeof(ColliderPairKey));
+}
+
+bool GameManager::ReadPairs(SnapshotReader& reader, std::vector<ColliderPairKey>& pairs)
+{
+    std::uint32_t count = 0;
+    if (!reader.Read(count))
+    {
+        return false;
+    }
+
+    pairs.resize(count);
+    return reader.ReadBytes(pairs.data(), count * sizeof(ColliderPairKey));
 }
 
 // ----------------------------------------------------------------------
@@ -171,8 +405,9 @@ void GameManager::ChangeScene(Scene newScene)
 // ----------------------------------------------------------------------
 void GameManager::CheckCollisions()
 {
-    std::vector<Collider*> colliders;
-    colliders.reserve(m_SceneGameObjects.size());
+    // NOTE: 以下の一時コンテナはすべて FrameArena 上に確保する（フレーム先頭で一括解放）
+    FrameVector<Collider*> colliders;
+    colliders.reserve(kColliderReserve);
 
     // シーン直下のGameObjectから、子も含めて全てのコライダーを収集
     for (GameObject* gameObject : m_SceneGameObjects)
@@ -182,19 +417,27 @@ void GameManager::CheckCollisions()
     }
 
     const size_t n = colliders.size();
-    
-    // 今フレームの衝突ペア情報を格納するセット
-    std::set<ColliderPair> currentCollisionPairs; // 衝突ペア情報
-    std::set<ColliderPair> currentTriggerPairs;   // トリガーペア情報
-
-    // ★ 今フレームに存在するコライダー集合を作成
-    std::unordered_set<Collider*> activeColliders;
-    activeColliders.reserve(n * 2);
-    for (auto* c : colliders)
+    FrameProfiler::SetCounter(ProfileCounter::Colliders, n);
+
+    // ★ 今回の判定に参加したコライダーへ印を付ける（Exit 判定で参照する）
+    // NOTE: 0 は「一度も参加していない」扱いなので飛ばす
+    if (++m_CollisionFrame == 0) ++m_CollisionFrame;
+    const std::uint32_t frame = m_CollisionFrame;
+    for (Collider* c : colliders)
     {
-        if (c) activeColliders.insert(c);
+        if (c) c->MarkCollected(frame);
     }
 
+    // 今フレームの衝突ペア情報（判定後にソートして二分探索に使う）
+    FrameVector<ColliderPairKey> currentCollisionPairs; // 衝突ペア情報
+    FrameVector<ColliderPairKey> currentTriggerPairs;   // トリガーペア情報
+    currentCollisionPairs.reserve(m_PreviousPairs.size() + kPairReserve);
+    currentTriggerPairs.reserve(m_PreviousTriggerPairs.size() + kPairReserve);
+
+    // 通知待ちのイベント（判定中はコールバックを呼ばず、ここへ積むだけ）
+    FrameVector<CollisionEvent> events;
+    events.reserve((m_PreviousPairs.size() + m_PreviousTriggerPairs.size()) * 2 + kEventReserve);
+
     // --- 衝突判定（Enter / Stay）---
     for (size_t i = 0; i < n; ++i)
     {
@@ -214,30 +457,25 @@ void GameManager::CheckCollisions()
 
             const bool isTriggerPair = (colliderA->m_IsTrigger || colliderB->m_IsTrigger);
 
-            ColliderPair pair = MakePair(colliderA, colliderB);
+            const ColliderPairKey pair = MakePairKey(colliderA->GetHandle(), colliderB->GetHandle());
 
             if (isTriggerPair)
             {
-                currentTriggerPairs.insert(pair);
-                const bool wasTriggering =
-                    (m_PreviousTriggerPairs.find(pair) != m_PreviousTriggerPairs.end());
-
-                if (wasTriggering)
-                {
-                    colliderA->InvokeOnTriggerStay(infoA);
-                    colliderB->InvokeOnTriggerStay(infoB);
-                }
-                else
-                {
-                    colliderA->InvokeOnTriggerEnter(infoA);
-                    colliderB->InvokeOnTriggerEnter(infoB);
-                }
+                currentTriggerPairs.push_back(pair);
+                const bool wasTriggering = std::binary_search(
+                    m_PreviousTriggerPairs.begin(), m_PreviousTriggerPairs.end(), pair);
+
+                const CollisionEventType type = wasTriggering
+                    ? CollisionEventType::TriggerStay
+                    : CollisionEventType::TriggerEnter;
+                QueueCollisionEvent(events, type, colliderA, infoA);
+                QueueCollisionEvent(events, type, colliderB, infoB);
             }
             else
             {
-                currentCollisionPairs.insert(pair);
-                const bool wasColliding =
-                    (m_PreviousPairs.find(pair) != m_PreviousPairs.end());
+                currentCollisionPairs.push_back(pair);
+                const bool wasColliding = std::binary_search(
+                    m_PreviousPairs.begin(), m_PreviousPairs.end(), pair);
 
                 // 既存：RigidBody解決（Triggerではやらない） :contentReference[oaicite:7]{index=7}
                 if (auto* ownerA = colliderA->m_Owner)
@@ -248,31 +486,30 @@ void GameManager::CheckCollisions()
                     if (auto* rbB = ownerB->GetComponent<RigidBody>())
                         rbB->ResolveCollision(infoB);
 
-                if (wasColliding)
-                {
-                    colliderA->InvokeOnCollisionStay(infoA);
-                    colliderB->InvokeOnCollisionStay(infoB);
-                }
-                else
-                {
-                    colliderA->InvokeOnCollisionEnter(infoA);
-                    colliderB->InvokeOnCollisionEnter(infoB);
-                }
+                const CollisionEventType type = wasColliding
+                    ? CollisionEventType::CollisionStay
+                    : CollisionEventType::CollisionEnter;
+                QueueCollisionEvent(events, type, colliderA, infoA);
+                QueueCollisionEvent(events, type, colliderB, infoB);
             }
         }
     }
 
+    // i < j の走査なのでペアは重複しない。ソートだけ行う
+    std::sort(currentCollisionPairs.begin(), currentCollisionPairs.end());
+    std::sort(currentTriggerPairs.begin(), currentTriggerPairs.end());
+
     // --- Collision Exit ---
-    for (const auto& pair : m_PreviousPairs)
+    // NOTE: 破棄済み（ハンドルが無効）/ 今回判定に参加していない Collider を含むペアは通知しない
+    for (const ColliderPairKey pair : m_PreviousPairs)
     {
-        Collider* a = pair.first;
-        Collider* b = pair.second;
+        Collider* a = ResolvePairFirst(pair);
+        Collider* b = ResolvePairSecond(pair);
 
-        if (activeColliders.find(a) == activeColliders.end() ||
-            activeColliders.find(b) == activeColliders.end())
+        if (!a || !b || !a->WasCollected(frame) || !b->WasCollected(frame))
             continue;
 
-        if (currentCollisionPairs.find(pair) == currentCollisionPairs.end())
+        if (!std::binary_search(currentCollisionPairs.begin(), currentCollisionPairs.end(), pair))
         {
             CollisionInfo infoA{};
             infoA.self  = a; infoA.other = b;
@@ -280,22 +517,21 @@ void GameManager::CheckCollisions()
             CollisionInfo infoB{};
             infoB.self  = b; infoB.other = a;
 
-            a->InvokeOnCollisionExit(infoA);
-            b->InvokeOnCollisionExit(infoB);
+            QueueCollisionEvent(events, CollisionEventType::CollisionExit, a, infoA);
+            QueueCollisionEvent(events, CollisionEventType::CollisionExit, b, infoB);
         }
     }
 
     // --- Trigger Exit ---
-    for (const auto& pair : m_PreviousTriggerPairs)
+    for (const ColliderPairKey pair : m_PreviousTriggerPairs)
     {
-        Collider* a = pair.first;
-        Collider* b = pair.second;
+        Collider* a = ResolvePairFirst(pair);
+        Collider* b = ResolvePairSecond(pair);
 
-        if (activeColliders.find(a) == activeColliders.end() ||
-            activeColliders.find(b) == activeColliders.end())
+        if (!a || !b || !a->WasCollected(frame) || !b->WasCollected(frame))
             continue;
 
-        if (currentTriggerPairs.find(pair) == currentTriggerPairs.end())
+        if (!std::binary_search(currentTriggerPairs.begin(), currentTriggerPairs.end(), pair))
         {
             CollisionInfo infoA{};
             infoA.self  = a; infoA.other = b;
@@ -303,12 +539,41 @@ void GameManager::CheckCollisions()
             CollisionInfo infoB{};
             infoB.self  = b; infoB.other = a;
 
-            a->InvokeOnTriggerExit(infoA);
-            b->InvokeOnTriggerExit(infoB);
+            QueueCollisionEvent(events, CollisionEventType::TriggerExit, a, infoA);
+            QueueCollisionEvent(events, CollisionEventType::TriggerExit, b, infoB);
         }
     }
 
-    // 次フレーム用に保存
-    m_PreviousPairs.swap(currentCollisionPairs);
-    m_PreviousTriggerPairs.swap(currentTriggerPairs);
+    // 次フレーム用に保存（FrameArena 上のデータは次フレームで無効になるため、永続側へコピー）
+    m_PreviousPairs.assign(currentCollisionPairs.begin(), currentCollisionPairs.end());
+    m_PreviousTriggerPairs.assign(currentTriggerPairs.begin(), currentTriggerPairs.end());
+
+    // --- イベント通知 ---
+    // 全ペアの判定と履歴の更新が済んでから、積んだ順にまとめて通知する
+    DispatchCollisionEvents(events);
+}
+
+// ----------------------------------------------------------------------
+// 衝突イベントの登録・通知
+// ----------------------------------------------------------------------
+// - 受信側（receiver の Owner）がその種別のコールバックを override していなければ積まない
+void GameManager::QueueCollisionEvent(FrameVector<CollisionEvent>& events, CollisionEventType type, Collider* receiver, const CollisionInfo& info)
+{
+    const GameObject* owner = receiver->m_Owner;
+    if (!owner || (owner->GetCollisionCallbackMask() & ToCallbackBit(type)) == 0)
+        return;
+
+    CollisionEvent& event = events.emplace_back();
+    event.type     = type;
+    event.receiver = receiver;
+    event.info     = info;
+}
+
+// - ハンドラ内で Destroy() されても破棄は親の Update 時なので、ここでの Collider / Owner は有効
+void GameManager::DispatchCollisionEvents(const FrameVector<CollisionEvent>& events)
+{
+    for (const CollisionEvent& event : events)
+    {
+        event.receiver->InvokeEvent(event.type, event.info);
+    }
 }
\ No newline at end of file
@@ -1,7 +1,8 @@
 ﻿#pragma once
 
 #include <vector>
-#include <set>
+#include <cstddef>
+#include <cstdint>
 #include "gameObject.h"
 #include "scene.h"
 
@@ -31,7 +32,7 @@ public:
     static void Draw();
 
     /// <summary>
-    /// シーン変更
+    /// シーン変更（次シーンをバックグラウンドで準備し、完了後の Update で差し替える）
     /// </summary>
     static void ChangeScene(Scene newScene);
 
@@ -40,19 +41,26 @@ public:
         return m_SceneGameObjects;
     }
 
+    /// <summary>
+    /// 現在のシーンの状態をスナップショットとして outBuffer へ書き出す
+    /// （中身は上書き。容量は再利用されるので、同じバッファを使い回せば定常状態では確保しない）
+    /// </summary>
+    static bool SaveSnapshot(std::vector<std::byte>& outBuffer);
+
+    /// <summary>
+    /// スナップショットを現在のシーンへ読み戻す（既存オブジェクトへの上書きのみで、シーンは作り直さない）
+    /// 戻り値：シーン / バージョン / 構成が一致せず復元できなかった場合 false
+    /// NOTE: 失敗時は途中まで上書きされた状態が残り得る
+    /// </summary>
+    static bool LoadSnapshot(const std::vector<std::byte>& buffer);
+
 private:
     // ----------------------------------------------------------------------
-    // 構造体定義
+    // 型定義
     // ----------------------------------------------------------------------
-    struct ColliderPair {
-        Collider* first;
-        Collider* second;
-
-        // 比較演算子を定義して set で使用可能にする
-        bool operator<(const ColliderPair& other) const {
-            return std::tie(first, second) < std::tie(other.first, other.second);
-        }
-    };
+    /// 衝突ペアのキー（上位 32bit：小さい方のハンドル / 下位 32bit：大きい方のハンドル）
+    /// NOTE: 整数なのでソート / 二分探索がそのまま使える
+    using ColliderPairKey = std::uint64_t;
 
     // ----------------------------------------------------------------------
     // 関数定義
@@ -63,21 +71,70 @@ private:
     static void CheckCollisions();
 
     /// <summary>
-    /// コライダーペアを作成（順序を気にせず一意に識別するため）
+    /// 衝突イベントを通知待ちに積む（受信側がその種別を override していなければ積まない）
     /// </summary>
-    static ColliderPair MakePair(Collider* first, Collider* second)
+    static void QueueCollisionEvent(FrameVector<CollisionEvent>& events, CollisionEventType type, Collider* receiver, const CollisionInfo& info);
+
+    /// <summary>
+    /// 積んだ衝突イベントを順に通知する（全ペアの判定が終わった後に呼ぶ）
+    /// </summary>
+    static void DispatchCollisionEvents(const FrameVector<CollisionEvent>& events);
+
+    /// <summary>
+    /// 読み込み済みのシーンへ差し替える（旧シーン解放 → 新シーン Init）
+    /// </summary>
+    static void ApplyLoadedScene(Scene newScene, std::vector<GameObject*>& newObjects);
+
+    /// <summary>
+    /// 衝突ペアの履歴を書き出す / 読み戻す（スナップショット用）
+    /// </summary>
+    static void WritePairs(SnapshotWriter& writer, const std::vector<ColliderPairKey>& pairs);
+    static bool ReadPairs(SnapshotReader& reader, std::vector<ColliderPairKey>& pairs);
+
+    /// <summary>
+    /// コライダーペアのキーを作成（順序を気にせず一意に識別するため）
+    /// </summary>
+    static ColliderPairKey MakePairKey(ColliderHandle first, ColliderHandle second)
     {
-        return (first < second) ? ColliderPair{ first, second } 
-                                : ColliderPair{ second, first };
+        const std::uint32_t a = first.GetValue();
+        const std::uint32_t b = second.GetValue();
+        return (a < b) ? (static_cast<ColliderPairKey>(a) << 32) | b
+                       : (static_cast<ColliderPairKey>(b) << 32) | a;
     }
 
+    /// <summary>
+    /// ペアキーの各ハンドルから Collider を引く（破棄済みなら nullptr）
+    /// </summary>
+    static Collider* ResolvePairFirst(ColliderPairKey key)
+    {
+        return Collider::Resolve(ColliderHandle::FromValue(static_cast<std::uint32_t>(key >> 32)));
+    }
+    static Collider* ResolvePairSecond(ColliderPairKey key)
+    {
+        return Collider::Resolve(ColliderHandle::FromValue(static_cast<std::uint32_t>(key)));
+    }
+
+    // ----------------------------------------------------------------------
+    // 定数定義
+    // ----------------------------------------------------------------------
+    static constexpr size_t kColliderReserve = 256;   // Collider 一覧の初期確保数（FrameArena 上）
+    static constexpr size_t kPairReserve     = 64;    // 衝突ペアの追加確保数（FrameArena 上）
+    static constexpr size_t kEventReserve    = 64;    // 衝突イベントの追加確保数（FrameArena 上）
+
     // ----------------------------------------------------------------------
     // 変数定義
     // ----------------------------------------------------------------------
     static Scene m_CurrentScene;                          // 現在のシーン
     static std::vector<GameObject*> m_SceneGameObjects;   // 現在のシーンのGameObjectリスト
-    static std::set<ColliderPair> m_PreviousPairs;        // 前フレームの衝突ペア情報
-    static std::set<ColliderPair> m_PreviousTriggerPairs; // 前フレームのトリガーペア情報
+    // NOTE: フレームをまたいで保持するため FrameArena ではなく通常の vector（ソート済み）。
+    //       容量は保持したまま中身だけ入れ替えるので、定常状態では再確保しない
+    static std::vector<ColliderPairKey> m_PreviousPairs;        // 前フレームの衝突ペア情報
+    static std::vector<ColliderPairKey> m_PreviousTriggerPairs; // 前フレームのトリガーペア情報
+    static std::uint32_t m_CollisionFrame;                      // 衝突判定の実行回数（Collider の参加判定用）
+
+#if defined(_DEBUG)
+    static std::vector<std::byte> m_DebugSnapshot;              // デバッグ用スナップショット（F5 保存 / F9 復元）
+#endif // _DEBUG
 
     
 };
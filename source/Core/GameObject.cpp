@@ -6,67 +6,222 @@
 // コンポーネント関連
 #include "ColliderGroup.h"
 #include "Collider.h"
+#include "ObjectPool.h"
+#include "Snapshot.h"
+#include "JobSystem.h"
+#include "FrameArena.h"
+
+// 静的メンバ変数の定義
+std::atomic<std::size_t> GameObject::s_LiveCount{ 0 };
+std::uint32_t GameObject::s_UpdateFrame = 0;
+
+namespace
+{
+    /// GameObject のハンドル表
+    /// NOTE: 関数内 static にして、初期化/破棄順序が他の静的オブジェクトに依存しないようにする
+    SlotMap<GameObject*, GameObjectHandleTag>& GetHandleRegistry()
+    {
+        static SlotMap<GameObject*, GameObjectHandleTag> s_Registry;
+        return s_Registry;
+    }
+
+    /// 並列更新で 1 ジョブが受け持つ子の数
+    constexpr std::size_t kParallelUpdateGrain = 8;
+
+    /// 並列更新する子と、その子へ渡す経過時間（更新頻度の間引き分を含む）
+    struct ScheduledUpdate
+    {
+        GameObject* object;
+        float       deltaTime;
+    };
+
+    /// 並列更新ジョブ本体（data は ScheduledUpdate 配列）
+    void UpdateObjectsJob(void* data, std::size_t begin, std::size_t end)
+    {
+        const auto* updates = static_cast<const ScheduledUpdate*>(data);
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            updates[i].object->Update(updates[i].deltaTime);
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------
+// 生成・破棄
+// ------------------------------------------------------------------------------
+// - 生存数は計測用（FrameProfiler）にのみ使用する
+// - ハンドルは生成時に発行し、破棄の最初に無効化する（子の破棄中に自身が引けないように）
+// - 破棄順は「子オブジェクト → Component」（unique_ptr 所有時と同じ順序）
+// - インライン領域の Component はデストラクタのみ呼び、ヒープ側は delete する
+GameObject::GameObject()
+{
+    m_Handle = GetHandleRegistry().Insert(this);
+    s_LiveCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+GameObject::~GameObject()
+{
+    GetHandleRegistry().Erase(m_Handle);
+
+    for (GameObject* child : m_Children)
+    {
+        delete child;
+    }
+    m_Children.clear();
+
+    for (Component* component : m_Components)
+    {
+        if (IsInlineComponent(component))
+        {
+            component->~Component();
+        }
+        else
+        {
+            delete component;
+        }
+    }
+    m_Components.clear();
+
+    s_LiveCount.fetch_sub(1, std::memory_order_relaxed);
+}
+
+// ------------------------------------------------------------------------------
+// ハンドル
+// ------------------------------------------------------------------------------
+// - RenewHandle は解除 → 再発行。同じスロットが再利用された場合も世代が進むので古いハンドルは一致しない
+void GameObject::RenewHandle()
+{
+    auto& registry = GetHandleRegistry();
+    registry.Erase(m_Handle);
+    m_Handle = registry.Insert(this);
+}
+
+GameObject* GameObject::Resolve(GameObjectHandle handle)
+{
+    GameObject** object = GetHandleRegistry().Find(handle);
+    return object ? *object : nullptr;
+}
+
+// ------------------------------------------------------------------------------
+// 更新頻度
+// ------------------------------------------------------------------------------
+// - EveryNFrames：フレーム番号が間隔で割り切れるフレームに更新する
+// - TimeSliced  ：ハンドルのインデックスで位相をずらし、同じ間隔のオブジェクトを各フレームへ分散する
+// NOTE: プールでハンドルが再発行されると位相が変わり、1 回だけ間隔が伸び縮みする。
+//       経過時間は溜めた分をそのまま渡すので、移動量などの合計は変わらない
+bool GameObject::AdvanceUpdateSchedule(float deltaTime, float& outDeltaTime)
+{
+    m_PendingDelta += deltaTime;
+
+    if (m_UpdateTier != UpdateTier::EveryFrame && m_UpdateInterval > 1)
+    {
+        const std::uint32_t phase = (m_UpdateTier == UpdateTier::TimeSliced) ? m_Handle.GetIndex() : 0;
+        if ((s_UpdateFrame + phase) % m_UpdateInterval != 0)
+        {
+            return false;
+        }
+    }
+
+    outDeltaTime   = m_PendingDelta;
+    m_PendingDelta = 0.0f;
+    return true;
+}
 
 // ------------------------------------------------------------------------------
 // 更新処理
 // ------------------------------------------------------------------------------
 // - Component / 子オブジェクトを更新する
 // - Update後に、Destroyフラグが立っている子オブジェクトを回収して破棄
-// - 子オブジェクトの実体破棄は親（このGameObject）が行う（m_Childrenのunique_ptrが解放される）
+// - 子オブジェクトの実体破棄は親（このGameObject）が行う
+// - プール管理下の子は破棄せず、プールへ返却する（無効化されて子のまま残る）
+// - 無効な子は更新しない。更新頻度で間引かれた子も、このフレームは更新しない
+// - 並列更新可能な子は直列の子の後にまとめて JobSystem へ渡し、完了を待ってから回収へ進む
 // NOTE: この回収では Uninit() は呼ばれない（必要なら別途明示的に呼ぶ設計にする）
 void GameObject::Update(float deltaTime)
 {
     // Component 更新
-    for (auto& component : m_Components)
+    for (Component* component : m_Components)
     {
         component->Update(deltaTime);
     }
     
-    // 子オブジェクト 更新
-    for (auto& child : m_Children)
+    // 子オブジェクト 更新（並列更新可能な子は後でまとめて回す）
+    if (!m_Children.empty())
     {
-        child->Update(deltaTime);
+        FrameVector<ScheduledUpdate> parallelChildren;
+        for (GameObject* child : m_Children)
+        {
+            if (!child->IsActive()) continue;
+
+            float childDelta = 0.0f;
+            if (!child->AdvanceUpdateSchedule(deltaTime, childDelta)) continue;
+
+            if (child->IsParallelUpdateSafe())
+            {
+                if (parallelChildren.empty()) parallelChildren.reserve(m_Children.size());
+                parallelChildren.push_back({ child, childDelta });
+                continue;
+            }
+            child->Update(childDelta);
+        }
+
+        if (!parallelChildren.empty())
+        {
+            JobCounter counter;
+            JobSystem::ParallelFor(parallelChildren.size(), kParallelUpdateGrain, &UpdateObjectsJob, parallelChildren.data(), counter);
+            JobSystem::Wait(counter);
+        }
     }
 
-    // Destroyフラグが立っている子オブジェクトを回収して破棄（unique_ptrなので実体も破棄される）
-    m_Children.erase(
-        std::remove_if(
-            m_Children.begin(),
-            m_Children.end(),
-            [](const std::unique_ptr<GameObject>& child) {
-                return child->IsDead();
-            }),
-        m_Children.end());
+    // Destroyフラグが立っている子オブジェクトを回収して破棄（生存分は順序を保って前詰め）
+    std::size_t aliveCount = 0;
+    for (std::size_t i = 0; i < m_Children.size(); ++i)
+    {
+        GameObject* child = m_Children[i];
+        if (child->IsDead())
+        {
+            if (child->m_Pool)
+            {
+                // プール管理下：削除フラグを戻して返却（子としては残す）
+                child->m_IsDead = false;
+                child->m_Pool->Release(child);
+                m_Children[aliveCount++] = child;
+                continue;
+            }
+            delete child;
+            continue;
+        }
+        m_Children[aliveCount++] = child;
+    }
+    m_Children.resize(aliveCount);
 }
 
 // ------------------------------------------------------------------------------
 // 描画処理
 // ------------------------------------------------------------------------------
-// - Component / 子オブジェクトを描画する
+// - Component / 子オブジェクトを描画する（無効な子は描画しない）
 // - デバッグ設定が有効な場合のみ、Collider を DebugDraw する
 void GameObject::Draw()
 {
     // Component 描画
-    for (auto &component : m_Components)
+    for (Component* component : m_Components)
     {
         component->Draw();
     }
 
     // 子オブジェクト 描画
-    for (auto &child : m_Children)
+    for (GameObject* child : m_Children)
     {
+        if (!child->IsActive()) continue;
         child->Draw();
     }
 
     // デバッグ用：Collider 描画（有効な場合のみ）
     if (g_EnableColliderDebugDraw)
     {
-        for (auto &component : m_Components)
+        for (auto* collider : m_Colliders)
         {
-            if (auto collider = dynamic_cast<Collider *>(component.get()))
-            {
-                collider->DebugDraw();
-            }
+            collider->DebugDraw();
         }
     }
 }
@@ -74,7 +229,7 @@ void GameObject::Draw()
 // ------------------------------------------------------------------------------
 // 子オブジェクトを追加する（基本版）
 // ------------------------------------------------------------------------------
-// 戻り値は非所有ポインタ（所有権は親GameObject側が保持：m_Childrenのunique_ptr）
+// 戻り値は非所有ポインタ（所有権は親GameObject側が保持：m_Children）
 // 生成直後に AttachChild により親子関係（m_Parent / Transformの親）が構築される
 GameObject* GameObject::CreateChild()
 {
@@ -94,23 +249,27 @@ void GameObject::AttachChild(std::unique_ptr<GameObject> child)
 {
     child->m_Parent = this;
     child->m_Transform.SetParent(&m_Transform);
-    m_Children.push_back(std::move(child));
+    m_Children.push_back(child.release());  // 以降の破棄は親（このGameObject）が行う
 }
 
 // ------------------------------------------------------------------------------
 // 子オブジェクトをデタッチする（親子関係も解除）
 // ------------------------------------------------------------------------------
 // NOTE: "Detach" という語感とは異なり、この実装は「所有を外へ渡す」のではなく
-//       親子関係を解除したあとに、m_Children.clear() で全破棄している点に注意
+//       親子関係を解除したあとに全破棄している点に注意
 void GameObject::DetachAllChildren()
 {
     // 破棄前に親子関係（Transform / Parent参照）を解除しておく
-    for (auto &child : m_Children)
+    for (GameObject* child : m_Children)
     {
         child->m_Transform.ClearParent();
         child->m_Parent = nullptr;
     }
-    // unique_ptr を破棄＝子オブジェクトもすべて破棄される
+    // 子オブジェクトをすべて破棄する
+    for (GameObject* child : m_Children)
+    {
+        delete child;
+    }
     m_Children.clear();
 }
 
@@ -119,33 +278,106 @@ void GameObject::DetachAllChildren()
 // ------------------------------------------------------------------------------
 // - ColliderGroup は中に Collider を保持するため、グループ内をフラットに展開して追加する
 // - それ以外の Collider はそのまま追加する
-// - 子オブジェクトも再帰的に収集する
-void GameObject::CollectCollidersRecursive(std::vector<Collider*>& outColliders)
+// - 子オブジェクトも再帰的に収集する（無効な子は除外）
+// NOTE: 展開は Collider::CollectColliders に委譲する（dynamic_cast を使わない）
+void GameObject::CollectCollidersRecursive(FrameVector<Collider*>& outColliders)
 {
-    // 自分の Component から収集
-    for (auto& component : m_Components)
+    // 自分の Collider 系 Component から収集
+    for (auto* collider : m_Colliders)
     {
-        // ColliderGroup は中身の Collider を展開して追加
-        if (auto* colliderGroup = dynamic_cast<ColliderGroup*>(component.get()))
-        {
-            for (auto& collider : colliderGroup->colliders)
-            {
-                if (collider)
-                {
-                    outColliders.push_back(collider.get());
-                }
-            }
-        }
-        // それ以外の単体 Collider はそのまま追加
-        else if (auto* collider = dynamic_cast<Collider*>(component.get()))
-        {
-            outColliders.push_back(collider);
-        }
+        collider->CollectColliders(outColliders);
     }
 
     // 子オブジェクトも再帰的に収集
-    for (auto& child : m_Children)
+    for (GameObject* child : m_Children)
     {
+        if (!child->IsActive()) continue;
         child->CollectCollidersRecursive(outColliders);
     }
-}
\ No newline at end of file
+}
+
+// ------------------------------------------------------------------------------
+// スナップショット
+// ------------------------------------------------------------------------------
+// - 書き出し順：Transform → 有効/削除フラグ → 更新頻度と未消化の経過時間 → Component 数と各状態 → 子の数と各状態
+// - 読み戻しは同じ順序。構成（Component 数）が違えば失敗として中断する
+// - 子の数が違う場合：
+//   - 足りない → GrowChildrenForRestore でプールを拡張して補う
+//   - 余る     → プール管理下の子は無効化（プール待機）、それ以外は失敗
+void GameObject::WriteState(SnapshotWriter& writer) const
+{
+    writer.Write(m_Transform.Position);
+    writer.Write(m_Transform.Rotation);
+    writer.Write(m_Transform.Scale);
+    writer.Write(m_IsActive);
+    writer.Write(m_IsDead);
+    writer.Write(m_UpdateTier);
+    writer.Write(m_UpdateInterval);
+    writer.Write(m_PendingDelta);
+
+    writer.Write(static_cast<std::uint32_t>(m_Components.size()));
+    for (const Component* component : m_Components)
+    {
+        component->WriteState(writer);
+    }
+
+    writer.Write(static_cast<std::uint32_t>(m_Children.size()));
+    for (const GameObject* child : m_Children)
+    {
+        child->WriteState(writer);
+    }
+}
+
+void GameObject::ReadState(SnapshotReader& reader)
+{
+    reader.Read(m_Transform.Position);
+    reader.Read(m_Transform.Rotation);
+    reader.Read(m_Transform.Scale);
+    reader.Read(m_IsActive);
+    reader.Read(m_IsDead);
+    reader.Read(m_UpdateTier);
+    reader.Read(m_UpdateInterval);
+    reader.Read(m_PendingDelta);
+
+    std::uint32_t componentCount = 0;
+    if (!reader.Read(componentCount) || componentCount != m_Components.size())
+    {
+        reader.Fail();
+        return;
+    }
+    for (Component* component : m_Components)
+    {
+        component->ReadState(reader);
+    }
+
+    std::uint32_t childCount = 0;
+    if (!reader.Read(childCount))
+    {
+        return;
+    }
+    if (childCount > m_Children.size() && !GrowChildrenForRestore(childCount))
+    {
+        reader.Fail();
+        return;
+    }
+
+    for (std::size_t i = 0; i < m_Children.size(); ++i)
+    {
+        GameObject* child = m_Children[i];
+        if (i < childCount)
+        {
+            child->ReadState(reader);
+            if (reader.IsFailed()) return;
+        }
+        else if (child->m_Pool)
+        {
+            child->m_IsDead = false;
+            child->SetActive(false);
+        }
+        else
+        {
+            reader.Fail();
+            return;
+        }
+    }
+}
@@ -14,11 +14,20 @@
 //
 // 構成:
 // - Transform              : 位置・回転・スケール情報を保持
-// - Component 管理         : Component を複数所有（unique_ptr）
+// - Component 管理         : Component を複数所有
+//                            型ID テーブルにより GetComponent<T>() を O(1) で解決
+//                            小さな Component は GameObject 内のインライン領域に配置
 // - 子オブジェクト管理     : GameObject を階層構造で所有可能
 // - ライフサイクル         : Init / Update / Draw
 // - 衝突イベント受信       : OnCollision / OnTrigger 系コールバック
+//                            override しているものだけをクラスごとのマスクで記録し、通知対象を絞る
 // - 生存管理               : Destroy による遅延削除フラグ
+// - 有効/無効              : 無効な子は Update / Draw / 衝突収集の対象外（プール待機用）
+// - ハンドル               : 生成時に世代付きハンドルを発行（非所有参照は ObjectHandle<T> で持つ）
+// - スナップショット       : WriteState / ReadState で Transform・フラグ・Component・子を順に保存/復元
+// - 並列更新               : IsParallelUpdateSafe() が true の子は JobSystem で並列に Update する
+// - 更新頻度               : UpdateTier で毎フレーム / N フレームごと / 時分割を選ぶ
+//                            間引かれたフレームの経過時間は溜めておき、次の Update にまとめて渡す
 //
 // NOTE:
 // GameObject 自体は描画処理を直接持たない。
@@ -27,9 +36,17 @@
 #pragma once
 #include "DebugSettings.h"
 #include "CollisionInfo.h"
+#include "CollisionEvent.h"
 #include <memory>
 #include <vector>
 #include <type_traits>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+#include <new>
+#include "InlineVector.h"
+#include "SlotMap.h"
 
 // コンポーネント関連ヘッダ
 #include "Transform.h"
@@ -39,6 +56,22 @@
 
 // 前方宣言
 class Collider;
+class GameObject;
+class GameObjectPoolBase;
+class SnapshotWriter;
+class SnapshotReader;
+
+/// 更新頻度の段階（GameObject::SetUpdateTier で設定）
+enum class UpdateTier : std::uint8_t
+{
+    EveryFrame,     // 毎フレーム更新する（既定）
+    EveryNFrames,   // N フレームに 1 回。同じ間隔のオブジェクトはそろって同じフレームに更新する
+    TimeSliced,     // N フレームに 1 回。オブジェクトごとに更新フレームをずらして負荷を均す
+};
+
+/// GameObject の世代付きハンドル
+struct GameObjectHandleTag;
+using GameObjectHandle = Handle<GameObjectHandleTag>;
 
 /// ゲームオブジェクトの基底クラス
 /// - Transform 情報を持ち、複数の Component と子オブジェクトを所有できる
@@ -47,8 +80,28 @@ class Collider;
 class GameObject  
 {
 public:
+    GameObject();
+
     /// 仮想デストラクタ（派生クラスを安全に破棄するため）
-    virtual ~GameObject() = default;
+    /// - 子オブジェクト → Component の順に破棄する
+    virtual ~GameObject();
+
+    // Component / 子を生ポインタで所有しているためコピー禁止
+    GameObject(const GameObject&) = delete;
+    GameObject& operator=(const GameObject&) = delete;
+
+    /// T を生成し、衝突コールバックのマスクを設定して返す
+    /// - 所有権：呼び出し側（シーン直下のリストや AttachChild へ渡すこと）
+    /// NOTE: new T() で直接生成した場合、マスクは「全イベント受信」のままになる（動作はするが省略が効かない）
+    template <class T, class... Args>
+    static T* Create(Args&&... args)
+    {
+        static_assert(std::is_base_of<GameObject, T>::value, "T must inherit from GameObject");
+
+        T* object = new T(std::forward<Args>(args)...);
+        object->m_CallbackMask = CollisionCallbackMaskOf<T>();
+        return object;
+    }
 
     // ----------------------------------------------------------------------
     // ライフサイクルメソッド
@@ -58,7 +111,13 @@ public:
     /// 終了処理（明示的な解放が必要な場合に実装）
     virtual void Uninit() {}
     /// 更新処理（deltaTimeは秒単位）
+    /// - 子のうち IsParallelUpdateSafe() なものは、直列の子を更新した後にまとめて並列で更新する
+    ///   （戻る前に全件の完了を待つので、親の回収処理・衝突判定とは重ならない）
     virtual void Update(float deltaTime);
+    /// Update を他オブジェクトと並列に呼んでよいか（既定：false）
+    /// - true を返す場合、Update（子・Component を含む）は自分自身の状態のみを読み書きすること
+    ///   （他オブジェクト・static 変数・シングルトン・Renderer / Audio / Input へ触れない）
+    virtual bool IsParallelUpdateSafe() const { return false; }
     /// 描画処理
     virtual void Draw();
 
@@ -66,7 +125,8 @@ public:
     // Component管理
     // ----------------------------------------------------------------------
     /// Componentを追加する
-    /// - 所有権：GameObjectが保持（unique_ptrで所有）
+    /// - 所有権：GameObjectが保持（破棄は GameObject のデストラクタ）
+    /// - 配置：インライン領域に収まる場合は GameObject 内に配置し、収まらない場合はヒープに確保する
     /// - 戻り値：非所有ポインタ
     ///   - GameObject が生存し、かつ当該 Component が保持されている間のみ有効
     ///   - 将来的に Component の削除/差し替えを導入した場合、無効化され得る
@@ -78,8 +138,11 @@ public:
     {
         static_assert(std::is_base_of<Component, T>::value, "T must inherit from Component");
 
-        auto comp = std::make_unique<T>(std::forward<Args>(args)...);
-        T *ptr = comp.get();
+        void* inlineMemory = AllocateInlineComponent(sizeof(T), alignof(T));
+        T *comp = inlineMemory
+            ? new (inlineMemory) T(std::forward<Args>(args)...)
+            : new T(std::forward<Args>(args)...);
+        T *ptr = comp;
 
         // GameObjectとの連携を設定（Ownerは常に設定）
         comp->m_Owner = this;
@@ -92,19 +155,32 @@ public:
             comp->m_Transform = &m_Transform;
 
         comp->Init();
-        m_Components.push_back(std::move(comp));
+        m_Components.push_back(comp);
+
+        // 型ID テーブルへ登録（GetComponent 用）
+        RegisterComponentLookup<T>(ptr);
+        if constexpr (std::is_base_of<Collider, T>::value)
+            m_Colliders.push_back(ptr);
+
         return ptr;
     }
 
     /// 指定タイプのComponentを取得する（例：GetComponent<BoxCollider>()）
+    /// - 型ID テーブルを引くだけなので O(1)（dynamic_cast は使わない）
+    /// - 追加時の型、または LookupBaseType で宣言された基底型（例：Collider）で引ける
+    /// - 同じ型が複数ある場合は最初に追加されたものを返す
     /// 戻り値：見つからない場合は nullptr
     template <typename T>
     T *GetComponent()
     {
-        for (auto &c : m_Components)
-            if (auto ptr = dynamic_cast<T *>(c.get()))
-                return ptr;
-        return nullptr;
+        static_assert(std::is_base_of<Component, T>::value, "T must inherit from Component");
+
+        const ComponentTypeId id = ComponentTypeRegistry::GetId<T>();
+        assert(id < kMaxComponentTypes && "kMaxComponentTypes を増やしてください");
+        if (id >= kMaxComponentTypes)
+            return nullptr;
+
+        return static_cast<T *>(m_ComponentLookup[id]);
     }
     
     // ----------------------------------------------------------------------
@@ -122,7 +198,7 @@ public:
     T* CreateChild(Args&&... args) {
         static_assert(std::is_base_of<GameObject, T>::value, "T must inherit from GameObject");
 
-        auto child = std::make_unique<T>(std::forward<Args>(args)...);
+        std::unique_ptr<T> child(Create<T>(std::forward<Args>(args)...));
         T* ptr = child.get();
         AttachChild(std::move(child));
         return ptr;
@@ -148,8 +224,29 @@ public:
     virtual void OnTriggerStay(const CollisionInfo& info) {}
     virtual void OnTriggerExit(const CollisionInfo& info) {}
 
+    /// 受け取る衝突イベントのマスク（GameManager がイベントを積むかの判定に使う）
+    CollisionCallbackMask GetCollisionCallbackMask() const { return m_CallbackMask; }
+
+    /// T が override している衝突コールバックからマスクを求める
+    /// - override していない関数は &T::OnXxx の型が GameObject のメンバ関数ポインタのままになることを利用する
+    template <class T>
+    static constexpr CollisionCallbackMask CollisionCallbackMaskOf()
+    {
+        using Callback = void (GameObject::*)(const CollisionInfo&);
+
+        CollisionCallbackMask mask = 0;
+        if (!std::is_same<decltype(&T::OnCollisionEnter), Callback>::value) mask |= ToCallbackBit(CollisionEventType::CollisionEnter);
+        if (!std::is_same<decltype(&T::OnCollisionStay),  Callback>::value) mask |= ToCallbackBit(CollisionEventType::CollisionStay);
+        if (!std::is_same<decltype(&T::OnCollisionExit),  Callback>::value) mask |= ToCallbackBit(CollisionEventType::CollisionExit);
+        if (!std::is_same<decltype(&T::OnTriggerEnter),   Callback>::value) mask |= ToCallbackBit(CollisionEventType::TriggerEnter);
+        if (!std::is_same<decltype(&T::OnTriggerStay),    Callback>::value) mask |= ToCallbackBit(CollisionEventType::TriggerStay);
+        if (!std::is_same<decltype(&T::OnTriggerExit),    Callback>::value) mask |= ToCallbackBit(CollisionEventType::TriggerExit);
+        return mask;
+    }
+
     /// 子オブジェクトも含めてすべての Collider を収集する
-    void CollectCollidersRecursive(std::vector<Collider*>& outColliders);
+    /// NOTE: 収集先はフレーム一時領域（FrameArena）。次フレームまで保持しないこと
+    void CollectCollidersRecursive(FrameVector<Collider*>& outColliders);
 
     // ----------------------------------------------------------------------
     // 生存管理
@@ -160,6 +257,134 @@ public:
     /// 削除予定かどうか
     bool IsDead() const { return m_IsDead; }
 
+    /// 有効/無効を切り替える
+    /// - 無効な子オブジェクトは親の Update / Draw / Collider 収集から除外される
+    /// - 有効化時、溜めていた経過時間は捨てる（プール待機前の端数を持ち越さない）
+    void SetActive(bool active)
+    {
+        if (active && !m_IsActive) m_PendingDelta = 0.0f;
+        m_IsActive = active;
+    }
+
+    /// 有効かどうか
+    bool IsActive() const { return m_IsActive; }
+
+    /// 所属するプールを設定する（ObjectPool から呼ばれる）
+    /// - 設定されている場合、Destroy() 後の回収時に破棄ではなくプールへ返却される
+    void SetPool(GameObjectPoolBase* pool) { m_Pool = pool; }
+
+    /// 生存中の GameObject 数（計測用）
+    static std::size_t GetLiveCount() { return s_LiveCount.load(std::memory_order_relaxed); }
+
+    // ----------------------------------------------------------------------
+    // 更新頻度
+    // ----------------------------------------------------------------------
+    /// 更新頻度を設定する
+    /// - interval：EveryNFrames / TimeSliced の間隔（フレーム数。1 以下なら毎フレーム）
+    /// NOTE: 間引くと子オブジェクトの更新も同じ頻度になる（子は親の Update から更新されるため）
+    void SetUpdateTier(UpdateTier tier, std::uint8_t interval = 1)
+    {
+        m_UpdateTier     = tier;
+        m_UpdateInterval = interval;
+    }
+
+    UpdateTier GetUpdateTier() const { return m_UpdateTier; }
+
+    /// 今フレーム更新するかを判定する（親 / GameManager が Update を呼ぶ前に使う）
+    /// - deltaTime を溜め、更新する場合は溜めた分を outDeltaTime に返してリセットする
+    /// 戻り値：今フレーム Update を呼ぶ場合 true
+    bool AdvanceUpdateSchedule(float deltaTime, float& outDeltaTime);
+
+    /// 更新フレーム番号を進める（GameManager::Update の先頭で 1 回呼ぶ）
+    static void AdvanceUpdateFrame() { ++s_UpdateFrame; }
+
+    /// 更新フレーム番号（スナップショット用）
+    static std::uint32_t GetUpdateFrame() { return s_UpdateFrame; }
+    static void SetUpdateFrame(std::uint32_t frame) { s_UpdateFrame = frame; }
+
+    // ----------------------------------------------------------------------
+    // ハンドル
+    // ----------------------------------------------------------------------
+    /// この GameObject のハンドル（生成時に発行、破棄時に無効化）
+    GameObjectHandle GetHandle() const { return m_Handle; }
+
+    /// ハンドルを発行し直す（古いハンドルは無効になる）
+    /// - プールへの返却時に呼ばれ、返却前の参照が再利用後の個体を指さないようにする
+    void RenewHandle();
+
+    /// ハンドルから GameObject を引く
+    /// 戻り値：破棄済み / 無効なハンドルなら nullptr
+    static GameObject* Resolve(GameObjectHandle handle);
+
+    // ----------------------------------------------------------------------
+    // スナップショット
+    // ----------------------------------------------------------------------
+    /// シミュレーション状態を書き出す
+    /// - Transform / 有効・削除フラグ / 各 Component / 子（再帰）の順
+    /// - 派生クラスで独自の状態を持つ場合は override し、基底を先に呼んでから追記する
+    virtual void WriteState(SnapshotWriter& writer) const;
+
+    /// WriteState で書いた状態を読み戻す（既存のオブジェクトへ上書きし、確保はしない）
+    /// - Component 数が一致しない場合は reader を失敗にして中断する
+    /// - 子が足りない場合は GrowChildrenForRestore で補う。余った子はプール管理下なら無効化する
+    virtual void ReadState(SnapshotReader& reader);
+
+protected:
+    /// 復元時に子が count 個に満たない場合に呼ばれる
+    /// - プールを持つ派生クラスは、プールを拡張して子を count 個にする
+    /// 戻り値：count 個にできた場合 true（既定：false = 構成不一致）
+    virtual bool GrowChildrenForRestore(std::size_t count) { return false; }
+
+public:
+
+private:
+    // ----------------------------------------------------------------------
+    // Component 型ID テーブル
+    // ----------------------------------------------------------------------
+    /// T とその LookupBaseType 連鎖の型ID へ comp を登録する
+    template <typename T>
+    void RegisterComponentLookup(Component* comp)
+    {
+        SetComponentLookup(ComponentTypeRegistry::GetId<T>(), comp);
+
+        using Base = typename T::LookupBaseType;
+        if constexpr (!std::is_void<Base>::value && !std::is_same<Base, T>::value)
+            RegisterComponentLookup<Base>(comp);
+    }
+
+    // ----------------------------------------------------------------------
+    // Component 配置
+    // ----------------------------------------------------------------------
+    /// インライン領域から size / align を満たす領域を切り出す
+    /// 戻り値：収まらない場合は nullptr（呼び出し側でヒープ確保する）
+    void* AllocateInlineComponent(std::size_t size, std::size_t align)
+    {
+        if (align > kInlineComponentAlign)
+            return nullptr;
+
+        const std::size_t offset = (m_InlineComponentUsed + align - 1) & ~(align - 1);
+        if (offset + size > kInlineComponentBytes)
+            return nullptr;
+
+        m_InlineComponentUsed = offset + size;
+        return m_InlineComponentStorage + offset;
+    }
+
+    /// comp がインライン領域に配置されているか
+    bool IsInlineComponent(const Component* comp) const
+    {
+        const auto* p = reinterpret_cast<const std::byte*>(comp);
+        return p >= m_InlineComponentStorage && p < m_InlineComponentStorage + kInlineComponentBytes;
+    }
+
+    /// 型ID の枠が空いていれば comp を登録する（先に追加されたものを優先）
+    void SetComponentLookup(ComponentTypeId id, Component* comp)
+    {
+        assert(id < kMaxComponentTypes && "kMaxComponentTypes を増やしてください");
+        if (id < kMaxComponentTypes && !m_ComponentLookup[id])
+            m_ComponentLookup[id] = comp;
+    }
+
 public:
     // ----------------------------------------------------------------------
     // Transform情報
@@ -171,9 +396,65 @@ protected:
     // 所有権・参照関係
     // ----------------------------------------------------------------------
     GameObject* m_Parent = nullptr;                         // 非所有：親への参照
-    
-    std::vector<std::unique_ptr<Component>> m_Components;   // 所有：Component群
-    std::vector<std::unique_ptr<GameObject>> m_Children;    // 所有：子オブジェクト群
+
+    // NOTE: 敵やギミックは Component 2〜3 個・子 0〜数個が大半のため、
+    //       その範囲はヒープ確保なし・連続メモリで走査できる容量にしている
+    static constexpr std::size_t kInlineComponentCount = 4;     // インラインで持つ Component ポインタ数
+    static constexpr std::size_t kInlineChildCount     = 4;     // インラインで持つ子ポインタ数
+    static constexpr std::size_t kInlineComponentBytes = 256;   // Component 本体を配置するインライン領域
+    static constexpr std::size_t kInlineComponentAlign = 16;    // インライン領域のアライメント
+
+    InlineVector<Component*, kInlineComponentCount> m_Components;   // 所有：Component群
+    InlineVector<GameObject*, kInlineChildCount>    m_Children;     // 所有：子オブジェクト群
+
+    Component* m_ComponentLookup[kMaxComponentTypes] = {};  // 非所有：型ID → Component
+    std::vector<Collider*> m_Colliders;                     // 非所有：Collider 系 Component
 
     bool m_IsDead = false;                                  // 削除フラグ
+    bool m_IsActive = true;                                 // 有効フラグ
+    GameObjectPoolBase* m_Pool = nullptr;                   // 非所有：返却先プール（プール管理外なら nullptr）
+
+private:
+    GameObjectHandle m_Handle;                              // 自身のハンドル
+    CollisionCallbackMask m_CallbackMask = kAllCollisionCallbacks; // 受け取る衝突イベント（Create<T> で設定）
+
+    UpdateTier   m_UpdateTier     = UpdateTier::EveryFrame; // 更新頻度
+    std::uint8_t m_UpdateInterval = 1;                      // 更新間隔（フレーム数）
+    float        m_PendingDelta   = 0.0f;                   // 間引かれて未消化の経過時間（秒）
+
+    alignas(kInlineComponentAlign) std::byte m_InlineComponentStorage[kInlineComponentBytes];  // Component 本体の配置先
+    std::size_t m_InlineComponentUsed = 0;                  // インライン領域の使用量（バイト）
+
+    static std::atomic<std::size_t> s_LiveCount;            // 生存中の GameObject 数
+    static std::uint32_t s_UpdateFrame;                     // 更新フレーム番号（間引き判定用）
+};
+
+/// 型付きの GameObject 非所有参照
+/// - 中身は GameObjectHandle なので、参照先が破棄されると Get() が nullptr を返す
+/// - T は GameObject 派生。ハンドルは T* から作ったものに限る（static_cast で戻すため）
+template <class T>
+class ObjectHandle
+{
+public:
+    ObjectHandle() = default;
+    explicit ObjectHandle(T* object) : m_Handle(object ? object->GetHandle() : GameObjectHandle{}) {}
+
+    /// 参照先を取得する
+    /// 戻り値：破棄済み / プールへ返却済みなら nullptr
+    T* Get() const
+    {
+        static_assert(std::is_base_of<GameObject, T>::value, "T must inherit from GameObject");
+        return static_cast<T*>(GameObject::Resolve(m_Handle));
+    }
+
+    /// 参照先が生存しているか
+    bool IsAlive() const { return Get() != nullptr; }
+
+    GameObjectHandle GetHandle() const { return m_Handle; }
+
+    bool operator==(const ObjectHandle& other) const { return m_Handle == other.m_Handle; }
+    bool operator!=(const ObjectHandle& other) const { return m_Handle != other.m_Handle; }
+
+private:
+    GameObjectHandle m_Handle;  // 参照先のハンドル
 };
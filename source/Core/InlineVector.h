@@ -0,0 +1,128 @@
+﻿//------------------------------------------------------------------------------
+// InlineVector
+//------------------------------------------------------------------------------
+// 役割:
+// 先頭 N 要素をオブジェクト内に直接持つ可変長配列。
+// 要素数が N 以下の間はヒープ確保を行わない。
+//
+// 設計意図:
+// GameObject の Component / 子オブジェクトの大半は 2〜4 個程度であり、
+// std::vector だと 1 オブジェクトごとに別ヒープ確保が発生し、走査時もキャッシュミスを招く。
+// assimp/SmallVector.h と同じ「インライン領域 + 溢れたらヒープ」の考え方だが、
+// 伸長を倍々にし（大量の子を持つ Spawner 対策）、要素の削除（resize による切り詰め）を扱えるようにしている。
+//
+// 構成:
+// - インライン領域 : m_Inline[N]
+// - ヒープ領域     : 容量超過時に倍々で確保し、以降はそちらを使う
+// - STL 風 API     : push_back / begin / end / size / resize / clear / operator[]
+//
+// NOTE:
+// - 要素はトリビアルコピー可能な型（ポインタ等）に限定する（memcpy で移動するため）
+// - 所有権の管理は行わない（ポインタを格納する場合、破棄は利用側の責務）
+//------------------------------------------------------------------------------
+#pragma once
+#include <cstddef>
+#include <cstring>
+#include <cassert>
+#include <type_traits>
+
+/// 先頭 N 要素をインラインで保持する可変長配列（トリビアルコピー可能な型専用）
+template <typename T, std::size_t N>
+class InlineVector
+{
+    static_assert(std::is_trivially_copyable<T>::value, "InlineVector は trivially copyable な型専用");
+    static_assert(N > 0, "インライン容量は 1 以上にすること");
+
+public:
+    InlineVector() = default;
+
+    ~InlineVector()
+    {
+        if (m_Data != m_Inline)
+        {
+            delete[] m_Data;
+        }
+    }
+
+    // コピー / ムーブは不要なため禁止（所有者の GameObject もコピー不可）
+    InlineVector(const InlineVector&) = delete;
+    InlineVector& operator=(const InlineVector&) = delete;
+
+    // ----------------------------------------------------------------------
+    // 要素操作
+    // ----------------------------------------------------------------------
+    /// 末尾へ追加する（容量不足時は倍の容量へ伸長）
+    void push_back(const T& value)
+    {
+        if (m_Size == m_Capacity)
+        {
+            Grow(m_Capacity * 2);
+        }
+        m_Data[m_Size++] = value;
+    }
+
+    /// 要素数を変更する（拡張時の新要素は値初期化）
+    void resize(std::size_t newSize)
+    {
+        if (newSize > m_Capacity)
+        {
+            Grow(newSize);
+        }
+        for (std::size_t i = m_Size; i < newSize; ++i)
+        {
+            m_Data[i] = T{};
+        }
+        m_Size = newSize;
+    }
+
+    /// 容量を確保する
+    void reserve(std::size_t capacity)
+    {
+        if (capacity > m_Capacity)
+        {
+            Grow(capacity);
+        }
+    }
+
+    /// 要素数を 0 にする（確保済み容量は維持）
+    void clear() { m_Size = 0; }
+
+    // ----------------------------------------------------------------------
+    // 参照
+    // ----------------------------------------------------------------------
+    std::size_t size() const { return m_Size; }
+    std::size_t capacity() const { return m_Capacity; }
+    bool empty() const { return m_Size == 0; }
+
+    /// インライン領域に収まっているか（ヒープ確保が発生していないか）
+    bool IsInline() const { return m_Data == m_Inline; }
+
+    T& operator[](std::size_t index) { assert(index < m_Size); return m_Data[index]; }
+    const T& operator[](std::size_t index) const { assert(index < m_Size); return m_Data[index]; }
+
+    T* begin() { return m_Data; }
+    T* end() { return m_Data + m_Size; }
+    const T* begin() const { return m_Data; }
+    const T* end() const { return m_Data + m_Size; }
+
+private:
+    /// 容量を newCapacity へ広げ、既存要素をヒープ領域へ移す
+    void Grow(std::size_t newCapacity)
+    {
+        T* newData = new T[newCapacity];
+        std::memcpy(newData, m_Data, m_Size * sizeof(T));
+
+        if (m_Data != m_Inline)
+        {
+            delete[] m_Data;
+        }
+        m_Data = newData;
+        m_Capacity = newCapacity;
+    }
+
+private:
+    T           m_Inline[N] = {};       // インライン領域
+    T*          m_Data      = m_Inline; // 現在の格納先（インライン or ヒープ）
+    std::size_t m_Size      = 0;        // 要素数
+    std::size_t m_Capacity  = N;        // 容量
+};
@@ -0,0 +1,243 @@
+﻿#include "JobSystem.h"
+
+// システム関連
+#include <algorithm>
+#include <cassert>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// ------------------------------------------------------------------------------
+// キュー
+// ------------------------------------------------------------------------------
+// - 固定長のリングバッファ。所有スレッドは末尾から、他スレッドは先頭から取り出す
+// - 1 件の出し入れは短いので、ロックフリーにはせず mutex で保護する
+struct JobSystem::WorkQueue
+{
+    std::mutex  mutex;
+    Job         jobs[kQueueCapacity];
+    std::size_t head  = 0;     // 先頭（盗まれる側）
+    std::size_t count = 0;     // 積まれている数
+
+    bool PushBack(const Job& job)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (count == kQueueCapacity) return false;
+        jobs[(head + count) % kQueueCapacity] = job;
+        ++count;
+        return true;
+    }
+
+    bool PopBack(Job& outJob)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (count == 0) return false;
+        --count;
+        outJob = jobs[(head + count) % kQueueCapacity];
+        return true;
+    }
+
+    bool StealFront(Job& outJob)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (count == 0) return false;
+        outJob = jobs[head];
+        head = (head + 1) % kQueueCapacity;
+        --count;
+        return true;
+    }
+};
+
+namespace
+{
+    thread_local unsigned    t_QueueIndex = 0;  // 呼び出しスレッドのキュー番号（メインスレッドは 0）
+    std::vector<std::thread> s_Threads;         // ワーカースレッド
+    std::mutex               s_WakeMutex;       // 待機中ワーカーの起床用
+    std::condition_variable  s_WakeCondition;   // 待機中ワーカーの起床用
+}
+
+// 静的メンバ変数の定義
+JobSystem::WorkQueue*      JobSystem::s_Queues     = nullptr;
+unsigned                   JobSystem::s_QueueCount = 0;
+std::atomic<bool>          JobSystem::s_Running{ false };
+std::atomic<std::uint32_t> JobSystem::s_QueuedJobs{ 0 };
+
+// ------------------------------------------------------------------------------
+// 初期化・終了
+// ------------------------------------------------------------------------------
+void JobSystem::Init(unsigned workerCount)
+{
+    assert(s_QueueCount == 0 && "JobSystem::Init が二重に呼ばれた");
+
+    if (workerCount == 0)
+    {
+        const unsigned hardware = std::thread::hardware_concurrency();
+        workerCount = hardware > 1 ? hardware - 1 : 0;
+    }
+    workerCount = std::min(workerCount, kMaxWorkers);
+
+    s_QueueCount = workerCount + 1;
+    s_Queues = new WorkQueue[s_QueueCount];
+    t_QueueIndex = 0;
+
+    s_Running.store(true, std::memory_order_release);
+    s_Threads.reserve(workerCount);
+    for (unsigned i = 1; i <= workerCount; ++i)
+    {
+        s_Threads.emplace_back(&JobSystem::WorkerMain, i);
+    }
+}
+
+void JobSystem::Shutdown()
+{
+    if (s_QueueCount == 0)
+    {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(s_WakeMutex);
+        s_Running.store(false, std::memory_order_release);
+    }
+    s_WakeCondition.notify_all();
+
+    for (std::thread& thread : s_Threads)
+    {
+        thread.join();
+    }
+    s_Threads.clear();
+
+    delete[] s_Queues;
+    s_Queues = nullptr;
+    s_QueueCount = 0;
+}
+
+// ------------------------------------------------------------------------------
+// 投入
+// ------------------------------------------------------------------------------
+// - grain 件ずつに区切ってジョブ化する
+// - 最後の 1 区間は投入せずに呼び出しスレッドで実行する（投入/取り出しを 1 回省く）
+// - 積み終えてからワーカーをまとめて起こす
+void JobSystem::ParallelFor(std::size_t count, std::size_t grain, JobFunction function, void* data, JobCounter& counter)
+{
+    if (count == 0)
+    {
+        return;
+    }
+
+    grain = std::max<std::size_t>(grain, 1);
+    if (s_QueueCount <= 1 || count <= grain)
+    {
+        function(data, 0, count);
+        return;
+    }
+
+    const std::size_t jobCount = (count + grain - 1) / grain;
+    counter.pending.fetch_add(static_cast<std::uint32_t>(jobCount - 1), std::memory_order_relaxed);
+
+    for (std::size_t begin = grain; begin < count; begin += grain)
+    {
+        Job job;
+        job.function = function;
+        job.data     = data;
+        job.begin    = begin;
+        job.end      = std::min(begin + grain, count);
+        job.counter  = &counter;
+        Push(job);
+    }
+
+    // 判定（s_QueuedJobs）と待機の間にいるワーカーを取りこぼさないよう、mutex を通してから起こす
+    {
+        std::lock_guard<std::mutex> lock(s_WakeMutex);
+    }
+    s_WakeCondition.notify_all();
+
+    function(data, 0, std::min(grain, count));
+}
+
+void JobSystem::Push(const Job& job)
+{
+    s_QueuedJobs.fetch_add(1, std::memory_order_release);
+    if (!s_Queues[t_QueueIndex].PushBack(job))
+    {
+        s_QueuedJobs.fetch_sub(1, std::memory_order_relaxed);
+        Execute(job);
+    }
+}
+
+// ------------------------------------------------------------------------------
+// 待機
+// ------------------------------------------------------------------------------
+// - 待つ間も自分 / 他スレッドのキューからジョブを実行する
+// - 実行できるジョブが無ければ（他スレッドで実行中）譲って再確認する
+void JobSystem::Wait(JobCounter& counter)
+{
+    while (counter.pending.load(std::memory_order_acquire) != 0)
+    {
+        if (!TryRunOne())
+        {
+            std::this_thread::yield();
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------
+// 取り出し・実行
+// ------------------------------------------------------------------------------
+// - 自分のキューは末尾から、他スレッドのキューは自分の次の番号から順に先頭を盗む
+bool JobSystem::TryRunOne()
+{
+    if (s_QueueCount == 0)
+    {
+        return false;
+    }
+
+    const unsigned self = t_QueueIndex;
+    Job job;
+    bool found = s_Queues[self].PopBack(job);
+    for (unsigned i = 1; !found && i < s_QueueCount; ++i)
+    {
+        found = s_Queues[(self + i) % s_QueueCount].StealFront(job);
+    }
+    if (!found)
+    {
+        return false;
+    }
+
+    s_QueuedJobs.fetch_sub(1, std::memory_order_relaxed);
+    Execute(job);
+    return true;
+}
+
+void JobSystem::Execute(const Job& job)
+{
+    job.function(job.data, job.begin, job.end);
+    if (job.counter)
+    {
+        job.counter->pending.fetch_sub(1, std::memory_order_release);
+    }
+}
+
+// ------------------------------------------------------------------------------
+// ワーカースレッド
+// ------------------------------------------------------------------------------
+// - ジョブがあれば実行し、無ければ投入されるまで眠る
+void JobSystem::WorkerMain(unsigned queueIndex)
+{
+    t_QueueIndex = queueIndex;
+
+    while (s_Running.load(std::memory_order_acquire))
+    {
+        if (TryRunOne())
+        {
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(s_WakeMutex);
+        s_WakeCondition.wait(lock, [] {
+            return !s_Running.load(std::memory_order_acquire) ||
+                   s_QueuedJobs.load(std::memory_order_acquire) != 0;
+        });
+    }
+}
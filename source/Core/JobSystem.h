@@ -0,0 +1,109 @@
+﻿//------------------------------------------------------------------------------
+// JobSystem
+//------------------------------------------------------------------------------
+// 役割:
+// 小さな処理（ジョブ）をワーカースレッドへ分配して並列に実行する。
+// 主な用途は、互いに独立した GameObject の Update を並列に回すこと。
+//
+// 設計意図:
+// GameObject の Update はシーン全体を 1 スレッドで順に回しており、敵が増えるほど
+// フレーム時間が伸びる。ワーカーごとにジョブキューを持たせ、自分のキューが空になったら
+// 他のキューから盗む（work stealing）ことで、ジョブの偏りがあっても全員が働けるようにする。
+// 待つ側のスレッド（メインスレッド含む）も、待っている間は自らジョブを実行する。
+//
+// 構成:
+// - Job          : 関数ポインタ + データ + 範囲 [begin, end) + 完了カウンタ
+// - JobCounter   : 未完了ジョブ数。Wait でこれが 0 になるまで待つ（バリア）
+// - ParallelFor  : [0, count) を grain 件ずつのジョブに分けて投入する
+// - Wait         : カウンタが 0 になるまで、キューのジョブを実行しながら待つ
+// - キュー       : スレッドごとの固定長リングバッファ（mutex 保護）
+//   - 所有スレッドは末尾から取り出す（直前に積んだ = キャッシュに残っている可能性が高い）
+//   - 他スレッドは先頭から盗む
+//
+// NOTE:
+// - Init 前 / ワーカー 0 人の場合、ParallelFor はその場で直列に実行する
+// - ジョブの投入・待機は、メインスレッドまたはジョブ実行中のスレッドから行うこと
+//   （ジョブ内からの入れ子の ParallelFor は可。その場合も呼び出し元が Wait すること）
+// - キューが満杯の場合、ジョブは投入元でその場で実行する（確保はしない）
+// - ジョブ内で例外を投げないこと
+//------------------------------------------------------------------------------
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+
+/// ジョブ関数（data は投入時に渡したもの、[begin, end) は担当範囲）
+using JobFunction = void (*)(void* data, std::size_t begin, std::size_t end);
+
+/// 完了待ち用のカウンタ
+/// - 投入時に加算され、ジョブ完了時に減算される
+struct JobCounter
+{
+    std::atomic<std::uint32_t> pending{ 0 };
+};
+
+/// ジョブ 1 件
+struct Job
+{
+    JobFunction  function = nullptr;
+    void*        data     = nullptr;
+    std::size_t  begin    = 0;
+    std::size_t  end      = 0;
+    JobCounter*  counter  = nullptr;    // 非所有：完了時に減算する
+};
+
+/// work stealing 方式のジョブシステム
+class JobSystem
+{
+public:
+    // ----------------------------------------------------------------------
+    // 初期化・終了
+    // ----------------------------------------------------------------------
+    /// ワーカースレッドを起動する
+    /// - workerCount が 0 の場合は「論理コア数 - 1」（上限 kMaxWorkers）
+    /// NOTE: 呼び出したスレッド（メインスレッド）はキュー 0 を使う
+    static void Init(unsigned workerCount = 0);
+
+    /// 全ワーカーを停止して join する
+    /// NOTE: 未完了のジョブが無い状態で呼ぶこと
+    static void Shutdown();
+
+    /// ワーカースレッド数（メインスレッドは含まない）
+    static unsigned GetWorkerCount() { return s_QueueCount > 0 ? s_QueueCount - 1 : 0; }
+
+    // ----------------------------------------------------------------------
+    // 投入・待機
+    // ----------------------------------------------------------------------
+    /// [0, count) を grain 件ずつのジョブに分けて投入する
+    /// - count が grain 以下 / ワーカーが居ない場合は、その場で直列に実行して戻る
+    /// - 戻った時点で全件が終わっているとは限らない。counter を Wait すること
+    static void ParallelFor(std::size_t count, std::size_t grain, JobFunction function, void* data, JobCounter& counter);
+
+    /// counter が 0 になるまで待つ（待つ間は自分でもジョブを実行する）
+    static void Wait(JobCounter& counter);
+
+private:
+    static constexpr unsigned    kMaxWorkers    = 8;       // ワーカー数の上限
+    static constexpr std::size_t kQueueCapacity = 256;     // 1 キューあたりのジョブ数上限
+
+    struct WorkQueue;
+
+    /// ジョブを呼び出しスレッドのキューへ積む（満杯ならその場で実行する）
+    static void Push(const Job& job);
+
+    /// キューからジョブを 1 件取り出して実行する（自分 → 他スレッドの順）
+    /// 戻り値：実行した場合 true
+    static bool TryRunOne();
+
+    /// ジョブを実行して完了を通知する
+    static void Execute(const Job& job);
+
+    /// ワーカースレッドの本体
+    static void WorkerMain(unsigned queueIndex);
+
+private:
+    static WorkQueue*             s_Queues;        // 所有：スレッドごとのキュー（[0] はメインスレッド）
+    static unsigned               s_QueueCount;    // キュー数（ワーカー数 + 1。未初期化なら 0）
+    static std::atomic<bool>      s_Running;       // ワーカー稼働中
+    static std::atomic<std::uint32_t> s_QueuedJobs; // キューに積まれている総ジョブ数（待機解除の判定用）
+};
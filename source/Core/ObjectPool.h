@@ -0,0 +1,188 @@
+﻿//------------------------------------------------------------------------------
+// ObjectPool
+//------------------------------------------------------------------------------
+// 役割:
+// 同じ型の GameObject をあらかじめ生成しておき、出現・消滅のたびに
+// 生成/破棄せず「有効化/無効化」で使い回すためのプール。
+//
+// 設計意図:
+// 敵や衝撃波は短い間隔で出現し、その都度 MeshRenderer の頂点バッファや
+// シェーダー、ColliderGroup を作り直していた。
+// 生成はシーン読み込み時（Init）に寄せ、出現時は状態のリセットだけで済ませる。
+// プール対象は所有者 GameObject の子として生成するため、所有・破棄・階層は従来通り。
+//
+// 構成:
+// - GameObjectPoolBase : GameObject から返却を受け付けるための共通インターフェース
+// - ObjectPool<T>      : 型付きプール（Prewarm / Acquire / Release）
+// - スナップショット   : 待機リストの順序を保存/復元（インスタンスの状態は所有者側の子として保存される）
+//
+// NOTE:
+// - インスタンスの実体は所有者（owner）の子として保持される（プールは非所有）
+// - Destroy() されたプール対象は、所有者の Update 後の回収時に破棄ではなく返却される
+// - プールが空の場合は追加生成する（生成コストが発生するため、初期数は余裕を持たせる）
+// - 返却は無効化のみで、状態のリセットは取得側（各クラスの Spawn 等）で行う
+// - 返却時にハンドルを発行し直す。返却前に取られたハンドルは、再利用後の別個体を指さない
+//------------------------------------------------------------------------------
+#pragma once
+#include <vector>
+#include <cstddef>
+#include <type_traits>
+#include <cstdint>
+#include "GameObject.h"
+#include "Snapshot.h"
+
+/// プールの共通インターフェース（GameObject からの返却用）
+class GameObjectPoolBase
+{
+public:
+    virtual ~GameObjectPoolBase() = default;
+
+    /// プールへ返却する（無効化して空きリストへ戻す）
+    virtual void Release(GameObject* object) = 0;
+};
+
+/// 型付き GameObject プール
+/// - T は GameObject 派生で、引数なしで生成できること
+template <class T>
+class ObjectPool : public GameObjectPoolBase
+{
+    static_assert(std::is_base_of<GameObject, T>::value, "T must inherit from GameObject");
+
+public:
+    // ----------------------------------------------------------------------
+    // 生成
+    // ----------------------------------------------------------------------
+    /// owner の子として count 個を生成し、Init 済み・無効状態で待機させる
+    /// NOTE: シーン読み込み時（owner の Init 内）に呼ぶ想定
+    void Prewarm(GameObject& owner, std::size_t count)
+    {
+        m_Owner = &owner;
+        m_Instances.reserve(m_Instances.size() + count);
+        m_Free.reserve(m_Free.size() + count);
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            T* object = CreateInstance();
+            object->SetActive(false);
+            m_Free.push_back(object);
+        }
+    }
+
+    // ----------------------------------------------------------------------
+    // 取得・返却
+    // ----------------------------------------------------------------------
+    /// 待機中のインスタンスを有効化して返す
+    /// - 空きがない場合は追加生成する（owner が未設定なら nullptr）
+    /// - 状態のリセットは呼び出し側で行うこと
+    T* Acquire()
+    {
+        T* object = nullptr;
+        if (!m_Free.empty())
+        {
+            object = m_Free.back();
+            m_Free.pop_back();
+        }
+        else
+        {
+            if (!m_Owner) return nullptr;
+            object = CreateInstance();
+        }
+
+        object->SetActive(true);
+        return object;
+    }
+
+    /// プールへ返却する（GameObject の回収処理から呼ばれる）
+    void Release(GameObject* object) override
+    {
+        if (!object) return;
+
+        object->SetActive(false);
+        object->RenewHandle();
+        m_Free.push_back(static_cast<T*>(object));
+    }
+
+    // ----------------------------------------------------------------------
+    // 参照
+    // ----------------------------------------------------------------------
+    /// 生成済みインスタンス数
+    std::size_t GetCapacity() const { return m_Instances.size(); }
+
+    /// 使用中インスタンス数
+    std::size_t GetActiveCount() const { return m_Instances.size() - m_Free.size(); }
+
+    /// 生成済みインスタンス一覧（非所有）
+    const std::vector<T*>& GetInstances() const { return m_Instances; }
+
+    // ----------------------------------------------------------------------
+    // スナップショット
+    // ----------------------------------------------------------------------
+    /// 生成数と待機リスト（インスタンス番号の並び）を書き出す
+    /// NOTE: 待機リストの順序で次に Acquire される個体が決まるため、順序ごと保存する
+    void WriteState(SnapshotWriter& writer) const
+    {
+        writer.Write(static_cast<std::uint32_t>(m_Instances.size()));
+        writer.Write(static_cast<std::uint32_t>(m_Free.size()));
+        for (const T* object : m_Free)
+        {
+            writer.Write(IndexOf(object));
+        }
+    }
+
+    /// 待機リストを読み戻す
+    /// - 保存時より多く生成されている場合、超過分（保存時に存在しなかった個体）は待機リストの先頭側に置く
+    /// NOTE: インスタンスの状態（有効フラグ含む）は所有者の子として先に復元されていること
+    void ReadState(SnapshotReader& reader)
+    {
+        std::uint32_t instanceCount = 0;
+        std::uint32_t freeCount = 0;
+        if (!reader.Read(instanceCount) || !reader.Read(freeCount) ||
+            instanceCount > m_Instances.size() || freeCount > instanceCount)
+        {
+            reader.Fail();
+            return;
+        }
+
+        m_Free.clear();
+        for (std::size_t i = instanceCount; i < m_Instances.size(); ++i)
+        {
+            m_Free.push_back(m_Instances[i]);
+        }
+        for (std::uint32_t i = 0; i < freeCount; ++i)
+        {
+            std::uint32_t index = 0;
+            if (!reader.Read(index) || index >= instanceCount)
+            {
+                reader.Fail();
+                return;
+            }
+            m_Free.push_back(m_Instances[index]);
+        }
+    }
+
+private:
+    /// インスタンス番号を引く（線形探索。スナップショット保存時のみ使用）
+    std::uint32_t IndexOf(const T* object) const
+    {
+        for (std::size_t i = 0; i < m_Instances.size(); ++i)
+        {
+            if (m_Instances[i] == object) return static_cast<std::uint32_t>(i);
+        }
+        return 0;
+    }
+
+    /// owner の子として 1 つ生成し、Init してプール管理下に置く
+    T* CreateInstance()
+    {
+        T* object = m_Owner->template CreateChild<T>();
+        object->Init();
+        object->SetPool(this);
+        m_Instances.push_back(object);
+        return object;
+    }
+
+private:
+    GameObject*     m_Owner = nullptr;  // 非所有：インスタンスの親
+    std::vector<T*> m_Instances;        // 非所有：生成済みインスタンス
+    std::vector<T*> m_Free;             // 非所有：待機中インスタンス
+};
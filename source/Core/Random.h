@@ -0,0 +1,177 @@
+﻿//------------------------------------------------------------------------------
+// Random
+//------------------------------------------------------------------------------
+// 役割:
+// シード指定・分岐可能な疑似乱数生成器（xoshiro128**）。
+// スポナーなど、乱数を使うオブジェクトがそれぞれ 1 つずつ持つ。
+//
+// 設計意図:
+// std::rand はグローバルな状態を共有するため、呼び出し順が変わると結果が変わり、
+// 同じシードから同じ盤面を再現できない。別スレッドから呼ぶと状態の取り合いにもなる。
+// 状態を値として持たせ、盤面のシードから「ストリーム」を分岐させて配ることで、
+// 盤面ごと・オブジェクトごとに独立して再現でき、並列に回しても競合しない。
+//
+// 構成:
+// - Random(seed)      : SplitMix64 でシードを 128bit の状態へ広げる
+// - Random(seed, id)  : シードとストリーム番号から独立した生成器を作る
+// - Split             : 自身を 2^64 個先へ進め、進める前の状態を別ストリームとして返す
+// - NextUInt / NextFloat / NextRange / NextIndex : 1 個ずつ生成
+// - FillRange         : まとめて生成（配列へ直接書き込む）
+//
+// NOTE:
+// - 暗号用途には使わないこと
+// - 状態は trivially copyable。スナップショットへそのまま書き込める
+// - 1 つの生成器を複数スレッドから同時に使わないこと（スレッドごとに Split して渡す）
+//------------------------------------------------------------------------------
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <cassert>
+
+/// 疑似乱数生成器（xoshiro128**）
+class Random
+{
+public:
+    /// 既定のシード（盤面側で指定しない場合）
+    static constexpr std::uint64_t kDefaultSeed = 0x5EED5EED5EED5EEDull;
+
+    Random() : Random(kDefaultSeed) {}
+
+    /// シードから生成する
+    explicit Random(std::uint64_t seed)
+    {
+        Seed(seed);
+    }
+
+    /// シードとストリーム番号から生成する
+    /// - 同じシードでもストリーム番号が違えば独立した系列になる
+    Random(std::uint64_t seed, std::uint64_t stream)
+    {
+        std::uint64_t mixed = stream;
+        Seed(seed ^ SplitMix64(mixed));
+    }
+
+    // ----------------------------------------------------------------------
+    // 分岐
+    // ----------------------------------------------------------------------
+    /// 新しいストリームを分岐させる
+    /// - 戻り値は現在の状態から始まる生成器。自身は 2^64 個先へ進む（系列は重ならない）
+    Random Split()
+    {
+        Random child = *this;
+        Jump();
+        return child;
+    }
+
+    // ----------------------------------------------------------------------
+    // 生成
+    // ----------------------------------------------------------------------
+    /// 32bit の一様乱数
+    std::uint32_t NextUInt()
+    {
+        const std::uint32_t result = RotateLeft(m_State[1] * 5u, 7) * 9u;
+        const std::uint32_t t = m_State[1] << 9;
+
+        m_State[2] ^= m_State[0];
+        m_State[3] ^= m_State[1];
+        m_State[1] ^= m_State[2];
+        m_State[0] ^= m_State[3];
+        m_State[2] ^= t;
+        m_State[3] = RotateLeft(m_State[3], 11);
+
+        return result;
+    }
+
+    /// [0, 1) の一様乱数（上位 24bit を使う）
+    float NextFloat()
+    {
+        return static_cast<float>(NextUInt() >> 8) * (1.0f / 16777216.0f);
+    }
+
+    /// [min, max) の一様乱数
+    float NextRange(float min, float max)
+    {
+        return min + (max - min) * NextFloat();
+    }
+
+    /// [0, count) の整数（剰余ではなく乗算で範囲を写す）
+    std::uint32_t NextIndex(std::uint32_t count)
+    {
+        assert(count > 0);
+        return static_cast<std::uint32_t>((static_cast<std::uint64_t>(NextUInt()) * count) >> 32);
+    }
+
+    /// [min, max) の一様乱数を out へ count 個書き込む
+    /// - 状態をローカルに持って回すので、1 個ずつ呼ぶより速い
+    void FillRange(float* out, std::size_t count, float min, float max)
+    {
+        const float scale = (max - min) * (1.0f / 16777216.0f);
+        Random local = *this;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            out[i] = min + static_cast<float>(local.NextUInt() >> 8) * scale;
+        }
+        *this = local;
+    }
+
+private:
+    static std::uint32_t RotateLeft(std::uint32_t x, int k)
+    {
+        return (x << k) | (x >> (32 - k));
+    }
+
+    /// シード展開用（1 回ごとに state を進める）
+    static std::uint64_t SplitMix64(std::uint64_t& state)
+    {
+        std::uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    void Seed(std::uint64_t seed)
+    {
+        std::uint64_t state = seed;
+        const std::uint64_t a = SplitMix64(state);
+        const std::uint64_t b = SplitMix64(state);
+        m_State[0] = static_cast<std::uint32_t>(a);
+        m_State[1] = static_cast<std::uint32_t>(a >> 32);
+        m_State[2] = static_cast<std::uint32_t>(b);
+        m_State[3] = static_cast<std::uint32_t>(b >> 32);
+
+        // 全 0 の状態は抜け出せないので避ける
+        if ((m_State[0] | m_State[1] | m_State[2] | m_State[3]) == 0)
+        {
+            m_State[0] = 1;
+        }
+    }
+
+    /// 2^64 回 NextUInt を呼んだのと同じだけ進める
+    void Jump()
+    {
+        static constexpr std::uint32_t kJump[] = { 0x8764000Bu, 0xF542D2D3u, 0x6FA035C3u, 0x77F2DB5Bu };
+
+        std::uint32_t s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+        for (std::uint32_t jump : kJump)
+        {
+            for (int b = 0; b < 32; ++b)
+            {
+                if (jump & (1u << b))
+                {
+                    s0 ^= m_State[0];
+                    s1 ^= m_State[1];
+                    s2 ^= m_State[2];
+                    s3 ^= m_State[3];
+                }
+                NextUInt();
+            }
+        }
+        m_State[0] = s0;
+        m_State[1] = s1;
+        m_State[2] = s2;
+        m_State[3] = s3;
+    }
+
+private:
+    std::uint32_t m_State[4];   // xoshiro128** の状態
+};
@@ -0,0 +1,111 @@
+﻿#include "SceneLoader.h"
+
+// システム関連
+#include <windows.h>
+#include <objbase.h>
+#include <cassert>
+
+#include "GameObject.h"
+
+// 静的メンバ変数の定義
+std::thread              SceneLoader::s_Thread;
+std::atomic<bool>        SceneLoader::s_Ready{ false };
+bool                     SceneLoader::s_Busy = false;
+Scene                    SceneLoader::s_Scene = Scene::Title;
+std::vector<GameObject*> SceneLoader::s_Objects;
+
+// ------------------------------------------------------------------------------
+// 読み込み開始
+// ------------------------------------------------------------------------------
+// - 読み込み中 / 未取得の結果がある場合は何もしない
+bool SceneLoader::Begin(Scene scene)
+{
+    if (s_Busy)
+    {
+        return false;
+    }
+
+    s_Busy  = true;
+    s_Scene = scene;
+    s_Ready.store(false, std::memory_order_relaxed);
+    s_Thread = std::thread(&SceneLoader::ThreadMain, scene);
+    return true;
+}
+
+// ------------------------------------------------------------------------------
+// 結果の取り出し
+// ------------------------------------------------------------------------------
+bool SceneLoader::TryTake(Scene& outScene, std::vector<GameObject*>& outObjects)
+{
+    if (!s_Busy || !s_Ready.load(std::memory_order_acquire))
+    {
+        return false;
+    }
+
+    Take(outScene, outObjects);
+    return true;
+}
+
+bool SceneLoader::WaitAndTake(Scene& outScene, std::vector<GameObject*>& outObjects)
+{
+    if (!s_Busy)
+    {
+        return false;
+    }
+
+    Take(outScene, outObjects);
+    return true;
+}
+
+// - join で完了を待つ（TryTake からは完了済みで呼ばれるので待たない）
+void SceneLoader::Take(Scene& outScene, std::vector<GameObject*>& outObjects)
+{
+    assert(s_Thread.joinable());
+    s_Thread.join();
+
+    outScene = s_Scene;
+    outObjects.swap(s_Objects);
+    s_Objects.clear();
+    s_Busy = false;
+}
+
+// ------------------------------------------------------------------------------
+// 終了処理
+// ------------------------------------------------------------------------------
+// - 取り出されなかった GameObject は Init 前なので、Uninit は呼ばずに破棄する
+void SceneLoader::Shutdown()
+{
+    if (!s_Busy)
+    {
+        return;
+    }
+
+    Scene scene;
+    std::vector<GameObject*> objects;
+    Take(scene, objects);
+
+    for (GameObject* gameObject : objects)
+    {
+        delete gameObject;
+    }
+}
+
+// ------------------------------------------------------------------------------
+// バックグラウンドスレッド
+// ------------------------------------------------------------------------------
+// - WIC デコード用にこのスレッドで COM を初期化する
+// - アセットの CPU 側デコード → GameObject 生成（コンストラクタのみ）の順に行う
+void SceneLoader::ThreadMain(Scene scene)
+{
+    const HRESULT hr = CoInitializeEx(nullptr, COINIT_MULTITHREADED);
+
+    DecodeSceneAssets(scene);
+    s_Objects = CreateSceneObjects(scene);
+
+    if (SUCCEEDED(hr))
+    {
+        CoUninitialize();
+    }
+
+    s_Ready.store(true, std::memory_order_release);
+}
@@ -0,0 +1,70 @@
+﻿//------------------------------------------------------------------------------
+// SceneLoader
+//------------------------------------------------------------------------------
+// 役割:
+// 次のシーンの準備（アセットの CPU 側デコードと GameObject の生成）を
+// バックグラウンドスレッドで行い、完了したら GameManager へ引き渡す。
+//
+// 設計意図:
+// シーン切り替えのたびに OBJ 解析や WIC デコードをメインスレッドで行うと、
+// その間ゲームが止まる。重い CPU 処理を別スレッドへ逃がし、
+// メインスレッドでは「GPU 転送（各 Init）と差し替え」だけを行う。
+// 準備中も現在のシーンはそのまま更新・描画を続ける。
+//
+// 構成:
+// - Begin        : 読み込み開始（スレッド起動）
+// - TryTake      : 完了していれば結果（シーン種別と GameObject 群）を取り出す
+// - WaitAndTake  : 完了まで待って取り出す（起動時など、表示中のシーンが無い場合）
+// - Shutdown     : 終了時に読み込み中のスレッドを待ち、未取得の結果を破棄する
+//
+// NOTE:
+// - 同時に読み込めるのは 1 シーンのみ。読み込み中の Begin は無視される（false を返す）
+// - GameObject の Init はメインスレッドで行う（PhysicsWorld / シングルトン / static 変数へ
+//   登録するため、実行中の旧シーンと並行して呼べない）
+// - すべての関数はメインスレッドから呼ぶこと
+//------------------------------------------------------------------------------
+#pragma once
+#include <vector>
+#include <thread>
+#include <atomic>
+#include "Scene.h"
+
+class GameObject;
+
+/// シーンのバックグラウンド読み込み
+class SceneLoader
+{
+public:
+    /// scene の読み込みを開始する
+    /// 戻り値：開始した場合 true（読み込み中 / 結果が未取得の場合は false）
+    static bool Begin(Scene scene);
+
+    /// 読み込み中、または結果が未取得か
+    static bool IsBusy() { return s_Busy; }
+
+    /// 完了していれば結果を取り出す
+    /// - 所有権：outObjects の GameObject は呼び出し側へ移る（Init は呼び出し側で行う）
+    /// 戻り値：取り出した場合 true（未完了 / 未開始なら false）
+    static bool TryTake(Scene& outScene, std::vector<GameObject*>& outObjects);
+
+    /// 完了まで待ってから結果を取り出す
+    /// 戻り値：取り出した場合 true（未開始なら false）
+    static bool WaitAndTake(Scene& outScene, std::vector<GameObject*>& outObjects);
+
+    /// 読み込み中なら完了を待ち、未取得の結果を破棄する
+    static void Shutdown();
+
+private:
+    /// バックグラウンドスレッドの本体
+    static void ThreadMain(Scene scene);
+
+    /// スレッドを回収して結果を取り出す（完了済みであること）
+    static void Take(Scene& outScene, std::vector<GameObject*>& outObjects);
+
+private:
+    static std::thread              s_Thread;   // 読み込みスレッド
+    static std::atomic<bool>        s_Ready;    // 完了フラグ（スレッド → メインスレッド）
+    static bool                     s_Busy;     // 開始済みで結果が未取得
+    static Scene                    s_Scene;    // 読み込み中のシーン
+    static std::vector<GameObject*> s_Objects;  // 所有：生成済み GameObject（取り出しまで）
+};
@@ -0,0 +1,206 @@
+﻿//------------------------------------------------------------------------------
+// SlotMap
+//------------------------------------------------------------------------------
+// 役割:
+// 32bit の世代付きハンドル（Handle<Tag>）と、ハンドルから値を引くスロット表（SlotMap）。
+// GameObject / Collider の「参照を保持するが所有はしない」場面で生ポインタの代わりに使う。
+//
+// 設計意図:
+// 生ポインタの保持は、参照先が破棄されてもそれを検出できない（破棄順の注意で回避するしかない）。
+// スロットごとに世代番号を持ち、解放時に世代を進めることで、
+// 古いハンドルは「インデックス参照 + 世代比較」の 1 回で無効と判定できるようにする。
+// ハンドルは 32bit 整数なので、2 つ並べて 64bit のペアキーにもできる。
+//
+// 構成:
+// - Handle<Tag>      : インデックス 20bit + 世代 12bit。値 0 は無効ハンドル
+// - SlotMap<T, Tag>  : ページ単位のスロット配列 + 空きリスト
+//   - Insert / Erase : mutex で保護（バックグラウンドスレッドからの生成に備える）
+//   - Find           : ロックなし（ページは確保後に移動しないため）
+//
+// NOTE:
+// - 世代は 12bit で一周する。同じスロットが 4095 回再利用されるまでの間に
+//   古いハンドルを使い続けると誤って一致し得る（フレーム単位の参照では問題にならない想定）
+// - Find と同じスロットへの Erase を別スレッドで同時に行わないこと（参照先の寿命管理と同じ制約）
+//------------------------------------------------------------------------------
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <cassert>
+#include <atomic>
+#include <memory>
+#include <mutex>
+
+/// 世代付きハンドル
+/// - Tag は対象の種類を区別するための型（別種のハンドル同士を取り違えないため）
+template <class Tag>
+class Handle
+{
+public:
+    static constexpr std::uint32_t kIndexBits       = 20;
+    static constexpr std::uint32_t kGenerationBits  = 32 - kIndexBits;
+    static constexpr std::uint32_t kIndexMask       = (1u << kIndexBits) - 1;
+    static constexpr std::uint32_t kGenerationMask  = (1u << kGenerationBits) - 1;
+    static constexpr std::uint32_t kMaxIndex        = kIndexMask;
+
+    constexpr Handle() = default;
+
+    /// インデックスと世代から作成する（世代 0 は無効扱いなので 1 以上を渡すこと）
+    static constexpr Handle Make(std::uint32_t index, std::uint32_t generation)
+    {
+        return FromValue((generation << kIndexBits) | (index & kIndexMask));
+    }
+
+    /// 整数値から復元する（ペアキーなどから戻すとき用）
+    static constexpr Handle FromValue(std::uint32_t value)
+    {
+        Handle handle;
+        handle.m_Value = value;
+        return handle;
+    }
+
+    constexpr std::uint32_t GetValue() const { return m_Value; }
+    constexpr std::uint32_t GetIndex() const { return m_Value & kIndexMask; }
+    constexpr std::uint32_t GetGeneration() const { return m_Value >> kIndexBits; }
+
+    /// 無効ハンドル（既定値）でないか
+    /// NOTE: 参照先が生存しているかは SlotMap::Find で確認すること
+    constexpr bool IsValid() const { return m_Value != 0; }
+
+    constexpr bool operator==(const Handle& other) const { return m_Value == other.m_Value; }
+    constexpr bool operator!=(const Handle& other) const { return m_Value != other.m_Value; }
+    constexpr bool operator<(const Handle& other) const { return m_Value < other.m_Value; }
+
+private:
+    std::uint32_t m_Value = 0;  // 上位：世代 / 下位：インデックス
+};
+
+/// 世代付きハンドルで値を引くスロット表
+/// - 値は小さなもの（ポインタなど）を想定している
+template <class T, class Tag>
+class SlotMap
+{
+public:
+    using HandleType = Handle<Tag>;
+
+    SlotMap() = default;
+    SlotMap(const SlotMap&) = delete;
+    SlotMap& operator=(const SlotMap&) = delete;
+
+    // ----------------------------------------------------------------------
+    // 登録・解除
+    // ----------------------------------------------------------------------
+    /// 値を登録し、ハンドルを返す
+    /// - 空きスロットがあれば再利用し、なければ末尾に追加する
+    HandleType Insert(const T& value)
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+
+        std::uint32_t index = m_FreeHead;
+        if (index != kNoFreeSlot)
+        {
+            m_FreeHead = GetSlot(index).nextFree;
+        }
+        else
+        {
+            index = m_SlotCount.load(std::memory_order_relaxed);
+            assert(index <= HandleType::kMaxIndex && "SlotMap のスロット数が上限を超えた");
+
+            const std::uint32_t page = index >> kPageBits;
+            if (!m_Pages[page])
+            {
+                m_Pages[page] = std::make_unique<Slot[]>(kPageSize);
+            }
+            // ページ作成後に公開する（Find 側は acquire で読む）
+            m_SlotCount.store(index + 1, std::memory_order_release);
+        }
+
+        Slot& slot = GetSlot(index);
+        slot.value    = value;
+        slot.nextFree = kNoFreeSlot;
+        ++m_Size;
+        return HandleType::Make(index, slot.generation);
+    }
+
+    /// ハンドルの登録を解除する
+    /// - スロットの世代を進めるので、以降そのハンドル（とコピー）は Find で nullptr になる
+    /// 戻り値：解除した場合 true（既に無効なハンドルなら false）
+    bool Erase(HandleType handle)
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+
+        if (!IsLive(handle))
+            return false;
+
+        const std::uint32_t index = handle.GetIndex();
+        Slot& slot = GetSlot(index);
+        slot.value      = T{};
+        slot.generation = NextGeneration(slot.generation);
+        slot.nextFree   = m_FreeHead;
+        m_FreeHead = index;
+        --m_Size;
+        return true;
+    }
+
+    // ----------------------------------------------------------------------
+    // 参照
+    // ----------------------------------------------------------------------
+    /// ハンドルから値を引く
+    /// 戻り値：解除済み / 無効なハンドルなら nullptr
+    T* Find(HandleType handle)
+    {
+        return IsLive(handle) ? &GetSlot(handle.GetIndex()).value : nullptr;
+    }
+
+    const T* Find(HandleType handle) const
+    {
+        return IsLive(handle) ? &GetSlot(handle.GetIndex()).value : nullptr;
+    }
+
+    /// ハンドルが生存中か
+    bool Contains(HandleType handle) const { return IsLive(handle); }
+
+    /// 登録中の個数
+    std::size_t GetSize() const { return m_Size; }
+
+private:
+    static constexpr std::uint32_t kPageBits   = 10;
+    static constexpr std::uint32_t kPageSize   = 1u << kPageBits;                       // 1 ページのスロット数
+    static constexpr std::uint32_t kMaxPages   = (HandleType::kMaxIndex + 1) >> kPageBits;
+    static constexpr std::uint32_t kNoFreeSlot = 0xFFFFFFFFu;
+
+    struct Slot
+    {
+        T             value{};
+        std::uint32_t generation = 1;               // 現在（または次回）発行する世代
+        std::uint32_t nextFree   = kNoFreeSlot;     // 空きリストの次
+    };
+
+    /// 世代を進める（0 は無効ハンドル用なので飛ばす）
+    static std::uint32_t NextGeneration(std::uint32_t generation)
+    {
+        const std::uint32_t next = (generation + 1) & HandleType::kGenerationMask;
+        return next == 0 ? 1 : next;
+    }
+
+    Slot& GetSlot(std::uint32_t index) { return m_Pages[index >> kPageBits][index & (kPageSize - 1)]; }
+    const Slot& GetSlot(std::uint32_t index) const { return m_Pages[index >> kPageBits][index & (kPageSize - 1)]; }
+
+    bool IsLive(HandleType handle) const
+    {
+        if (!handle.IsValid())
+            return false;
+
+        const std::uint32_t index = handle.GetIndex();
+        if (index >= m_SlotCount.load(std::memory_order_acquire))
+            return false;
+
+        return GetSlot(index).generation == handle.GetGeneration();
+    }
+
+private:
+    std::unique_ptr<Slot[]>    m_Pages[kMaxPages];          // 所有：スロットのページ（確保後は移動しない）
+    std::atomic<std::uint32_t> m_SlotCount{ 0 };            // 使用したことのあるスロット数
+    std::uint32_t              m_FreeHead = kNoFreeSlot;    // 空きリストの先頭
+    std::size_t                m_Size     = 0;              // 登録中の個数
+    std::mutex                 m_Mutex;                     // Insert / Erase の排他
+};
@@ -0,0 +1,145 @@
+﻿//------------------------------------------------------------------------------
+// Snapshot
+//------------------------------------------------------------------------------
+// 役割:
+// 実行中シーンのシミュレーション状態を、平坦なバイナリ列として書き出し / 読み戻すための
+// 書き込み器（SnapshotWriter）と読み込み器（SnapshotReader）。
+//
+// 設計意図:
+// 自動テストでの「やり直し・巻き戻し・分岐探索」のため、状態の保存と復元を
+// マイクロ秒単位で行いたい。オブジェクト単位の確保やシリアライズ形式の解釈は行わず、
+// GameObject 階層を決まった順に走査して POD 値を詰めるだけの形式にする。
+// 復元はオブジェクト構成が一致している前提で、既存オブジェクトへ上書きする（確保しない）。
+//
+// 構成:
+// - SnapshotHeader : 識別子 / バージョン / シーン / 先頭オブジェクト数
+// - SnapshotWriter : バッファ末尾へ値を追加する（容量は呼び出し側のバッファで保持）
+// - SnapshotReader : 先頭から値を読む。不足・構成不一致は失敗フラグで通知する
+//
+// NOTE:
+// - 書き込む値は trivially copyable な型に限る（ポインタは書かないこと）
+// - Vector3 はコピーコンストラクタを持ち trivially copyable ではないため、成分（float 3 つ）で読み書きする
+// - 形式は同一ビルド内での利用を想定（エンディアン変換や型情報は持たない）
+// - 書き込み内容（順序・型）を変えた場合は kSnapshotVersion を上げること
+//------------------------------------------------------------------------------
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+#include "Vector3.h"
+
+/// スナップショット形式のバージョン
+static constexpr std::uint32_t kSnapshotVersion = 6;
+
+/// スナップショット識別子（'PBSN'）
+static constexpr std::uint32_t kSnapshotMagic = 0x4E534250u;
+
+/// スナップショット先頭のヘッダ
+struct SnapshotHeader
+{
+    std::uint32_t magic       = kSnapshotMagic;
+    std::uint32_t version     = kSnapshotVersion;
+    std::uint32_t scene       = 0;    // 保存時のシーン（GameManager::Scene）
+    std::uint32_t objectCount = 0;    // シーン直下の GameObject 数
+};
+
+/// スナップショットの書き込み器
+/// - 対象バッファの中身は破棄され、容量は再利用される
+class SnapshotWriter
+{
+public:
+    explicit SnapshotWriter(std::vector<std::byte>& buffer) : m_Buffer(buffer) { m_Buffer.clear(); }
+
+    /// 値を 1 つ書き込む
+    template <class T>
+    void Write(const T& value)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "Snapshot には trivially copyable な型のみ書き込める");
+        static_assert(!std::is_pointer<T>::value, "Snapshot にポインタを書き込まないこと");
+        WriteBytes(&value, sizeof(T));
+    }
+
+    /// Vector3 を書き込む（x, y, z の順）
+    void Write(const Vector3& value)
+    {
+        Write(value.x);
+        Write(value.y);
+        Write(value.z);
+    }
+
+    /// 生バイト列を書き込む
+    void WriteBytes(const void* data, std::size_t size)
+    {
+        const std::size_t offset = m_Buffer.size();
+        m_Buffer.resize(offset + size);
+        std::memcpy(m_Buffer.data() + offset, data, size);
+    }
+
+    /// 書き込み済みのサイズ（バイト）
+    std::size_t GetSize() const { return m_Buffer.size(); }
+
+private:
+    std::vector<std::byte>& m_Buffer;   // 非所有：書き込み先
+};
+
+/// スナップショットの読み込み器
+/// - 失敗（データ不足・構成不一致）後の Read は何もせず false を返す
+class SnapshotReader
+{
+public:
+    SnapshotReader(const std::byte* data, std::size_t size) : m_Data(data), m_Size(size) {}
+
+    /// 値を 1 つ読み込む
+    /// 戻り値：成功した場合 true（失敗時は value を変更しない）
+    template <class T>
+    bool Read(T& value)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "Snapshot からは trivially copyable な型のみ読み込める");
+        return ReadBytes(&value, sizeof(T));
+    }
+
+    /// Vector3 を読み込む（x, y, z の順）
+    /// 戻り値：成功した場合 true（失敗時は value を変更しない）
+    bool Read(Vector3& value)
+    {
+        float xyz[3];
+        if (!ReadBytes(xyz, sizeof(xyz)))
+            return false;
+
+        value.x = xyz[0];
+        value.y = xyz[1];
+        value.z = xyz[2];
+        return true;
+    }
+
+    /// 生バイト列を読み込む
+    bool ReadBytes(void* data, std::size_t size)
+    {
+        if (m_Failed || m_Offset + size > m_Size)
+        {
+            m_Failed = true;
+            return false;
+        }
+
+        std::memcpy(data, m_Data + m_Offset, size);
+        m_Offset += size;
+        return true;
+    }
+
+    /// 構成不一致などで失敗扱いにする
+    void Fail() { m_Failed = true; }
+
+    /// 失敗しているか
+    bool IsFailed() const { return m_Failed; }
+
+    /// 読み残しが無いか
+    bool IsAtEnd() const { return m_Offset == m_Size; }
+
+private:
+    const std::byte* m_Data   = nullptr;    // 非所有：読み込み元
+    std::size_t      m_Size   = 0;          // 読み込み元のサイズ
+    std::size_t      m_Offset = 0;          // 読み込み位置
+    bool             m_Failed = false;      // 失敗フラグ
+};
@@ -24,7 +24,7 @@
 //------------------------------------------------------------------------------
 #pragma once
 
-#include "vector3.h"
+#include "Vector3.h"
 #include <DirectXMath.h>
 
 using namespace DirectX;
@@ -70,6 +70,17 @@ struct Transform
         return Parent ? (localMatrix * Parent->GetWorldMatrix()) : localMatrix;
     }
 
+    /// ワールド座標を取得する（ワールド行列の平行移動成分）
+    Vector3 GetWorldPosition() const
+    {
+        if (!Parent)
+            return Position;
+
+        XMFLOAT3 pos{};
+        XMStoreFloat3(&pos, GetWorldMatrix().r[3]);
+        return Vector3{ pos.x, pos.y, pos.z };
+    }
+
     // ----------------------------------------------------------------------
     // 親子関係管理
     // ----------------------------------------------------------------------
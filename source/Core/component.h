@@ -12,8 +12,10 @@
 //
 // 構成:
 // - ライフサイクル         : Init / Uninit / Update / Draw
-// - 所有関係               : GameObject が unique_ptr で所有（想定）
+// - 所有関係               : GameObject が所有（想定）
 // - 参照関係               : m_Owner で親 GameObject を参照（非所有）
+// - 型ID                   : ComponentTypeRegistry が型ごとに連番 ID を発行する
+// - スナップショット       : WriteState / ReadState（シミュレーション状態を持つ Component のみ実装）
 //
 // NOTE:
 // - Component 単体では機能は成立しない（Owner にアタッチされて初めて意味を持つ）
@@ -21,8 +23,40 @@
 // - Init / Uninit の呼び出し責務は管理側（通常は GameObject）にある
 //------------------------------------------------------------------------------
 #pragma once
+#include <atomic>
+#include <cstdint>
 
 class GameObject;
+class SnapshotWriter;
+class SnapshotReader;
+
+// ----------------------------------------------------------------------
+// Component 型ID
+// ----------------------------------------------------------------------
+using ComponentTypeId = std::uint32_t;
+
+/// 1 つの GameObject が型ID で引ける Component 型の上限
+/// NOTE: 新しい Component 型を追加して上限を超えた場合は値を増やすこと
+static constexpr ComponentTypeId kMaxComponentTypes = 32;
+
+/// Component 型ごとに連番の型ID を発行する
+/// - 型ごとに初回呼び出し時に採番され、以降は同じ値を返す
+/// - RTTI を使わずに GetComponent<T>() を配列参照で解決するために使用する
+/// NOTE: 採番順は実行ごとに変わり得るため、ID を保存・通信に使わないこと
+class ComponentTypeRegistry
+{
+public:
+    template <typename T>
+    static ComponentTypeId GetId()
+    {
+        static const ComponentTypeId s_Id = s_NextId.fetch_add(1);
+        return s_Id;
+    }
+
+private:
+    // シーン構築を別スレッドで行っても採番が衝突しないよう atomic にしている
+    static inline std::atomic<ComponentTypeId> s_NextId{ 0 };
+};
 
 /// Component の基底クラス
 /// - GameObject に付与できる「振る舞い」を表す
@@ -30,6 +64,11 @@ class GameObject;
 class Component
 {
 public:
+    /// GetComponent<基底型>() で引けるようにする基底型
+    /// - void の場合は自身の型でのみ登録される
+    /// - 派生側で using LookupBaseType = 基底型; を宣言すると、その子孫も基底型で引ける
+    using LookupBaseType = void;
+
     Component() = default;
     virtual ~Component() = default;
 
@@ -49,6 +88,15 @@ public:
     /// 描画処理
     virtual void Draw() {}
 
+    // ----------------------------------------------------------------------
+    // スナップショット
+    // ----------------------------------------------------------------------
+    /// シミュレーション状態を書き出す（既定：何も書かない）
+    virtual void WriteState(SnapshotWriter& writer) const {}
+
+    /// WriteState で書いた状態を同じ順序で読み戻す（既定：何も読まない）
+    virtual void ReadState(SnapshotReader& reader) {}
+
 public:
     /// 所属する GameObject への参照（非所有）
     /// - 有効期間：Owner(GameObject) が生存している間のみ有効
@@ -1,6 +1,9 @@
 ﻿#include "main.h"
 #include "GameManager.h"
 #include "TimeSystem.h"
+#include "FrameProfiler.h"
+#include "Renderer.h"
+#include <cstring>
 #include <thread>
 
 
@@ -50,6 +53,11 @@ int APIENTRY WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLi
 
 	CoInitializeEx(nullptr, COINITBASE_MULTITHREADED);
 
+	// -nullrender：GPU を使わず記録用バックエンドで描画呼び出しだけを数える
+	if (lpCmdLine && std::strstr(lpCmdLine, "-nullrender"))
+	{
+		Renderer::SetBackendType(RenderBackendType::Recording);
+	}
 
 	GameManager::Init();
 	TimeSystem::Init();
@@ -72,11 +80,16 @@ int APIENTRY WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLi
 			TimeSystem::Update();
 			float deltaTime = TimeSystem::DeltaTime();
 
+			FrameProfiler::BeginSection(ProfileSection::Frame);
+
 			// マネージャ更新
 			GameManager::Update(deltaTime);
 
 			// 描画
 			GameManager::Draw();
+
+			FrameProfiler::EndSection(ProfileSection::Frame);
+			FrameProfiler::EndFrame();
 		}
 	}
 
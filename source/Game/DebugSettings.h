@@ -11,6 +11,7 @@
 //
 // 構成:
 // - g_EnableColliderDebugDraw : Collider のデバッグ描画有効/無効フラグ
+// - g_EnableEnemySwarm        : EnemySwarm（大量の敵）の出現有効/無効フラグ
 //
 // NOTE:
 // - extern 変数の実体定義は .cpp 側で 1 箇所のみ行うこと
@@ -20,3 +21,6 @@
 
 /// Collider のデバッグ描画を有効にするかどうか
 extern bool g_EnableColliderDebugDraw;
+
+/// EnemySwarm の出現を有効にするかどうか（負荷確認用）
+extern bool g_EnableEnemySwarm;
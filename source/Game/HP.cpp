@@ -1,9 +1,11 @@
-﻿#include "HP.h"
+﻿#include "main.h"
+#include "HP.h"
 #include "Renderer.h"
 #include "Input.h"
 #include <algorithm>
 #include <string>
 #include "MathUtil.h"
+#include "Snapshot.h"
 
 // --------------------------------------------------------------------------------
 // Staticメンバ変数定義
@@ -29,6 +31,13 @@ void HP::Init()
     s_DrainPerSec = kDefaultDrainPerSec; // 毎秒のHP減少量
     s_HolePenalty = kDefaultHolePenalty; // 敵がホールに入ったときのペナルティ
     s_KillHeal    = kDefaultKillHeal;    // 敵を倒したときの回復量
+
+    // --- 更新頻度 ---
+    // 毎秒減少は溜めた経過時間で計算するので、間引いても減少量は変わらない
+    // NOTE: デバッグ操作は GetKeyTrigger（押した瞬間のフレームのみ）なので、デバッグビルドでは間引かない
+#if !defined(_DEBUG)
+    SetUpdateTier(UpdateTier::EveryNFrames, kUpdateInterval);
+#endif
 }
 
 // 終了処理
@@ -63,8 +72,39 @@ void HP::Draw()
     int hp  = static_cast<int>(s_HP);
     int max = static_cast<int>(s_MaxHP);
     
-    std::wstring text = L"HP: " + std::to_wstring(hp) + L" / " + std::to_wstring(max);
-    Renderer::DrawText(text, 10.0f, 30.0f);
+    // 表示文字列は値が変わったときだけ作り直す（レイアウトも同じ内容なら TextRenderer が使い回す）
+    if (hp != m_DisplayedHP || max != m_DisplayedMaxHP)
+    {
+        m_DisplayText = L"HP: " + std::to_wstring(hp) + L" / " + std::to_wstring(max);
+        m_DisplayedHP    = hp;
+        m_DisplayedMaxHP = max;
+    }
+    Renderer::DrawText(m_DisplayText, 10.0f, 30.0f);
+}
+
+// --------------------------------------------------------------------------------
+// スナップショット
+// --------------------------------------------------------------------------------
+// 書き出し
+void HP::WriteState(SnapshotWriter& writer) const
+{
+    GameObject::WriteState(writer);
+    writer.Write(s_HP);
+    writer.Write(s_MaxHP);
+    writer.Write(s_DrainPerSec);
+    writer.Write(s_HolePenalty);
+    writer.Write(s_KillHeal);
+}
+
+// 読み戻し
+void HP::ReadState(SnapshotReader& reader)
+{
+    GameObject::ReadState(reader);
+    reader.Read(s_HP);
+    reader.Read(s_MaxHP);
+    reader.Read(s_DrainPerSec);
+    reader.Read(s_HolePenalty);
+    reader.Read(s_KillHeal);
 }
 
 // --------------------------------------------------------------------------------
@@ -1,6 +1,7 @@
 ﻿#pragma once
 
 #include "gameObject.h"
+#include <string>
 
 /// <summary>
 /// HP管理クラス
@@ -19,6 +20,13 @@ public:
     void Update(float deltaTime) override;
     void Draw() override;
 
+    /// <summary>
+    /// スナップショット
+    /// HP・パラメータは static で共有されているため、HP オブジェクトの状態として保存する
+    /// </summary>
+    void WriteState(SnapshotWriter& writer) const override;
+    void ReadState(SnapshotReader& reader) override;
+
     /// <summary>
     /// HP情報を取得
     /// </summary>
@@ -60,6 +68,7 @@ private:
     static constexpr float kDefaultDrainPerSec = 1.0f;   // デフォルト毎秒HP減少量
     static constexpr float kDefaultHolePenalty = 10.0f;  // デフォルトのホールペナルティ
     static constexpr float kDefaultKillHeal    = 5.0f;   // デフォルトの撃破回復量
+    static constexpr std::uint8_t kUpdateInterval = 2;   // 更新間隔（フレーム数。リリースビルドのみ）
 
     // ------------------------------------------------------------------------------
     // 変数定義（Private）
@@ -73,4 +82,9 @@ private:
     static float s_DrainPerSec;                          // 毎秒のHP減少量
     static float s_HolePenalty;                          // 敵がホールに入ったときのペナルティ
     static float s_KillHeal;                             // 敵を倒したときの回復量
+
+    // 表示（値が変わったときだけ文字列を作り直す）
+    int          m_DisplayedHP    = -1;                  // m_DisplayText を作ったときの HP
+    int          m_DisplayedMaxHP = -1;                  // m_DisplayText を作ったときの最大HP
+    std::wstring m_DisplayText;                          // 表示中の文字列
 };
@@ -32,7 +32,7 @@ void Ball::Init()
     // ModelRenderer を追加
     // ----------------------------------------------------------------------
     m_ModelRenderer = AddComponent<ModelRenderer>();
-    m_ModelRenderer->Load("asset//model//ball.obj");
+    m_ModelRenderer->Load(kModelPath);
 
     // ----------------------------------------------------------------------
     // ColliderGroup + SphereCollider を追加
@@ -46,9 +46,9 @@ void Ball::Init()
     // RigidBody を追加（物理設定）
     // ----------------------------------------------------------------------
     m_RigidBody = AddComponent<RigidBody>();
-    m_RigidBody->m_Restitution  = m_BallBounce;
-    m_RigidBody->m_UseGravity   = true;
-    m_RigidBody->m_IsKinematic  = false;
+    m_RigidBody->SetRestitution(m_BallBounce);
+    m_RigidBody->SetUseGravity(true);
+    m_RigidBody->SetKinematic(false);
 
     // ----------------------------------------------------------------------
     // ピンボール用の重力設定
@@ -60,13 +60,13 @@ void Ball::Init()
     const float gy = -g * std::cosf(rad); // Y成分
     const float gz = -g * std::sinf(rad); // Z成分
 
-    m_RigidBody->m_Gravity = Vector3(0.0f, gy, gz);
+    m_RigidBody->SetGravity(Vector3(0.0f, gy, gz));
 }
 
 // ----------------------------------------------------------------------
 // 終了処理
 // ----------------------------------------------------------------------
-// - GameObject が Component を unique_ptr で所有しているため、ここでは参照を切るのみ
+// - GameObject が Component を所有しているため、ここでは参照を切るのみ
 void Ball::Uninit()
 {
     m_ModelRenderer = nullptr;
@@ -84,13 +84,13 @@ void Ball::Update(float deltaTime)
 {
 #if defined(_DEBUG)
     // NOTE: デバッグ用の直書き操作。物理挙動の検証用途として現状維持。
-    if (Input::GetKeyTrigger('W')) { m_RigidBody->m_Velocity.z += 12.0f; }
-    if (Input::GetKeyTrigger('S')) { m_RigidBody->m_Velocity.z -= 12.0f; }
-    if (Input::GetKeyTrigger('D')) { m_RigidBody->m_Velocity.x += 12.0f; }
-    if (Input::GetKeyTrigger('A')) { m_RigidBody->m_Velocity.x -= 12.0f; }
+    if (Input::GetKeyTrigger('W')) { m_RigidBody->AddVelocity(Vector3(0.0f, 0.0f, 12.0f)); }
+    if (Input::GetKeyTrigger('S')) { m_RigidBody->AddVelocity(Vector3(0.0f, 0.0f, -12.0f)); }
+    if (Input::GetKeyTrigger('D')) { m_RigidBody->AddVelocity(Vector3(12.0f, 0.0f, 0.0f)); }
+    if (Input::GetKeyTrigger('A')) { m_RigidBody->AddVelocity(Vector3(-12.0f, 0.0f, 0.0f)); }
 #endif
 
-    // Component 更新
+    // Component 更新（RigidBody の積分は PhysicsWorld::Step で済んでいる）
     GameObject::Update(deltaTime);
 
     // ----------------------------------------------------------------------
@@ -104,9 +104,14 @@ void Ball::Update(float deltaTime)
         pos.y = kTableMinY;
 
         // 下向き速度はカット
-        if (m_RigidBody && m_RigidBody->m_Velocity.y < 0.0f)
+        if (m_RigidBody)
         {
-            m_RigidBody->m_Velocity.y = 0.0f;
+            Vector3 velocity = m_RigidBody->GetVelocity();
+            if (velocity.y < 0.0f)
+            {
+                velocity.y = 0.0f;
+                m_RigidBody->SetVelocity(velocity);
+            }
         }
     }
 
@@ -116,9 +121,14 @@ void Ball::Update(float deltaTime)
         pos.y = kTableMaxY;
 
         // 上向き速度はカット
-        if (m_RigidBody && m_RigidBody->m_Velocity.y > 0.0f)
+        if (m_RigidBody)
         {
-            m_RigidBody->m_Velocity.y = 0.0f;
+            Vector3 velocity = m_RigidBody->GetVelocity();
+            if (velocity.y > 0.0f)
+            {
+                velocity.y = 0.0f;
+                m_RigidBody->SetVelocity(velocity);
+            }
         }
     }
 }
@@ -145,6 +155,6 @@ void Ball::ResetBall()
     m_Velocity = { 0.0f, 0.0f, 0.0f };
     if (m_RigidBody)
     {
-        m_RigidBody->m_Velocity = { 0.0f, 0.0f, 0.0f };
+        m_RigidBody->SetVelocity(Vector3(0.0f, 0.0f, 0.0f));
     }
 }
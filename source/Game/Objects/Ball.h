@@ -19,7 +19,7 @@
 // - 制約：テーブル面の上下（kTableMinY〜kTableMaxY）の高さ制限
 //
 // NOTE:
-// - 現状 m_Velocity（Ball側）と m_RigidBody->m_Velocity（物理側）が二重管理になっている。
+// - 現状 m_Velocity（Ball側）と RigidBody 側の速度（物理側）が二重管理になっている。
 //   どちらを正とするか統一しないと、バグの温床になる。
 //   例：ResetBall は両方をゼロ化しているが、Update は Ball側 m_Velocity を使っていない。
 //------------------------------------------------------------------------------
@@ -39,6 +39,9 @@ class RigidBody;
 class Ball : public GameObject
 {
 public:
+    /// モデルのパス（シーンの先行デコードでも参照する）
+    static constexpr const char* kModelPath = "asset//model//ball.obj";
+
     // ----------------------------------------------------------------------
     // ライフサイクルメソッド
     // ----------------------------------------------------------------------
@@ -48,7 +51,7 @@ public:
     void Init() override;
 
     /// 終了処理
-    /// NOTE: Component の実体は GameObject が unique_ptr で所有しているため、
+    /// NOTE: Component の実体は GameObject が所有しているため、
     ///       ここでは参照ポインタ（非所有）を nullptr に戻すだけでよい
     void Uninit() override;
 
@@ -5,6 +5,7 @@
 #include "ColliderGroup.h"
 #include "ModelRenderer.h"
 #include "RigidBody.h"
+#include "Snapshot.h"
 
 #include <DirectXMath.h>
 
@@ -35,7 +36,7 @@ void Bumper::Init()
     // ModelRenderer コンポーネント追加
     // ----------------------------------------------------------------------
     m_ModelRenderer = AddComponent<ModelRenderer>();
-    m_ModelRenderer->Load("asset//model//Bumper.obj");
+    m_ModelRenderer->Load(kModelPath);
 
     // ----------------------------------------------------------------------
     // SphereCollider コンポーネント追加
@@ -43,6 +44,11 @@ void Bumper::Init()
     auto* colliderGroup = AddComponent<ColliderGroup>();
     auto* sphereCollider = colliderGroup->AddCollider<SphereCollider>();
     sphereCollider->m_radius = kBumperDefaultColliderRadius;
+
+    // ----------------------------------------------------------------------
+    // 衝撃波を事前生成（衝突時に生成・GPUリソース作成を行わないため）
+    // ----------------------------------------------------------------------
+    m_ShockWavePool.Prewarm(*this, kShockWavePoolSize);
 }
 
 // ------------------------------------------------------------------------------
@@ -73,7 +79,7 @@ void Bumper::Draw()
 // 終了処理
 // ------------------------------------------------------------------------------
 // - 本クラスは非所有参照のみを保持しているため nullptr へ戻す
-// NOTE: Component の実体破棄は GameObject 側（unique_ptr）で行われる
+// NOTE: Component の実体破棄は GameObject 側（m_Components：InlineVector とインライン領域）で行われる
 void Bumper::Uninit()
 {
     m_ModelRenderer = nullptr;
@@ -114,11 +120,11 @@ void Bumper::OnCollisionEnter(const CollisionInfo& info)
     // ----------------------------------------------------------------------
     if (m_ShockCooldownTimer <= 0.0f)
     {
-        auto* shockWave = CreateChild<ShockWave>();
-        shockWave->Init();
-
-        // 子オブジェクトなのでローカル原点に置く（親Transformでワールド位置が決まる）
-        shockWave->m_Transform.Position = Vector3{ 0.0f, 0.0f, 0.0f };
+        if (auto* shockWave = m_ShockWavePool.Acquire())
+        {
+            // 子オブジェクトなのでローカル原点に置く（親Transformでワールド位置が決まる）
+            shockWave->Spawn(Vector3{ 0.0f, 0.0f, 0.0f });
+        }
 
         m_ShockCooldownTimer = kShockCooldown;
     }
@@ -146,5 +152,30 @@ void Bumper::OnCollisionEnter(const CollisionInfo& info)
     // ----------------------------------------------------------------------
     Vector3 newVel = n * kBumperKickHorizontalSpeed;
     newVel.y = kBumperKickVerticalSpeed;
-    rb->m_Velocity = newVel;
+    rb->SetVelocity(newVel);
+}
+
+// ------------------------------------------------------------------------------
+// スナップショット
+// ------------------------------------------------------------------------------
+// - 子（衝撃波）の状態は GameObject::WriteState で保存済み。ここではクールダウンと待機順を追加する
+void Bumper::WriteState(SnapshotWriter& writer) const
+{
+    GameObject::WriteState(writer);
+    writer.Write(m_ShockCooldownTimer);
+    m_ShockWavePool.WriteState(writer);
+}
+
+void Bumper::ReadState(SnapshotReader& reader)
+{
+    GameObject::ReadState(reader);
+    reader.Read(m_ShockCooldownTimer);
+    m_ShockWavePool.ReadState(reader);
+}
+
+// - 子は衝撃波のみなので、不足分をそのまま事前生成する
+bool Bumper::GrowChildrenForRestore(std::size_t count)
+{
+    m_ShockWavePool.Prewarm(*this, count - m_Children.size());
+    return m_Children.size() == count;
 }
@@ -22,6 +22,8 @@
 
 #include "GameObject.h"
 #include "CollisionInfo.h"
+#include "ObjectPool.h"
+#include "ShockWave.h"
 
 // 前方宣言
 class ColliderGroup;
@@ -34,6 +36,9 @@ class ModelRenderer;
 class Bumper : public GameObject
 {
 public:
+    /// モデルのパス（シーンの先行デコードでも参照する）
+    static constexpr const char* kModelPath = "asset//model//Bumper.obj";
+
     // ----------------------------------------------------------------------
     // ライフサイクルメソッド
     // ----------------------------------------------------------------------
@@ -51,7 +56,7 @@ public:
     void Draw() override;
 
     /// 終了処理
-    /// NOTE: GameObject 側で Component は unique_ptr 破棄される。
+    /// NOTE: Component は GameObject 側（m_Components：InlineVector とインライン領域）で破棄される。
     ///       本クラスは非所有参照を nullptr へ戻すのみ。
     void Uninit() override;
 
@@ -63,6 +68,17 @@ public:
     /// - 追加でスコア加算/サウンド/エフェクト等を起こす場合はここに集約する
     void OnCollisionEnter(const CollisionInfo& info) override;
 
+    // ----------------------------------------------------------------------
+    // スナップショット
+    // ----------------------------------------------------------------------
+    /// クールダウンと衝撃波プールの待機順を保存する（衝撃波自体は子として保存される）
+    void WriteState(SnapshotWriter& writer) const override;
+    void ReadState(SnapshotReader& reader) override;
+
+protected:
+    /// 保存時より衝撃波が少ない場合にプールを拡張する
+    bool GrowChildrenForRestore(std::size_t count) override;
+
 private:
     // ----------------------------------------------------------------------
     // バンパー設定（調整パラメータ）
@@ -75,6 +91,10 @@ private:
     static constexpr float kBumperKickHorizontalSpeed   = 25.0f; // 水平方向のキック速度
     static constexpr float kBumperKickVerticalSpeed     = 15.0f; // 垂直方向のキック速度
 
+    // 衝撃波プール
+    // - 寿命(0.35秒)とクールダウン(0.4秒)の関係上、同時に存在するのは基本 1 つ
+    static constexpr size_t kShockWavePoolSize          = 2;     // 事前生成する衝撃波の数
+
     // ----------------------------------------------------------------------
     // コンポーネント参照（非所有）
     // ----------------------------------------------------------------------
@@ -86,5 +106,7 @@ private:
     // 状態
     // ----------------------------------------------------------------------
     float m_ShockCooldownTimer = 0.0f; // 衝撃波発生のクールダウンタイマー（秒）
+
+    ObjectPool<ShockWave> m_ShockWavePool; // 衝撃波プール（実体は子として所有）
 };
 
@@ -1,7 +1,9 @@
-﻿#include "EnemyBase.h"
+﻿#include "main.h"
+#include "EnemyBase.h"
 #include "Input.h"
 #include "HP.h"
 #include "EnemyManager.h"
+#include "Snapshot.h"
 
 // コンポーネント
 #include "BoxCollider.h"
@@ -15,13 +17,12 @@
 #include "Hole.h"
 
 // 初期化処理
+// NOTE: プールで使い回すため、ここでは Component の構築のみ行う。
+//       出現ごとの状態設定と EnemyManager への登録は Spawn で行う。
 void EnemyBase::Init()
 {
     // 親クラスの初期化呼び出し
     GameObject::Init();
-
-    // エネミーマネージャーへ登録
-    EnemyManager::RegisterEnemy(this);
     // ------------------------------------------------------------------------------
     // パラメーター初期化
     // ------------------------------------------------------------------------------
@@ -68,6 +69,24 @@ void EnemyBase::Init()
     boxCollider->m_IsTrigger = true; // トリガーに設定
 }
 
+// 出現処理
+void EnemyBase::Spawn(const Vector3& position, const Vector3& targetPos, int flowField)
+{
+    // 状態を初期値へ戻す（プールからの再利用時に前回の状態を持ち越さない）
+    m_HP        = kDefaultEnemyHP;
+    m_Velocity  = { 0.0f, 0.0f, 0.0f };
+    m_AnimFrame = 0;
+    m_IsDead    = false;
+    SetUpdateTier(UpdateTier::EveryFrame);
+
+    m_Transform.Position = position;
+    m_TargetPos          = targetPos;
+    m_FlowField          = flowField;
+
+    // エネミーマネージャーへ登録
+    EnemyManager::RegisterEnemy(this);
+}
+
 // 終了処理
 void EnemyBase::Uninit()
 {
@@ -86,8 +105,8 @@ void EnemyBase::Update(float deltaTime)
     // 親クラスの更新処理呼び出し
     GameObject::Update(deltaTime);
 
-    // ターゲット方向へ移動する
-    m_Transform.Position += GetDirToTarget() * (m_Speed * deltaTime);
+    // ターゲット方向へ移動する（フローフィールドがあれば障害物を避ける経路に沿う）
+    m_Transform.Position += GetMoveDirection() * (m_Speed * deltaTime);
 
     // アニメーションの更新
     // 状態に応じてアニメーションを切り替える場合はここで実装
@@ -99,6 +118,19 @@ void EnemyBase::Update(float deltaTime)
     {
         m_IsDead = true;
     }
+
+    // 更新頻度の切り替え
+    // ターゲット（ホール）から遠い間は時分割で間引く
+    // 間引いた分の移動量（2 フレーム分）はフローフィールドのセルより短いので、経路から外れない
+    const float distSq = (m_TargetPos - m_Transform.Position).LengthSq();
+    if (distSq > kNearTargetDistance * kNearTargetDistance)
+    {
+        SetUpdateTier(UpdateTier::TimeSliced, kFarUpdateInterval);
+    }
+    else
+    {
+        SetUpdateTier(UpdateTier::EveryFrame);
+    }
 }
 
 // 描画処理
@@ -134,6 +166,38 @@ void EnemyBase::OnTriggerEnter(const CollisionInfo& info)
     }
 }
 
+// スナップショット書き出し
+void EnemyBase::WriteState(SnapshotWriter& writer) const
+{
+    GameObject::WriteState(writer);
+    writer.Write(m_Speed);
+    writer.Write(m_HP);
+    writer.Write(m_Score);
+    writer.Write(m_TargetPos);
+    writer.Write(m_Velocity);
+    writer.Write(m_AnimFrame);
+    writer.Write(m_FlowField);
+}
+
+// スナップショット読み戻し
+// NOTE: EnemyManager の一覧は復元前にクリアされている前提（GameManager::LoadSnapshot）
+void EnemyBase::ReadState(SnapshotReader& reader)
+{
+    GameObject::ReadState(reader);
+    reader.Read(m_Speed);
+    reader.Read(m_HP);
+    reader.Read(m_Score);
+    reader.Read(m_TargetPos);
+    reader.Read(m_Velocity);
+    reader.Read(m_AnimFrame);
+    reader.Read(m_FlowField);
+
+    if (!reader.IsFailed() && IsActive() && !IsDead())
+    {
+        EnemyManager::RegisterEnemy(this);
+    }
+}
+
 // ターゲットへの正規化方向
 Vector3 EnemyBase::GetDirToTarget() const
 {
@@ -147,3 +211,14 @@ Vector3 EnemyBase::GetDirToTarget() const
     // Vector3に備わっているNormalizeSafeを使用
     return dir.NormalizeSafe();
 }
+
+// 移動方向
+// NOTE: フローフィールドはワールド座標で引く（敵の位置は Spawner 基準のローカル座標）
+Vector3 EnemyBase::GetMoveDirection() const
+{
+    if (m_FlowField == FlowField::kNoField)
+    {
+        return GetDirToTarget();
+    }
+    return FlowField::Sample(m_FlowField, m_Transform.GetWorldPosition());
+}
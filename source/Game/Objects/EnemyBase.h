@@ -2,6 +2,7 @@
 
 #include "GameObject.h"
 #include "Vector3.h"
+#include "FlowField.h"
 
 class ColliderGroup;
 class AnimationModel;
@@ -26,16 +27,39 @@ public:
     void Draw() override;
     void Uninit() override;
 
+    /// <summary>
+    /// 並列更新可能
+    /// Update はターゲットへの移動・アニメーションカウンタ・死亡判定のみで、自分の状態しか触らない
+    /// （フローフィールドの参照は読み取りのみ）
+    /// NOTE: Update に他オブジェクトや HP などの static へ触る処理を足す場合は false に戻すこと
+    /// </summary>
+    bool IsParallelUpdateSafe() const override { return true; }
+
     /// <summary>
     /// 衝突コールバック
     /// </summary>
     void OnTriggerEnter(const CollisionInfo& info) override;
 
+    /// <summary>
+    /// 出現処理（プールからの取得直後に呼ぶ）
+    /// 体力・アニメーション等の状態を初期値へ戻し、位置と目標を設定して EnemyManager へ登録する
+    /// flowField を指定した場合は、障害物を避けてフローフィールドに沿って進む（未指定なら目標へ直進）
+    /// </summary>
+    void Spawn(const Vector3& position, const Vector3& targetPos, int flowField = FlowField::kNoField);
+
     /// <summary>
     /// ターゲット位置を設定する
     /// </summary>
     void SetTargetPosition(const Vector3& targetPos) { m_TargetPos = targetPos; }
 
+    /// <summary>
+    /// スナップショット
+    /// 移動・体力・アニメーションの状態を保存する
+    /// 読み戻し時、出現中であれば EnemyManager へ再登録する
+    /// </summary>
+    void WriteState(SnapshotWriter& writer) const override;
+    void ReadState(SnapshotReader& reader) override;
+
 private:
     // ----------------------------------------------------------------------
     // 関数定義
@@ -45,11 +69,22 @@ private:
     /// </summary>
     Vector3 GetDirToTarget() const;
 
+    /// <summary>
+    /// 移動方向
+    /// フローフィールドが指定されていればその方向、なければターゲットへの正規化方向
+    /// </summary>
+    Vector3 GetMoveDirection() const;
+
     // ----------------------------------------------------------------------
     // 定数定義
     // ----------------------------------------------------------------------
     // エネミーのデフォルトパラメーター
     static constexpr float kDefaultEnemyScale = 0.01f; // スケール
+    static constexpr int   kDefaultEnemyHP    = 1;     // 体力
+
+    // 更新頻度（ターゲットから遠い間は時分割で間引く）
+    static constexpr float        kNearTargetDistance = 8.0f; // これより近ければ毎フレーム更新
+    static constexpr std::uint8_t kFarUpdateInterval  = 2;    // 遠い間の更新間隔（フレーム数）
 
     // シェーダーパス
     static constexpr const char* VertexShaderPath =   // 頂点シェーダのパス
@@ -62,10 +97,11 @@ private:
     // ----------------------------------------------------------------------
     // 共通パラメーター
     float   m_Speed     = 3.0f;                       // 移動速度
-    int     m_HP        = 1;                          // 体力
+    int     m_HP        = kDefaultEnemyHP;            // 体力
     int     m_Score     = 100;                        // スコア値
     Vector3 m_TargetPos = { 0.0f, 0.0f, 0.0f };       // 目標位置
     Vector3 m_Velocity  = { 0.0f, 0.0f, 0.0f };       // 現在速度
+    int     m_FlowField = FlowField::kNoField;        // 経路誘導に使うフローフィールド
 
     // アニメーション用
     int m_AnimFrame = 0;                              // アニメーションフレームカウンタ
@@ -23,14 +23,15 @@ EnemyManager* EnemyManager::Get()
 const std::vector<EnemyBase*>& EnemyManager::GetEnemies()
 {
     static std::vector<EnemyBase*> s_Empty;
-    return s_Instance ? s_Instance->m_Enemies : s_Empty;
+    return s_Instance ? s_Instance->m_EnemyView : s_Empty;
 }
 
 // ------------------------------------------------------------------------------
 // 敵登録
 // ------------------------------------------------------------------------------
 // - EnemyManager が存在しない / enemy が nullptr の場合は何もしない
-// - 重複登録を防ぐ（std::find で存在確認）
+// - 重複登録を防ぐ（std::find で存在確認。プール再利用時はハンドルが変わるので別要素になる）
+// - 登録直後から GetEnemies() に含める
 // NOTE: 所有はしない。EnemyBase の破棄は別経路で行うこと。
 void EnemyManager::RegisterEnemy(EnemyBase* enemy)
 {
@@ -39,14 +40,74 @@ void EnemyManager::RegisterEnemy(EnemyBase* enemy)
         return;
     }
 
+    const ObjectHandle<EnemyBase> handle(enemy);
     auto& enemies = s_Instance->m_Enemies;
-    const auto it = std::find(enemies.begin(), enemies.end(), enemy);
+    const auto it = std::find(enemies.begin(), enemies.end(), handle);
     if (it == enemies.end())
     {
-        enemies.push_back(enemy);
+        enemies.push_back(handle);
+        s_Instance->m_EnemyView.push_back(enemy);
+        s_Instance->m_EnemyCells.push_back(
+            s_Instance->m_Grid.Insert(enemy, enemy->m_Transform.GetWorldPosition()));
     }
 }
 
+// ------------------------------------------------------------------------------
+// 空間インデックス
+// ------------------------------------------------------------------------------
+// - 先に死亡/無効参照を除去する（破棄済みの敵をインデックスに残さない）
+// - セルが変わった敵だけ付け替える（EnemySpatialGrid::Move）
+void EnemyManager::SyncSpatialIndex()
+{
+    if (s_Instance == nullptr)
+    {
+        return;
+    }
+
+    s_Instance->CleanupDeadEnemies();
+
+    auto& enemies = s_Instance->m_Enemies;
+    auto& cells   = s_Instance->m_EnemyCells;
+    auto& view    = s_Instance->m_EnemyView;
+    for (std::size_t i = 0; i < enemies.size(); ++i)
+    {
+        cells[i] = s_Instance->m_Grid.Move(enemies[i].GetHandle(), cells[i], view[i]->m_Transform.GetWorldPosition());
+    }
+}
+
+void EnemyManager::QueryRadius(const Vector3& center, float radius, FrameVector<EnemyBase*>& out)
+{
+    if (s_Instance) s_Instance->m_Grid.QueryRadius(center, radius, out);
+}
+
+void EnemyManager::QueryRing(const Vector3& center, float innerRadius, float outerRadius, FrameVector<EnemyBase*>& out)
+{
+    if (s_Instance) s_Instance->m_Grid.QueryRing(center, innerRadius, outerRadius, out);
+}
+
+void EnemyManager::QueryNearest(const Vector3& center, std::size_t count, FrameVector<EnemyBase*>& out)
+{
+    if (s_Instance) s_Instance->m_Grid.QueryNearest(center, count, out);
+}
+
+// ------------------------------------------------------------------------------
+// 管理リストのクリア
+// ------------------------------------------------------------------------------
+// - EnemyManager が存在しない場合は何もしない
+// NOTE: 一覧の順序は登録順に依存するが、利用側は順序に依存しない（件数・走査のみ）
+void EnemyManager::ClearEnemies()
+{
+    if (s_Instance == nullptr)
+    {
+        return;
+    }
+
+    s_Instance->m_Enemies.clear();
+    s_Instance->m_EnemyView.clear();
+    s_Instance->m_EnemyCells.clear();
+    s_Instance->m_Grid.Clear();
+}
+
 // ------------------------------------------------------------------------------
 // 初期化
 // ------------------------------------------------------------------------------
@@ -58,6 +119,9 @@ void EnemyManager::Init()
 {
     GameObject::Init();
     m_Enemies.clear();
+    m_EnemyView.clear();
+    m_EnemyCells.clear();
+    m_Grid.Clear();
     s_Instance = this;
 }
 
@@ -81,6 +145,9 @@ void EnemyManager::Update(float deltaTime)
 void EnemyManager::Uninit()
 {
     m_Enemies.clear();
+    m_EnemyView.clear();
+    m_EnemyCells.clear();
+    m_Grid.Clear();
     if (s_Instance == this)
     {
         s_Instance = nullptr;
@@ -91,16 +158,31 @@ void EnemyManager::Uninit()
 // ------------------------------------------------------------------------------
 // 死亡/無効参照の除去
 // ------------------------------------------------------------------------------
-// - nullptr または enemy->IsDead() を満たす要素を erase-remove で除去する
+// - 破棄済みハンドル / enemy->IsDead() / プールへ返却済み（!IsActive()）の要素を前詰めで除去する
+//   （セル番号の並びも合わせて詰め、除去した敵は空間インデックスから外す）
+// - 生存分で GetEnemies() 用の一覧を作り直す
 // NOTE: 破棄はしない（非所有のため）
 void EnemyManager::CleanupDeadEnemies()
 {
-    m_Enemies.erase(
-        std::remove_if(
-            m_Enemies.begin(),
-            m_Enemies.end(),
-            [](EnemyBase* enemy) {
-                return enemy == nullptr || enemy->IsDead();
-            }),
-        m_Enemies.end());
+    std::size_t aliveCount = 0;
+    for (std::size_t i = 0; i < m_Enemies.size(); ++i)
+    {
+        const EnemyBase* enemy = m_Enemies[i].Get();
+        if (enemy == nullptr || enemy->IsDead() || !enemy->IsActive())
+        {
+            m_Grid.Remove(m_Enemies[i].GetHandle(), m_EnemyCells[i]);
+            continue;
+        }
+        m_Enemies[aliveCount]    = m_Enemies[i];
+        m_EnemyCells[aliveCount] = m_EnemyCells[i];
+        ++aliveCount;
+    }
+    m_Enemies.resize(aliveCount);
+    m_EnemyCells.resize(aliveCount);
+
+    m_EnemyView.clear();
+    for (const auto& handle : m_Enemies)
+    {
+        m_EnemyView.push_back(handle.Get());
+    }
 }
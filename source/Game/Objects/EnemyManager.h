@@ -11,25 +11,30 @@
 //
 // 構成:
 // - シングルトン参照      : s_Instance（非所有）
-// - 敵リスト管理（非所有） : m_Enemies（EnemyBase*）
+// - 敵リスト管理（非所有） : m_Enemies（ObjectHandle<EnemyBase>）
 // - 死亡/無効参照の掃除     : CleanupDeadEnemies()
+// - 参照用の一覧           : m_EnemyView（掃除後の生存分を EnemyBase* で並べたもの）
+// - 空間インデックス       : m_Grid（EnemySpatialGrid）。半径 / リング / 近傍 k 件の検索を提供する
+//                            位置の反映は SyncSpatialIndex()（全 Update 後に GameManager から呼ぶ）
 //
 // NOTE:
 // - m_Enemies は EnemyBase を所有しない（破棄は各 Enemy 側 / 所有者が行う）。
 // - GetEnemies() が返す参照は、EnemyManager が生存している間のみ有効。
-// - 登録解除は明示的に行わず、Update 内で IsDead / nullptr を除去する方式。
+// - 登録解除は明示的に行わず、Update 内で IsDead / 破棄済みハンドルを除去する方式。
 //   （死亡判定のタイミングが要件に合うか確認すること）
+// - ハンドルで保持するため、Enemy が先に破棄・プール返却されても参照が残らない。
 //------------------------------------------------------------------------------
 #pragma once
 
 #include <vector>
 #include "GameObject.h"
+#include "EnemySpatialGrid.h"
 
 class EnemyBase;
 
 /// エネミー参照（非所有）を一元管理するマネージャー
 /// - シングルトン参照としてアクセスする
-/// - EnemyBase* のみを保持し、所有・破棄は行わない
+/// - ObjectHandle<EnemyBase> のみを保持し、所有・破棄は行わない
 class EnemyManager : public GameObject
 {
 public:
@@ -45,6 +50,8 @@ public:
     ///   - EnemyManager が存在する場合：EnemyManager の m_Enemies が有効な間のみ
     ///   - EnemyManager が存在しない場合：空配列（静的）の参照は常に有効
     /// NOTE: 返る参照を保持し続けるのではなく、必要な都度取得すること
+    /// NOTE: 一覧は Update 内の掃除時点のもの。フレームをまたいで要素を保持する場合は
+    ///       ObjectHandle<EnemyBase> に変換して持つこと
     static const std::vector<EnemyBase*>& GetEnemies();
 
     /// エネミーを登録する（重複登録はしない）
@@ -53,6 +60,28 @@ public:
     /// - 失敗条件：EnemyManager が存在しない場合は何もしない
     static void RegisterEnemy(EnemyBase* enemy);
 
+    // ----------------------------------------------------------------------
+    // 空間検索
+    // ----------------------------------------------------------------------
+    /// 死亡/無効参照を除去し、各エネミーの現在位置を空間インデックスへ反映する
+    /// - 全 GameObject の Update 後（衝突判定の前）に 1 回呼ぶ
+    /// NOTE: 検索結果はこの時点の位置に基づく（フレーム途中の移動は次回の反映まで反映されない）
+    static void SyncSpatialIndex();
+
+    /// center から radius 以内（XZ 平面）のエネミーを out へ追加する
+    /// - EnemyManager が存在しない場合は何もしない
+    static void QueryRadius(const Vector3& center, float radius, FrameVector<EnemyBase*>& out);
+
+    /// center からの距離が (innerRadius, outerRadius] のエネミーを out へ追加する
+    static void QueryRing(const Vector3& center, float innerRadius, float outerRadius, FrameVector<EnemyBase*>& out);
+
+    /// center に近い順に最大 count 体を out へ追加する
+    static void QueryNearest(const Vector3& center, std::size_t count, FrameVector<EnemyBase*>& out);
+
+    /// 管理リストを空にする
+    /// - スナップショット復元の前に呼ぶ（生存中のエネミーは EnemyBase::ReadState で再登録される）
+    static void ClearEnemies();
+
     // ----------------------------------------------------------------------
     // ライフサイクル
     // ----------------------------------------------------------------------
@@ -75,14 +104,19 @@ private:
     // ----------------------------------------------------------------------
     // 内部状態
     // ----------------------------------------------------------------------
-    static EnemyManager* s_Instance;      // 非所有：シングルトン参照
-    std::vector<EnemyBase*> m_Enemies;    // 非所有：敵参照リスト
+    static EnemyManager* s_Instance;                  // 非所有：シングルトン参照
+    std::vector<ObjectHandle<EnemyBase>> m_Enemies;   // 非所有：敵参照リスト
+    std::vector<EnemyBase*> m_EnemyView;              // 非所有：生存中の敵（GetEnemies 用）
+    std::vector<int> m_EnemyCells;                    // m_Enemies と同じ並び：空間インデックス上のセル番号
+    EnemySpatialGrid m_Grid;                          // 空間インデックス
 
     // ----------------------------------------------------------------------
     // 内部処理
     // ----------------------------------------------------------------------
     /// 死亡/無効参照を除去する
-    /// - nullptr または enemy->IsDead() の要素を erase-remove で取り除く
+    /// - 破棄済みハンドル / enemy->IsDead() / 無効化済み（プール待機中）の要素を erase-remove で取り除く
+    /// - 取り除いた要素は空間インデックスからも外す
+    /// - 残った要素で m_EnemyView を作り直す
     /// NOTE: ここでは EnemyBase の Uninit/破棄は行わない（所有していないため）
     void CleanupDeadEnemies();
 };
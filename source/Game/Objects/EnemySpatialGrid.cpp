@@ -0,0 +1,186 @@
+﻿#include "EnemySpatialGrid.h"
+
+#include "EnemyBase.h"
+#include <algorithm>
+#include <cstdlib>
+#include <utility>
+
+// ------------------------------------------------------------------------------
+// 座標変換
+// ------------------------------------------------------------------------------
+int EnemySpatialGrid::ToCellX(float x)
+{
+    const int cx = static_cast<int>((x - kOriginX) / kCellSize);
+    return std::clamp(cx, 0, kCellsX - 1);
+}
+
+int EnemySpatialGrid::ToCellZ(float z)
+{
+    const int cz = static_cast<int>((z - kOriginZ) / kCellSize);
+    return std::clamp(cz, 0, kCellsZ - 1);
+}
+
+// - 登録後にプールへ返却されるとハンドルが再発行され、ここでは引けなくなる
+EnemyBase* EnemySpatialGrid::ResolveLive(const Entry& entry)
+{
+    auto* enemy = static_cast<EnemyBase*>(GameObject::Resolve(entry.handle));
+    if (!enemy || !enemy->IsActive() || enemy->IsDead())
+        return nullptr;
+    return enemy;
+}
+
+// ------------------------------------------------------------------------------
+// 登録・更新
+// ------------------------------------------------------------------------------
+void EnemySpatialGrid::Clear()
+{
+    for (auto& cell : m_Cells)
+    {
+        cell.clear();
+    }
+}
+
+int EnemySpatialGrid::Insert(EnemyBase* enemy, const Vector3& worldPos)
+{
+    const int cell = ToCell(ToCellX(worldPos.x), ToCellZ(worldPos.z));
+    m_Cells[cell].push_back({ enemy->GetHandle(), worldPos.x, worldPos.z });
+    return cell;
+}
+
+// - 同じセル内なら座標だけ書き換える
+// - セルが変わった場合は旧セルから外して（末尾と入れ替えて削除）新セルへ追加する
+int EnemySpatialGrid::Move(GameObjectHandle handle, int cell, const Vector3& worldPos)
+{
+    const int newCell = ToCell(ToCellX(worldPos.x), ToCellZ(worldPos.z));
+    if (newCell == cell)
+    {
+        for (Entry& entry : m_Cells[cell])
+        {
+            if (entry.handle == handle)
+            {
+                entry.x = worldPos.x;
+                entry.z = worldPos.z;
+                return cell;
+            }
+        }
+    }
+
+    Remove(handle, cell);
+    m_Cells[newCell].push_back({ handle, worldPos.x, worldPos.z });
+    return newCell;
+}
+
+void EnemySpatialGrid::Remove(GameObjectHandle handle, int cell)
+{
+    if (cell == kNoCell)
+        return;
+
+    auto& entries = m_Cells[cell];
+    for (std::size_t i = 0; i < entries.size(); ++i)
+    {
+        if (entries[i].handle == handle)
+        {
+            entries[i] = entries.back();
+            entries.pop_back();
+            return;
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------
+// 検索
+// ------------------------------------------------------------------------------
+void EnemySpatialGrid::QueryRadius(const Vector3& center, float radius, FrameVector<EnemyBase*>& out) const
+{
+    QueryRing(center, -1.0f, radius, out);
+}
+
+// - 外半径の外接矩形に掛かるセルだけを調べる
+// - 内半径が負の場合は中心も含む（QueryRadius）
+void EnemySpatialGrid::QueryRing(const Vector3& center, float innerRadius, float outerRadius, FrameVector<EnemyBase*>& out) const
+{
+    if (outerRadius < 0.0f)
+        return;
+
+    const float innerSq = (innerRadius < 0.0f) ? -1.0f : innerRadius * innerRadius;
+    const float outerSq = outerRadius * outerRadius;
+
+    const int x0 = ToCellX(center.x - outerRadius);
+    const int x1 = ToCellX(center.x + outerRadius);
+    const int z0 = ToCellZ(center.z - outerRadius);
+    const int z1 = ToCellZ(center.z + outerRadius);
+
+    for (int cz = z0; cz <= z1; ++cz)
+    {
+        for (int cx = x0; cx <= x1; ++cx)
+        {
+            for (const Entry& entry : m_Cells[ToCell(cx, cz)])
+            {
+                const float dx = entry.x - center.x;
+                const float dz = entry.z - center.z;
+                const float distSq = dx * dx + dz * dz;
+                if (distSq <= innerSq || distSq > outerSq)
+                    continue;
+
+                if (EnemyBase* enemy = ResolveLive(entry))
+                    out.push_back(enemy);
+            }
+        }
+    }
+}
+
+// - 中心のセルから 1 周ずつ外側のセルを調べる
+// - count 件そろい、かつ次の周のセルがそれより遠いことが確定したら打ち切る
+//   （周 r + 1 のセル内の点は、中心から少なくとも r * kCellSize 離れている）
+void EnemySpatialGrid::QueryNearest(const Vector3& center, std::size_t count, FrameVector<EnemyBase*>& out) const
+{
+    if (count == 0)
+        return;
+
+    FrameVector<std::pair<float, EnemyBase*>> candidates;
+    candidates.reserve(count * 2);
+
+    const int ccx = ToCellX(center.x);
+    const int ccz = ToCellZ(center.z);
+    const int maxRing = std::max(kCellsX, kCellsZ);
+
+    for (int ring = 0; ring <= maxRing; ++ring)
+    {
+        for (int cz = ccz - ring; cz <= ccz + ring; ++cz)
+        {
+            if (cz < 0 || cz >= kCellsZ) continue;
+            for (int cx = ccx - ring; cx <= ccx + ring; ++cx)
+            {
+                if (cx < 0 || cx >= kCellsX) continue;
+
+                // 周上のセルのみ（内側は前の周で調べ済み）
+                if (std::abs(cx - ccx) != ring && std::abs(cz - ccz) != ring) continue;
+
+                for (const Entry& entry : m_Cells[ToCell(cx, cz)])
+                {
+                    EnemyBase* enemy = ResolveLive(entry);
+                    if (!enemy) continue;
+
+                    const float dx = entry.x - center.x;
+                    const float dz = entry.z - center.z;
+                    candidates.emplace_back(dx * dx + dz * dz, enemy);
+                }
+            }
+        }
+
+        if (candidates.size() >= count)
+        {
+            std::nth_element(candidates.begin(), candidates.begin() + (count - 1), candidates.end());
+            const float reach = ring * kCellSize;
+            if (candidates[count - 1].first <= reach * reach)
+                break;
+        }
+    }
+
+    const std::size_t n = std::min(count, candidates.size());
+    std::partial_sort(candidates.begin(), candidates.begin() + n, candidates.end());
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        out.push_back(candidates[i].second);
+    }
+}
@@ -0,0 +1,97 @@
+﻿//------------------------------------------------------------------------------
+// EnemySpatialGrid
+//------------------------------------------------------------------------------
+// 役割:
+// エネミーを台の平面（XZ）上の一様グリッドで分類し、
+// 半径・リング（円環）・近傍 k 件の検索を行う空間インデックス。
+//
+// 設計意図:
+// 範囲攻撃や索敵のたびに全エネミーを走査したり、Trigger 判定のペアを全エネミー分
+// 作ったりすると、敵の数に比例してコストが増える。セル単位で候補を絞り、
+// 検索範囲に掛かるセルだけを調べるようにする。
+// 移動による更新は「セルが変わった敵だけ付け替える」差分方式にする。
+//
+// 構成:
+// - Insert / Remove / Move : 登録・解除・移動（セルの番号を返す / 受け取る）
+// - QueryRadius            : 中心から半径以内
+// - QueryRing              : 内半径より外かつ外半径以内（円環）
+// - QueryNearest           : 近い順に k 件
+//
+// NOTE:
+// - 距離は XZ 平面上で測る（高さは無視する）
+// - 範囲外の座標は端のセルへ寄せる（検索は実座標で判定するので結果は正しい）
+// - 要素はハンドルで持つ。破棄済み / プール返却済み / 削除予約済みの敵は検索結果に含めない
+// - 検索結果の出力先はフレーム一時領域（FrameVector）
+//------------------------------------------------------------------------------
+#pragma once
+
+#include <vector>
+#include "GameObject.h"
+
+class EnemyBase;
+
+/// エネミー用の一様グリッド
+class EnemySpatialGrid
+{
+public:
+    // ----------------------------------------------------------------------
+    // 定数
+    // ----------------------------------------------------------------------
+    static constexpr float kCellSize   = 2.0f;     // セルの一辺（ワールド単位）
+    static constexpr int   kCellsX     = 16;       // X 方向のセル数
+    static constexpr int   kCellsZ     = 20;       // Z 方向のセル数
+    static constexpr float kOriginX    = -kCellSize * kCellsX * 0.5f;   // グリッド左端の X
+    static constexpr float kOriginZ    = -kCellSize * kCellsZ * 0.5f;   // グリッド手前端の Z
+    static constexpr int   kNoCell     = -1;       // 未登録
+
+    // ----------------------------------------------------------------------
+    // 登録・更新
+    // ----------------------------------------------------------------------
+    /// すべてのセルを空にする（容量は保持する）
+    void Clear();
+
+    /// 登録する
+    /// 戻り値：登録先のセル番号（Move / Remove に渡すため呼び出し側で保持する）
+    int Insert(EnemyBase* enemy, const Vector3& worldPos);
+
+    /// 位置を更新する（セルが変わった場合のみ付け替える）
+    /// - handle / cell は登録時（または前回の Move）のもの
+    /// 戻り値：更新後のセル番号
+    int Move(GameObjectHandle handle, int cell, const Vector3& worldPos);
+
+    /// 登録を解除する
+    /// - handle は登録時のもの（プール返却で再発行された後でも、登録時の値で探す）
+    void Remove(GameObjectHandle handle, int cell);
+
+    // ----------------------------------------------------------------------
+    // 検索
+    // ----------------------------------------------------------------------
+    /// center から radius 以内の敵を out へ追加する
+    void QueryRadius(const Vector3& center, float radius, FrameVector<EnemyBase*>& out) const;
+
+    /// center からの距離が (innerRadius, outerRadius] の敵を out へ追加する
+    void QueryRing(const Vector3& center, float innerRadius, float outerRadius, FrameVector<EnemyBase*>& out) const;
+
+    /// center に近い順に最大 count 件を out へ追加する
+    void QueryNearest(const Vector3& center, std::size_t count, FrameVector<EnemyBase*>& out) const;
+
+private:
+    /// セルの要素（検索時に敵本体へ触らずに距離判定できるよう座標を持つ）
+    struct Entry
+    {
+        GameObjectHandle handle;
+        float            x;
+        float            z;
+    };
+
+    /// 座標 → セル座標（範囲外は端へ寄せる）
+    static int ToCellX(float x);
+    static int ToCellZ(float z);
+    static int ToCell(int cx, int cz) { return cz * kCellsX + cx; }
+
+    /// 要素が検索結果に含めてよい敵なら返す（破棄済み / 返却済み / 削除予約済みなら nullptr）
+    static EnemyBase* ResolveLive(const Entry& entry);
+
+private:
+    std::vector<Entry> m_Cells[kCellsX * kCellsZ];     // セルごとの要素
+};
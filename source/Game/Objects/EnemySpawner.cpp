@@ -2,7 +2,7 @@
 #include "Hole.h"
 #include "EnemyBase.h"
 #include "EnemyStraight.h"
-#include <cstdlib>          // rand
+#include "Snapshot.h"
 
 // 初期化処理
 void EnemySpawner::Init()
@@ -13,6 +13,9 @@ void EnemySpawner::Init()
     // 最初のスポーンまでのタイマー
     m_SpawnTimer = m_SpawnIntervalSec;
 
+    // エネミーを事前生成（スポーン時に生成・GPUリソース作成を行わないため）
+    m_EnemyPool.Prewarm(*this, kEnemyPoolSize);
+
     // ----------------------------------------------------------------------
     // MeshRendererコンポーネントの追加
     // デバッグ用に黒い箱メッシュを表示
@@ -47,6 +50,38 @@ void EnemySpawner::Update(float deltaTime)
     }
 }
 
+// ターゲットにするHoleを登録
+void EnemySpawner::AddTargetHole(Hole* hole)
+{
+    if (!hole) return;
+    m_TargetHoles.emplace_back(hole);
+}
+
+// スナップショット書き出し
+void EnemySpawner::WriteState(SnapshotWriter& writer) const
+{
+    GameObject::WriteState(writer);
+    writer.Write(m_SpawnTimer);
+    writer.Write(m_Random);
+    m_EnemyPool.WriteState(writer);
+}
+
+// スナップショット読み戻し
+void EnemySpawner::ReadState(SnapshotReader& reader)
+{
+    GameObject::ReadState(reader);
+    reader.Read(m_SpawnTimer);
+    reader.Read(m_Random);
+    m_EnemyPool.ReadState(reader);
+}
+
+// プールの拡張（子はエネミーのみなので、不足分をそのまま事前生成する）
+bool EnemySpawner::GrowChildrenForRestore(std::size_t count)
+{
+    m_EnemyPool.Prewarm(*this, count - m_Children.size());
+    return m_Children.size() == count;
+}
+
 // エネミーをスポーン
 void EnemySpawner::SpawnEnemy()
 {
@@ -62,22 +97,23 @@ void EnemySpawner::SpawnEnemy()
     const Vector3 spawnPos = { x, y, z };
 
     // ランダムにターゲットホールを選択
-    const int holeIndex = rand() % static_cast<int>(m_TargetHoles.size());
-    Hole* targetHole = m_TargetHoles[holeIndex];
+    const std::uint32_t holeIndex = m_Random.NextIndex(static_cast<std::uint32_t>(m_TargetHoles.size()));
+    Hole* targetHole = m_TargetHoles[holeIndex].Get();
+    if (!targetHole) {
+        // 破棄済みのホールは候補から外す（次回以降のスポーンで選び直す）
+        m_TargetHoles.erase(m_TargetHoles.begin() + holeIndex);
+        return;
+    }
 
-    // 敵を生成
-    EnemyStraight* enemy = nullptr;
-    enemy = CreateChild<EnemyStraight>();
-    enemy->Init();
-    enemy->m_Transform.Position = spawnPos;
+    // プールから敵を取得し、位置とターゲットホールを設定して出現させる
+    EnemyStraight* enemy = m_EnemyPool.Acquire();
+    if (!enemy) return;
 
-    // ターゲットホールの位置をエネミーに設定
-    enemy->SetTargetPosition(targetHole->GetHolePosition());
+    enemy->Spawn(spawnPos, targetHole->GetHolePosition(), targetHole->GetFlowField());
 }
 
-// [min, max]の範囲でランダムなfloat値を取得
+// [min, max)の範囲でランダムなfloat値を取得
 float EnemySpawner::GetRandomFloat(float min, float max)
 {
-    const float t = static_cast<float>(std::rand()) / static_cast<float>(RAND_MAX);
-    return min + (max - min) * t;
+    return m_Random.NextRange(min, max);
 }
\ No newline at end of file
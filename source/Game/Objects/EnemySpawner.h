@@ -1,7 +1,10 @@
 ﻿#pragma once
 
 #include "GameObject.h"
+#include "ObjectPool.h"
+#include "EnemyStraight.h"
 #include "Vector3.h"
+#include "Random.h"
 #include <vector>
 
 class Hole;
@@ -39,12 +42,31 @@ public:
         m_SpawnZ = z;
     }
 
+    /// <summary>
+    /// 乱数ストリームを設定（FieldBuilder が盤面のシードから分岐させて渡す）
+    /// </summary>
+    void SetRandom(const Random& random) { m_Random = random; }
+
     /// <summary>
     /// ターゲットにするHoleを登録
+    /// NOTE: ハンドルで保持するため、Hole が先に破棄されてもスポーン時に除外される
     /// </summary>
-    void AddTargetHole(Hole* hole) { m_TargetHoles.push_back(hole); }
+    void AddTargetHole(Hole* hole);
+
+    /// <summary>
+    /// スナップショット
+    /// スポーンタイマー・乱数の状態・エネミープールの待機順を保存する（エネミー自体は子として保存される）
+    /// NOTE: ターゲットHoleは構成情報のため保存しない
+    /// </summary>
+    void WriteState(SnapshotWriter& writer) const override;
+    void ReadState(SnapshotReader& reader) override;
 
 protected:
+    /// <summary>
+    /// 保存時よりエネミーが少ない場合にプールを拡張する
+    /// </summary>
+    bool GrowChildrenForRestore(std::size_t count) override;
+
     // ----------------------------------------------------------------------
     // 関数定義
     // ----------------------------------------------------------------------
@@ -54,7 +76,7 @@ protected:
     void SpawnEnemy();
 
     /// <summary>
-    /// [min, max]の範囲でランダムなfloat値を取得
+    /// [min, max)の範囲でランダムなfloat値を取得
     /// </summary>
     float GetRandomFloat(float min, float max);
 
@@ -66,6 +88,7 @@ private:
     static constexpr float kDefaultSpawnXMin        = -5.0f; // デフォルトスポーン位置X最小値
     static constexpr float kDefaultSpawnXMax        = 5.0f;  // デフォルトスポーン位置X最大値
     static constexpr float kDefaultSpawnZ           = 5.0f;  // デフォルトスポーン位置Z
+    static constexpr size_t kEnemyPoolSize          = 16;    // 事前生成するエネミー数（足りなければ追加生成）
     
     // シェーダーパス
     static constexpr const char* VertexShaderPath =          // 頂点シェーダのパス
@@ -81,7 +104,9 @@ private:
     float m_SpawnXMin        = kDefaultSpawnXMin;            // スポーン位置X最小値
     float m_SpawnXMax        = kDefaultSpawnXMax;            // スポーン位置X最大値
     float m_SpawnZ           = kDefaultSpawnZ;               // スポーン位置Z
-    std::vector<Hole*>         m_TargetHoles;                // ターゲットHoleリスト
+    std::vector<ObjectHandle<Hole>> m_TargetHoles;           // ターゲットHoleリスト（非所有）
+    Random                     m_Random;                     // 出現位置・ターゲット選択用の乱数
+    ObjectPool<EnemyStraight>  m_EnemyPool;                  // エネミープール（実体は子として所有）
     
     MeshRenderer*              m_MeshRenderer   = nullptr;   // メッシュレンダラーコンポーネント
 };
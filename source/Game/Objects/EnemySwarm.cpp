@@ -0,0 +1,505 @@
+﻿#include "main.h"
+#include "EnemySwarm.h"
+
+// システム関連
+#include <DirectXMath.h>
+#include <cassert>
+#include <cmath>
+
+#include "renderer.h"
+#include "GameManager.h"
+#include "JobSystem.h"
+#include "Snapshot.h"
+#include "DebugSettings.h"
+#include "FlowField.h"
+
+// ゲームオブジェクト
+#include "Ball.h"
+#include "Hole.h"
+#include "HP.h"
+
+using namespace DirectX;
+
+// 静的メンバ変数の定義
+EnemySwarm* EnemySwarm::s_Instance = nullptr;
+
+namespace
+{
+    /// 配列の先頭 index から 4 要素を読み込む
+    inline XMVECTOR Load4(const std::vector<float>& values, std::uint32_t index)
+    {
+        return XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(values.data() + index));
+    }
+
+    /// 配列の先頭 index から 4 要素を書き込む
+    inline void Store4(std::vector<float>& values, std::uint32_t index, FXMVECTOR v)
+    {
+        XMStoreFloat4(reinterpret_cast<XMFLOAT4*>(values.data() + index), v);
+    }
+
+    /// 配列すべてに同じ処理を行う（伸長・移動・0 埋め用）
+    template <typename Func>
+    void ForEachArray(SwarmArrays& m, Func&& func)
+    {
+        func(m.posX); func(m.posZ);
+        func(m.velX); func(m.velZ);
+        func(m.alive);
+        func(m.hp);
+        func(m.target);
+    }
+
+    template <typename Func>
+    void ForEachArray(const SwarmArrays& m, Func&& func)
+    {
+        func(m.posX); func(m.posZ);
+        func(m.velX); func(m.velZ);
+        func(m.alive);
+        func(m.hp);
+        func(m.target);
+    }
+}
+
+// ------------------------------------------------------------------------------
+// 初期化処理
+// ------------------------------------------------------------------------------
+// - 配列は最大数まで確保しておく（出現・スナップショット読み戻しで確保を起こさない）
+// - メッシュは Component として登録せず、インスタンス描画専用に持つ
+void EnemySwarm::Init()
+{
+    GameObject::Init();
+
+    assert(s_Instance == nullptr && "EnemySwarm はシーン内に 1 つだけ置くこと");
+    s_Instance = this;
+
+    ForEachArray(m_Members, [](auto& values) { values.reserve(kCapacity); });
+    m_Count = 0;
+    m_SpawnAccumulator = 0.0f;
+    ResizeArrays(0);
+
+    m_Mesh.LoadInstancedShader(kSwarmVertexShaderPath, kSwarmPixelShaderPath);
+    m_Mesh.CreateUnitBox();
+    m_Mesh.m_Color = kSwarmColor;
+
+    GpuBufferDesc desc{};
+    desc.size  = sizeof(XMFLOAT4) * kCapacity;
+    desc.usage = GpuBufferUsage::Dynamic;
+    desc.bind  = GpuBufferBind::Vertex;
+    m_InstanceBuffer = Renderer::GetBackend().CreateBuffer(desc, nullptr);
+}
+
+// ------------------------------------------------------------------------------
+// 終了処理
+// ------------------------------------------------------------------------------
+void EnemySwarm::Uninit()
+{
+    if (m_InstanceBuffer)
+    {
+        Renderer::GetBackend().Release(m_InstanceBuffer);
+        m_InstanceBuffer = nullptr;
+    }
+    m_Mesh.Uninit();
+
+    if (s_Instance == this)
+    {
+        s_Instance = nullptr;
+    }
+
+    GameObject::Uninit();
+}
+
+// ------------------------------------------------------------------------------
+// 設定
+// ------------------------------------------------------------------------------
+void EnemySwarm::SetSpawnArea(float xMin, float xMax, float z)
+{
+    m_SpawnXMin = xMin;
+    m_SpawnXMax = xMax;
+    m_SpawnZ    = z;
+}
+
+void EnemySwarm::AddTargetHole(Hole* hole)
+{
+    if (!hole) return;
+    assert(m_Targets.size() < 256 && "目標の添字は 8bit で持つ");
+
+    SwarmTarget target;
+    target.hole = ObjectHandle<Hole>(hole);
+    m_Targets.push_back(target);
+}
+
+// ------------------------------------------------------------------------------
+// 更新処理
+// ------------------------------------------------------------------------------
+// 1. 目標ホールの情報を読み直す
+// 2. 出現
+// 3. 進行方向の取得（FlowField。ジョブで並列）
+// 4. 積分（SIMD）
+// 5. ボール・ホールとの当たり判定（SIMD）
+// 6. 死亡分の詰め直し
+// NOTE: 衝撃波の判定（KillInRing）は Bumper の更新中に呼ばれ、倒した敵は 6. で詰められる
+void EnemySwarm::Update(float deltaTime)
+{
+    GameObject::Update(deltaTime);
+
+    RefreshTargets();
+    SpawnMembers(deltaTime);
+    if (m_Count == 0)
+        return;
+
+    JobCounter counter;
+    JobSystem::ParallelFor(m_Count, kSteerGrain, &SteerJob, this, counter);
+    JobSystem::Wait(counter);
+
+    Integrate(deltaTime);
+    TestTriggers();
+    Compact();
+}
+
+// - 破棄済みのホールはキャッシュをそのまま使う（出現先の候補には残る）
+void EnemySwarm::RefreshTargets()
+{
+    for (SwarmTarget& target : m_Targets)
+    {
+        if (Hole* hole = target.hole.Get())
+        {
+            const Vector3 center = hole->m_Transform.GetWorldPosition();
+            target.centerX   = center.x;
+            target.centerZ   = center.z;
+            target.halfX     = hole->m_Transform.Scale.x * 0.5f;
+            target.halfZ     = hole->m_Transform.Scale.z * 0.5f;
+            target.flowField = hole->GetFlowField();
+        }
+    }
+}
+
+// - 出現数は「経過時間 × 出現速度」の端数を持ち越して決める
+// - スポーン範囲は群れの Transform 基準（回転は考慮しない）
+// - 出現位置 X は乱数でまとめて配列へ書き込む
+void EnemySwarm::SpawnMembers(float deltaTime)
+{
+    if (!g_EnableEnemySwarm || m_Targets.empty())
+    {
+        m_SpawnAccumulator = 0.0f;
+        return;
+    }
+
+    m_SpawnAccumulator += deltaTime * kSwarmSpawnPerSecond;
+    const float whole = std::floor(m_SpawnAccumulator);
+    m_SpawnAccumulator -= whole;
+
+    const std::uint32_t spawnCount = std::min(static_cast<std::uint32_t>(whole), kCapacity - m_Count);
+    if (spawnCount == 0)
+        return;
+
+    const Vector3 origin = m_Transform.GetWorldPosition();
+    const std::uint32_t first = m_Count;
+    m_Count += spawnCount;
+    ResizeArrays(m_Count);
+
+    SwarmArrays& m = m_Members;
+    m_Random.FillRange(&m.posX[first], spawnCount, origin.x + m_SpawnXMin, origin.x + m_SpawnXMax);
+
+    const std::uint32_t targetCount = static_cast<std::uint32_t>(m_Targets.size());
+    for (std::uint32_t i = first; i < m_Count; ++i)
+    {
+        m.posZ[i]   = origin.z + m_SpawnZ;
+        m.velX[i]   = 0.0f;
+        m.velZ[i]   = 0.0f;
+        m.alive[i]  = 1.0f;
+        m.hp[i]     = kSwarmEnemyHP;
+        m.target[i] = static_cast<std::uint8_t>(m_Random.NextIndex(targetCount));
+    }
+}
+
+// - フローフィールドが無い目標へは直進する
+void EnemySwarm::SteerRange(std::size_t begin, std::size_t end)
+{
+    SwarmArrays& m = m_Members;
+    for (std::size_t i = begin; i < end; ++i)
+    {
+        const SwarmTarget& target = m_Targets[m.target[i]];
+        const Vector3 position = { m.posX[i], 0.0f, m.posZ[i] };
+
+        Vector3 dir;
+        if (target.flowField != FlowField::kNoField)
+        {
+            dir = FlowField::Sample(target.flowField, position);
+        }
+        else
+        {
+            const Vector3 toTarget = { target.centerX - position.x, 0.0f, target.centerZ - position.z };
+            dir = (toTarget.LengthSq() < 1e-6f) ? Vector3{ 0.0f, 0.0f, 0.0f } : toTarget.NormalizeSafe();
+        }
+
+        m.velX[i] = dir.x * kSwarmSpeed;
+        m.velZ[i] = dir.z * kSwarmSpeed;
+    }
+}
+
+void EnemySwarm::SteerJob(void* data, std::size_t begin, std::size_t end)
+{
+    static_cast<EnemySwarm*>(data)->SteerRange(begin, end);
+}
+
+// - p = p + v * dt を 4 体ずつ（配列はパディング済みなので端数処理は不要）
+void EnemySwarm::Integrate(float deltaTime)
+{
+    SwarmArrays& m = m_Members;
+    const XMVECTOR dt = XMVectorReplicate(deltaTime);
+    for (std::uint32_t i = 0; i < m_Count; i += kSimdWidth)
+    {
+        Store4(m.posX, i, XMVectorMultiplyAdd(Load4(m.velX, i), dt, Load4(m.posX, i)));
+        Store4(m.posZ, i, XMVectorMultiplyAdd(Load4(m.velZ, i), dt, Load4(m.posZ, i)));
+    }
+}
+
+// - ボール：XZ 距離が「ボール半径 + 敵の半分の大きさ」以内
+// - ホール：ホールの XZ 範囲を敵の半分の大きさだけ広げた矩形の内側
+// - 4 体とも当たっていなければ次へ。当たった組だけ添字ごとに処理する
+//   （ホールを優先。EnemyBase::OnTriggerEnter と同じ通知を HP へ送る）
+void EnemySwarm::TestTriggers()
+{
+    SwarmArrays& m = m_Members;
+
+    const Ball* ball = FindBall();
+    const bool hasBall = (ball != nullptr) && ball->IsActive();
+    const Vector3 ballPos = hasBall ? ball->m_Transform.GetWorldPosition() : Vector3{ 0.0f, 0.0f, 0.0f };
+    const float ballReach = hasBall ? ball->GetRadius() + kSwarmHalfExtent : 0.0f;
+
+    const XMVECTOR zero        = XMVectorZero();
+    const XMVECTOR ballX       = XMVectorReplicate(ballPos.x);
+    const XMVECTOR ballZ       = XMVectorReplicate(ballPos.z);
+    const XMVECTOR ballReachSq = XMVectorReplicate(hasBall ? ballReach * ballReach : -1.0f);
+
+    for (std::uint32_t i = 0; i < m_Count; i += kSimdWidth)
+    {
+        const XMVECTOR aliveMask = XMVectorGreater(Load4(m.alive, i), zero);
+        const XMVECTOR px = Load4(m.posX, i);
+        const XMVECTOR pz = Load4(m.posZ, i);
+
+        const XMVECTOR dx = XMVectorSubtract(px, ballX);
+        const XMVECTOR dz = XMVectorSubtract(pz, ballZ);
+        const XMVECTOR distSq = XMVectorMultiplyAdd(dx, dx, XMVectorMultiply(dz, dz));
+        const XMVECTOR ballHit = XMVectorAndInt(XMVectorLessOrEqual(distSq, ballReachSq), aliveMask);
+
+        XMVECTOR holeHit = XMVectorFalseInt();
+        for (const SwarmTarget& target : m_Targets)
+        {
+            const XMVECTOR inX = XMVectorLessOrEqual(
+                XMVectorAbs(XMVectorSubtract(px, XMVectorReplicate(target.centerX))),
+                XMVectorReplicate(target.halfX + kSwarmHalfExtent));
+            const XMVECTOR inZ = XMVectorLessOrEqual(
+                XMVectorAbs(XMVectorSubtract(pz, XMVectorReplicate(target.centerZ))),
+                XMVectorReplicate(target.halfZ + kSwarmHalfExtent));
+            holeHit = XMVectorOrInt(holeHit, XMVectorAndInt(inX, inZ));
+        }
+        holeHit = XMVectorAndInt(holeHit, aliveMask);
+
+        if (XMVector4EqualInt(XMVectorOrInt(ballHit, holeHit), XMVectorFalseInt()))
+            continue;
+
+        XMUINT4 ballLanes, holeLanes;
+        XMStoreUInt4(&ballLanes, ballHit);
+        XMStoreUInt4(&holeLanes, holeHit);
+        const std::uint32_t ballBits[kSimdWidth] = { ballLanes.x, ballLanes.y, ballLanes.z, ballLanes.w };
+        const std::uint32_t holeBits[kSimdWidth] = { holeLanes.x, holeLanes.y, holeLanes.z, holeLanes.w };
+
+        for (std::uint32_t lane = 0; lane < kSimdWidth; ++lane)
+        {
+            const std::uint32_t index = i + lane;
+            if (holeBits[lane])
+            {
+                // ホールに入ったら即座に死亡扱い
+                m.alive[index] = 0.0f;
+                HP::OnEnemyEnteredHole();
+            }
+            else if (ballBits[lane])
+            {
+                m.hp[index] -= 1;
+                HP::OnEnemyKilled();
+                if (m.hp[index] <= 0)
+                {
+                    m.alive[index] = 0.0f;
+                }
+            }
+        }
+    }
+}
+
+// - 死亡した添字へ末尾の敵を移して密に保つ（順序は保たない）
+void EnemySwarm::Compact()
+{
+    std::uint32_t i = 0;
+    while (i < m_Count)
+    {
+        if (m_Members.alive[i] > 0.0f)
+        {
+            ++i;
+            continue;
+        }
+
+        const std::uint32_t last = m_Count - 1;
+        if (i != last)
+        {
+            MoveMember(last, i);
+        }
+        ClearMember(last);
+        --m_Count;
+    }
+    ResizeArrays(m_Count);
+}
+
+// ------------------------------------------------------------------------------
+// 衝撃波の判定
+// ------------------------------------------------------------------------------
+// - 4 体ずつ距離の 2 乗を内半径・外半径と比べる（内半径が負なら中心も含む）
+// - 倒した敵は alive = 0 にするだけ。詰め直しは群れの Update で行う
+std::uint32_t EnemySwarm::KillInRing(const Vector3& center, float innerRadius, float outerRadius)
+{
+    if (s_Instance == nullptr || outerRadius < 0.0f)
+        return 0;
+
+    EnemySwarm& swarm = *s_Instance;
+    SwarmArrays& m = swarm.m_Members;
+
+    const XMVECTOR zero    = XMVectorZero();
+    const XMVECTOR centerX = XMVectorReplicate(center.x);
+    const XMVECTOR centerZ = XMVectorReplicate(center.z);
+    const XMVECTOR innerSq = XMVectorReplicate(innerRadius < 0.0f ? -1.0f : innerRadius * innerRadius);
+    const XMVECTOR outerSq = XMVectorReplicate(outerRadius * outerRadius);
+
+    std::uint32_t killed = 0;
+    for (std::uint32_t i = 0; i < swarm.m_Count; i += kSimdWidth)
+    {
+        const XMVECTOR dx = XMVectorSubtract(Load4(m.posX, i), centerX);
+        const XMVECTOR dz = XMVectorSubtract(Load4(m.posZ, i), centerZ);
+        const XMVECTOR distSq = XMVectorMultiplyAdd(dx, dx, XMVectorMultiply(dz, dz));
+
+        XMVECTOR hit = XMVectorAndInt(XMVectorGreater(distSq, innerSq), XMVectorLessOrEqual(distSq, outerSq));
+        hit = XMVectorAndInt(hit, XMVectorGreater(Load4(m.alive, i), zero));
+        if (XMVector4EqualInt(hit, XMVectorFalseInt()))
+            continue;
+
+        // 当たった添字の alive だけ 0 にする
+        const XMVECTOR remaining = XMVectorSelect(Load4(m.alive, i), zero, hit);
+        Store4(m.alive, i, remaining);
+
+        XMUINT4 lanes;
+        XMStoreUInt4(&lanes, hit);
+        killed += (lanes.x ? 1u : 0u) + (lanes.y ? 1u : 0u) + (lanes.z ? 1u : 0u) + (lanes.w ? 1u : 0u);
+    }
+    return killed;
+}
+
+std::uint32_t EnemySwarm::GetLiveCount()
+{
+    return s_Instance ? s_Instance->m_Count : 0;
+}
+
+// ------------------------------------------------------------------------------
+// 描画処理
+// ------------------------------------------------------------------------------
+// - 生存中の敵の位置・大きさをインスタンスバッファへ書き、1 回の描画呼び出しで描く
+void EnemySwarm::Draw()
+{
+    GameObject::Draw();
+
+    if (m_Count == 0 || !m_InstanceBuffer)
+        return;
+
+    RenderBackend& backend = Renderer::GetBackend();
+    auto* instances = static_cast<XMFLOAT4*>(backend.MapDiscard(m_InstanceBuffer));
+    if (!instances)
+        return;
+
+    const SwarmArrays& m = m_Members;
+    for (std::uint32_t i = 0; i < m_Count; ++i)
+    {
+        instances[i] = XMFLOAT4(m.posX[i], kSwarmHalfExtent, m.posZ[i], kSwarmEnemyScale);
+    }
+    backend.Unmap(m_InstanceBuffer, sizeof(XMFLOAT4) * m_Count);
+
+    m_Mesh.DrawInstanced(m_InstanceBuffer, sizeof(XMFLOAT4), m_Count);
+}
+
+// ------------------------------------------------------------------------------
+// スナップショット
+// ------------------------------------------------------------------------------
+// - 出現の端数・乱数の状態・数・生存中の敵の配列（パディングは含めない）を保存する
+// - 目標ホールは構成情報のため保存しない
+void EnemySwarm::WriteState(SnapshotWriter& writer) const
+{
+    GameObject::WriteState(writer);
+    writer.Write(m_SpawnAccumulator);
+    writer.Write(m_Random);
+    writer.Write(m_Count);
+
+    const std::uint32_t count = m_Count;
+    ForEachArray(m_Members, [&](const auto& values) {
+        writer.WriteBytes(values.data(), sizeof(values[0]) * count);
+    });
+}
+
+// - 容量は Init で確保済みなので、読み戻しで確保は起きない
+void EnemySwarm::ReadState(SnapshotReader& reader)
+{
+    GameObject::ReadState(reader);
+
+    std::uint32_t count = 0;
+    if (!reader.Read(m_SpawnAccumulator) || !reader.Read(m_Random) || !reader.Read(count))
+        return;
+
+    if (count > kCapacity)
+    {
+        reader.Fail();
+        return;
+    }
+
+    // パディングを 0 に戻すため、一度空にしてから伸ばす
+    ResizeArrays(0);
+    ResizeArrays(count);
+    m_Count = count;
+
+    ForEachArray(m_Members, [&](auto& values) {
+        reader.ReadBytes(values.data(), sizeof(values[0]) * count);
+    });
+}
+
+// ------------------------------------------------------------------------------
+// 配列操作
+// ------------------------------------------------------------------------------
+// - 長さは SIMD 幅の倍数。伸ばした分は 0（alive = 0）で埋まる
+void EnemySwarm::ResizeArrays(std::uint32_t count)
+{
+    const std::uint32_t padded = (count + kSimdWidth - 1) / kSimdWidth * kSimdWidth;
+    ForEachArray(m_Members, [padded](auto& values) { values.resize(padded); });
+}
+
+void EnemySwarm::MoveMember(std::uint32_t src, std::uint32_t dst)
+{
+    ForEachArray(m_Members, [src, dst](auto& values) { values[dst] = values[src]; });
+}
+
+void EnemySwarm::ClearMember(std::uint32_t index)
+{
+    ForEachArray(m_Members, [index](auto& values) { values[index] = 0; });
+}
+
+// - Camera と同じく、シーン直下から Ball を探す（見つかったらハンドルで持つ）
+Ball* EnemySwarm::FindBall()
+{
+    if (Ball* ball = m_Ball.Get())
+    {
+        return ball;
+    }
+
+    for (GameObject* obj : GameManager::GetGameObjects())
+    {
+        if (auto* ball = dynamic_cast<Ball*>(obj))
+        {
+            m_Ball = ObjectHandle<Ball>(ball);
+            return ball;
+        }
+    }
+    return nullptr;
+}
@@ -0,0 +1,189 @@
+﻿//------------------------------------------------------------------------------
+// EnemySwarm
+//------------------------------------------------------------------------------
+// 役割:
+// 大量（1 万体以上）の敵を、GameObject を使わずに配列（SoA）だけで管理する群れ。
+// 出現・移動・ボール / ホール / 衝撃波との当たり判定・描画をまとめて行う。
+//
+// 設計意図:
+// EnemyStraight は 1 体ごとに GameObject / MeshRenderer（頂点バッファ・シェーダー）/
+// ColliderGroup を持つため、数千体で Update・衝突ペア・描画呼び出しが支配的になる。
+// 群れの敵は「位置・速度・体力・目標・生存」だけを種類ごとの連続配列に持ち、
+//  - 進行方向の取得（FlowField）はジョブで並列に
+//  - 積分と当たり判定は 4 体ずつ SIMD で（分岐なし、当たった組だけスカラーで処理）
+//  - 描画はインスタンスバッファ 1 つ + DrawIndexedInstanced 1 回
+// で処理する。
+//
+// 構成:
+// - SwarmArrays    : 敵の状態の SoA 配列（SIMD 幅に合わせて末尾をパディング）
+// - SwarmTarget    : 目標ホール（位置・大きさ・フローフィールド番号のキャッシュ）
+// - Update         : 出現 → 方向取得 → 積分 → 当たり判定 → 死亡分の詰め直し
+// - KillInRing     : 衝撃波からの円環判定（ShockWave::SweepEnemies から呼ぶ）
+// - Draw           : インスタンスデータを書き込み、1 回の描画呼び出しで描く
+// - スナップショット : 出現タイマーと生存中の敵の配列を保存する
+//
+// NOTE:
+// - 出現は g_EnableEnemySwarm（デバッグキー F6）が有効な間だけ行う。既存の敵は無効化後も動き続ける
+// - 当たり判定は XZ 平面で行う（敵は床の上にしかいない）
+// - シーン内に 1 つだけ置く前提（s_Instance）。Field が FieldBuilder 経由で生成する
+// - メインスレッドから更新すること（IsParallelUpdateSafe は false のまま。HP などの static に触るため）
+//------------------------------------------------------------------------------
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "GameObject.h"
+#include "MeshRenderer.h"
+#include "Random.h"
+
+class Ball;
+class Hole;
+
+/// 群れの敵の状態（SoA）
+/// - 添字 i が 1 体を表す。末尾はパディング（SIMD 幅の倍数まで 0 埋め、alive = 0）
+struct SwarmArrays
+{
+    std::vector<float>         posX, posZ;     // 位置（ワールド XZ）
+    std::vector<float>         velX, velZ;     // 速度
+    std::vector<float>         alive;          // 1：生存 / 0：死亡（判定のマスクに使う）
+    std::vector<std::int32_t>  hp;             // 体力
+    std::vector<std::uint8_t>  target;         // 目標（m_Targets の添字）
+};
+
+/// SoA で管理する敵の群れ
+class EnemySwarm : public GameObject
+{
+public:
+    // ----------------------------------------------------------------------
+    // 定数
+    // ----------------------------------------------------------------------
+    static constexpr std::uint32_t kSimdWidth = 4;          // 一括処理の幅
+    static constexpr std::uint32_t kCapacity  = 16384;      // 最大数（配列はこの数まで事前確保する）
+
+    // ----------------------------------------------------------------------
+    // ライフサイクル
+    // ----------------------------------------------------------------------
+    /// 初期化
+    /// - 配列を最大数まで確保し、インスタンス描画用のメッシュ・シェーダー・バッファを作る
+    void Init() override;
+
+    /// 終了
+    /// - インスタンスバッファを解放し、s_Instance を外す
+    void Uninit() override;
+
+    /// 更新
+    /// - 出現 → 方向取得 → 積分 → 当たり判定 → 死亡分の詰め直し
+    void Update(float deltaTime) override;
+
+    /// 描画
+    /// - 生存中の敵を 1 回のインスタンス描画で描く
+    void Draw() override;
+
+    // ----------------------------------------------------------------------
+    // 設定（FieldBuilder から呼ぶ）
+    // ----------------------------------------------------------------------
+    /// スポーン範囲を設定（X は範囲内ランダム、Z は固定）
+    void SetSpawnArea(float xMin, float xMax, float z);
+
+    /// 目標のホールを追加する
+    /// NOTE: ハンドルで保持する。フローフィールド番号は更新時にホールから読み直す
+    void AddTargetHole(Hole* hole);
+
+    /// 乱数ストリームを設定（FieldBuilder が盤面のシードから分岐させて渡す）
+    void SetRandom(const Random& random) { m_Random = random; }
+
+    // ----------------------------------------------------------------------
+    // 判定・参照
+    // ----------------------------------------------------------------------
+    /// center からの距離が (innerRadius, outerRadius] の生存中の敵を倒す（XZ 平面）
+    /// 戻り値：倒した数（撃破扱いの通知は呼び出し側で行う）
+    /// - 群れが存在しない場合は 0
+    static std::uint32_t KillInRing(const Vector3& center, float innerRadius, float outerRadius);
+
+    /// 群れの現在数（群れが存在しない場合は 0）
+    static std::uint32_t GetLiveCount();
+
+    // ----------------------------------------------------------------------
+    // スナップショット
+    // ----------------------------------------------------------------------
+    void WriteState(SnapshotWriter& writer) const override;
+    void ReadState(SnapshotReader& reader) override;
+
+private:
+    /// 目標ホールのキャッシュ
+    struct SwarmTarget
+    {
+        ObjectHandle<Hole> hole;                    // 非所有：目標ホール
+        float centerX = 0.0f, centerZ = 0.0f;      // 中心（ワールド XZ）
+        float halfX = 0.0f, halfZ = 0.0f;          // 半分の大きさ（XZ）
+        int   flowField = -1;                      // フローフィールド番号
+    };
+
+    // ----------------------------------------------------------------------
+    // 調整パラメータ
+    // ----------------------------------------------------------------------
+    static constexpr float kSwarmSpawnPerSecond = 2000.0f;   // 1 秒あたりの出現数
+    static constexpr float kSwarmSpeed          = 3.0f;      // 移動速度
+    static constexpr float kSwarmEnemyScale     = 0.4f;      // 大きさ（ユニットボックスの一辺）
+    static constexpr float kSwarmHalfExtent     = kSwarmEnemyScale * 0.5f; // 判定用の半分の大きさ
+    static constexpr std::int32_t kSwarmEnemyHP = 1;         // 体力
+    static constexpr std::size_t kSteerGrain    = 1024;      // 方向取得ジョブ 1 つあたりの件数
+    inline static const XMFLOAT4 kSwarmColor    = XMFLOAT4(1.0f, 0.3f, 0.0f, 1.0f); // 色
+    static constexpr const char* kSwarmVertexShaderPath = "shader\\bin\\EnemySwarmVS.cso";
+    static constexpr const char* kSwarmPixelShaderPath  = "shader\\bin\\BaseLitPS.cso";
+
+    // ----------------------------------------------------------------------
+    // 更新の各段階
+    // ----------------------------------------------------------------------
+    /// 目標ホールの位置・大きさ・フローフィールド番号を読み直す
+    void RefreshTargets();
+
+    /// 出現タイマーを進め、溜まった分だけ出現させる
+    void SpawnMembers(float deltaTime);
+
+    /// [begin, end) の進行方向をフローフィールドから取得し、速度に反映する（ジョブから呼ぶ）
+    void SteerRange(std::size_t begin, std::size_t end);
+    static void SteerJob(void* data, std::size_t begin, std::size_t end);
+
+    /// 位置を積分する（4 体ずつ）
+    void Integrate(float deltaTime);
+
+    /// ボール・ホールとの当たり判定（4 体ずつ。当たった組だけスカラーで処理する）
+    void TestTriggers();
+
+    /// 死亡した敵を末尾の敵で埋めて詰める
+    void Compact();
+
+    /// 配列の長さを count 以上の SIMD 幅の倍数にする（容量内なので確保は起きない）
+    void ResizeArrays(std::uint32_t count);
+
+    /// src の敵を dst へ移す
+    void MoveMember(std::uint32_t src, std::uint32_t dst);
+
+    /// index の敵を 0 埋めする（パディング扱いにする）
+    void ClearMember(std::uint32_t index);
+
+    /// ボールを探す（見つかったらハンドルで保持する）
+    Ball* FindBall();
+
+    // ----------------------------------------------------------------------
+    // 状態
+    // ----------------------------------------------------------------------
+    SwarmArrays              m_Members;                 // 敵の状態
+    std::uint32_t            m_Count = 0;               // 生存中（詰め直し前は死亡を含む）の数
+    std::vector<SwarmTarget> m_Targets;                 // 目標ホール
+    float                    m_SpawnXMin = 0.0f;        // スポーン範囲（X 最小）
+    float                    m_SpawnXMax = 0.0f;        // スポーン範囲（X 最大）
+    float                    m_SpawnZ    = 0.0f;        // スポーン Z 座標
+    float                    m_SpawnAccumulator = 0.0f; // 出現待ちの端数
+    Random                   m_Random;                  // 出現位置・目標選択用の乱数
+    ObjectHandle<Ball>       m_Ball;                    // 非所有：当たり判定の相手
+
+    // ----------------------------------------------------------------------
+    // 描画
+    // ----------------------------------------------------------------------
+    MeshRenderer  m_Mesh;                       // ユニットボックス + インスタンス描画用シェーダー（Component としては登録しない）
+    GpuBuffer*    m_InstanceBuffer = nullptr;   // 所有：インスタンスデータ（XMFLOAT4 × kCapacity）
+
+    static EnemySwarm* s_Instance;              // シーン内の群れ
+};
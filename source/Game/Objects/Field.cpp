@@ -7,6 +7,7 @@
 // コンポーネント関連
 #include "MeshRenderer.h"
 #include "ColliderGroup.h"
+#include "StaticBatch.h"
 #include "BoxCollider.h"
 
 // フィールドオブジェクト
@@ -14,6 +15,7 @@
 #include "Bumper.h"
 #include "Hole.h"
 #include "EnemySpawner.h"
+#include "FlowField.h"
 
 //------------------------------------------------------------------------------
 // Field
@@ -74,6 +76,16 @@ FieldLayout Field::MakeStage01Layout()
 
     layout.spawners.push_back(spawner);
 
+    // 群れは通常の敵と同じ範囲から出現し、同じ Hole を目指す（出現はデバッグキーで有効化）
+    SwarmDesc swarm;
+    swarm.position = { 0.0f, 0.0f, 0.0f };
+    swarm.spawnZ = spawner.spawnZ;
+    swarm.spawnXMin = spawner.spawnXMin;
+    swarm.spawnXMax = spawner.spawnXMax;
+    swarm.targetHoleIds = { kMainHoleId };
+
+    layout.swarms.push_back(swarm);
+
     return layout;
 }
 
@@ -119,6 +131,14 @@ void Field::Init()
     const float yCenter = kWallHeight * 0.5f;
     const XMFLOAT4 kWallColor = XMFLOAT4(0.8f, 0.8f, 0.85f, 1.0f);
 
+    // 壁/ガイドは StaticBatch の候補にする（当たり判定は子ごとに残す）
+    // BaseLit にはインスタンス描画版の VS があるので取り込まれず、RenderQueue のインスタンス描画で 1 回にまとまる
+    // （インスタンス描画版の無いシェーダーに替えた場合だけ結合される）
+    m_StaticBatch = AddComponent<StaticBatch>();
+
+    // 敵の経路計算に使う静的な障害物（壁・ガイド・バンパー）
+    std::vector<GameObject*> navObstacles;
+
     // 1枚の壁を生成する簡易ヘルパー
     auto MakeWall = [&](const Vector3& position, const Vector3& scale)
     {
@@ -133,10 +153,13 @@ void Field::Init()
         wallMesh->SetTexture(kWallTexturePath);
         wallMesh->CreateUnitBox();
         wallMesh->m_Color = kWallColor;
+        m_StaticBatch->Add(wallMesh);
 
         // 当たり判定（Center/Size は Transform から算出される想定）
         auto wallColliderGroup = wallObj->AddComponent<ColliderGroup>();
         wallColliderGroup->AddCollider<BoxCollider>();
+
+        navObstacles.push_back(wallObj);
     };
 
     // 壁の作成
@@ -176,10 +199,13 @@ void Field::Init()
         guideMesh->SetTexture(kWallTexturePath);
         guideMesh->CreateUnitBox();
         guideMesh->m_Color = kGuideColor;  // 壁より少し明るめ
+        m_StaticBatch->Add(guideMesh);
 
         // 当たり判定（Transform から自動反映）
         auto colGroup = guideObj->AddComponent<ColliderGroup>();
         colGroup->AddCollider<BoxCollider>();
+
+        navObstacles.push_back(guideObj);
     };
 
     // ガイドの位置
@@ -193,6 +219,9 @@ void Field::Init()
     // 右ガイド（内側へ向ける）
     MakeGuide({ +guideX, guideY, guideZ }, -kGuideRotationDeg);
 
+    // 壁/ガイドがそろったので、インスタンス描画できないものだけを結合する
+    m_StaticBatch->Build();
+
     // ガイドの下に、更にコライダーのみを追加（ボールが潜り抜けないようにするため）
     constexpr float kGuideColliderLength = 10.0f;
     constexpr float kGuideColliderZOffset = 2.5f;
@@ -208,6 +237,8 @@ void Field::Init()
         // 当たり判定（Transform から自動反映）
         auto colGroup = guideObj->AddComponent<ColliderGroup>();
         colGroup->AddCollider<BoxCollider>();
+
+        navObstacles.push_back(guideObj);
     };
 
     // ガイドの位置
@@ -226,8 +257,28 @@ void Field::Init()
     // - レイアウト定義に従って子オブジェクトを生成する
     // - Build 内で参照接続と Init を行う（Build 後に即プレイ可能な状態を想定）
     FieldLayout layout = MakeStage01Layout();
+    layout.seed = m_Seed;
     FieldBuilder builder;
     m_Level = builder.Build(*this, layout);
+
+    // ----------------------------------------------------------------------
+    // 敵の経路（フローフィールド）の計算
+    // ----------------------------------------------------------------------
+    // - レイアウトが決まった時点で 1 回だけ計算する（Flipper は動くので障害物にしない）
+    // - Hole ごとにフィールドを作り、番号を Hole に持たせる（Spawner が敵へ渡す）
+    // NOTE: Bumper のコライダーは Build 内の Init で作られるので、Build の後に行う
+    for (Bumper* bumper : m_Level.bumpers)
+    {
+        navObstacles.push_back(bumper);
+    }
+
+    FlowField::Clear();
+    FlowField::SetLayout(-kHalfWidth, -kHalfHeight, kHalfWidth, kHalfHeight, navObstacles);
+    for (const auto& pair : m_Level.holesById)
+    {
+        Hole* hole = pair.second;
+        hole->SetFlowField(FlowField::AddTarget(hole->m_Transform.GetWorldPosition(), hole->m_Transform.Scale));
+    }
 }
 
 void Field::Uninit()
@@ -237,7 +288,11 @@ void Field::Uninit()
     // ----------------------------------------------------------------------
     // コンポーネントの参照をクリア
     m_Floor = nullptr;
+    m_StaticBatch = nullptr;
     m_ColliderGroup = nullptr;
+
+    // 経路はこのフィールドのレイアウトから作ったものなので破棄する
+    FlowField::Clear();
 }
 
 void Field::Update(float deltaTime)
@@ -22,6 +22,7 @@
 // 前方宣言
 class MeshRenderer;
 class ColliderGroup;
+class StaticBatch;
 
 //------------------------------------------------------------------------------
 // Field
@@ -44,13 +45,15 @@ public:
     // ライフサイクルメソッド
     // ----------------------------------------------------------------------
     /// 初期化処理
-    /// - 床/壁（環境）を生成する
+    /// - 床/壁（環境）を生成する（壁/ガイドは StaticBatch の候補にし、当たり判定は子に残す）
     /// - FieldLayout を作成し、FieldBuilder により子オブジェクトを生成する
+    /// - 静的な障害物（壁/ガイド/バンパー）から、Hole ごとの FlowField を計算する
     /// 注意：FieldBuilder::Build は生成後に各オブジェクトの Init を呼び出す
     void Init() override;
 
     /// 終了処理
     /// - 参照ポインタを無効化する（所有しているリソースの解放は GameObject 側に従う）
+    /// - FlowField を破棄する
     void Uninit() override;
 
     /// 更新処理
@@ -61,6 +64,13 @@ public:
     /// - 現状は基底クラスの描画（子の描画）に委譲する
     void Draw() override;
 
+    // ----------------------------------------------------------------------
+    // 設定
+    // ----------------------------------------------------------------------
+    /// 乱数シードを設定する（Init より前に呼ぶこと）
+    /// - 敵の出現位置・目標の選択はこのシードから決まる（同じシードなら同じ盤面になる）
+    void SetSeed(std::uint64_t seed) { m_Seed = seed; }
+
 private:
     // ----------------------------------------------------------------------
     // レイアウト作成
@@ -89,6 +99,8 @@ private:
     // コンポーネントの参照ポインタ
     // ----------------------------------------------------------------------
     MeshRenderer*  m_Floor = nullptr;         // 非所有：床メッシュ描画（Init で設定 / Uninit で無効化）
+    StaticBatch*   m_StaticBatch = nullptr;   // 非所有：壁/ガイドのうちインスタンス描画できないものを結合した描画（Init で設定 / Uninit で無効化）
     ColliderGroup* m_ColliderGroup = nullptr; // 非所有：床/壁の当たり判定（Init で設定 / Uninit で無効化）
     LevelObjects   m_Level;                   // 非所有：生成済みレベルオブジェクト参照の集合
+    std::uint64_t  m_Seed = Random::kDefaultSeed; // 乱数シード
 };
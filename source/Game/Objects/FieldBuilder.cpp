@@ -4,6 +4,7 @@
 
 #include "Bumper.h"
 #include "EnemySpawner.h"
+#include "EnemySwarm.h"
 #include "Field.h"
 #include "Flipper.h"
 #include "Hole.h"
@@ -12,10 +13,12 @@
 // レイアウト定義からフィールドを構築する
 // ----------------------------------------------------------------------
 // - レイアウト順に生成し参照を保持する
+// - 乱数はシードから生成順に分岐させる（同じレイアウト・シードなら同じ系列になる）
 // - 生成後に参照接続と Init を行う
 LevelObjects FieldBuilder::Build(Field& field, const FieldLayout& layout)
 {
     LevelObjects out;
+    Random random(layout.seed);
 
     for (const auto& holeDesc : layout.holes)
     {
@@ -34,7 +37,12 @@ LevelObjects FieldBuilder::Build(Field& field, const FieldLayout& layout)
 
     for (const auto& spawnerDesc : layout.spawners)
     {
-        CreateSpawner(field, spawnerDesc, out);
+        CreateSpawner(field, spawnerDesc, random, out);
+    }
+
+    for (const auto& swarmDesc : layout.swarms)
+    {
+        CreateSwarm(field, swarmDesc, random, out);
     }
 
     WireUp(out, layout);
@@ -93,19 +101,37 @@ Bumper* FieldBuilder::CreateBumper(Field& field, const BumperDesc& desc, LevelOb
 // ----------------------------------------------------------------------
 // - Transform::Position を設定する
 // - スポーン範囲を設定する
-EnemySpawner* FieldBuilder::CreateSpawner(Field& field, const SpawnerDesc& desc, LevelObjects& out)
+// - 乱数ストリームを分岐させて渡す
+EnemySpawner* FieldBuilder::CreateSpawner(Field& field, const SpawnerDesc& desc, Random& random, LevelObjects& out)
 {
     EnemySpawner* spawner = field.CreateChild<EnemySpawner>();
     spawner->m_Transform.Position = desc.position;
     spawner->SetSpawnArea(desc.spawnXMin, desc.spawnXMax, desc.spawnZ);
+    spawner->SetRandom(random.Split());
     out.spawners.push_back(spawner);
     return spawner;
 }
 
+// ----------------------------------------------------------------------
+// EnemySwarm の生成
+// ----------------------------------------------------------------------
+// - Transform::Position を設定する
+// - スポーン範囲を設定する
+// - 乱数ストリームを分岐させて渡す
+EnemySwarm* FieldBuilder::CreateSwarm(Field& field, const SwarmDesc& desc, Random& random, LevelObjects& out)
+{
+    EnemySwarm* swarm = field.CreateChild<EnemySwarm>();
+    swarm->m_Transform.Position = desc.position;
+    swarm->SetSpawnArea(desc.spawnXMin, desc.spawnXMax, desc.spawnZ);
+    swarm->SetRandom(random.Split());
+    out.swarms.push_back(swarm);
+    return swarm;
+}
+
 // ----------------------------------------------------------------------
 // 参照関係の接続
 // ----------------------------------------------------------------------
-// - EnemySpawner に TargetHole を関連付ける
+// - EnemySpawner / EnemySwarm に TargetHole を関連付ける
 // - レイアウト上の targetHoleIds を Hole ID マップから解決する
 // 注意：
 // - 不正な Hole ID が指定されている場合はアサートで停止する
@@ -130,6 +156,26 @@ void FieldBuilder::WireUp(LevelObjects& out, const FieldLayout& layout)
             spawner->AddTargetHole(it->second);
         }
     }
+
+    assert(out.swarms.size() == layout.swarms.size());
+
+    for (size_t i = 0; i < layout.swarms.size(); ++i)
+    {
+        EnemySwarm* swarm = out.swarms[i];
+        const SwarmDesc& desc = layout.swarms[i];
+
+        for (const auto& holeId : desc.targetHoleIds)
+        {
+            auto it = out.holesById.find(holeId);
+            if (it == out.holesById.end())
+            {
+                assert(false && "Unknown hole id.");
+                continue;
+            }
+
+            swarm->AddTargetHole(it->second);
+        }
+    }
 }
 
 // ----------------------------------------------------------------------
@@ -158,4 +204,9 @@ void FieldBuilder::InitAll(LevelObjects& out)
     {
         spawner->Init();
     }
+
+    for (EnemySwarm* swarm : out.swarms)
+    {
+        swarm->Init();
+    }
 }
\ No newline at end of file
@@ -25,11 +25,13 @@
 #include <vector>
 
 #include "FieldLayout.h"
+#include "Random.h"
 
 // 前方宣言
 class Field;
 class Hole;
 class EnemySpawner;
+class EnemySwarm;
 class Flipper;
 class Bumper;
 
@@ -38,12 +40,13 @@ struct LevelObjects
 {
     std::unordered_map<std::string, Hole*> holesById;
     std::vector<EnemySpawner*> spawners;
+    std::vector<EnemySwarm*> swarms;
     std::vector<Flipper*> flippers;
     std::vector<Bumper*> bumpers;
 };
 
 /// フィールドレイアウト定義から、ゲーム内オブジェクトを構築するビルダークラス
-/// - Field をルートとして、各 GameObject（Hole / Flipper / Bumper / EnemySpawner）を生成する
+/// - Field をルートとして、各 GameObject（Hole / Flipper / Bumper / EnemySpawner / EnemySwarm）を生成する
 /// - 生成順は FieldLayout に記述された配列順に従う
 /// - 生成後にオブジェクト間の参照関係を接続し、最後に Init を明示的に呼び出す
 /// 注意：
@@ -57,7 +60,8 @@ public:
     // ----------------------------------------------------------------------
     /// レイアウト定義からフィールド内オブジェクトを生成する
     /// - Field を親として子 GameObject を生成する
-    /// - 生成順：Hole → Flipper → Bumper → EnemySpawner
+    /// - 生成順：Hole → Flipper → Bumper → EnemySpawner → EnemySwarm
+    /// - layout.seed から乱数ストリームを生成順に分岐させ、EnemySpawner / EnemySwarm へ配る
     /// - 生成後に参照関係を接続し、すべてのオブジェクトに Init を呼び出す
     /// 戻り値：
     /// - 生成された各オブジェクトへの非所有参照をまとめた構造体
@@ -85,14 +89,19 @@ private:
 
     /// EnemySpawner を生成して登録する
     /// - Transform::Position を設定する
-    /// - スポーン範囲（XMin / XMax / Z）を設定する
-    EnemySpawner* CreateSpawner(Field& field, const SpawnerDesc& desc, LevelObjects& out);
+    /// - スポーン範囲（XMin / XMax / Z）と乱数ストリームを設定する
+    EnemySpawner* CreateSpawner(Field& field, const SpawnerDesc& desc, Random& random, LevelObjects& out);
+
+    /// EnemySwarm を生成して登録する
+    /// - Transform::Position を設定する
+    /// - スポーン範囲（XMin / XMax / Z）と乱数ストリームを設定する
+    EnemySwarm* CreateSwarm(Field& field, const SwarmDesc& desc, Random& random, LevelObjects& out);
 
     // ----------------------------------------------------------------------
     // 生成後処理
     // ----------------------------------------------------------------------
     /// 生成済みオブジェクト間の参照関係を接続する
-    /// - EnemySpawner に TargetHole を関連付ける
+    /// - EnemySpawner / EnemySwarm に TargetHole を関連付ける
     /// 注意：
     /// - レイアウトと生成結果の配列順が一致していることを前提とする
     void WireUp(LevelObjects& out, const FieldLayout& layout);
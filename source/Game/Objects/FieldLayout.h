@@ -15,6 +15,7 @@
 //------------------------------------------------------------------------------
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -57,6 +58,18 @@ struct SpawnerDesc
     std::vector<std::string> targetHoleIds; // 対象 Hole の ID 一覧
 };
 
+/// EnemySwarm の配置・接続定義
+/// - スポーン範囲は群れの配置位置基準（SpawnerDesc と同じ）
+/// - targetHoleIds により、群れが目指す Hole を指定する
+struct SwarmDesc
+{
+    Vector3 position;                    // 配置位置
+    float spawnXMin = 0.0f;              // スポーン範囲（X 最小）
+    float spawnXMax = 0.0f;              // スポーン範囲（X 最大）
+    float spawnZ = 0.0f;                 // スポーン Z 座標
+    std::vector<std::string> targetHoleIds; // 対象 Hole の ID 一覧
+};
+
 /// フィールド構成を定義するデータ構造
 /// - 実体の生成は行わず、配置・接続情報のみを保持する
 /// - FieldBuilder によって解釈・構築される
@@ -66,4 +79,6 @@ struct FieldLayout
     std::vector<BumperDesc> bumpers;   // Bumper 定義一覧
     std::vector<HoleDesc> holes;       // Hole 定義一覧
     std::vector<SpawnerDesc> spawners; // EnemySpawner 定義一覧
+    std::vector<SwarmDesc> swarms;     // EnemySwarm 定義一覧（シーン内に 1 つまで）
+    std::uint64_t seed = 0;            // 乱数シード（FieldBuilder が各 Spawner / Swarm へストリームを分岐して配る）
 };
\ No newline at end of file
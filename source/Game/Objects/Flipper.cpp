@@ -1,4 +1,5 @@
-﻿#include "Flipper.h"
+﻿#include "main.h"
+#include "Flipper.h"
 #include "Input.h"
 
 // コンポーネント
@@ -6,6 +7,7 @@
 #include "ColliderGroup.h"
 #include "MeshRenderer.h"
 #include "RigidBody.h"
+#include "Snapshot.h"
 
 Flipper::Flipper(Side side)
     : m_Side(side)
@@ -78,7 +80,7 @@ void Flipper::Update(float deltaTime)
     const float prevDeg = m_Transform.Rotation.y;
 
     // キー入力取得
-    const BYTE key     = GetActiveKey();
+    const std::uint8_t key = GetActiveKey();
     const bool isPress = Input::GetKeyPress(key);
 
     // 目標角度（度数）
@@ -136,8 +138,22 @@ void Flipper::Uninit()
     m_ArmObject = nullptr;
 }
 
+// スナップショット書き出し
+void Flipper::WriteState(SnapshotWriter& writer) const
+{
+    GameObject::WriteState(writer);
+    writer.Write(m_AngularVelDegPerSec);
+}
+
+// スナップショット読み戻し
+void Flipper::ReadState(SnapshotReader& reader)
+{
+    GameObject::ReadState(reader);
+    reader.Read(m_AngularVelDegPerSec);
+}
+
 // 動作キー取得
-BYTE Flipper::GetActiveKey() const
+std::uint8_t Flipper::GetActiveKey() const
 {
     if (m_Side == Side::Left)
     {
@@ -164,7 +180,7 @@ void Flipper::OnCollisionStay(const CollisionInfo& info)
     if (!rb) return;
 
     // フリッパーを動かしているときだけ「弾く」
-    const BYTE key     = GetActiveKey();
+    const std::uint8_t key = GetActiveKey();
     const bool isPress = Input::GetKeyPress(key);
     if (!isPress) return;
 
@@ -201,5 +217,5 @@ void Flipper::OnCollisionStay(const CollisionInfo& info)
     Vector3 newVel = n * kFlipperHorizontalSpeed;
     newVel.y = kFlipperUpSpeed;
 
-    rb->m_Velocity = newVel;
+    rb->SetVelocity(newVel);
 }
@@ -2,6 +2,7 @@
 
 #include "GameObject.h"
 #include "Vector3.h"
+#include <cstdint>
 
 class CollliderGroup;
 class MeshRenderer;
@@ -48,6 +49,13 @@ public:
     /// </summary>
     void OnCollisionStay(const CollisionInfo& info) override;
 
+    /// <summary>
+    /// スナップショット
+    /// 角度は Transform（回転）として保存されるため、角速度のみ追加する
+    /// </summary>
+    void WriteState(SnapshotWriter& writer) const override;
+    void ReadState(SnapshotReader& reader) override;
+
 private:
     // ----------------------------------------------------------------------
     // 定数定義
@@ -86,5 +94,5 @@ private:
     static constexpr const char* PixelShaderPath  =                 // ピクセルシェーダのパス
         "shader\\bin\\BaseLitPS.cso";   
     
-    BYTE GetActiveKey() const;                                      // 動作キー取得
+    std::uint8_t GetActiveKey() const;                              // 動作キー取得（仮想キーコード）
 };  
\ No newline at end of file
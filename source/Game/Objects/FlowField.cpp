@@ -0,0 +1,348 @@
+﻿#include "main.h"
+#include "FlowField.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <functional>
+#include <queue>
+#include <utility>
+
+#include "GameObject.h"
+#include "ColliderGroup.h"
+#include "BoxCollider.h"
+#include "SphereCollider.h"
+
+// 静的メンバ変数の定義
+float                     FlowField::s_OriginX = 0.0f;
+float                     FlowField::s_OriginZ = 0.0f;
+int                       FlowField::s_CellsX  = 0;
+int                       FlowField::s_CellsZ  = 0;
+std::vector<std::uint8_t> FlowField::s_Blocked;
+std::vector<FlowField::Target> FlowField::s_Targets;
+
+namespace
+{
+    /// 隣接 8 方向（斜めは 2 つの直交方向がどちらも空いている場合のみ通れる）
+    struct Neighbor
+    {
+        int   dx;
+        int   dz;
+        float cost;     // 移動コスト（セル数）
+        float dirX;     // 正規化済み方向
+        float dirZ;
+    };
+
+    constexpr float kDiagonal    = 1.41421356f;
+    constexpr float kInvDiagonal = 0.70710678f;
+
+    constexpr Neighbor kNeighbors[8] =
+    {
+        {  1,  0, 1.0f,       1.0f,          0.0f },
+        { -1,  0, 1.0f,      -1.0f,          0.0f },
+        {  0,  1, 1.0f,       0.0f,          1.0f },
+        {  0, -1, 1.0f,       0.0f,         -1.0f },
+        {  1,  1, kDiagonal,  kInvDiagonal,  kInvDiagonal },
+        { -1,  1, kDiagonal, -kInvDiagonal,  kInvDiagonal },
+        {  1, -1, kDiagonal,  kInvDiagonal, -kInvDiagonal },
+        { -1, -1, kDiagonal, -kInvDiagonal, -kInvDiagonal },
+    };
+
+    /// ターゲット中心への直線方向（XZ 平面）
+    Vector3 DirectTo(const Vector3& center, const Vector3& worldPos)
+    {
+        const Vector3 dir = { center.x - worldPos.x, 0.0f, center.z - worldPos.z };
+        if (dir.LengthSq() < 1e-6f)
+        {
+            return Vector3{ 0.0f, 0.0f, 0.0f };
+        }
+        return dir.NormalizeSafe();
+    }
+}
+
+// ------------------------------------------------------------------------------
+// 構築
+// ------------------------------------------------------------------------------
+// - 範囲をセルに分割し、障害物セルを塗ってから全ターゲットを作り直す
+void FlowField::SetLayout(float minX, float minZ, float maxX, float maxZ, const std::vector<GameObject*>& obstacles)
+{
+    s_OriginX = minX;
+    s_OriginZ = minZ;
+    s_CellsX  = std::max(1, static_cast<int>(std::ceil((maxX - minX) / kCellSize)));
+    s_CellsZ  = std::max(1, static_cast<int>(std::ceil((maxZ - minZ) / kCellSize)));
+    s_Blocked.assign(static_cast<std::size_t>(s_CellsX) * s_CellsZ, 0);
+
+    for (GameObject* obstacle : obstacles)
+    {
+        RasterizeObstacle(obstacle);
+    }
+    DilateBlocked();
+
+    for (Target& target : s_Targets)
+    {
+        BuildTarget(target);
+    }
+}
+
+int FlowField::AddTarget(const Vector3& center, const Vector3& size)
+{
+    Target target;
+    target.center = center;
+    target.size   = size;
+    BuildTarget(target);
+
+    s_Targets.push_back(std::move(target));
+    return static_cast<int>(s_Targets.size()) - 1;
+}
+
+void FlowField::Clear()
+{
+    s_Targets.clear();
+    s_Blocked.clear();
+    s_CellsX = 0;
+    s_CellsZ = 0;
+}
+
+// ------------------------------------------------------------------------------
+// 参照
+// ------------------------------------------------------------------------------
+// - セルの方向を引く。到達点・経路なし・範囲外はターゲットへ直進する
+Vector3 FlowField::Sample(int field, const Vector3& worldPos)
+{
+    if (field < 0 || field >= static_cast<int>(s_Targets.size()))
+    {
+        return Vector3{ 0.0f, 0.0f, 0.0f };
+    }
+
+    const Target& target = s_Targets[field];
+
+    const float fx = std::floor((worldPos.x - s_OriginX) / kCellSize);
+    const float fz = std::floor((worldPos.z - s_OriginZ) / kCellSize);
+    if (fx < 0.0f || fz < 0.0f || fx >= static_cast<float>(s_CellsX) || fz >= static_cast<float>(s_CellsZ))
+    {
+        return DirectTo(target.center, worldPos);
+    }
+
+    const std::uint8_t dir = target.flow[static_cast<int>(fz) * s_CellsX + static_cast<int>(fx)];
+    if (dir == kNoDirection)
+    {
+        return DirectTo(target.center, worldPos);
+    }
+
+    return Vector3{ kNeighbors[dir].dirX, 0.0f, kNeighbors[dir].dirZ };
+}
+
+// ------------------------------------------------------------------------------
+// 障害物
+// ------------------------------------------------------------------------------
+// - BoxCollider：ワールド AABB に掛かるセルの中心をボックスのローカルへ戻し、内側なら塞ぐ
+//   （回転したガイドを AABB のまま塞ぐと通路まで埋まるため）
+// - SphereCollider：中心からの距離で判定する
+void FlowField::RasterizeObstacle(GameObject* obstacle)
+{
+    if (!obstacle)
+        return;
+
+    auto* group = obstacle->GetComponent<ColliderGroup>();
+    if (!group)
+        return;
+
+    FrameVector<Collider*> colliders;
+    group->CollectColliders(colliders);
+
+    for (Collider* collider : colliders)
+    {
+        if (collider->m_IsTrigger)
+            continue;
+
+        int x0 = 0, x1 = -1, z0 = 0, z1 = -1;
+
+        if (auto* box = dynamic_cast<BoxCollider*>(collider))
+        {
+            Vector3 aabbMin, aabbMax;
+            box->GetWorldAABB(aabbMin, aabbMax);
+            x0 = ToCellX(aabbMin.x); x1 = ToCellX(aabbMax.x);
+            z0 = ToCellZ(aabbMin.z); z1 = ToCellZ(aabbMax.z);
+
+            const XMMATRIX invWorld = XMMatrixInverse(nullptr, box->GetWorldMatrix());
+            const float centerY = box->GetWorldPosition().y;
+
+            for (int cz = z0; cz <= z1; ++cz)
+            {
+                for (int cx = x0; cx <= x1; ++cx)
+                {
+                    XMFLOAT3 local{};
+                    XMStoreFloat3(&local, XMVector3TransformCoord(
+                        XMVectorSet(CellCenterX(cx), centerY, CellCenterZ(cz), 1.0f), invWorld));
+
+                    if (std::fabs(local.x) <= 0.5f && std::fabs(local.z) <= 0.5f)
+                    {
+                        s_Blocked[cz * s_CellsX + cx] = 1;
+                    }
+                }
+            }
+        }
+        else if (auto* sphere = dynamic_cast<SphereCollider*>(collider))
+        {
+            const Vector3 center = sphere->GetWorldPosition();
+            const float radius = sphere->m_radius;
+            x0 = ToCellX(center.x - radius); x1 = ToCellX(center.x + radius);
+            z0 = ToCellZ(center.z - radius); z1 = ToCellZ(center.z + radius);
+
+            for (int cz = z0; cz <= z1; ++cz)
+            {
+                for (int cx = x0; cx <= x1; ++cx)
+                {
+                    const float dx = CellCenterX(cx) - center.x;
+                    const float dz = CellCenterZ(cz) - center.z;
+                    if (dx * dx + dz * dz <= radius * radius)
+                    {
+                        s_Blocked[cz * s_CellsX + cx] = 1;
+                    }
+                }
+            }
+        }
+    }
+}
+
+// - 敵は大きさを持つので、塞いだセルの周囲 kClearanceCells も通さない
+void FlowField::DilateBlocked()
+{
+    const std::vector<std::uint8_t> source = s_Blocked;
+
+    for (int cz = 0; cz < s_CellsZ; ++cz)
+    {
+        for (int cx = 0; cx < s_CellsX; ++cx)
+        {
+            if (!source[cz * s_CellsX + cx])
+                continue;
+
+            const int zBegin = std::max(0, cz - kClearanceCells);
+            const int zEnd   = std::min(s_CellsZ - 1, cz + kClearanceCells);
+            const int xBegin = std::max(0, cx - kClearanceCells);
+            const int xEnd   = std::min(s_CellsX - 1, cx + kClearanceCells);
+            for (int z = zBegin; z <= zEnd; ++z)
+            {
+                for (int x = xBegin; x <= xEnd; ++x)
+                {
+                    s_Blocked[z * s_CellsX + x] = 1;
+                }
+            }
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------
+// 距離場・方向場
+// ------------------------------------------------------------------------------
+// - ターゲットの XZ 範囲に掛かるセルを到達点（距離 0）にする
+//   範囲外のターゲット（壁際の Hole など）は端のセルへ寄せ、障害物でも到達点を優先する
+// - 到達点から Dijkstra で距離を広げる（障害物セルへは入らない）
+// - 各セルの方向は「距離が最も小さい隣接セル」へ向ける
+//   障害物セル（余白を含む）にいる敵も、空いている隣接セルへ押し出されるように方向を持たせる
+void FlowField::BuildTarget(Target& target)
+{
+    const int cellCount = s_CellsX * s_CellsZ;
+    target.flow.assign(static_cast<std::size_t>(cellCount), kNoDirection);
+    if (cellCount == 0)
+        return;
+
+    std::vector<float> distance(static_cast<std::size_t>(cellCount), FLT_MAX);
+
+    using QueueEntry = std::pair<float, int>;
+    std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry>> open;
+
+    const float halfX = target.size.x * 0.5f;
+    const float halfZ = target.size.z * 0.5f;
+    for (int cz = ToCellZ(target.center.z - halfZ); cz <= ToCellZ(target.center.z + halfZ); ++cz)
+    {
+        for (int cx = ToCellX(target.center.x - halfX); cx <= ToCellX(target.center.x + halfX); ++cx)
+        {
+            const int cell = cz * s_CellsX + cx;
+            distance[cell] = 0.0f;
+            open.push({ 0.0f, cell });
+        }
+    }
+
+    auto isOpen = [&](int cx, int cz)
+    {
+        if (cx < 0 || cz < 0 || cx >= s_CellsX || cz >= s_CellsZ)
+            return false;
+        const int cell = cz * s_CellsX + cx;
+        return !s_Blocked[cell] || distance[cell] == 0.0f;
+    };
+
+    while (!open.empty())
+    {
+        const auto [cost, cell] = open.top();
+        open.pop();
+        if (cost > distance[cell])
+            continue;
+
+        const int cx = cell % s_CellsX;
+        const int cz = cell / s_CellsX;
+        for (const Neighbor& neighbor : kNeighbors)
+        {
+            const int nx = cx + neighbor.dx;
+            const int nz = cz + neighbor.dz;
+            if (!isOpen(nx, nz))
+                continue;
+            if (neighbor.dx != 0 && neighbor.dz != 0 && (!isOpen(cx + neighbor.dx, cz) || !isOpen(cx, cz + neighbor.dz)))
+                continue;
+
+            const int next = nz * s_CellsX + nx;
+            const float nextCost = cost + neighbor.cost;
+            if (nextCost < distance[next])
+            {
+                distance[next] = nextCost;
+                open.push({ nextCost, next });
+            }
+        }
+    }
+
+    for (int cz = 0; cz < s_CellsZ; ++cz)
+    {
+        for (int cx = 0; cx < s_CellsX; ++cx)
+        {
+            const int cell = cz * s_CellsX + cx;
+            if (distance[cell] == 0.0f)
+                continue;
+
+            const bool blocked = (s_Blocked[cell] != 0);
+            float best = blocked ? FLT_MAX : distance[cell];
+            for (std::uint8_t i = 0; i < 8; ++i)
+            {
+                const Neighbor& neighbor = kNeighbors[i];
+                const int nx = cx + neighbor.dx;
+                const int nz = cz + neighbor.dz;
+                if (nx < 0 || nz < 0 || nx >= s_CellsX || nz >= s_CellsZ)
+                    continue;
+                if (!blocked && neighbor.dx != 0 && neighbor.dz != 0 && (!isOpen(cx + neighbor.dx, cz) || !isOpen(cx, cz + neighbor.dz)))
+                    continue;
+
+                const float d = distance[nz * s_CellsX + nx];
+                if (d < best)
+                {
+                    best = d;
+                    target.flow[cell] = i;
+                }
+            }
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------
+// セル
+// ------------------------------------------------------------------------------
+// - 範囲外は端のセルへ寄せる
+int FlowField::ToCellX(float x)
+{
+    const int cx = static_cast<int>(std::floor((x - s_OriginX) / kCellSize));
+    return std::min(std::max(cx, 0), s_CellsX - 1);
+}
+
+int FlowField::ToCellZ(float z)
+{
+    const int cz = static_cast<int>(std::floor((z - s_OriginZ) / kCellSize));
+    return std::min(std::max(cz, 0), s_CellsZ - 1);
+}
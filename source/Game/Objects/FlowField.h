@@ -0,0 +1,99 @@
+﻿//------------------------------------------------------------------------------
+// FlowField
+//------------------------------------------------------------------------------
+// 役割:
+// フィールド（台）の平面（XZ）をセルに分割し、ターゲット（Hole）ごとに
+// 「各セルから次に進むべき方向」を事前計算しておく敵の経路誘導。
+//
+// 設計意図:
+// 敵ごとに経路探索（A* など）を行うと、障害物を避ける経路が必要になった時点で
+// 敵の数に比例してコストが増える。静的な障害物（壁・ガイド・バンパー）から
+// ターゲットごとに 1 回だけ距離場を作り、敵は自分のセルの方向を引くだけにする。
+// 敵が何体いても、1 体あたりのコストは「セル番号の計算 + 配列参照」で一定になる。
+//
+// 構成:
+// - SetLayout  : 対象範囲と静的障害物の設定（障害物セルを塗り、全ターゲットを再計算）
+// - AddTarget  : ターゲットの追加（到達点からの Dijkstra で距離場 → 方向場を作る）
+// - Sample     : ワールド座標から進行方向を引く（読み取りのみ）
+// - Clear      : 全フィールドの破棄
+//
+// NOTE:
+// - 再計算はレイアウトが変わったとき（SetLayout）だけ行う。動く物（Flipper / Ball）は障害物にしない
+// - Sample は読み取りのみなので、並列更新中の敵から呼んでよい
+//   （SetLayout / AddTarget / Clear はメインスレッドから、敵の更新と並行しないように呼ぶこと）
+// - 方向は隣接 8 方向のいずれか。フィールド外・到達点・経路の無いセルではターゲットへ直進する
+//------------------------------------------------------------------------------
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "Vector3.h"
+
+class GameObject;
+
+/// ターゲットごとのフローフィールド
+class FlowField
+{
+public:
+    // ----------------------------------------------------------------------
+    // 定数
+    // ----------------------------------------------------------------------
+    static constexpr int   kNoField        = -1;      // フィールド未指定（ターゲットへ直進）
+    static constexpr float kCellSize       = 0.5f;    // セルの一辺（ワールド単位）
+    static constexpr int   kClearanceCells = 1;       // 障害物の周囲に確保する余白（セル数：敵の半分の大きさ分）
+
+    // ----------------------------------------------------------------------
+    // 構築
+    // ----------------------------------------------------------------------
+    /// 対象範囲（XZ）と静的障害物を設定し、登録済みの全ターゲットを再計算する
+    /// - obstacles : ColliderGroup を持つ GameObject（トリガーのコライダーは障害物にしない）
+    static void SetLayout(float minX, float minZ, float maxX, float maxZ, const std::vector<GameObject*>& obstacles);
+
+    /// ターゲットを追加し、フィールドを計算する
+    /// - center / size : ターゲットの位置と大きさ（XZ の範囲に掛かるセルを到達点にする）
+    /// 戻り値：フィールド番号（Sample に渡す）
+    static int AddTarget(const Vector3& center, const Vector3& size);
+
+    /// 全フィールドと障害物を破棄する
+    static void Clear();
+
+    // ----------------------------------------------------------------------
+    // 参照
+    // ----------------------------------------------------------------------
+    /// worldPos からターゲットへ向かう方向（XZ 平面、正規化済み）
+    /// - field が kNoField / 範囲外の場合は (0,0,0)
+    static Vector3 Sample(int field, const Vector3& worldPos);
+
+private:
+    /// 1 ターゲット分のフィールド
+    struct Target
+    {
+        Vector3 center;                     // ターゲット中心
+        Vector3 size;                       // ターゲットの大きさ
+        std::vector<std::uint8_t> flow;     // セルごとの進行方向（kNeighbors の添字 / kNoDirection）
+    };
+
+    static constexpr std::uint8_t kNoDirection = 0xFF;   // 直進（到達点 / 経路なし）
+
+    /// 障害物のコライダーが覆うセルを塞ぐ
+    static void RasterizeObstacle(GameObject* obstacle);
+
+    /// 塞いだセルを kClearanceCells だけ広げる
+    static void DilateBlocked();
+
+    /// 到達点からの距離場を作り、各セルの進行方向を決める
+    static void BuildTarget(Target& target);
+
+    static int ToCellX(float x);
+    static int ToCellZ(float z);
+    static float CellCenterX(int cx) { return s_OriginX + (static_cast<float>(cx) + 0.5f) * kCellSize; }
+    static float CellCenterZ(int cz) { return s_OriginZ + (static_cast<float>(cz) + 0.5f) * kCellSize; }
+
+private:
+    static float                     s_OriginX;    // グリッド左端の X
+    static float                     s_OriginZ;    // グリッド手前端の Z
+    static int                       s_CellsX;     // X 方向のセル数
+    static int                       s_CellsZ;     // Z 方向のセル数
+    static std::vector<std::uint8_t> s_Blocked;    // セルごとの障害物フラグ
+    static std::vector<Target>       s_Targets;    // 登録済みターゲット
+};
@@ -16,13 +16,14 @@
 // - 衝突イベント受信        : OnCollisionEnter
 //
 // NOTE:
-// - m_MeshRenderer / m_ColliderGroup は非所有参照（所有は GameObject 側：unique_ptr）
+// - m_MeshRenderer / m_ColliderGroup は非所有参照（所有は GameObject 側：m_Components の InlineVector とインライン領域）
 // - Uninit() では参照を nullptr に戻すのみ（コンポーネント実体の破棄は所有側に依存）
 //------------------------------------------------------------------------------
 #pragma once
 
 #include "gameobject.h"
 #include "vector3.h"
+#include "FlowField.h"
 
 class MeshRenderer;
 class ColliderGroup;
@@ -67,6 +68,12 @@ public:
     /// ホールの中心位置を返す
     Vector3 GetHolePosition() const { return m_Transform.Position; }
 
+    /// このホールへ向かうフローフィールドの番号（未計算なら FlowField::kNoField）
+    int GetFlowField() const { return m_FlowField; }
+
+    /// フローフィールドの番号を設定する（Field が計算後に設定する）
+    void SetFlowField(int flowField) { m_FlowField = flowField; }
+
 private:
     // ----------------------------------------------------------------------
     // リソース設定
@@ -79,4 +86,6 @@ private:
     // ----------------------------------------------------------------------
     MeshRenderer*  m_MeshRenderer  = nullptr; // 非所有：表示用メッシュ
     ColliderGroup* m_ColliderGroup = nullptr; // 非所有：当たり判定用コライダー群
+
+    int m_FlowField = FlowField::kNoField;     // このホールへ向かうフローフィールドの番号
 };
\ No newline at end of file
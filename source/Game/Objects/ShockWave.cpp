@@ -1,30 +1,23 @@
 ﻿#include "ShockWave.h"
 
 // コンポーネント
-#include "ColliderGroup.h"
-#include "SphereCollider.h"
 #include "MeshRenderer.h"
+#include "Snapshot.h"
 
 // ゲームオブジェクト
 #include "EnemyBase.h"
+#include "EnemyManager.h"
+#include "EnemySwarm.h"
 #include "HP.h"
 
 // ------------------------------------------------------------------------------
 // 初期化処理
 // ------------------------------------------------------------------------------
-// - ColliderGroup / SphereCollider を生成してトリガー判定を構築
-// - SphereCollider 半径を開始値に設定
+// - MeshRenderer を生成し、開始半径の大きさで構築
 // - 経過時間をリセット
+// NOTE: プールの事前生成時に一度だけ呼ばれる。発生ごとのリセットは Spawn で行う
 void ShockWave::Init()
 {
-    // ColliderGroup + SphereCollider を追加
-    m_ColliderGroup = AddComponent<ColliderGroup>();
-    m_SphereCollider = m_ColliderGroup->AddCollider<SphereCollider>();
-
-    // Trigger 判定（物理反発なし）
-    m_SphereCollider->m_IsTrigger = true;
-    m_SphereCollider->m_radius = kShockWaveStartRadius;
-
     m_MeshRenderer = AddComponent<MeshRenderer>();
     m_MeshRenderer->LoadShader(kShockWaveVertexShaderPath, kShockWavePixelShaderPath);
     m_MeshRenderer->SetTexture(kShockWaveTexturePath);
@@ -35,39 +28,124 @@ void ShockWave::Init()
     m_Elapsed = 0.0f;
 }
 
+// ------------------------------------------------------------------------------
+// 発生処理
+// ------------------------------------------------------------------------------
+// - 経過時間・判定済み半径・スケール・色を開始時の値へ戻す
+// - localPosition に配置する（親 Transform 基準）
+// NOTE: 判定済み半径は負値にしておき、初回の検索で中心の敵も含める
+void ShockWave::Spawn(const Vector3& localPosition)
+{
+    m_Elapsed   = 0.0f;
+    m_HitRadius = -1.0f;
+    m_IsDead  = false;
+    m_Transform.Position = localPosition;
+
+    ApplyElapsed();
+}
+
 // ------------------------------------------------------------------------------
 // 更新処理
 // ------------------------------------------------------------------------------
-// - 経過時間に応じて SphereCollider の半径を線形補間で拡大する
+// - 経過時間に応じて半径を線形補間で拡大し、新たに掛かった敵を倒す
 // - 寿命(kDuration)を超えたら Destroy() して削除予約する
 // NOTE:
-// - Destroy() は即時削除ではない（親の回収タイミングで破棄される）
+// - Destroy() は即時削除ではない（親の回収タイミングでプールへ返却される）
 void ShockWave::Update(float deltaTime)
 {
     GameObject::Update(deltaTime);
 
     m_Elapsed += deltaTime;
+    ApplyElapsed();
+    SweepEnemies();
 
+    if (m_Elapsed >= kShockWaveDuration)
+    {
+        Destroy();
+    }
+}
+
+// ------------------------------------------------------------------------------
+// 経過時間の反映
+// ------------------------------------------------------------------------------
+// - 経過時間を寿命で正規化した進行度（0～1）
+// - 半径は進行度で線形補間する
+float ShockWave::GetProgress() const
+{
     float t = (kShockWaveDuration > 0.0f) ? (m_Elapsed / kShockWaveDuration) : 1.0f;
     if (t < 0.0f) t = 0.0f;
     if (t > 1.0f) t = 1.0f;
+    return t;
+}
 
-    const float radius = kShockWaveStartRadius + (kShockWaveEndRadius - kShockWaveStartRadius) * t;
+float ShockWave::GetRadius() const
+{
+    return kShockWaveStartRadius + (kShockWaveEndRadius - kShockWaveStartRadius) * GetProgress();
+}
 
+// - 半径・進行度を見た目（スケール・透明度）へ反映する
+// - Spawn（経過 0）/ Update / スナップショット読み戻しで共通に使う
+void ShockWave::ApplyElapsed()
+{
     // 非所有参照のため、生存確認してから操作する
-    if (m_SphereCollider)
-        m_SphereCollider->m_radius = radius;
-
     if (m_MeshRenderer)
     {
+        const float radius = GetRadius();
+        const float t = GetProgress();
         m_MeshRenderer->SetLocalScale(radius * 2.0f, 1.0f, radius * 2.0f);
         const float alpha = 1.0f - t;
         m_MeshRenderer->m_Color = { 1.0f, 1.0f, 1.0f, alpha };
     }
+}
 
-    if (m_Elapsed >= kShockWaveDuration)
+// ------------------------------------------------------------------------------
+// 撃破判定
+// ------------------------------------------------------------------------------
+// - 判定済み半径より外、現在の半径（+ 敵の大きさ分）以内の敵を検索し、Destroy() して撃破扱いにする
+// - EnemySwarm の敵も同じ円環で判定する（倒した数だけ撃破扱いにする）
+// - 検索後、判定済み半径を現在の半径まで進める（同じ敵を二度数えない）
+// NOTE:
+// - 検索位置は前回の SyncSpatialIndex 時点のもの
+// - Destroy() 済みの敵は検索結果に含まれないので、複数の衝撃波が重なっても撃破は 1 回
+void ShockWave::SweepEnemies()
+{
+    const float hitRadius = GetRadius() + kShockWaveHitMargin;
+
+    FrameVector<EnemyBase*> hits;
+    EnemyManager::QueryRing(m_Transform.GetWorldPosition(), m_HitRadius, hitRadius, hits);
+
+    for (EnemyBase* enemy : hits)
     {
-        Destroy();
+        enemy->Destroy();
+        HP::OnEnemyKilled();
+    }
+
+    const std::uint32_t swarmKills = EnemySwarm::KillInRing(m_Transform.GetWorldPosition(), m_HitRadius, hitRadius);
+    for (std::uint32_t i = 0; i < swarmKills; ++i)
+    {
+        HP::OnEnemyKilled();
+    }
+
+    m_HitRadius = hitRadius;
+}
+
+// ------------------------------------------------------------------------------
+// スナップショット
+// ------------------------------------------------------------------------------
+// - 保存するのは経過時間と判定済み半径。スケール・色は経過時間から導出できる
+void ShockWave::WriteState(SnapshotWriter& writer) const
+{
+    GameObject::WriteState(writer);
+    writer.Write(m_Elapsed);
+    writer.Write(m_HitRadius);
+}
+
+void ShockWave::ReadState(SnapshotReader& reader)
+{
+    GameObject::ReadState(reader);
+    if (reader.Read(m_Elapsed) && reader.Read(m_HitRadius))
+    {
+        ApplyElapsed();
     }
 }
 
@@ -87,39 +165,9 @@ void ShockWave::Draw()
 // ------------------------------------------------------------------------------
 // - 非所有参照をクリア（安全のため）
 // NOTE:
-// - Component 実体の所有は GameObject 側（unique_ptr）
-// - ShockWave 自身の破棄は Destroy() → 親の回収で行われる想定
+// - Component 実体の所有は GameObject 側
+// - ShockWave 自身は Destroy() → 親の回収でプールへ返却され、破棄は親と共に行われる
 void ShockWave::Uninit()
 {
-    m_ColliderGroup = nullptr;
-    m_SphereCollider = nullptr;
     m_MeshRenderer = nullptr;
 }
-
-// ------------------------------------------------------------------------------
-// トリガーコールバック
-// ------------------------------------------------------------------------------
-// - 接触相手の Owner が EnemyBase の場合、敵を Destroy() して撃破扱いにする
-// - その際 HP::OnEnemyKilled() を呼び出し、撃破数などの進行を更新する
-//
-// 戻り値:
-// - なし
-//
-// 副作用:
-// - EnemyBase::Destroy() により対象敵が削除予約される
-// - HP::OnEnemyKilled() によりゲーム進行状態が更新される
-//
-// NOTE:
-// - 同一フレームで複数回入った場合、OnEnemyKilled() が複数回呼ばれ得る
-//   （仕様として許容するか、Enemy側で一度だけ処理する設計にするか検討）
-void ShockWave::OnTriggerEnter(const CollisionInfo& info)
-{
-    if (!info.other || !info.other->m_Owner) return;
-
-    if (auto* enemy = dynamic_cast<EnemyBase*>(info.other->m_Owner))
-    {
-        enemy->Destroy();
-        HP::OnEnemyKilled();
-    }
-}
-
@@ -3,31 +3,34 @@
 //------------------------------------------------------------------------------
 // 役割:
 // バンパー衝突時などに生成される衝撃波オブジェクト。
-// Trigger 判定用 SphereCollider を時間で拡大し、接触した敵を倒す。
+// 半径を時間で拡大し、波面が通過した敵を倒す。
 //
 // 設計意図:
 // - 範囲攻撃を「短寿命オブジェクト」として独立させ、呼び出し側の責務を減らす
-// - 物理反発ではなく Trigger による接触通知で処理する
+// - 当たり判定は Trigger コライダーではなく EnemyManager の空間検索で行う
+//   （毎フレーム「前回の半径より外・今回の半径以内」の円環を 1 回検索するだけで済み、
+//     敵の数だけ衝突ペアを作らない）
 //
 // 構成:
-// - ColliderGroup / SphereCollider : 当たり判定（Trigger）
-// - ライフサイクル               : Init / Update / Draw / Uninit
-// - 衝突イベント                 : OnTriggerEnter
+// - ライフサイクル               : Init / Spawn / Update / Draw / Uninit
+// - 撃破判定                     : Update 内で EnemyManager::QueryRing
+// - スナップショット             : 経過時間と判定済み半径を保存し、見た目は読み戻し時に再計算
 //
 // NOTE:
-// - ColliderGroup / SphereCollider への参照は非所有（GameObject が所有）
+// - MeshRenderer への参照は非所有（GameObject が所有）
+// - 波面は敵の移動より十分速いので、円環の掃引で「円内に入った敵」を取りこぼさない前提
+// - Bumper の ObjectPool で使い回す前提。Init は Component 構築のみ、
+//   発生ごとの状態リセットは Spawn で行う
 //------------------------------------------------------------------------------
 #pragma once
 
 #include "GameObject.h"
 
-class ColliderGroup;
-class SphereCollider;
 class MeshRenderer;
 
 /// 衝撃波オブジェクト
-/// - 一定時間だけ半径を拡大する Trigger 判定を発生させる
-/// - 接触した EnemyBase を Destroy() し、撃破扱いにする
+/// - 一定時間だけ半径を拡大する
+/// - 半径内に入った EnemyBase を Destroy() し、撃破扱いにする
 class ShockWave : public GameObject
 {
 public:
@@ -35,11 +38,17 @@ public:
     // ライフサイクル
     // ----------------------------------------------------------------------
     /// 初期化
-    /// - ColliderGroup / SphereCollider を構築し、Trigger 判定を有効化する
+    /// - MeshRenderer を構築する
     void Init() override;
 
+    /// 発生
+    /// - 経過時間・半径・見た目を初期値へ戻し、localPosition に配置する
+    /// NOTE: プールから取得した直後に呼ぶこと
+    void Spawn(const Vector3& localPosition);
+
     /// 更新
-    /// - 経過時間に応じて半径を拡大し、寿命で Destroy() する
+    /// - 経過時間に応じて半径を拡大し、新たに半径内へ入った敵を倒す
+    /// - 寿命で Destroy() する（プールへ返却される）
     void Update(float deltaTime) override;
 
     /// 描画
@@ -51,11 +60,10 @@ public:
     void Uninit() override;
 
     // ----------------------------------------------------------------------
-    // 衝突イベント
+    // スナップショット
     // ----------------------------------------------------------------------
-    /// トリガー侵入
-    /// - EnemyBase に接触した場合、敵を Destroy() し撃破扱いにする
-    void OnTriggerEnter(const CollisionInfo& info) override;
+    void WriteState(SnapshotWriter& writer) const override;
+    void ReadState(SnapshotReader& reader) override;
 
 private:
     // ----------------------------------------------------------------------
@@ -65,19 +73,31 @@ private:
     static constexpr float kShockWaveStartRadius            = 4.5f;  // 開始半径
     static constexpr float kShockWaveEndRadius              = 7.2f;  // 終了半径
     static constexpr float kShockWaveDuration               = 0.35f; // 寿命（秒）
+    static constexpr float kShockWaveHitMargin              = 0.5f;  // 判定半径への上乗せ（敵の半分の大きさ）
     static constexpr const wchar_t* kShockWaveTexturePath   = L"asset\\texture\\BumperShockWave.png"; 
     static constexpr const char* kShockWaveVertexShaderPath = "shader\\bin\\BaseLitVS.cso";
     static constexpr const char* kShockWavePixelShaderPath  = "shader\\bin\\BaseLitPS.cso";
 
+    /// 経過時間から進行度（0～1）を求める
+    float GetProgress() const;
+
+    /// 経過時間から現在の半径を求める
+    float GetRadius() const;
+
+    /// 経過時間からスケール・透明度を反映する
+    void ApplyElapsed();
+
+    /// 判定済み半径から現在の半径までの円環にいる敵を倒す
+    void SweepEnemies();
+
     // ----------------------------------------------------------------------
     // 状態
     // ----------------------------------------------------------------------
-    float m_Elapsed = 0.0f; // 経過時間（秒）
+    float m_Elapsed   = 0.0f; // 経過時間（秒）
+    float m_HitRadius = 0.0f; // 判定済みの半径（この内側の敵は処理済み）
 
     // ----------------------------------------------------------------------
     // コンポーネント参照（非所有）
     // ----------------------------------------------------------------------
-    ColliderGroup*  m_ColliderGroup  = nullptr; // 非所有：ColliderGroup
-    SphereCollider* m_SphereCollider = nullptr; // 非所有：SphereCollider
     MeshRenderer*   m_MeshRenderer   = nullptr; // 非所有：MeshRenderer
 };
@@ -15,6 +15,8 @@
 #include "SoundManager.h"
 #include "HP.h"
 #include "EnemyManager.h"
+#include "Bumper.h"
+#include "modelRenderer.h"
 
 /// シーン列挙型
 enum class Scene {
@@ -23,25 +25,43 @@ enum class Scene {
     Result
 };
 
+/// 指定シーンで使うアセットの CPU 側デコードを行う（inline 実装）
+/// - SceneLoader のバックグラウンドスレッドから呼ばれる
+/// - ここでデコードしたものは、各 GameObject の Init では GPU 転送だけになる
+/// NOTE: デバイス / コンテキストを使う処理（シェーダー作成など）はここに書かないこと
+inline void DecodeSceneAssets(Scene scene) {
+    switch (scene) {
+    case Scene::Game:
+        ModelRenderer::Decode(Ball::kModelPath);
+        ModelRenderer::Decode(Bumper::kModelPath);
+        break;
+    default:
+        break;
+    }
+}
+
 /// 指定シーンの GameObject* を生成して返す（inline 実装）
+/// NOTE: SceneLoader のバックグラウンドスレッドから呼ばれる。
+///       コンストラクタでは共有状態（シングルトン / static 変数など）に触れないこと
+/// NOTE: 衝突コールバックのマスクを設定するため、new ではなく GameObject::Create<T>() で生成する
 inline std::vector<GameObject*> CreateSceneObjects(Scene scene) {
     std::vector<GameObject*> objs;
     switch (scene) {
     case Scene::Title:
-        objs.push_back(new Title());
+        objs.push_back(GameObject::Create<Title>());
 		break;
     case Scene::Game:
-        objs.push_back(new Camera());
-        objs.push_back(new EnemyManager());
-        objs.push_back(new Field());
-        objs.push_back(new Ball());
-        objs.push_back(new Polygon2D());
-        objs.push_back(new Score());
-        objs.push_back(new HP());
-        objs.push_back(new SoundManager());
+        objs.push_back(GameObject::Create<Camera>());
+        objs.push_back(GameObject::Create<EnemyManager>());
+        objs.push_back(GameObject::Create<Field>());
+        objs.push_back(GameObject::Create<Ball>());
+        objs.push_back(GameObject::Create<Polygon2D>());
+        objs.push_back(GameObject::Create<Score>());
+        objs.push_back(GameObject::Create<HP>());
+        objs.push_back(GameObject::Create<SoundManager>());
         break;
     case Scene::Result:
-        objs.push_back(new Result());
+        objs.push_back(GameObject::Create<Result>());
         break;
     }
     return objs;
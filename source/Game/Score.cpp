@@ -7,6 +7,7 @@
 // Windows API / 標準ライブラリ
 #include <windows.h>
 #include <string>
+#include "Snapshot.h"
 
 // ------------------------------------------------------------------------------
 // 静的メンバー定義
@@ -22,6 +23,9 @@ void Score::Init()
 
     // スコア初期化
     s_Score = 0;
+
+    // 更新はデバッグ入力のみなので間引く（キーは押下状態の比較なので取りこぼさない）
+    SetUpdateTier(UpdateTier::EveryNFrames, kUpdateInterval);
 }
 
 // ------------------------------------------------------------------------------
@@ -76,12 +80,32 @@ void Score::Draw()
 {
     GameObject::Draw();
 
-    std::wstring paddedScore = std::to_wstring(s_Score);
-    while (paddedScore.length() < 5)
+    // 表示文字列はスコアが変わったときだけ作り直す（レイアウトも同じ内容なら TextRenderer が使い回す）
+    if (s_Score != m_DisplayedScore)
     {
-        paddedScore = L"0" + paddedScore;
+        const std::wstring digits = std::to_wstring(s_Score);
+        m_DisplayText = L"SCORE: ";
+        if (digits.length() < kScoreDigits)
+        {
+            m_DisplayText.append(kScoreDigits - digits.length(), L'0');
+        }
+        m_DisplayText += digits;
+        m_DisplayedScore = s_Score;
     }
+    Renderer::DrawText(m_DisplayText, 10, 10);
+}
+
+// ------------------------------------------------------------------------------
+// スナップショット
+// ------------------------------------------------------------------------------
+void Score::WriteState(SnapshotWriter& writer) const
+{
+    GameObject::WriteState(writer);
+    writer.Write(s_Score);
+}
 
-    const std::wstring displayText = L"SCORE: " + paddedScore;
-    Renderer::DrawText(displayText, 10, 10);
+void Score::ReadState(SnapshotReader& reader)
+{
+    GameObject::ReadState(reader);
+    reader.Read(s_Score);
 }
@@ -13,7 +13,7 @@
 // 構成:
 // - スコア管理             : static int s_Score
 // - 更新処理               : デバッグキー入力（+ / -）
-// - 描画                   : 5桁固定のスコア文字列を描画
+// - 描画                   : 5桁固定のスコア文字列を描画（スコアが変わったときだけ作り直す）
 //
 // NOTE:
 // - 現在のキー入力処理はデバッグ用途
@@ -22,6 +22,7 @@
 #pragma once
 
 #include "gameObject.h"
+#include <string>
 
 /// スコア管理・表示用 GameObject
 /// - スコアは static 変数として全体で共有される
@@ -33,6 +34,7 @@ public:
     // ライフサイクルメソッド
     // ----------------------------------------------------------------------
     /// 初期化処理
+    /// - HUD のため更新頻度を落とす（表示は Draw で毎フレーム行う）
     void Init() override;
 
     /// 終了処理
@@ -46,6 +48,11 @@ public:
     /// - 左上にスコアを5桁固定で描画する
     void Draw() override;
 
+    /// スナップショット
+    /// - 共有スコア（static）を Score オブジェクトの状態として保存する
+    void WriteState(SnapshotWriter& writer) const override;
+    void ReadState(SnapshotReader& reader) override;
+
     // ----------------------------------------------------------------------
     // スコア操作
     // ----------------------------------------------------------------------
@@ -59,8 +66,20 @@ public:
     static void AddScore(int points) { s_Score += points; }
 
 private:
+    // ----------------------------------------------------------------------
+    // 定数
+    // ----------------------------------------------------------------------
+    static constexpr size_t kScoreDigits = 5;   // 表示桁数（ゼロ埋め）
+    static constexpr std::uint8_t kUpdateInterval = 2;  // 更新間隔（フレーム数）
+
     // ----------------------------------------------------------------------
     // スコア管理
     // ----------------------------------------------------------------------
     static int s_Score;   // 共有スコア（全シーン共通）
+
+    // ----------------------------------------------------------------------
+    // 表示（値が変わったときだけ文字列を作り直す）
+    // ----------------------------------------------------------------------
+    int          m_DisplayedScore = -1;   // m_DisplayText を作ったときのスコア
+    std::wstring m_DisplayText;           // 表示中の文字列
 };
@@ -93,11 +93,7 @@ void AnimationModel::Update(const char* AnimationName1, int Frame1)
 	{
 		aiMesh* mesh = m_AiScene->mMeshes[i];
 
-		D3D11_MAPPED_SUBRESOURCE ms;
-		Renderer::GetDeviceContext()->Map(m_VertexBuffer[i], 0,
-			D3D11_MAP_WRITE_DISCARD, 0, &ms);
-
-		VERTEX_3D* vertex = (VERTEX_3D*)ms.pData;
+		VERTEX_3D* vertex = (VERTEX_3D*)Renderer::GetBackend().MapDiscard(m_VertexBuffer[i]);
 
 		for (unsigned int v = 0; v < mesh->mNumVertices; ++v)
 		{
@@ -146,7 +142,7 @@ void AnimationModel::Update(const char* AnimationName1, int Frame1)
 			vertex[v].Diffuse = XMFLOAT4(1.0f, 1.0f, 1.0f, 1.0f);
 		}
 
-		Renderer::GetDeviceContext()->Unmap(m_VertexBuffer[i], 0);
+		Renderer::GetBackend().Unmap(m_VertexBuffer[i], sizeof(VERTEX_3D) * mesh->mNumVertices);
 	}
 }
 
@@ -162,8 +158,8 @@ void AnimationModel::Draw()
     Renderer::SetWorldMatrix(world);
 
 	// プリミティブトポロジ設定
-	Renderer::GetDeviceContext()->IASetPrimitiveTopology(
-		D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+	RenderBackend& backend = Renderer::GetBackend();
+	backend.SetTopology(GpuTopology::TriangleList);
 
 	// マテリアル設定
 	MATERIAL material;
@@ -194,7 +190,7 @@ void AnimationModel::Draw()
 		}
 		else
 		{
-			Renderer::GetDeviceContext()->PSSetShaderResources(0, 1, &m_Texture[texture.data]);
+			backend.SetTexture(0, m_Texture[texture.data]);
 			material.TextureEnable = true;
 		}
 
@@ -204,25 +200,25 @@ void AnimationModel::Draw()
 
 
 		// 頂点バッファ設定
-		UINT stride = sizeof(VERTEX_3D);
-		UINT offset = 0;
-		Renderer::GetDeviceContext()->IASetVertexBuffers(0, 1, &m_VertexBuffer[m], &stride, &offset);
+		backend.SetVertexBuffer(0, m_VertexBuffer[m], sizeof(VERTEX_3D));
 
 		// インデックスバッファ設定
-		Renderer::GetDeviceContext()->IASetIndexBuffer(m_IndexBuffer[m], DXGI_FORMAT_R32_UINT, 0);
+		backend.SetIndexBuffer(m_IndexBuffer[m], GpuIndexFormat::UInt32);
 
 		// ポリゴン描画
-		Renderer::GetDeviceContext()->DrawIndexed(mesh->mNumFaces * 3, 0, 0);
+		backend.DrawIndexed(mesh->mNumFaces * 3, 0, 0);
 	}
 }
 
 // 終了処理
 void AnimationModel::Uninit()
 {
+	RenderBackend& backend = Renderer::GetBackend();
+
 	for (unsigned int m = 0; m < m_AiScene->mNumMeshes; m++)
 	{
-		m_VertexBuffer[m]->Release();
-		m_IndexBuffer[m]->Release();
+		backend.Release(m_VertexBuffer[m]);
+		backend.Release(m_IndexBuffer[m]);
 	}
 
 	delete[] m_VertexBuffer;
@@ -231,9 +227,9 @@ void AnimationModel::Uninit()
 	delete[] m_DeformVertex;
 
 
-	for (std::pair<const std::string, ID3D11ShaderResourceView*> pair : m_Texture)
+	for (std::pair<const std::string, GpuTexture*> pair : m_Texture)
 	{
-		pair.second->Release();
+		backend.Release(pair.second);
 	}
 
 
@@ -265,8 +261,8 @@ void AnimationModel::Load(const char* FileName)
 		aiProcess_SortByPType);
 	assert(m_AiScene);
 
-	m_VertexBuffer = new ID3D11Buffer * [m_AiScene->mNumMeshes];
-	m_IndexBuffer = new ID3D11Buffer * [m_AiScene->mNumMeshes];
+	m_VertexBuffer = new GpuBuffer * [m_AiScene->mNumMeshes];
+	m_IndexBuffer = new GpuBuffer * [m_AiScene->mNumMeshes];
 
 	//変形後頂点配列生成
 	m_DeformVertex = new std::vector<DEFORM_VERTEX>[m_AiScene->mNumMeshes];
@@ -297,19 +293,12 @@ void AnimationModel::Load(const char* FileName)
 				vertex[v].Diffuse = XMFLOAT4(1.0f, 1.0f, 1.0f, 1.0f);
 			}
 
-			D3D11_BUFFER_DESC bd;
-			ZeroMemory(&bd, sizeof(bd));
-			bd.Usage = D3D11_USAGE_DYNAMIC;
-			bd.ByteWidth = sizeof(VERTEX_3D) * mesh->mNumVertices;
-			bd.BindFlags = D3D11_BIND_VERTEX_BUFFER;
-			bd.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
-
-			D3D11_SUBRESOURCE_DATA sd;
-			ZeroMemory(&sd, sizeof(sd));
-			sd.pSysMem = vertex;
+			GpuBufferDesc desc{};
+			desc.size = sizeof(VERTEX_3D) * mesh->mNumVertices;
+			desc.usage = GpuBufferUsage::Dynamic;
+			desc.bind = GpuBufferBind::Vertex;
 
-			Renderer::GetDevice()->CreateBuffer(&bd, &sd,
-				&m_VertexBuffer[m]);
+			m_VertexBuffer[m] = Renderer::GetBackend().CreateBuffer(desc, vertex);
 
 			delete[] vertex;
 		}
@@ -330,18 +319,11 @@ void AnimationModel::Load(const char* FileName)
 				index[f * 3 + 2] = face->mIndices[2];
 			}
 
-			D3D11_BUFFER_DESC bd;
-			ZeroMemory(&bd, sizeof(bd));
-			bd.Usage = D3D11_USAGE_DEFAULT;
-			bd.ByteWidth = sizeof(unsigned int) * mesh->mNumFaces * 3;
-			bd.BindFlags = D3D11_BIND_INDEX_BUFFER;
-			bd.CPUAccessFlags = 0;
+			GpuBufferDesc desc{};
+			desc.size = sizeof(unsigned int) * mesh->mNumFaces * 3;
+			desc.bind = GpuBufferBind::Index;
 
-			D3D11_SUBRESOURCE_DATA sd;
-			ZeroMemory(&sd, sizeof(sd));
-			sd.pSysMem = index;
-
-			Renderer::GetDevice()->CreateBuffer(&bd, &sd, &m_IndexBuffer[m]);
+			m_IndexBuffer[m] = Renderer::GetBackend().CreateBuffer(desc, index);
 
 			delete[] index;
 		}
@@ -396,13 +378,11 @@ void AnimationModel::Load(const char* FileName)
 	{
 		aiTexture* aitexture = m_AiScene->mTextures[i];
 
-		ID3D11ShaderResourceView* texture;
-
 		// テクスチャ読み込み
 		TexMetadata metadata;
 		ScratchImage image;
 		LoadFromWICMemory(aitexture->pcData, aitexture->mWidth, WIC_FLAGS_NONE, &metadata, image);
-		CreateShaderResourceView(Renderer::GetDevice(), image.GetImages(), image.GetImageCount(), metadata, &texture);
+		GpuTexture* texture = Renderer::CreateTexture(image);
 		assert(texture);
 
 		m_Texture[aitexture->mFilename.data] = texture;
@@ -495,11 +475,7 @@ void AnimationModel::UpdateBlend(const char* AnimationNameA, int FrameA, const c
 	{
 		aiMesh* mesh = m_AiScene->mMeshes[i];
 
-		D3D11_MAPPED_SUBRESOURCE ms;
-		Renderer::GetDeviceContext()->Map(m_VertexBuffer[i], 0,
-			D3D11_MAP_WRITE_DISCARD, 0, &ms);
-
-		VERTEX_3D* vertex = (VERTEX_3D*)ms.pData;
+		VERTEX_3D* vertex = (VERTEX_3D*)Renderer::GetBackend().MapDiscard(m_VertexBuffer[i]);
 
 		for (unsigned int v = 0; v < mesh->mNumVertices; ++v)
 		{
@@ -548,7 +524,7 @@ void AnimationModel::UpdateBlend(const char* AnimationNameA, int FrameA, const c
 			vertex[v].Diffuse = XMFLOAT4(1.0f, 1.0f, 1.0f, 1.0f);
 		}
 
-		Renderer::GetDeviceContext()->Unmap(m_VertexBuffer[i], 0);
+		Renderer::GetBackend().Unmap(m_VertexBuffer[i], sizeof(VERTEX_3D) * mesh->mNumVertices);
 	}
 }
 
@@ -11,6 +11,7 @@
 
 // コンポーネント関連
 #include "component.h"
+#include "RenderBackend.h"
 
 class Transform;
 
@@ -100,10 +101,10 @@ private:
 	const aiScene* m_AiScene = nullptr;
 	std::unordered_map<std::string, const aiScene*> m_Animation;
 
-	ID3D11Buffer** m_VertexBuffer;
-	ID3D11Buffer** m_IndexBuffer;
+	GpuBuffer** m_VertexBuffer;
+	GpuBuffer** m_IndexBuffer;
 
-	std::unordered_map<std::string, ID3D11ShaderResourceView*> m_Texture;
+	std::unordered_map<std::string, GpuTexture*> m_Texture;
 
 	std::vector<DEFORM_VERTEX>* m_DeformVertex;   						  //変形後頂点データ
 	std::unordered_map<std::string, BONE> m_Bone; 						  //ボーンデータ（名前で参照）
@@ -3,6 +3,7 @@
 // システム
 #include "main.h"
 #include "renderer.h"
+#include "FrustumCulling.h"
 #include "Input.h"
 #include "GameManager.h"
 
@@ -260,6 +261,7 @@ void Camera::Update(float deltaTime)
 /// 描画処理
 /// - Projection を生成して Renderer に適用する
 /// - Transform からカメラ位置を求め、Target とともに View を生成して適用する
+/// - 確定した View / Projection で視錐台カリングを行う（以降の Draw は判定結果を読むだけ）
 void Camera::Draw()
 {
     m_Projection = XMMatrixPerspectiveFovLH(
@@ -280,6 +282,8 @@ void Camera::Draw()
         XMLoadFloat3(&up));
 
     Renderer::SetViewMatrix(m_View);
+
+    FrustumCulling::Cull(m_View * m_Projection);
 }
 
 
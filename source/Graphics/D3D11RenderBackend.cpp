@@ -0,0 +1,542 @@
+﻿#pragma comment(lib, "d2d1.lib")
+#pragma comment(lib, "dwrite.lib")
+
+#include "D3D11RenderBackend.h"
+#include "TextRenderer.h"
+
+#include <cassert>
+
+namespace
+{
+    static_assert(kGpuFormatR8G8B8A8Unorm == DXGI_FORMAT_R8G8B8A8_UNORM, "kGpuFormatR8G8B8A8Unorm が DXGI_FORMAT と一致していない");
+
+    DXGI_FORMAT ToDXGI(GpuVertexFormat format)
+    {
+        switch (format)
+        {
+        case GpuVertexFormat::Float2: return DXGI_FORMAT_R32G32_FLOAT;
+        case GpuVertexFormat::Float3: return DXGI_FORMAT_R32G32B32_FLOAT;
+        case GpuVertexFormat::Float4: return DXGI_FORMAT_R32G32B32A32_FLOAT;
+        }
+        return DXGI_FORMAT_UNKNOWN;
+    }
+
+    D3D11_PRIMITIVE_TOPOLOGY ToD3D11(GpuTopology topology)
+    {
+        switch (topology)
+        {
+        case GpuTopology::TriangleList:  return D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST;
+        case GpuTopology::TriangleStrip: return D3D11_PRIMITIVE_TOPOLOGY_TRIANGLESTRIP;
+        case GpuTopology::LineList:      return D3D11_PRIMITIVE_TOPOLOGY_LINELIST;
+        }
+        return D3D11_PRIMITIVE_TOPOLOGY_UNDEFINED;
+    }
+
+    template <class T>
+    void SafeRelease(T*& object)
+    {
+        if (object)
+        {
+            object->Release();
+            object = nullptr;
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------
+// 初期化処理
+// ------------------------------------------------------------------------------
+// - デバイス / スワップチェーン / 描画先 / 深度バッファ
+// - 既定の状態（ラスタライザ・ブレンド・深度・サンプラー）を作成して設定する
+bool D3D11RenderBackend::Init(HWND window, UINT width, UINT height)
+{
+    DXGI_SWAP_CHAIN_DESC swapChainDesc{};
+    swapChainDesc.BufferCount = 1;
+    swapChainDesc.BufferDesc.Width = width;
+    swapChainDesc.BufferDesc.Height = height;
+    swapChainDesc.BufferDesc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
+    swapChainDesc.BufferDesc.RefreshRate.Numerator = 60;
+    swapChainDesc.BufferDesc.RefreshRate.Denominator = 1;
+    swapChainDesc.BufferUsage = DXGI_USAGE_RENDER_TARGET_OUTPUT;
+    swapChainDesc.OutputWindow = window;
+    swapChainDesc.SampleDesc.Count = 1;
+    swapChainDesc.SampleDesc.Quality = 0;
+    swapChainDesc.Windowed = TRUE;
+
+    UINT createFlags = D3D11_CREATE_DEVICE_BGRA_SUPPORT;
+    HRESULT hr = D3D11CreateDeviceAndSwapChain(NULL,
+                                               D3D_DRIVER_TYPE_HARDWARE,
+                                               NULL,
+                                               createFlags,
+                                               NULL,
+                                               0,
+                                               D3D11_SDK_VERSION,
+                                               &swapChainDesc,
+                                               &m_SwapChain,
+                                               &m_Device,
+                                               &m_FeatureLevel,
+                                               &m_Context);
+    if (FAILED(hr))
+    {
+        return false;
+    }
+
+    // 定数バッファの範囲設定（D3D11.1）に対応しているか
+    // - 対応していなければ描画ごとに定数バッファを書き換える従来の経路になる
+    if (SUCCEEDED(m_Context->QueryInterface(__uuidof(ID3D11DeviceContext1), reinterpret_cast<void**>(&m_Context1))))
+    {
+        D3D11_FEATURE_DATA_D3D11_OPTIONS options{};
+        if (SUCCEEDED(m_Device->CheckFeatureSupport(D3D11_FEATURE_D3D11_OPTIONS, &options, sizeof(options))))
+        {
+            m_ConstantBufferRanges = options.ConstantBufferOffsetting != FALSE;
+        }
+    }
+
+    ID3D11Texture2D* renderTarget{};
+    m_SwapChain->GetBuffer(0, __uuidof(ID3D11Texture2D), (LPVOID*)&renderTarget);
+    m_Device->CreateRenderTargetView(renderTarget, NULL, &m_RenderTargetView);
+    renderTarget->Release();
+
+    ID3D11Texture2D* depthStencile{};
+    D3D11_TEXTURE2D_DESC textureDesc{};
+    textureDesc.Width = swapChainDesc.BufferDesc.Width;
+    textureDesc.Height = swapChainDesc.BufferDesc.Height;
+    textureDesc.MipLevels = 1;
+    textureDesc.ArraySize = 1;
+    textureDesc.Format = DXGI_FORMAT_D16_UNORM;
+    textureDesc.SampleDesc = swapChainDesc.SampleDesc;
+    textureDesc.Usage = D3D11_USAGE_DEFAULT;
+    textureDesc.BindFlags = D3D11_BIND_DEPTH_STENCIL;
+    textureDesc.CPUAccessFlags = 0;
+    textureDesc.MiscFlags = 0;
+    m_Device->CreateTexture2D(&textureDesc, NULL, &depthStencile);
+
+    D3D11_DEPTH_STENCIL_VIEW_DESC depthStencilViewDesc{};
+    depthStencilViewDesc.Format = textureDesc.Format;
+    depthStencilViewDesc.ViewDimension = D3D11_DSV_DIMENSION_TEXTURE2D;
+    depthStencilViewDesc.Flags = 0;
+    m_Device->CreateDepthStencilView(depthStencile, &depthStencilViewDesc, &m_DepthStencilView);
+    depthStencile->Release();
+
+    m_Context->OMSetRenderTargets(1, &m_RenderTargetView, m_DepthStencilView);
+
+    D3D11_VIEWPORT viewport;
+    viewport.Width = (FLOAT)width;
+    viewport.Height = (FLOAT)height;
+    viewport.MinDepth = 0.0f;
+    viewport.MaxDepth = 1.0f;
+    viewport.TopLeftX = 0;
+    viewport.TopLeftY = 0;
+    m_Context->RSSetViewports(1, &viewport);
+
+    D3D11_RASTERIZER_DESC rasterizerDesc{};
+    rasterizerDesc.FillMode = D3D11_FILL_SOLID;
+    rasterizerDesc.CullMode = D3D11_CULL_BACK;
+    rasterizerDesc.DepthClipEnable = TRUE;
+    rasterizerDesc.MultisampleEnable = FALSE;
+    m_Device->CreateRasterizerState(&rasterizerDesc, &m_RasterizerState);
+    m_Context->RSSetState(m_RasterizerState);
+
+    D3D11_BLEND_DESC blendDesc{};
+    blendDesc.AlphaToCoverageEnable = FALSE;
+    blendDesc.IndependentBlendEnable = FALSE;
+    blendDesc.RenderTarget[0].BlendEnable = TRUE;
+    blendDesc.RenderTarget[0].SrcBlend = D3D11_BLEND_SRC_ALPHA;
+    blendDesc.RenderTarget[0].DestBlend = D3D11_BLEND_INV_SRC_ALPHA;
+    blendDesc.RenderTarget[0].BlendOp = D3D11_BLEND_OP_ADD;
+    blendDesc.RenderTarget[0].SrcBlendAlpha = D3D11_BLEND_ONE;
+    blendDesc.RenderTarget[0].DestBlendAlpha = D3D11_BLEND_ZERO;
+    blendDesc.RenderTarget[0].BlendOpAlpha = D3D11_BLEND_OP_ADD;
+    blendDesc.RenderTarget[0].RenderTargetWriteMask = D3D11_COLOR_WRITE_ENABLE_ALL;
+    m_Device->CreateBlendState(&blendDesc, &m_BlendState);
+
+    blendDesc.AlphaToCoverageEnable = TRUE;
+    m_Device->CreateBlendState(&blendDesc, &m_BlendStateATC);
+
+    float blendFactor[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+    m_Context->OMSetBlendState(m_BlendState, blendFactor, 0xffffffff);
+
+    D3D11_DEPTH_STENCIL_DESC depthStencilDesc{};
+    depthStencilDesc.DepthEnable = TRUE;
+    depthStencilDesc.DepthWriteMask = D3D11_DEPTH_WRITE_MASK_ALL;
+    depthStencilDesc.DepthFunc = D3D11_COMPARISON_LESS_EQUAL;
+    depthStencilDesc.StencilEnable = FALSE;
+    m_Device->CreateDepthStencilState(&depthStencilDesc, &m_DepthStateEnable);
+
+    //depthStencilDesc.DepthEnable = FALSE;
+    depthStencilDesc.DepthWriteMask = D3D11_DEPTH_WRITE_MASK_ZERO;
+    m_Device->CreateDepthStencilState(&depthStencilDesc, &m_DepthStateDisable);
+
+    m_Context->OMSetDepthStencilState(m_DepthStateEnable, NULL);
+
+    D3D11_SAMPLER_DESC samplerDesc{};
+    samplerDesc.Filter = D3D11_FILTER_ANISOTROPIC;
+    samplerDesc.AddressU = D3D11_TEXTURE_ADDRESS_WRAP;
+    samplerDesc.AddressV = D3D11_TEXTURE_ADDRESS_WRAP;
+    samplerDesc.AddressW = D3D11_TEXTURE_ADDRESS_WRAP;
+    samplerDesc.MaxAnisotropy = 4;
+    samplerDesc.MaxLOD = D3D11_FLOAT32_MAX;
+    m_Device->CreateSamplerState(&samplerDesc, &m_SamplerState);
+    m_Context->PSSetSamplers(0, 1, &m_SamplerState);
+
+    if (!InitText())
+    {
+        return false;
+    }
+
+    // 上で直接設定した状態は追跡していないので、次の設定は必ず通す
+    InvalidateState();
+    return true;
+}
+
+// - 以前 Renderer::Init で作っていたものと同じ（バックバッファへ直接描く D2D の描画先・Segoe UI 24pt・白）
+bool D3D11RenderBackend::InitText()
+{
+    HRESULT hr = D2D1CreateFactory(D2D1_FACTORY_TYPE_SINGLE_THREADED, &m_D2DFactory);
+    if (FAILED(hr))
+    {
+        return false;
+    }
+
+    IDXGISurface* backBuffer = nullptr;
+    hr = m_SwapChain->GetBuffer(0, __uuidof(IDXGISurface), reinterpret_cast<void**>(&backBuffer));
+    if (FAILED(hr))
+    {
+        return false;
+    }
+
+    const D2D1_RENDER_TARGET_PROPERTIES props =
+        D2D1::RenderTargetProperties(
+            D2D1_RENDER_TARGET_TYPE_DEFAULT,
+            D2D1::PixelFormat(DXGI_FORMAT_UNKNOWN, D2D1_ALPHA_MODE_PREMULTIPLIED)
+        );
+    hr = m_D2DFactory->CreateDxgiSurfaceRenderTarget(backBuffer, &props, &m_D2DRenderTarget);
+    backBuffer->Release();
+    if (FAILED(hr))
+    {
+        return false;
+    }
+
+    hr = DWriteCreateFactory(DWRITE_FACTORY_TYPE_SHARED,
+                             __uuidof(IDWriteFactory),
+                             reinterpret_cast<IUnknown**>(&m_DWriteFactory));
+    if (FAILED(hr))
+    {
+        return false;
+    }
+
+    hr = m_DWriteFactory->CreateTextFormat(
+        L"Segoe UI",
+        nullptr,
+        DWRITE_FONT_WEIGHT_NORMAL,
+        DWRITE_FONT_STYLE_NORMAL,
+        DWRITE_FONT_STRETCH_NORMAL,
+        24.0f,
+        L"",
+        &m_TextFormat);
+    if (FAILED(hr))
+    {
+        return false;
+    }
+
+    hr = m_D2DRenderTarget->CreateSolidColorBrush(D2D1::ColorF(D2D1::ColorF::White), &m_TextBrush);
+    if (FAILED(hr))
+    {
+        return false;
+    }
+
+    TextRenderer::Init(m_DWriteFactory, m_TextFormat);
+    return true;
+}
+
+// ------------------------------------------------------------------------------
+// 終了処理
+// ------------------------------------------------------------------------------
+// - 文字の描画用オブジェクトはバックバッファを参照しているので、スワップチェーンより先に解放する
+void D3D11RenderBackend::Uninit()
+{
+    if (m_TextFormat)
+    {
+        TextRenderer::Uninit();
+    }
+    SafeRelease(m_TextBrush);
+    SafeRelease(m_TextFormat);
+    SafeRelease(m_DWriteFactory);
+    SafeRelease(m_D2DRenderTarget);
+    SafeRelease(m_D2DFactory);
+
+    if (m_Context)
+    {
+        m_Context->ClearState();
+    }
+
+    SafeRelease(m_SamplerState);
+    SafeRelease(m_DepthStateDisable);
+    SafeRelease(m_DepthStateEnable);
+    SafeRelease(m_BlendStateATC);
+    SafeRelease(m_BlendState);
+    SafeRelease(m_RasterizerState);
+    SafeRelease(m_DepthStencilView);
+    SafeRelease(m_RenderTargetView);
+    SafeRelease(m_SwapChain);
+    SafeRelease(m_Context1);
+    m_ConstantBufferRanges = false;
+    SafeRelease(m_Context);
+    SafeRelease(m_Device);
+}
+
+// ------------------------------------------------------------------------------
+// フレーム
+// ------------------------------------------------------------------------------
+void D3D11RenderBackend::OnBeginFrame()
+{
+    float clearColor[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
+    m_Context->ClearRenderTargetView(m_RenderTargetView, clearColor);
+    m_Context->ClearDepthStencilView(m_DepthStencilView, D3D11_CLEAR_DEPTH, 1.0f, 0);
+}
+
+void D3D11RenderBackend::OnEndFrame()
+{
+    m_SwapChain->Present(1, 0);
+}
+
+// ------------------------------------------------------------------------------
+// リソース
+// ------------------------------------------------------------------------------
+GpuBuffer* D3D11RenderBackend::OnCreateBuffer(const GpuBufferDesc& desc, const void* initialData)
+{
+    D3D11_BUFFER_DESC bd{};
+    bd.ByteWidth = desc.size;
+    bd.Usage = (desc.usage == GpuBufferUsage::Dynamic) ? D3D11_USAGE_DYNAMIC : D3D11_USAGE_DEFAULT;
+    bd.CPUAccessFlags = (desc.usage == GpuBufferUsage::Dynamic) ? D3D11_CPU_ACCESS_WRITE : 0;
+    switch (desc.bind)
+    {
+    case GpuBufferBind::Vertex:   bd.BindFlags = D3D11_BIND_VERTEX_BUFFER;   break;
+    case GpuBufferBind::Index:    bd.BindFlags = D3D11_BIND_INDEX_BUFFER;    break;
+    case GpuBufferBind::Constant: bd.BindFlags = D3D11_BIND_CONSTANT_BUFFER; break;
+    }
+
+    D3D11_SUBRESOURCE_DATA sd{};
+    sd.pSysMem = initialData;
+
+    ID3D11Buffer* buffer = nullptr;
+    m_Device->CreateBuffer(&bd, initialData ? &sd : nullptr, &buffer);
+    return reinterpret_cast<GpuBuffer*>(buffer);
+}
+
+void D3D11RenderBackend::OnUpdateBuffer(GpuBuffer* buffer, const void* data, std::uint32_t size)
+{
+    m_Context->UpdateSubresource(ToD3D(buffer), 0, NULL, data, 0, 0);
+}
+
+void* D3D11RenderBackend::OnMapDiscard(GpuBuffer* buffer)
+{
+    D3D11_MAPPED_SUBRESOURCE mapped{};
+    if (FAILED(m_Context->Map(ToD3D(buffer), 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped)))
+    {
+        return nullptr;
+    }
+    return mapped.pData;
+}
+
+void D3D11RenderBackend::OnUnmap(GpuBuffer* buffer)
+{
+    m_Context->Unmap(ToD3D(buffer), 0);
+}
+
+// - テクスチャ本体は SRV が参照を持つので、作成後すぐ手放す
+GpuTexture* D3D11RenderBackend::OnCreateTexture2D(const GpuTextureDesc& desc, const GpuSubresource* subresources)
+{
+    constexpr UINT kMaxMips = 16;
+    assert(desc.mipLevels > 0 && desc.mipLevels <= kMaxMips);
+
+    D3D11_TEXTURE2D_DESC td{};
+    td.Width = desc.width;
+    td.Height = desc.height;
+    td.MipLevels = desc.mipLevels;
+    td.ArraySize = 1;
+    td.Format = static_cast<DXGI_FORMAT>(desc.format);
+    td.SampleDesc.Count = 1;
+    td.Usage = D3D11_USAGE_DEFAULT;
+    td.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+
+    D3D11_SUBRESOURCE_DATA initial[kMaxMips]{};
+    for (UINT i = 0; i < desc.mipLevels; ++i)
+    {
+        initial[i].pSysMem = subresources[i].pixels;
+        initial[i].SysMemPitch = static_cast<UINT>(subresources[i].rowPitch);
+        initial[i].SysMemSlicePitch = static_cast<UINT>(subresources[i].slicePitch);
+    }
+
+    ID3D11Texture2D* texture = nullptr;
+    if (FAILED(m_Device->CreateTexture2D(&td, initial, &texture)))
+    {
+        return nullptr;
+    }
+
+    D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc{};
+    srvDesc.Format = td.Format;
+    srvDesc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2D;
+    srvDesc.Texture2D.MipLevels = desc.mipLevels;
+
+    ID3D11ShaderResourceView* view = nullptr;
+    m_Device->CreateShaderResourceView(texture, &srvDesc, &view);
+    texture->Release();
+    return reinterpret_cast<GpuTexture*>(view);
+}
+
+GpuVertexShader* D3D11RenderBackend::OnCreateVertexShader(const void* bytecode, std::size_t size,
+    const GpuVertexElement* elements, std::uint32_t elementCount, GpuInputLayout** outLayout)
+{
+    ID3D11VertexShader* shader = nullptr;
+    m_Device->CreateVertexShader(bytecode, size, NULL, &shader);
+
+    if (outLayout)
+    {
+        constexpr std::uint32_t kMaxElements = 16;
+        assert(elementCount <= kMaxElements);
+
+        D3D11_INPUT_ELEMENT_DESC layout[kMaxElements]{};
+        for (std::uint32_t i = 0; i < elementCount; ++i)
+        {
+            const GpuVertexElement& element = elements[i];
+            layout[i].SemanticName = element.semantic;
+            layout[i].SemanticIndex = element.semanticIndex;
+            layout[i].Format = ToDXGI(element.format);
+            layout[i].InputSlot = element.slot;
+            layout[i].AlignedByteOffset = element.offset;
+            layout[i].InputSlotClass = element.perInstance ? D3D11_INPUT_PER_INSTANCE_DATA : D3D11_INPUT_PER_VERTEX_DATA;
+            layout[i].InstanceDataStepRate = element.perInstance ? 1 : 0;
+        }
+
+        ID3D11InputLayout* inputLayout = nullptr;
+        m_Device->CreateInputLayout(layout, elementCount, bytecode, size, &inputLayout);
+        *outLayout = reinterpret_cast<GpuInputLayout*>(inputLayout);
+    }
+
+    return reinterpret_cast<GpuVertexShader*>(shader);
+}
+
+GpuPixelShader* D3D11RenderBackend::OnCreatePixelShader(const void* bytecode, std::size_t size)
+{
+    ID3D11PixelShader* shader = nullptr;
+    m_Device->CreatePixelShader(bytecode, size, NULL, &shader);
+    return reinterpret_cast<GpuPixelShader*>(shader);
+}
+
+// ------------------------------------------------------------------------------
+// 状態の設定
+// ------------------------------------------------------------------------------
+void D3D11RenderBackend::OnSetInputLayout(GpuInputLayout* layout)
+{
+    m_Context->IASetInputLayout(ToD3D(layout));
+}
+
+void D3D11RenderBackend::OnSetVertexShader(GpuVertexShader* shader)
+{
+    m_Context->VSSetShader(ToD3D(shader), nullptr, 0);
+}
+
+void D3D11RenderBackend::OnSetPixelShader(GpuPixelShader* shader)
+{
+    m_Context->PSSetShader(ToD3D(shader), nullptr, 0);
+}
+
+void D3D11RenderBackend::OnSetVertexBuffers(std::uint32_t startSlot, std::uint32_t count, GpuBuffer* const* buffers, const std::uint32_t* strides)
+{
+    constexpr std::uint32_t kMaxSlots = D3D11_IA_VERTEX_INPUT_RESOURCE_SLOT_COUNT;
+    assert(count <= kMaxSlots);
+
+    ID3D11Buffer* d3dBuffers[kMaxSlots];
+    UINT offsets[kMaxSlots] = {};
+    for (std::uint32_t i = 0; i < count; ++i)
+    {
+        d3dBuffers[i] = ToD3D(buffers[i]);
+    }
+    m_Context->IASetVertexBuffers(startSlot, count, d3dBuffers, strides, offsets);
+}
+
+void D3D11RenderBackend::OnSetIndexBuffer(GpuBuffer* buffer, GpuIndexFormat format)
+{
+    const DXGI_FORMAT dxgiFormat = (format == GpuIndexFormat::UInt16) ? DXGI_FORMAT_R16_UINT : DXGI_FORMAT_R32_UINT;
+    m_Context->IASetIndexBuffer(ToD3D(buffer), dxgiFormat, 0);
+}
+
+void D3D11RenderBackend::OnSetTopology(GpuTopology topology)
+{
+    m_Context->IASetPrimitiveTopology(ToD3D11(topology));
+}
+
+void D3D11RenderBackend::OnSetTexture(std::uint32_t slot, GpuTexture* texture)
+{
+    ID3D11ShaderResourceView* view = ToD3D(texture);
+    m_Context->PSSetShaderResources(slot, 1, &view);
+}
+
+// - 範囲は 16 バイト（定数 1 個）単位で渡す。先頭と大きさは 256 バイト（定数 16 個）の倍数
+void D3D11RenderBackend::OnSetConstantBufferRange(std::uint32_t slot, std::uint8_t stages, GpuBuffer* buffer,
+                                                  std::uint32_t offset, std::uint32_t size)
+{
+    ID3D11Buffer* d3dBuffer = ToD3D(buffer);
+    if (size == 0)
+    {
+        if (stages & GpuShaderStageVertex) m_Context->VSSetConstantBuffers(slot, 1, &d3dBuffer);
+        if (stages & GpuShaderStagePixel)  m_Context->PSSetConstantBuffers(slot, 1, &d3dBuffer);
+        return;
+    }
+
+    const UINT firstConstant = offset / 16;
+    const UINT numConstants  = size / 16;
+    if (stages & GpuShaderStageVertex) m_Context1->VSSetConstantBuffers1(slot, 1, &d3dBuffer, &firstConstant, &numConstants);
+    if (stages & GpuShaderStagePixel)  m_Context1->PSSetConstantBuffers1(slot, 1, &d3dBuffer, &firstConstant, &numConstants);
+}
+
+void D3D11RenderBackend::OnSetDepthEnable(bool enable)
+{
+    m_Context->OMSetDepthStencilState(enable ? m_DepthStateEnable : m_DepthStateDisable, NULL);
+}
+
+void D3D11RenderBackend::OnSetAlphaToCoverage(bool enable)
+{
+    float blendFactor[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+    m_Context->OMSetBlendState(enable ? m_BlendStateATC : m_BlendState, blendFactor, 0xffffffff);
+}
+
+// ------------------------------------------------------------------------------
+// 描画
+// ------------------------------------------------------------------------------
+void D3D11RenderBackend::OnDraw(std::uint32_t vertexCount, std::uint32_t startVertex)
+{
+    m_Context->Draw(vertexCount, startVertex);
+}
+
+void D3D11RenderBackend::OnDrawIndexed(std::uint32_t indexCount, std::uint32_t startIndex, std::int32_t baseVertex)
+{
+    m_Context->DrawIndexed(indexCount, startIndex, baseVertex);
+}
+
+void D3D11RenderBackend::OnDrawInstanced(std::uint32_t vertexCount, std::uint32_t instanceCount, std::uint32_t startInstance)
+{
+    m_Context->DrawInstanced(vertexCount, instanceCount, 0, startInstance);
+}
+
+void D3D11RenderBackend::OnDrawIndexedInstanced(std::uint32_t indexCount, std::uint32_t instanceCount,
+                                                std::uint32_t startIndex, std::uint32_t startInstance)
+{
+    m_Context->DrawIndexedInstanced(indexCount, instanceCount, startIndex, 0, startInstance);
+}
+
+// ------------------------------------------------------------------------------
+// 文字
+// ------------------------------------------------------------------------------
+// - 同じ内容の文字列はレイアウトを使い回し、描画は FlushText まで遅らせる
+void D3D11RenderBackend::OnSubmitText(const wchar_t* text, std::size_t length, float x, float y)
+{
+    TextRenderer::Submit(text, length, x, y);
+}
+
+// - Direct2D は同じデバイスで描くので、描いた場合は基底クラスが追跡中の状態を不明扱いにする
+bool D3D11RenderBackend::OnFlushText()
+{
+    return TextRenderer::Flush(m_D2DRenderTarget, m_TextBrush);
+}
@@ -0,0 +1,123 @@
+﻿//------------------------------------------------------------------------------
+// D3D11RenderBackend
+//------------------------------------------------------------------------------
+// 役割:
+// RenderBackend の Direct3D 11 実装。デバイス / スワップチェーン / 既定の描画状態と、
+// 文字を描くための Direct2D / DirectWrite のオブジェクトを所有する。
+//
+// 設計意図:
+// 以前 Renderer::Init が直接持っていたデバイス作成と固定の状態（ラスタライザ・ブレンド・
+// 深度・サンプラー）をここへ移し、Renderer は RenderBackend 越しにだけ描画する。
+// Gpu〜 ハンドルの実体は ID3D11〜 そのもの（キャストのみで変換し、包まない）。
+// 文字の描画も以前は Renderer が Direct2D を直接持っていたが、Windows 専用の部分をここへ集め、
+// Renderer / RenderQueue などの描画経路を Windows のヘッダなしでビルドできるようにした。
+//
+// NOTE:
+// - GetDevice / GetContext / GetSwapChain は Direct2D の初期化など D3D11 固有の処理用
+// - 定数バッファの範囲設定（VSSetConstantBuffers1）は D3D11.1 のランタイムとドライバが対応している場合のみ使える
+// - 文字は TextRenderer がレイアウトを使い回し、FlushText で 1 回の BeginDraw / EndDraw にまとめて描く
+//------------------------------------------------------------------------------
+#pragma once
+#include <windows.h>
+#include <d3d11.h>
+#include <d3d11_1.h>
+#include <d2d1.h>
+#include <dwrite.h>
+#include "RenderBackend.h"
+
+/// Direct3D 11 の描画バックエンド
+class D3D11RenderBackend : public RenderBackend
+{
+public:
+    ~D3D11RenderBackend() override { Uninit(); }
+
+    const char* GetName() const override { return "D3D11"; }
+    bool SupportsConstantBufferRanges() const override { return m_ConstantBufferRanges; }
+
+    /// デバイス・スワップチェーン・既定の状態・文字の描画用オブジェクトを作成する
+    /// 戻り値：成功した場合 true
+    bool Init(HWND window, UINT width, UINT height);
+
+    /// 作成したものをすべて解放する（未初期化なら何もしない）
+    void Uninit();
+
+    // ----------------------------------------------------------------------
+    // D3D11 固有
+    // ----------------------------------------------------------------------
+    ID3D11Device*        GetDevice() const { return m_Device; }
+    ID3D11DeviceContext* GetContext() const { return m_Context; }
+    IDXGISwapChain*      GetSwapChain() const { return m_SwapChain; }
+
+    /// ID3D11〜 と Gpu〜 ハンドルの変換
+    static ID3D11Buffer*             ToD3D(GpuBuffer* buffer)        { return reinterpret_cast<ID3D11Buffer*>(buffer); }
+    static ID3D11ShaderResourceView* ToD3D(GpuTexture* texture)      { return reinterpret_cast<ID3D11ShaderResourceView*>(texture); }
+    static ID3D11VertexShader*       ToD3D(GpuVertexShader* shader)  { return reinterpret_cast<ID3D11VertexShader*>(shader); }
+    static ID3D11PixelShader*        ToD3D(GpuPixelShader* shader)   { return reinterpret_cast<ID3D11PixelShader*>(shader); }
+    static ID3D11InputLayout*        ToD3D(GpuInputLayout* layout)   { return reinterpret_cast<ID3D11InputLayout*>(layout); }
+
+protected:
+    void OnBeginFrame() override;
+    void OnEndFrame() override;
+
+    GpuBuffer* OnCreateBuffer(const GpuBufferDesc& desc, const void* initialData) override;
+    void OnUpdateBuffer(GpuBuffer* buffer, const void* data, std::uint32_t size) override;
+    void* OnMapDiscard(GpuBuffer* buffer) override;
+    void OnUnmap(GpuBuffer* buffer) override;
+    GpuTexture* OnCreateTexture2D(const GpuTextureDesc& desc, const GpuSubresource* subresources) override;
+    GpuVertexShader* OnCreateVertexShader(const void* bytecode, std::size_t size,
+        const GpuVertexElement* elements, std::uint32_t elementCount, GpuInputLayout** outLayout) override;
+    GpuPixelShader* OnCreatePixelShader(const void* bytecode, std::size_t size) override;
+
+    void OnRelease(GpuBuffer* buffer) override          { ToD3D(buffer)->Release(); }
+    void OnRelease(GpuTexture* texture) override        { ToD3D(texture)->Release(); }
+    void OnRelease(GpuVertexShader* shader) override    { ToD3D(shader)->Release(); }
+    void OnRelease(GpuPixelShader* shader) override     { ToD3D(shader)->Release(); }
+    void OnRelease(GpuInputLayout* layout) override     { ToD3D(layout)->Release(); }
+
+    void OnSetInputLayout(GpuInputLayout* layout) override;
+    void OnSetVertexShader(GpuVertexShader* shader) override;
+    void OnSetPixelShader(GpuPixelShader* shader) override;
+    void OnSetVertexBuffers(std::uint32_t startSlot, std::uint32_t count, GpuBuffer* const* buffers, const std::uint32_t* strides) override;
+    void OnSetIndexBuffer(GpuBuffer* buffer, GpuIndexFormat format) override;
+    void OnSetTopology(GpuTopology topology) override;
+    void OnSetTexture(std::uint32_t slot, GpuTexture* texture) override;
+    void OnSetConstantBufferRange(std::uint32_t slot, std::uint8_t stages, GpuBuffer* buffer,
+                                  std::uint32_t offset, std::uint32_t size) override;
+    void OnSetDepthEnable(bool enable) override;
+    void OnSetAlphaToCoverage(bool enable) override;
+
+    void OnDraw(std::uint32_t vertexCount, std::uint32_t startVertex) override;
+    void OnDrawIndexed(std::uint32_t indexCount, std::uint32_t startIndex, std::int32_t baseVertex) override;
+    void OnDrawInstanced(std::uint32_t vertexCount, std::uint32_t instanceCount, std::uint32_t startInstance) override;
+    void OnDrawIndexedInstanced(std::uint32_t indexCount, std::uint32_t instanceCount,
+                                std::uint32_t startIndex, std::uint32_t startInstance) override;
+
+    void OnSubmitText(const wchar_t* text, std::size_t length, float x, float y) override;
+    bool OnFlushText() override;
+
+private:
+    /// Direct2D / DirectWrite を作成し、TextRenderer を初期化する（スワップチェーンの作成後）
+    bool InitText();
+
+    D3D_FEATURE_LEVEL        m_FeatureLevel      = D3D_FEATURE_LEVEL_11_0;
+    ID3D11Device*            m_Device            = nullptr;
+    ID3D11DeviceContext*     m_Context           = nullptr;
+    ID3D11DeviceContext1*    m_Context1          = nullptr;     // D3D11.1 が使えない場合は nullptr
+    bool                     m_ConstantBufferRanges = false;    // 定数バッファの範囲設定に対応しているか
+    IDXGISwapChain*          m_SwapChain         = nullptr;
+    ID3D11RenderTargetView*  m_RenderTargetView  = nullptr;
+    ID3D11DepthStencilView*  m_DepthStencilView  = nullptr;
+    ID3D11RasterizerState*   m_RasterizerState   = nullptr;
+    ID3D11DepthStencilState* m_DepthStateEnable  = nullptr;
+    ID3D11DepthStencilState* m_DepthStateDisable = nullptr;
+    ID3D11BlendState*        m_BlendState        = nullptr;
+    ID3D11BlendState*        m_BlendStateATC     = nullptr;
+    ID3D11SamplerState*      m_SamplerState      = nullptr;
+
+    // 文字の描画（Direct2D / DirectWrite）
+    ID2D1Factory*            m_D2DFactory        = nullptr;
+    ID2D1RenderTarget*       m_D2DRenderTarget   = nullptr;     // バックバッファへ描く
+    IDWriteFactory*          m_DWriteFactory     = nullptr;
+    IDWriteTextFormat*       m_TextFormat        = nullptr;
+    ID2D1SolidColorBrush*    m_TextBrush         = nullptr;
+};
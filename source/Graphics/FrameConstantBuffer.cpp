@@ -0,0 +1,67 @@
+﻿#include "FrameConstantBuffer.h"
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+namespace
+{
+    constexpr std::uint32_t kMinCapacity = 64 * 1024;  // 作り直しを減らすための最小の大きさ（バイト）
+}
+
+// ------------------------------------------------------------------------------
+// 書き込み
+// ------------------------------------------------------------------------------
+// - 足りない場合は 2 倍（最小 kMinCapacity）で作り直す
+bool FrameConstantBuffer::Begin(RenderBackend& backend, std::uint32_t maxBytes)
+{
+    assert(!m_Mapped && "FrameConstantBuffer::Begin：End の前に Begin した");
+
+    if (maxBytes > m_Capacity)
+    {
+        backend.Release(m_Buffer);
+        m_Capacity = std::max(maxBytes, std::max(m_Capacity * 2, kMinCapacity));
+
+        GpuBufferDesc desc{};
+        desc.size  = m_Capacity;
+        desc.usage = GpuBufferUsage::Dynamic;
+        desc.bind  = GpuBufferBind::Constant;
+        m_Buffer = backend.CreateBuffer(desc, nullptr);
+    }
+
+    m_Mapped = static_cast<std::byte*>(backend.MapDiscard(m_Buffer));
+    m_Used   = 0;
+    m_Limit  = maxBytes;
+    return m_Mapped != nullptr;
+}
+
+std::uint32_t FrameConstantBuffer::Push(const void* data, std::uint32_t size)
+{
+    constexpr std::uint32_t kAlignment = RenderBackend::kConstantRangeAlignment;
+    const std::uint32_t alignedSize = (size + kAlignment - 1) / kAlignment * kAlignment;
+    assert(m_Mapped && m_Used + alignedSize <= m_Limit && "FrameConstantBuffer::Push：Begin で指定した量を超えた");
+
+    const std::uint32_t offset = m_Used;
+    std::memcpy(m_Mapped + offset, data, size);
+    m_Used += alignedSize;
+    return offset;
+}
+
+void FrameConstantBuffer::End(RenderBackend& backend)
+{
+    if (!m_Mapped)
+        return;
+
+    backend.Unmap(m_Buffer, m_Used);
+    m_Mapped = nullptr;
+}
+
+// ------------------------------------------------------------------------------
+// 解放
+// ------------------------------------------------------------------------------
+void FrameConstantBuffer::Release(RenderBackend& backend)
+{
+    End(backend);
+    backend.Release(m_Buffer);
+    m_Buffer   = nullptr;
+    m_Capacity = 0;
+}
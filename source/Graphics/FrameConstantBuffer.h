@@ -0,0 +1,56 @@
+﻿//------------------------------------------------------------------------------
+// FrameConstantBuffer
+//------------------------------------------------------------------------------
+// 役割:
+// 描画ごとの定数（ワールド行列・マテリアル）を 1 つの動的定数バッファへまとめて書き込み、
+// 各描画にはその中の位置（256 バイト単位）だけを渡すための割り当て器。
+//
+// 設計意図:
+// 描画ごとに小さな定数バッファを UpdateBuffer で書き換えると、描画の数だけドライバへの
+// 転送要求が発生する。描画前に全描画分の定数を 1 回の MapDiscard で書き込み、
+// 描画時は範囲を切り替える（VSSetConstantBuffers1）だけにすることで、転送要求を 1 回にまとめる。
+//
+// 構成:
+// - Begin  : maxBytes 分の領域を確保して Map する（足りなければバッファを作り直す）
+// - Push   : 定数を書き込み、バッファ内の位置を返す（256 バイト単位で前から詰める）
+// - End    : Unmap する（書き込んだバイト数を転送量として数える）
+// - Release: バッファを解放する
+//
+// NOTE:
+// - Begin 〜 End の間はバッファを描画に使えない（Map 中のため）。End の後に範囲を設定して描くこと
+// - 1 回の Begin 〜 End で書き込める量は maxBytes まで（超えた場合は assert）
+// - 範囲の設定は RenderBackend::SupportsConstantBufferRanges な実装でのみ行えるので、呼び出し側で確認すること
+//------------------------------------------------------------------------------
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include "RenderBackend.h"
+
+/// 描画ごとの定数をまとめて書き込む動的定数バッファ
+class FrameConstantBuffer
+{
+public:
+    /// 書き込みを開始する
+    /// 戻り値：Map できた場合 true
+    bool Begin(RenderBackend& backend, std::uint32_t maxBytes);
+
+    /// 定数を書き込む（size は 256 バイト単位に切り上げて詰める）
+    /// 戻り値：バッファ内の位置（バイト）
+    std::uint32_t Push(const void* data, std::uint32_t size);
+
+    /// 書き込みを終える
+    void End(RenderBackend& backend);
+
+    /// バッファを解放する
+    void Release(RenderBackend& backend);
+
+    /// 定数を書き込んだバッファ（範囲の設定に使う）
+    GpuBuffer* GetBuffer() const { return m_Buffer; }
+
+private:
+    GpuBuffer*    m_Buffer   = nullptr;     // 所有：動的定数バッファ
+    std::uint32_t m_Capacity = 0;           // m_Buffer の大きさ（バイト）
+    std::byte*    m_Mapped   = nullptr;     // Begin 〜 End の間の書き込み先
+    std::uint32_t m_Used     = 0;           // 書き込み済みのバイト数
+    std::uint32_t m_Limit    = 0;           // Begin で指定された上限
+};
@@ -0,0 +1,222 @@
+﻿#include "FrustumCulling.h"
+#include "Transform.h"
+
+// システム関連
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+// 静的メンバ変数の定義
+CullingBoundsArrays FrustumCulling::s_Bounds;
+std::uint32_t       FrustumCulling::s_BoundsCount = 0;
+std::uint32_t       FrustumCulling::s_CulledCount = 0;
+bool                FrustumCulling::s_Culled      = false;
+
+namespace
+{
+    /// 配列の先頭 index から 4 要素を読み込む
+    inline XMVECTOR Load4(const std::vector<float>& values, std::uint32_t index)
+    {
+        return XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(values.data() + index));
+    }
+
+    /// float 配列すべてに同じ処理を行う（伸長・移動・0 埋め用）
+    template <typename Func>
+    void ForEachFloatArray(CullingBoundsArrays& b, Func&& func)
+    {
+        std::vector<float>* arrays[] = { &b.centerX, &b.centerY, &b.centerZ, &b.radius, &b.localRadius };
+        for (std::vector<float>* values : arrays)
+        {
+            func(*values);
+        }
+    }
+
+    /// Transform（親を含む）が長さを何倍にし得るか
+    /// - スケール × 回転の伸び率はスケールの最大成分なので、親をたどって掛け合わせる
+    float MaxWorldScale(const Transform* transform)
+    {
+        float scale = 1.0f;
+        for (const Transform* t = transform; t; t = t->Parent)
+        {
+            scale *= std::max({ std::fabs(t->Scale.x), std::fabs(t->Scale.y), std::fabs(t->Scale.z) });
+        }
+        return scale;
+    }
+}
+
+// ------------------------------------------------------------------------------
+// 判定
+// ------------------------------------------------------------------------------
+void FrustumCulling::BeginFrame()
+{
+    s_Culled      = false;
+    s_CulledCount = 0;
+}
+
+// 1. Transform から境界球を作り直す
+// 2. viewProjection の列から 6 平面を取り出して正規化する（D3D の深度範囲 0〜1）
+// 3. 4 つずつ、いずれかの平面で「中心の符号付き距離 < -半径」なら外（分岐なし）
+// 4. 外と判定した数を数える
+void FrustumCulling::Cull(FXMMATRIX viewProjection)
+{
+    s_Culled = true;
+    if (s_BoundsCount == 0) return;
+
+    CullingBoundsArrays& b = s_Bounds;
+
+    // 1. 境界球の更新
+    for (std::uint32_t i = 0; i < s_BoundsCount; ++i)
+    {
+        const Transform* transform = b.transforms[i];
+        const Vector3 center = transform->GetWorldPosition();
+        b.centerX[i] = center.x;
+        b.centerY[i] = center.y;
+        b.centerZ[i] = center.z;
+        b.radius[i]  = b.localRadius[i] * MaxWorldScale(transform);
+    }
+
+    // 2. 平面（行ベクトル規約なので、クリップ座標の各成分は行列の列との内積）
+    const XMMATRIX columns = XMMatrixTranspose(viewProjection);
+    const XMVECTOR planes[6] =
+    {
+        XMPlaneNormalize(XMVectorAdd(columns.r[3], columns.r[0])),         // 左
+        XMPlaneNormalize(XMVectorSubtract(columns.r[3], columns.r[0])),    // 右
+        XMPlaneNormalize(XMVectorAdd(columns.r[3], columns.r[1])),         // 下
+        XMPlaneNormalize(XMVectorSubtract(columns.r[3], columns.r[1])),    // 上
+        XMPlaneNormalize(columns.r[2]),                                    // 手前
+        XMPlaneNormalize(XMVectorSubtract(columns.r[3], columns.r[2])),    // 奥
+    };
+
+    // 3. 一括判定（配列はパディング済みなので端数処理は不要）
+    for (std::uint32_t i = 0; i < s_BoundsCount; i += kSimdWidth)
+    {
+        const XMVECTOR cx = Load4(b.centerX, i);
+        const XMVECTOR cy = Load4(b.centerY, i);
+        const XMVECTOR cz = Load4(b.centerZ, i);
+        const XMVECTOR negRadius = XMVectorNegate(Load4(b.radius, i));
+
+        XMVECTOR outside = XMVectorFalseInt();
+        for (const XMVECTOR& plane : planes)
+        {
+            XMVECTOR distance = XMVectorSplatW(plane);
+            distance = XMVectorMultiplyAdd(XMVectorSplatX(plane), cx, distance);
+            distance = XMVectorMultiplyAdd(XMVectorSplatY(plane), cy, distance);
+            distance = XMVectorMultiplyAdd(XMVectorSplatZ(plane), cz, distance);
+            outside = XMVectorOrInt(outside, XMVectorLess(distance, negRadius));
+        }
+
+        XMStoreInt4(b.visible.data() + i, XMVectorEqualInt(outside, XMVectorFalseInt()));
+    }
+
+    // 4. 統計（パディング分は数えない）
+    std::uint32_t culled = 0;
+    for (std::uint32_t i = 0; i < s_BoundsCount; ++i)
+    {
+        culled += b.visible[i] == 0 ? 1u : 0u;
+    }
+    s_CulledCount = culled;
+}
+
+// ------------------------------------------------------------------------------
+// 登録・解除
+// ------------------------------------------------------------------------------
+// - 登録直後は「見える」（このフレームの Cull より後に登録されても消えないように）
+std::uint32_t FrustumCulling::CreateBounds(CullingBounds* owner, const Transform* transform)
+{
+    assert(owner && transform);
+
+    const std::uint32_t index = s_BoundsCount++;
+    ResizeArrays(s_BoundsCount);
+
+    CullingBoundsArrays& b = s_Bounds;
+    b.visible[index]    = 0xFFFFFFFFu;
+    b.owners[index]     = owner;
+    b.transforms[index] = transform;
+    return index;
+}
+
+// - 末尾の境界球を空いた添字へ詰め、配列を密に保つ
+// - 移動した境界球の持ち主（CullingBounds）の添字を書き換える
+void FrustumCulling::DestroyBounds(std::uint32_t index)
+{
+    assert(index < s_BoundsCount);
+    if (index >= s_BoundsCount) return;
+
+    const std::uint32_t last = s_BoundsCount - 1;
+    if (index != last)
+    {
+        MoveBounds(last, index);
+        s_Bounds.owners[index]->m_Index = index;
+    }
+
+    ClearBounds(last);
+    --s_BoundsCount;
+}
+
+// ------------------------------------------------------------------------------
+// 内部処理
+// ------------------------------------------------------------------------------
+// 配列の長さを SIMD 幅の倍数にそろえる（追加分は 0 埋め）
+void FrustumCulling::ResizeArrays(std::uint32_t count)
+{
+    const std::uint32_t padded = (count + kSimdWidth - 1) / kSimdWidth * kSimdWidth;
+    if (s_Bounds.centerX.size() >= padded) return;
+
+    // 伸長は倍々（敵の出現のたびに再確保しないため）
+    const std::size_t newSize = std::max<std::size_t>(padded, s_Bounds.centerX.size() * 2);
+
+    CullingBoundsArrays& b = s_Bounds;
+    ForEachFloatArray(b, [newSize](std::vector<float>& values) { values.resize(newSize, 0.0f); });
+    b.visible.resize(newSize, 0);
+    b.owners.resize(newSize, nullptr);
+    b.transforms.resize(newSize, nullptr);
+}
+
+// 添字 to へ from の内容を移す
+void FrustumCulling::MoveBounds(std::uint32_t from, std::uint32_t to)
+{
+    CullingBoundsArrays& b = s_Bounds;
+    ForEachFloatArray(b, [from, to](std::vector<float>& values) { values[to] = values[from]; });
+    b.visible[to]    = b.visible[from];
+    b.owners[to]     = b.owners[from];
+    b.transforms[to] = b.transforms[from];
+}
+
+// 添字 index を 0 埋めする
+void FrustumCulling::ClearBounds(std::uint32_t index)
+{
+    CullingBoundsArrays& b = s_Bounds;
+    ForEachFloatArray(b, [index](std::vector<float>& values) { values[index] = 0.0f; });
+    b.visible[index]    = 0;
+    b.owners[index]     = nullptr;
+    b.transforms[index] = nullptr;
+}
+
+// ------------------------------------------------------------------------------
+// CullingBounds
+// ------------------------------------------------------------------------------
+void CullingBounds::Register(const Transform* transform)
+{
+    if (IsRegistered())
+    {
+        FrustumCulling::s_Bounds.transforms[m_Index] = transform;
+        return;
+    }
+    m_Index = FrustumCulling::CreateBounds(this, transform);
+}
+
+void CullingBounds::Unregister()
+{
+    if (!IsRegistered()) return;
+
+    FrustumCulling::DestroyBounds(m_Index);
+    m_Index = FrustumCulling::kInvalidBounds;
+}
+
+void CullingBounds::SetLocalRadius(float radius)
+{
+    assert(IsRegistered());
+    if (!IsRegistered()) return;
+
+    FrustumCulling::s_Bounds.localRadius[m_Index] = radius;
+}
@@ -0,0 +1,139 @@
+﻿//------------------------------------------------------------------------------
+// FrustumCulling
+//------------------------------------------------------------------------------
+// 役割:
+// 描画コンポーネント（MeshRenderer / ModelRenderer）のワールド境界球を連続した配列（SoA）で持ち、
+// カメラの視錐台の外にあるものを 4 つずつ SIMD でまとめて判定する。
+//
+// 設計意図:
+// カメラはボールに近づいて追従するため、台の多くは画面外にあるが、
+// これまでは GameObject の Draw がすべての描画パケットを RenderQueue へ積んでいた。
+// 描画の前に一括で判定しておき、Draw では判定結果を 1 回読むだけで画面外の描画を積まないようにする。
+// 境界球は判定の直前に Transform から作り直すので、物理や衝突補正で動いた後の位置で判定される。
+//
+// 構成:
+// - CullingBoundsArrays : 境界球と判定結果の SoA 配列（SIMD 幅に合わせて末尾をパディング）
+// - CullingBounds       : 描画コンポーネントが持つ登録ハンドル（配列上の添字を持つだけ）
+// - FrustumCulling      : 登録と解除（解除は末尾要素との入れ替えで O(1)）、一括判定、統計
+//
+// NOTE:
+// - 境界球の中心は Transform の原点（メッシュの原点）。半径は原点から最も遠い頂点までの距離に
+//   スケールの最大成分を掛けたもの（回転によらず外側に収まる）
+// - Cull は Camera::Draw で呼ばれる。同じフレームでカメラより先に描かれたもの、
+//   Cull より後に登録されたものは「見える」扱いになる（描き過ぎることはあっても消えることはない）
+// - Cull が呼ばれないフレーム（カメラの無いシーン）はすべて「見える」
+// - メインスレッドからのみ操作すること
+//------------------------------------------------------------------------------
+#pragma once
+#include <cstdint>
+#include <vector>
+#include <DirectXMath.h>
+
+using namespace DirectX;
+
+class CullingBounds;
+struct Transform;
+
+/// 境界球の SoA 配列
+/// - 添字 i が 1 つの描画コンポーネントを表す
+/// - 末尾はパディング（SIMD 幅の倍数まで 0 埋め）されている
+struct CullingBoundsArrays
+{
+    std::vector<float> centerX, centerY, centerZ;   // ワールド空間の中心（Cull の先頭で Transform から更新）
+    std::vector<float> radius;                      // ワールド空間の半径（同上）
+    std::vector<float> localRadius;                 // ローカル空間の半径（Transform のスケールを掛ける前）
+    std::vector<std::uint32_t> visible;             // 判定結果（0xFFFFFFFF：見える / 0：視錐台の外）
+
+    // 参照（非所有）
+    std::vector<CullingBounds*>   owners;           // 添字の持ち主
+    std::vector<const Transform*> transforms;       // 境界球の元になる Transform
+};
+
+/// 視錐台カリング
+class FrustumCulling
+{
+public:
+    static constexpr std::uint32_t kInvalidBounds = 0xFFFFFFFFu;  // 未登録を表す添字
+    static constexpr std::uint32_t kSimdWidth     = 4;            // 一括判定の幅
+
+    // ----------------------------------------------------------------------
+    // 判定
+    // ----------------------------------------------------------------------
+    /// フレーム開始（判定前の状態に戻し、統計を 0 にする）
+    static void BeginFrame();
+
+    /// 境界球を Transform から更新し、viewProjection の視錐台の外にあるものを判定する
+    static void Cull(FXMMATRIX viewProjection);
+
+    /// 添字の境界球が見えるか（このフレームでまだ Cull していなければ true）
+    static bool IsVisible(std::uint32_t index)
+    {
+        return !s_Culled || s_Bounds.visible[index] != 0;
+    }
+
+    // ----------------------------------------------------------------------
+    // 統計
+    // ----------------------------------------------------------------------
+    /// 登録中の境界球の数
+    static std::uint32_t GetBoundsCount() { return s_BoundsCount; }
+
+    /// このフレームで視錐台の外と判定した数
+    static std::uint32_t GetCulledCount() { return s_CulledCount; }
+
+private:
+    friend class CullingBounds;
+
+    /// 境界球を登録し、添字を返す
+    static std::uint32_t CreateBounds(CullingBounds* owner, const Transform* transform);
+
+    /// 境界球を解除する（末尾の境界球を空いた添字へ移し、その持ち主の添字を更新する）
+    static void DestroyBounds(std::uint32_t index);
+
+    /// 配列の長さを count 以上の SIMD 幅の倍数にそろえる
+    static void ResizeArrays(std::uint32_t count);
+
+    /// 添字 to へ from の内容を移す
+    static void MoveBounds(std::uint32_t from, std::uint32_t to);
+
+    /// 添字 index を 0 埋めする
+    static void ClearBounds(std::uint32_t index);
+
+private:
+    static CullingBoundsArrays s_Bounds;        // SoA 配列
+    static std::uint32_t       s_BoundsCount;   // 登録中の境界球の数
+    static std::uint32_t       s_CulledCount;   // このフレームで視錐台の外と判定した数
+    static bool                s_Culled;        // このフレームで Cull 済みか
+};
+
+/// 描画コンポーネントが持つ境界球のハンドル
+/// - 状態は FrustumCulling の SoA 配列にあり、ここは添字を持つだけ
+/// - 破棄時に自動で解除する（コピーはできない）
+class CullingBounds
+{
+public:
+    CullingBounds() = default;
+    ~CullingBounds() { Unregister(); }
+
+    CullingBounds(const CullingBounds&) = delete;
+    CullingBounds& operator=(const CullingBounds&) = delete;
+
+    /// transform を元にした境界球を登録する（登録済みなら元の Transform を差し替える）
+    void Register(const Transform* transform);
+
+    /// 登録を解除する（未登録なら何もしない）
+    void Unregister();
+
+    /// ローカル空間の半径を設定する（Transform のスケールを掛ける前の値）
+    void SetLocalRadius(float radius);
+
+    /// 登録済みか
+    bool IsRegistered() const { return m_Index != FrustumCulling::kInvalidBounds; }
+
+    /// 見えるか（未登録なら常に true）
+    bool IsVisible() const { return !IsRegistered() || FrustumCulling::IsVisible(m_Index); }
+
+private:
+    friend class FrustumCulling;
+
+    std::uint32_t m_Index = FrustumCulling::kInvalidBounds;   // FrustumCulling 上の添字（FrustumCulling が入れ替え時に更新する）
+};
@@ -0,0 +1,108 @@
+﻿#include "MeshCache.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+// 静的メンバ変数の定義
+std::unordered_map<std::uint32_t, SharedMesh> MeshCache::s_Meshes;
+
+// ------------------------------------------------------------------------------
+// 取得・登録
+// ------------------------------------------------------------------------------
+SharedMesh* MeshCache::Acquire(std::uint32_t key)
+{
+    auto found = s_Meshes.find(key);
+    if (found == s_Meshes.end())
+        return nullptr;
+
+    ++found->second.refCount;
+    return &found->second;
+}
+
+SharedMesh* MeshCache::Insert(std::uint32_t key,
+                              const VERTEX_3D* vertices, std::uint32_t vertexCount,
+                              const std::uint16_t* indices, std::uint32_t indexCount)
+{
+    assert(s_Meshes.find(key) == s_Meshes.end() && "MeshCache::Insert：登録済みのキー（先に Acquire すること）");
+
+    RenderBackend& backend = Renderer::GetBackend();
+    SharedMesh& mesh = s_Meshes[key];
+
+    GpuBufferDesc desc{};
+    desc.size = sizeof(VERTEX_3D) * vertexCount;
+    desc.bind = GpuBufferBind::Vertex;
+    mesh.vertexBuffer = backend.CreateBuffer(desc, vertices);
+    mesh.vertexCount  = vertexCount;
+
+    float radiusSq = 0.0f;
+    for (std::uint32_t i = 0; i < vertexCount; ++i)
+    {
+        const XMFLOAT3& p = vertices[i].Position;
+        radiusSq = std::max(radiusSq, p.x * p.x + p.y * p.y + p.z * p.z);
+    }
+    mesh.boundingRadius = std::sqrt(radiusSq);
+    mesh.vertices.assign(vertices, vertices + vertexCount);
+
+    if (indices && indexCount > 0)
+    {
+        desc.size = sizeof(std::uint16_t) * indexCount;
+        desc.bind = GpuBufferBind::Index;
+        mesh.indexBuffer = backend.CreateBuffer(desc, indices);
+        mesh.indexCount  = indexCount;
+        mesh.indices.assign(indices, indices + indexCount);
+    }
+
+    mesh.refCount = 1;
+    return &mesh;
+}
+
+// ------------------------------------------------------------------------------
+// 解放
+// ------------------------------------------------------------------------------
+void MeshCache::Release(SharedMesh* mesh)
+{
+    if (!mesh)
+        return;
+
+    assert(mesh->refCount > 0 && "MeshCache::Release：参照カウントが 0 の形状を解放した");
+    --mesh->refCount;
+}
+
+// - シーン差し替え後に呼び、新シーンで使われない形状のバッファを手放す
+std::size_t MeshCache::PurgeUnused()
+{
+    std::size_t purged = 0;
+    for (auto it = s_Meshes.begin(); it != s_Meshes.end();)
+    {
+        if (it->second.refCount == 0)
+        {
+            Destroy(it->second);
+            it = s_Meshes.erase(it);
+            ++purged;
+        }
+        else
+        {
+            ++it;
+        }
+    }
+    return purged;
+}
+
+// - 終了時は全 MeshRenderer が解放済みのはずなので、参照が残っていれば解放漏れ
+void MeshCache::Uninit()
+{
+    for (auto& pair : s_Meshes)
+    {
+        assert(pair.second.refCount == 0 && "MeshCache::Uninit：参照が残っている形状がある");
+        Destroy(pair.second);
+    }
+    s_Meshes.clear();
+}
+
+void MeshCache::Destroy(SharedMesh& mesh)
+{
+    RenderBackend& backend = Renderer::GetBackend();
+    backend.Release(mesh.vertexBuffer);
+    backend.Release(mesh.indexBuffer);
+    mesh = SharedMesh{};
+}
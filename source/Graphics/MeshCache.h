@@ -0,0 +1,80 @@
+﻿//------------------------------------------------------------------------------
+// MeshCache
+//------------------------------------------------------------------------------
+// 役割:
+// MeshRenderer の手続き形状（単位ボックス / 平面 / 球）の頂点・インデックスバッファを
+// 形状と分割数のキーで 1 組だけ作り、参照カウントで共有する。
+//
+// 設計意図:
+// 形状の中身はキーが同じなら常に同じなのに、コンポーネントごとにバッファを作って転送すると、
+// 敵や衝撃波の出現のたびに GPU リソースの作成が走り、使用メモリもオブジェクト数に比例して増える。
+// 共有すれば出現時にバッファを作らず、RenderQueue のインスタンス化も同じバッファ同士でまとまる。
+//
+// 構成:
+// - SharedMesh : 共有されるバッファと頂点数 / インデックス数、境界球の半径、参照カウント、頂点の CPU 側の写し
+// - Acquire    : キーが登録済みなら参照を 1 つ増やして返す（未登録なら nullptr）
+// - Insert     : バッファを作って登録し、参照 1 で返す
+// - Release    : 参照を 1 つ減らす（0 になってもすぐには解放しない）
+// - PurgeUnused: 参照 0 の形状を解放する（シーン差し替え後に呼ぶ）
+// - Uninit     : すべて解放する（Renderer::Uninit より前に呼ぶこと）
+//
+// NOTE:
+// - 参照 0 でも残しておくのは、敵が全滅した直後の再出現でバッファを作り直さないため
+// - CPU 側の写しは手続き形状の頂点数が小さい（球でも数百）ので常に持つ
+// - メインスレッドからのみ呼ぶこと
+//------------------------------------------------------------------------------
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "Renderer.h"
+
+/// 共有される手続き形状
+struct SharedMesh
+{
+    GpuBuffer*    vertexBuffer = nullptr;
+    GpuBuffer*    indexBuffer  = nullptr;  // インデックスを持たない形状は nullptr
+    std::uint32_t vertexCount  = 0;
+    std::uint32_t indexCount   = 0;
+    float         boundingRadius = 0.0f;   // 原点から最も遠い頂点までの距離（視錐台カリング用）
+    std::uint32_t refCount     = 0;
+
+    std::vector<VERTEX_3D>     vertices;   // CPU 側の写し（StaticBatch が変換して取り込む）
+    std::vector<std::uint16_t> indices;    // 同上（インデックスを持たない形状は空）
+};
+
+/// 手続き形状のキャッシュ
+class MeshCache
+{
+public:
+    /// 登録済みなら参照を増やして返す
+    /// 戻り値：未登録なら nullptr（呼び出し側で形状を作って Insert すること）
+    static SharedMesh* Acquire(std::uint32_t key);
+
+    /// バッファを作って登録する（参照 1 で返す）
+    /// - indices が nullptr / indexCount が 0 ならインデックスバッファは作らない
+    static SharedMesh* Insert(std::uint32_t key,
+                              const VERTEX_3D* vertices, std::uint32_t vertexCount,
+                              const std::uint16_t* indices, std::uint32_t indexCount);
+
+    /// 参照を 1 つ減らす（nullptr は無視）
+    static void Release(SharedMesh* mesh);
+
+    /// 参照 0 の形状を解放する
+    /// 戻り値：解放した形状の数
+    static std::size_t PurgeUnused();
+
+    /// すべての形状を解放する
+    static void Uninit();
+
+    /// 登録中の形状の数（GPU 上のバッファ組の数）
+    static std::size_t GetMeshCount() { return s_Meshes.size(); }
+
+private:
+    /// バッファを解放する
+    static void Destroy(SharedMesh& mesh);
+
+private:
+    static std::unordered_map<std::uint32_t, SharedMesh> s_Meshes;   // 所有：キー → 形状（要素のアドレスは不変）
+};
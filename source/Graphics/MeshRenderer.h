@@ -1,10 +1,18 @@
 ﻿#pragma once
 
-#include "main.h"
-#include "Component.h"
-#include "renderer.h"
-#include "vector3.h"
+#include "component.h"
+#include "Renderer.h"
+#include "RenderQueue.h"
+#include "MeshCache.h"
+#include "ShaderCache.h"
+#include "TextureCache.h"
+#include "FrustumCulling.h"
+#include "Vector3.h"
 #include "Transform.h"
+#include <cstdint>
+#include <iterator>
+#include <algorithm>
+#include <cmath>
 #include <string>
 #include <vector>
 #include <DirectXMath.h>
@@ -24,11 +32,11 @@ enum class MeshShape
 class MeshRenderer : public Component
 {	
 public:
-	ID3D11Buffer*               m_VertexBuffer  = nullptr;
-    ID3D11InputLayout*          m_VertexLayout  = nullptr;
-    ID3D11VertexShader*         m_VertexShader  = nullptr;
-    ID3D11PixelShader*          m_PixelShader   = nullptr;
-    ID3D11ShaderResourceView*   m_Texture       = nullptr;
+	GpuBuffer*                  m_VertexBuffer  = nullptr;
+    GpuInputLayout*             m_VertexLayout  = nullptr;
+    GpuVertexShader*            m_VertexShader  = nullptr;
+    GpuPixelShader*             m_PixelShader   = nullptr;
+    SharedTexture*              m_Texture       = nullptr;    // 非所有：TextureCache のテクスチャ
     Transform*                  m_Transform     = nullptr;
 
     Vector3 m_LocalScale = { 1.0f, 1.0f, 1.0f };
@@ -37,9 +45,17 @@ public:
 	bool m_EnableTexture = false;
 
 private:
-    ID3D11Buffer* m_IndexBuffer = nullptr;
-    UINT m_IndexCount = 0;
-	UINT m_VertexCount = 0;
+    GpuBuffer* m_IndexBuffer = nullptr;
+    std::uint32_t m_IndexCount = 0;
+	std::uint32_t m_VertexCount = 0;
+	SharedMesh* m_SharedMesh = nullptr;						// 非所有：MeshCache の形状（頂点 / インデックスバッファはここから借りる）
+	SharedVertexShader* m_SharedVertexShader = nullptr;		// 非所有：ShaderCache の VS（m_VertexShader / m_VertexLayout はここから借りる）
+	SharedPixelShader* m_SharedPixelShader = nullptr;		// 非所有：ShaderCache の PS（m_PixelShader はここから借りる）
+	const InstancedShader* m_InstancedShader = nullptr;		// 非所有：インスタンス描画版の VS（無ければ nullptr）
+	CullingBounds m_Bounds;									// 視錐台カリング用の境界球（Transform がある場合だけ登録する）
+	bool m_StaticBatched = false;							// StaticBatch に取り込まれた（以後は描画しない）
+
+	friend class StaticBatch;								// 取り込み時に形状・シェーダー・テクスチャの参照を受け渡すため
 
 public:
 	MeshRenderer() = default;
@@ -47,37 +63,65 @@ public:
 
 	/// <summary>
 	/// </summary>
-	void Init() override {};
+	void Init() override
+	{
+		if (m_Transform)
+		{
+			m_Bounds.Register(m_Transform);
+			UpdateBoundingRadius();
+		}
+	}
 	void Uninit() override { Release(); };
 
     // ----------------------------------------------------------------------
     // ----------------------------------------------------------------------
 	/// <summary>
+	/// テクスチャを TextureCache から借りる
+	/// デコードは別スレッドで行われ、転送されるまでは白い代用テクスチャで描く（ここでは待たない）
 	/// </summary>
 	void SetTexture(const std::wstring& filePath)
 	{
-		TexMetadata Metadata{};
-		ScratchImage Image{};
-        if (SUCCEEDED(LoadFromWICFile(filePath.c_str(), WIC_FLAGS_NONE, &Metadata, Image)))
-        {
-            CreateShaderResourceView(Renderer::GetDevice(), Image.GetImages(), Image.GetImageCount(), Metadata, &m_Texture);
-			m_EnableTexture = true;
-        }
+		TextureCache::Release(m_Texture);
+		m_Texture = TextureCache::Acquire(filePath);
+		m_EnableTexture = true;
 	}
 
 	/// <summary>
 	/// </summary>
 	void LoadShader(const char* vsFilePath, const char* psFilePath)
 	{
-        Renderer::CreateVertexShader(&m_VertexShader, &m_VertexLayout, vsFilePath);
-        Renderer::CreatePixelShader(&m_PixelShader, psFilePath);
+        ReleaseShader();
+        BindSharedShader(ShaderCache::AcquireVertexShader(vsFilePath), ShaderCache::AcquirePixelShader(psFilePath));
+        m_InstancedShader = RenderQueue::FindInstancedShader(vsFilePath);
     }
 
+	/// <summary>
+	/// インスタンス描画用のシェーダーを読み込む
+	/// 頂点（スロット 0：VERTEX_3D）に加え、スロット 1 からインスタンスごとの
+	/// INSTANCE（float4：xyz = ワールド位置 / w = 一様スケール）を受け取る入力レイアウトを作る
+	/// NOTE: このシェーダーを読み込んだ MeshRenderer は DrawInstanced で描画する
+	/// </summary>
+	void LoadInstancedShader(const char* vsFilePath, const char* psFilePath)
+	{
+		const GpuVertexElement layout[] =
+		{
+			{ "POSITION", 0, GpuVertexFormat::Float3, 0, 0,      false },
+			{ "NORMAL",   0, GpuVertexFormat::Float3, 0, 4 * 3,  false },
+			{ "COLOR",    0, GpuVertexFormat::Float4, 0, 4 * 6,  false },
+			{ "TEXCOORD", 0, GpuVertexFormat::Float2, 0, 4 * 10, false },
+			{ "INSTANCE", 0, GpuVertexFormat::Float4, 1, 0,      true  },
+		};
+
+		ReleaseShader();
+		BindSharedShader(ShaderCache::AcquireVertexShader(vsFilePath, layout, static_cast<std::uint32_t>(std::size(layout))), ShaderCache::AcquirePixelShader(psFilePath));
+	}
+
     /// <summary>
     /// </summary>
     void SetLocalScale(float x, float y, float z)
     {
         m_LocalScale = { x, y, z };
+        UpdateBoundingRadius();
     }
 
     /// ------------------------------------------------------------------------
@@ -86,6 +130,11 @@ public:
     /// </summary>
     void CreateUnitPlane()
     {
+        m_Shape = MeshShape::Plane;
+        const std::uint32_t key = MakeMeshKey(MeshShape::Plane, 0, 0);
+        if (AcquireSharedMesh(key))
+            return;
+
 		VERTEX_3D v[4];
 		v[0].Position = {-0.5f, 0.0f,  0.5f};
 		v[1].Position = { 0.5f, 0.0f,  0.5f};
@@ -98,14 +147,18 @@ public:
 			v[i].Diffuse = { 1.0f, 1.0f, 1.0f, 1.0f };
 			v[i].TexCoord = { (i % 2) ? 1.0f : 0.0f, (i / 2) ? 1.0f : 0.0f };
 		}
-		MakeVertexBuffer(v, 4);
-        m_Shape = MeshShape::Plane;
+		InsertSharedMesh(key, v, 4, nullptr, 0);
     }
 
     /// <summary>
     /// </summary>
     void CreateUnitBox()
     {
+        m_Shape = MeshShape::Box;
+        const std::uint32_t key = MakeMeshKey(MeshShape::Box, 0, 0);
+        if (AcquireSharedMesh(key))
+            return;
+
         const float h = 0.5f;
 
         VERTEX_3D v[24] =
@@ -146,15 +199,18 @@ public:
         20, 22, 21, 21, 22, 23,
     };
 
-        MakeVertexBuffer(v, 24);
-        MakeIndexBuffer(indices, 36);
-        m_Shape = MeshShape::Box;
+        InsertSharedMesh(key, v, 24, indices, 36);
     }
 
     /// <summary>
     /// </summary>
     void CreateUnitSphere(int slices = 16, int stacks = 16)
     {
+        m_Shape = MeshShape::Sphere;
+        const std::uint32_t key = MakeMeshKey(MeshShape::Sphere, slices, stacks);
+        if (AcquireSharedMesh(key))
+            return;
+
         std::vector<VERTEX_3D> vertices;
         vertices.reserve((stacks + 1) * (slices + 1));
 
@@ -189,8 +245,7 @@ public:
             }
         }
 
-        MakeVertexBuffer(vertices.data(), static_cast<UINT>(vertices.size()));
-        m_Shape = MeshShape::Sphere;
+        InsertSharedMesh(key, vertices.data(), static_cast<std::uint32_t>(vertices.size()), nullptr, 0);
     }
 
     /// ----------------------------------------------------------------------
@@ -199,101 +254,215 @@ public:
 	/// </summary>
 	void Draw() override
     {
+        // 視錐台の外なら積まない（判定は Camera::Draw でまとめて行われている）
+        // StaticBatch に取り込まれたものは StaticBatch 側で描かれる
+        if (m_StaticBatched || !m_Bounds.IsVisible())
+            return;
+
         const auto localScaleMatrix = XMMatrixScaling(m_LocalScale.x, m_LocalScale.y, m_LocalScale.z);
         const auto world = localScaleMatrix * m_Transform->GetWorldMatrix();
 
-        MATERIAL mat{};
-        mat.Diffuse = m_Color;
-        mat.Ambient = {1,1,1,1};
-        mat.TextureEnable = m_EnableTexture;
-
-        Renderer::SetMaterial(mat);
-        Renderer::SetWorldMatrix(world);
+        // 描画は RenderQueue に溜め、状態の近い描画とまとめて Renderer::End で行う
+        RenderPacket packet;
+        packet.instanced    = m_InstancedShader;
+        packet.layout       = m_VertexLayout;
+        packet.vertexShader = m_VertexShader;
+        packet.pixelShader  = m_PixelShader;
+        packet.texture      = GetTexture();
+        packet.vertexBuffer = m_VertexBuffer;
+        packet.topology     = GetTopology();
+        packet.pass         = m_Color.w < 1.0f ? RenderPass::Transparent : RenderPass::Opaque;
 
-        auto ctx = Renderer::GetDeviceContext();
-        ctx->IASetInputLayout(m_VertexLayout);
-        ctx->VSSetShader(m_VertexShader, nullptr, 0);
-        ctx->PSSetShader(m_PixelShader, nullptr, 0);
+        packet.material.Diffuse = m_Color;
+        packet.material.Ambient = {1,1,1,1};
+        packet.material.TextureEnable = m_EnableTexture;
 
-        UINT stride = sizeof(VERTEX_3D), offset = 0;
-        ctx->IASetVertexBuffers(0, 1, &m_VertexBuffer, &stride, &offset);
-        
-        if (m_Texture)
-        {
-            ctx->PSSetShaderResources(0, 1, &m_Texture);
-        }
+        XMStoreFloat4x4(&packet.world, world);
 
         if (m_IndexBuffer && m_IndexCount > 0)
         {
-            ctx->IASetIndexBuffer(m_IndexBuffer, DXGI_FORMAT_R16_UINT, 0);
-            ctx->IASetPrimitiveTopology(GetTopology());
-            ctx->DrawIndexed(m_IndexCount, 0, 0);
+            packet.indexBuffer = m_IndexBuffer;
+            packet.indexFormat = GpuIndexFormat::UInt16;
+            packet.count       = m_IndexCount;
         }
         else
         {
-            ctx->IASetPrimitiveTopology(GetTopology());
-            ctx->Draw(m_VertexCount, 0);
+            packet.count = m_VertexCount;
         }
+
+        RenderQueue::Submit(packet);
     }
-	
+
+	/// <summary>
+	/// インスタンス描画
+	/// メッシュを instanceCount 個まとめて 1 回の DrawIndexedInstanced / DrawInstanced で描く
+	/// instanceBuffer はスロット 1 に、stride 間隔のインスタンスデータとして渡す
+	/// NOTE: LoadInstancedShader で読み込んだシェーダーを使うこと（ワールド行列はインスタンスデータから作る）
+	/// </summary>
+	void DrawInstanced(GpuBuffer* instanceBuffer, std::uint32_t instanceStride, std::uint32_t instanceCount)
+	{
+		if (instanceCount == 0)
+			return;
+
+		MATERIAL mat{};
+		mat.Diffuse = m_Color;
+		mat.Ambient = {1,1,1,1};
+		mat.TextureEnable = m_EnableTexture;
+		Renderer::SetMaterial(mat);
+
+		RenderBackend& backend = Renderer::GetBackend();
+		backend.SetInputLayout(m_VertexLayout);
+		backend.SetVertexShader(m_VertexShader);
+		backend.SetPixelShader(m_PixelShader);
+
+		GpuBuffer* const buffers[2] = { m_VertexBuffer, instanceBuffer };
+		const std::uint32_t strides[2] = { sizeof(VERTEX_3D), instanceStride };
+		backend.SetVertexBuffers(0, 2, buffers, strides);
+
+		if (m_Texture)
+		{
+			backend.SetTexture(0, GetTexture());
+		}
+
+		backend.SetTopology(GetTopology());
+		if (m_IndexBuffer && m_IndexCount > 0)
+		{
+			backend.SetIndexBuffer(m_IndexBuffer, GpuIndexFormat::UInt16);
+			backend.DrawIndexedInstanced(m_IndexCount, instanceCount);
+		}
+		else
+		{
+			backend.DrawInstanced(m_VertexCount, instanceCount);
+		}
+	}
+
 private:
 	/// <summary>
+	/// 形状と分割数から MeshCache のキーを作る（同じ引数の Create〜 は同じ頂点内容になる）
 	/// </summary>
-    void MakeVertexBuffer(const VERTEX_3D* verts, UINT count)
-    {
-        m_VertexCount = count;
-        D3D11_BUFFER_DESC bd{};
-        bd.Usage = D3D11_USAGE_DEFAULT;
-        bd.ByteWidth = sizeof(VERTEX_3D) * count;
-        bd.BindFlags = D3D11_BIND_VERTEX_BUFFER;
+	static std::uint32_t MakeMeshKey(MeshShape shape, int slices, int stacks)
+	{
+		return (static_cast<std::uint32_t>(shape) + 1) << 24
+			| (static_cast<std::uint32_t>(slices) & 0xFFF) << 12
+			| (static_cast<std::uint32_t>(stacks) & 0xFFF);
+	}
 
-        D3D11_SUBRESOURCE_DATA sd{};
-        sd.pSysMem = verts;
+	/// <summary>
+	/// MeshCache に登録済みの形状を借りる（前に持っていた形状は返す）
+	/// 戻り値：登録済みなら true（バッファは作らない）
+	/// </summary>
+	bool AcquireSharedMesh(std::uint32_t key)
+	{
+		ReleaseMesh();
+		return BindSharedMesh(MeshCache::Acquire(key));
+	}
 
-        Renderer::GetDevice()->CreateBuffer(&bd, &sd, &m_VertexBuffer);
-    }
+	/// <summary>
+	/// 形状のバッファを作って MeshCache に登録し、それを借りる
+	/// </summary>
+	void InsertSharedMesh(std::uint32_t key, const VERTEX_3D* verts, std::uint32_t vertexCount, const uint16_t* indices, std::uint32_t indexCount)
+	{
+		BindSharedMesh(MeshCache::Insert(key, verts, vertexCount, indices, indexCount));
+	}
 
-    /// <summary>
-    /// </summary>
-    void MakeIndexBuffer(const uint16_t* indices, UINT count)
-    {
-        m_IndexCount = count;
+	bool BindSharedMesh(SharedMesh* mesh)
+	{
+		m_SharedMesh = mesh;
+		if (!mesh)
+			return false;
+
+		m_VertexBuffer = mesh->vertexBuffer;
+		m_IndexBuffer  = mesh->indexBuffer;
+		m_VertexCount  = mesh->vertexCount;
+		m_IndexCount   = mesh->indexCount;
+		UpdateBoundingRadius();
+		return true;
+	}
+
+	/// <summary>
+	/// 借りている形状を MeshCache に返す（バッファは解放しない）
+	/// </summary>
+	void ReleaseMesh()
+	{
+		MeshCache::Release(m_SharedMesh);
+		m_SharedMesh   = nullptr;
+		m_VertexBuffer = nullptr;
+		m_IndexBuffer  = nullptr;
+		m_VertexCount  = 0;
+		m_IndexCount   = 0;
+		UpdateBoundingRadius();
+	}
 
-        D3D11_BUFFER_DESC bd{};
-        bd.Usage = D3D11_USAGE_DEFAULT;
-        bd.ByteWidth = sizeof(uint16_t) * count;
-        bd.BindFlags = D3D11_BIND_INDEX_BUFFER;
+	/// <summary>
+	/// 境界球の半径を形状とローカルスケールから求め直す（Transform のスケールは判定時に掛ける）
+	/// </summary>
+	void UpdateBoundingRadius()
+	{
+		if (!m_Bounds.IsRegistered())
+			return;
 
-        D3D11_SUBRESOURCE_DATA sd{};
-        sd.pSysMem = indices;
+		const float meshRadius = m_SharedMesh ? m_SharedMesh->boundingRadius : 0.0f;
+		const float maxScale = std::max({ std::fabs(m_LocalScale.x), std::fabs(m_LocalScale.y), std::fabs(m_LocalScale.z) });
+		m_Bounds.SetLocalRadius(meshRadius * maxScale);
+	}
 
-        Renderer::GetDevice()->CreateBuffer(&bd, &sd, &m_IndexBuffer);
-    }
+	/// <summary>
+	/// ShaderCache のシェーダーを借りる
+	/// </summary>
+	void BindSharedShader(SharedVertexShader* vertexShader, SharedPixelShader* pixelShader)
+	{
+		m_SharedVertexShader = vertexShader;
+		m_SharedPixelShader  = pixelShader;
+		m_VertexShader = vertexShader->shader;
+		m_VertexLayout = vertexShader->layout;
+		m_PixelShader  = pixelShader->shader;
+	}
+
+	/// <summary>
+	/// 借りているシェーダーを ShaderCache に返す（シェーダーは解放しない）
+	/// </summary>
+	void ReleaseShader()
+	{
+		ShaderCache::Release(m_SharedVertexShader);
+		ShaderCache::Release(m_SharedPixelShader);
+		m_SharedVertexShader = nullptr;
+		m_SharedPixelShader  = nullptr;
+		m_VertexShader = nullptr;
+		m_VertexLayout = nullptr;
+		m_PixelShader  = nullptr;
+	}
+
+	/// <summary>
+	/// 描画に使うテクスチャ（未設定なら nullptr、転送前なら代用テクスチャ）
+	/// </summary>
+	GpuTexture* GetTexture() const
+	{
+		return m_Texture ? TextureCache::GetTexture(m_Texture) : nullptr;
+	}
 
 	/// <summary>
 	/// </summary>
-	D3D11_PRIMITIVE_TOPOLOGY GetTopology() const
+	GpuTopology GetTopology() const
 	{
 		switch (m_Shape)
 		{
 			case MeshShape::Plane:
-				return D3D11_PRIMITIVE_TOPOLOGY_TRIANGLESTRIP;
+				return GpuTopology::TriangleStrip;
 			case MeshShape::Box:
-				return D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST;
+				return GpuTopology::TriangleList;
 			case MeshShape::Sphere:
-				return D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST;
+				return GpuTopology::TriangleList;
 			default:
-				return D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST;
+				return GpuTopology::TriangleList;
 		}
 	}
 
     void Release()
     {
-        if (m_Texture)       { m_Texture->Release(); m_Texture = nullptr; }
-        if (m_VertexBuffer)  { m_VertexBuffer->Release(); m_VertexBuffer = nullptr; }
-        if (m_VertexLayout)  { m_VertexLayout->Release(); m_VertexLayout = nullptr; }
-        if (m_VertexShader)  { m_VertexShader->Release(); m_VertexShader = nullptr; }
-        if (m_PixelShader)   { m_PixelShader->Release(); m_PixelShader = nullptr; }
-        if (m_IndexBuffer)   { m_IndexBuffer->Release(); m_IndexBuffer = nullptr; }
+        TextureCache::Release(m_Texture);
+        m_Texture = nullptr;
+        ReleaseShader();
+        ReleaseMesh();
+        m_Bounds.Unregister();
     }
 };
@@ -0,0 +1,129 @@
+﻿#include "RecordingRenderBackend.h"
+
+#include <cassert>
+
+// - 解放漏れがあっても破棄できないので、件数だけ確認する
+RecordingRenderBackend::~RecordingRenderBackend()
+{
+    assert(m_LiveObjects == 0 && "RecordingRenderBackend：解放されていないリソースがある");
+}
+
+// ------------------------------------------------------------------------------
+// フレーム
+// ------------------------------------------------------------------------------
+// - 基底クラスが確定させる前の現在値を累計へ足す
+void RecordingRenderBackend::OnEndFrame()
+{
+    const RenderStats& frame = GetCurrentStats();
+    m_TotalStats.drawCalls       += frame.drawCalls;
+    m_TotalStats.instances       += frame.instances;
+    m_TotalStats.stateChanges    += frame.stateChanges;
+    m_TotalStats.redundantStates += frame.redundantStates;
+    m_TotalStats.uploadedBytes   += frame.uploadedBytes;
+    m_TotalStats.bufferUpdates   += frame.bufferUpdates;
+    m_TotalStats.createdObjects  += frame.createdObjects;
+    ++m_FrameCount;
+}
+
+// ------------------------------------------------------------------------------
+// リソース
+// ------------------------------------------------------------------------------
+// - Dynamic バッファだけ MapDiscard 用の領域を持つ
+GpuBuffer* RecordingRenderBackend::OnCreateBuffer(const GpuBufferDesc& desc, const void* initialData)
+{
+    const std::size_t storage = (desc.usage == GpuBufferUsage::Dynamic) ? desc.size : 0;
+    RecordedObject* object = NewObject(storage);
+    object->size = desc.size;
+    return reinterpret_cast<GpuBuffer*>(object);
+}
+
+void* RecordingRenderBackend::OnMapDiscard(GpuBuffer* buffer)
+{
+    RecordedObject* object = reinterpret_cast<RecordedObject*>(buffer);
+    if (object->storage.empty())
+        return nullptr;
+
+    object->mapped = true;
+    return object->storage.data();
+}
+
+void RecordingRenderBackend::OnUnmap(GpuBuffer* buffer)
+{
+    reinterpret_cast<RecordedObject*>(buffer)->mapped = false;
+}
+
+GpuTexture* RecordingRenderBackend::OnCreateTexture2D(const GpuTextureDesc& desc, const GpuSubresource* subresources)
+{
+    return reinterpret_cast<GpuTexture*>(NewObject());
+}
+
+GpuVertexShader* RecordingRenderBackend::OnCreateVertexShader(const void* bytecode, std::size_t size,
+    const GpuVertexElement* elements, std::uint32_t elementCount, GpuInputLayout** outLayout)
+{
+    if (outLayout)
+    {
+        *outLayout = reinterpret_cast<GpuInputLayout*>(NewObject());
+    }
+    return reinterpret_cast<GpuVertexShader*>(NewObject());
+}
+
+GpuPixelShader* RecordingRenderBackend::OnCreatePixelShader(const void* bytecode, std::size_t size)
+{
+    return reinterpret_cast<GpuPixelShader*>(NewObject());
+}
+
+void RecordingRenderBackend::OnRelease(GpuBuffer* buffer)
+{
+    for (const RecordedObject*& bound : m_ConstantBuffers)
+    {
+        if (bound == reinterpret_cast<const RecordedObject*>(buffer))
+        {
+            bound = nullptr;
+        }
+    }
+    DeleteObject(buffer);
+}
+
+void RecordingRenderBackend::OnRelease(GpuTexture* texture)      { DeleteObject(texture); }
+void RecordingRenderBackend::OnRelease(GpuVertexShader* shader)  { DeleteObject(shader); }
+void RecordingRenderBackend::OnRelease(GpuPixelShader* shader)   { DeleteObject(shader); }
+void RecordingRenderBackend::OnRelease(GpuInputLayout* layout)   { DeleteObject(layout); }
+
+RecordingRenderBackend::RecordedObject* RecordingRenderBackend::NewObject(std::size_t storageSize)
+{
+    RecordedObject* object = new RecordedObject;
+    object->storage.resize(storageSize);
+    ++m_LiveObjects;
+    return object;
+}
+
+void RecordingRenderBackend::DeleteObject(void* handle)
+{
+    assert(m_LiveObjects > 0);
+    delete static_cast<RecordedObject*>(handle);
+    --m_LiveObjects;
+}
+
+// ------------------------------------------------------------------------------
+// 状態の設定・描画の確認
+// ------------------------------------------------------------------------------
+void RecordingRenderBackend::OnSetConstantBufferRange(std::uint32_t slot, std::uint8_t stages, GpuBuffer* buffer,
+                                                      std::uint32_t offset, std::uint32_t size)
+{
+    const RecordedObject* object = reinterpret_cast<const RecordedObject*>(buffer);
+    assert((!object || size == 0 || offset + size <= object->size)
+        && "RecordingRenderBackend：定数バッファの範囲がバッファの外にはみ出している");
+
+    if (slot < kMaxConstantSlots)
+    {
+        m_ConstantBuffers[slot] = object;
+    }
+}
+
+void RecordingRenderBackend::CheckDrawState() const
+{
+    for (const RecordedObject* bound : m_ConstantBuffers)
+    {
+        assert((!bound || !bound->mapped) && "RecordingRenderBackend：Map 中の定数バッファを設定したまま描画した");
+    }
+}
@@ -0,0 +1,109 @@
+﻿//------------------------------------------------------------------------------
+// RecordingRenderBackend
+//------------------------------------------------------------------------------
+// 役割:
+// GPU を使わない描画バックエンド。リソースは CPU 側のダミーで、描画は統計に数えるだけ。
+//
+// 設計意図:
+// 描画経路の最適化（状態変更の削減・インスタンス化・転送量の削減など）の効果を、
+// GPU や Windows の無い環境でも「描画呼び出し数・状態変更数・転送量」で比較できるようにする。
+// フレームごとの統計は基底クラスが集計するので、ここでは全フレームの累計と
+// 生存中のリソース数（解放漏れの確認用）だけを持つ。
+//
+// NOTE:
+// - Dynamic バッファの MapDiscard は CPU 側の領域を返す（書き込み自体は実際に行える）
+// - 定数バッファの範囲がバッファに収まっているか、描画時に設定中の定数バッファが Map されたままでないかを
+//   assert で確かめる（D3D11 では検出されずに描画が壊れる誤りを、GPU の無い環境で見つけるため）
+// - 画面への出力は無い。フレーム時間は描画を除いた CPU 側の処理だけになる
+// - 文字（SubmitText）は数えずに捨てる（文字の描画は D3D11 実装の TextRenderer が数える）
+// - 定数バッファの範囲設定への対応はコンストラクタで切り替えられる（D3D11.1 が無い環境の経路を比べるため）
+//------------------------------------------------------------------------------
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "RenderBackend.h"
+
+/// 記録用（GPU を使わない）描画バックエンド
+class RecordingRenderBackend : public RenderBackend
+{
+public:
+    explicit RecordingRenderBackend(bool constantBufferRanges = true) : m_ConstantBufferRanges(constantBufferRanges) {}
+    ~RecordingRenderBackend() override;
+
+    const char* GetName() const override { return "Recording"; }
+    bool SupportsConstantBufferRanges() const override { return m_ConstantBufferRanges; }
+
+    /// 記録したフレーム数
+    std::uint64_t GetFrameCount() const { return m_FrameCount; }
+
+    /// 全フレームの累計
+    const RenderStats& GetTotalStats() const { return m_TotalStats; }
+
+    /// 生存中のリソース数（作成 - 解放）
+    std::size_t GetLiveObjectCount() const { return m_LiveObjects; }
+
+protected:
+    void OnBeginFrame() override {}
+    void OnEndFrame() override;
+
+    GpuBuffer* OnCreateBuffer(const GpuBufferDesc& desc, const void* initialData) override;
+    void OnUpdateBuffer(GpuBuffer* buffer, const void* data, std::uint32_t size) override {}
+    void* OnMapDiscard(GpuBuffer* buffer) override;
+    void OnUnmap(GpuBuffer* buffer) override;
+    GpuTexture* OnCreateTexture2D(const GpuTextureDesc& desc, const GpuSubresource* subresources) override;
+    GpuVertexShader* OnCreateVertexShader(const void* bytecode, std::size_t size,
+        const GpuVertexElement* elements, std::uint32_t elementCount, GpuInputLayout** outLayout) override;
+    GpuPixelShader* OnCreatePixelShader(const void* bytecode, std::size_t size) override;
+
+    void OnRelease(GpuBuffer* buffer) override;
+    void OnRelease(GpuTexture* texture) override;
+    void OnRelease(GpuVertexShader* shader) override;
+    void OnRelease(GpuPixelShader* shader) override;
+    void OnRelease(GpuInputLayout* layout) override;
+
+    void OnSetInputLayout(GpuInputLayout* layout) override {}
+    void OnSetVertexShader(GpuVertexShader* shader) override {}
+    void OnSetPixelShader(GpuPixelShader* shader) override {}
+    void OnSetVertexBuffers(std::uint32_t startSlot, std::uint32_t count, GpuBuffer* const* buffers, const std::uint32_t* strides) override {}
+    void OnSetIndexBuffer(GpuBuffer* buffer, GpuIndexFormat format) override {}
+    void OnSetTopology(GpuTopology topology) override {}
+    void OnSetTexture(std::uint32_t slot, GpuTexture* texture) override {}
+    void OnSetConstantBufferRange(std::uint32_t slot, std::uint8_t stages, GpuBuffer* buffer,
+                                  std::uint32_t offset, std::uint32_t size) override;
+    void OnSetDepthEnable(bool enable) override {}
+    void OnSetAlphaToCoverage(bool enable) override {}
+
+    void OnDraw(std::uint32_t vertexCount, std::uint32_t startVertex) override { CheckDrawState(); }
+    void OnDrawIndexed(std::uint32_t indexCount, std::uint32_t startIndex, std::int32_t baseVertex) override { CheckDrawState(); }
+    void OnDrawInstanced(std::uint32_t vertexCount, std::uint32_t instanceCount, std::uint32_t startInstance) override { CheckDrawState(); }
+    void OnDrawIndexedInstanced(std::uint32_t indexCount, std::uint32_t instanceCount,
+                                std::uint32_t startIndex, std::uint32_t startInstance) override { CheckDrawState(); }
+
+    void OnSubmitText(const wchar_t* text, std::size_t length, float x, float y) override {}
+    bool OnFlushText() override { return false; }
+
+private:
+    /// ダミーのリソース（すべての Gpu〜 ハンドルの実体）
+    struct RecordedObject
+    {
+        std::vector<std::byte> storage;     // Dynamic バッファの書き込み先（それ以外は空）
+        std::uint32_t size   = 0;           // バッファの大きさ（バッファ以外は 0）
+        bool          mapped = false;       // MapDiscard 〜 Unmap の間
+    };
+
+    /// ダミーを作成する
+    RecordedObject* NewObject(std::size_t storageSize = 0);
+
+    /// ダミーを破棄する
+    void DeleteObject(void* handle);
+
+    /// 描画時に設定中の定数バッファが Map されたままでないか確かめる
+    void CheckDrawState() const;
+
+    bool          m_ConstantBufferRanges;   // SupportsConstantBufferRanges の値
+    std::uint64_t m_FrameCount  = 0;        // 記録したフレーム数
+    RenderStats   m_TotalStats;             // 全フレームの累計
+    std::size_t   m_LiveObjects = 0;        // 生存中のリソース数
+    const RecordedObject* m_ConstantBuffers[kMaxConstantSlots] = {};    // 非所有：設定中の定数バッファ
+};
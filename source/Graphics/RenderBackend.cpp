@@ -0,0 +1,382 @@
+﻿#include "RenderBackend.h"
+#include <cassert>
+
+// ------------------------------------------------------------------------------
+// フレーム
+// ------------------------------------------------------------------------------
+void RenderBackend::BeginFrame()
+{
+    m_Stats = RenderStats{};
+    OnBeginFrame();
+}
+
+void RenderBackend::EndFrame()
+{
+    OnEndFrame();
+    m_LastFrameStats = m_Stats;
+}
+
+// ------------------------------------------------------------------------------
+// リソース
+// ------------------------------------------------------------------------------
+// - 作成時の初期データ・書き換えたバイト数を転送量として数える
+GpuBuffer* RenderBackend::CreateBuffer(const GpuBufferDesc& desc, const void* initialData)
+{
+    GpuBuffer* buffer = OnCreateBuffer(desc, initialData);
+    if (buffer)
+    {
+        ++m_Stats.createdObjects;
+        if (initialData)
+        {
+            m_Stats.uploadedBytes += desc.size;
+        }
+    }
+    return buffer;
+}
+
+void RenderBackend::UpdateBuffer(GpuBuffer* buffer, const void* data, std::uint32_t size)
+{
+    if (!buffer || !data)
+        return;
+
+    OnUpdateBuffer(buffer, data, size);
+    m_Stats.uploadedBytes += size;
+    ++m_Stats.bufferUpdates;
+}
+
+void* RenderBackend::MapDiscard(GpuBuffer* buffer)
+{
+    if (!buffer)
+        return nullptr;
+
+    ++m_Stats.bufferUpdates;
+    return OnMapDiscard(buffer);
+}
+
+void RenderBackend::Unmap(GpuBuffer* buffer, std::uint32_t writtenBytes)
+{
+    if (!buffer)
+        return;
+
+    OnUnmap(buffer);
+    m_Stats.uploadedBytes += writtenBytes;
+}
+
+GpuTexture* RenderBackend::CreateTexture2D(const GpuTextureDesc& desc, const GpuSubresource* subresources)
+{
+    GpuTexture* texture = OnCreateTexture2D(desc, subresources);
+    if (texture)
+    {
+        ++m_Stats.createdObjects;
+        for (std::uint32_t i = 0; subresources && i < desc.mipLevels; ++i)
+        {
+            m_Stats.uploadedBytes += subresources[i].slicePitch;
+        }
+    }
+    return texture;
+}
+
+GpuVertexShader* RenderBackend::CreateVertexShader(const void* bytecode, std::size_t size,
+    const GpuVertexElement* elements, std::uint32_t elementCount, GpuInputLayout** outLayout)
+{
+    GpuVertexShader* shader = OnCreateVertexShader(bytecode, size, elements, elementCount, outLayout);
+    if (shader)
+    {
+        ++m_Stats.createdObjects;
+        m_Stats.uploadedBytes += size;
+    }
+    return shader;
+}
+
+GpuPixelShader* RenderBackend::CreatePixelShader(const void* bytecode, std::size_t size)
+{
+    GpuPixelShader* shader = OnCreatePixelShader(bytecode, size);
+    if (shader)
+    {
+        ++m_Stats.createdObjects;
+        m_Stats.uploadedBytes += size;
+    }
+    return shader;
+}
+
+// - 解放したものが設定中なら不明扱いに戻す（同じアドレスで再作成されたものを「同じ」と誤判定しない）
+void RenderBackend::Release(GpuBuffer* buffer)
+{
+    if (!buffer)
+        return;
+
+    for (std::uint32_t slot = 0; slot < kMaxVertexSlots; ++slot)
+    {
+        if (m_VertexBuffers[slot] == buffer)
+        {
+            m_Known &= ~(KnownVertexSlot0 << slot);
+        }
+    }
+    if (m_IndexBuffer == buffer)
+    {
+        m_Known &= ~KnownIndexBuffer;
+    }
+    for (std::uint32_t slot = 0; slot < kMaxConstantSlots; ++slot)
+    {
+        if (m_ConstantBuffers[slot] == buffer)
+        {
+            m_Known &= ~(KnownConstantSlot0 << slot);
+        }
+    }
+    OnRelease(buffer);
+}
+
+void RenderBackend::Release(GpuTexture* texture)
+{
+    if (!texture)
+        return;
+
+    for (std::uint32_t slot = 0; slot < kMaxTextureSlots; ++slot)
+    {
+        if (m_Textures[slot] == texture)
+        {
+            m_Known &= ~(KnownTextureSlot0 << slot);
+        }
+    }
+    OnRelease(texture);
+}
+
+void RenderBackend::Release(GpuVertexShader* shader)
+{
+    if (!shader)
+        return;
+
+    if (m_VertexShader == shader)
+    {
+        m_Known &= ~KnownVertexShader;
+    }
+    OnRelease(shader);
+}
+
+void RenderBackend::Release(GpuPixelShader* shader)
+{
+    if (!shader)
+        return;
+
+    if (m_PixelShader == shader)
+    {
+        m_Known &= ~KnownPixelShader;
+    }
+    OnRelease(shader);
+}
+
+void RenderBackend::Release(GpuInputLayout* layout)
+{
+    if (!layout)
+        return;
+
+    if (m_InputLayout == layout)
+    {
+        m_Known &= ~KnownInputLayout;
+    }
+    OnRelease(layout);
+}
+
+// ------------------------------------------------------------------------------
+// 状態の設定
+// ------------------------------------------------------------------------------
+template <class T>
+bool RenderBackend::Track(T& current, T value, std::uint32_t bit)
+{
+    if ((m_Known & bit) && current == value)
+    {
+        ++m_Stats.redundantStates;
+        return false;
+    }
+
+    current = value;
+    m_Known |= bit;
+    ++m_Stats.stateChanges;
+    return true;
+}
+
+void RenderBackend::SetInputLayout(GpuInputLayout* layout)
+{
+    if (Track(m_InputLayout, layout, KnownInputLayout))
+    {
+        OnSetInputLayout(layout);
+    }
+}
+
+void RenderBackend::SetVertexShader(GpuVertexShader* shader)
+{
+    if (Track(m_VertexShader, shader, KnownVertexShader))
+    {
+        OnSetVertexShader(shader);
+    }
+}
+
+void RenderBackend::SetPixelShader(GpuPixelShader* shader)
+{
+    if (Track(m_PixelShader, shader, KnownPixelShader))
+    {
+        OnSetPixelShader(shader);
+    }
+}
+
+// - 範囲内のどれか 1 つでも違えば、範囲ごと 1 回の状態変更として実装へ渡す
+// - 追跡範囲外のスロットは常に渡す
+void RenderBackend::SetVertexBuffers(std::uint32_t startSlot, std::uint32_t count, GpuBuffer* const* buffers, const std::uint32_t* strides)
+{
+    bool changed = (startSlot + count > kMaxVertexSlots);
+    for (std::uint32_t i = 0; i < count && !changed; ++i)
+    {
+        const std::uint32_t slot = startSlot + i;
+        const std::uint32_t bit = KnownVertexSlot0 << slot;
+        changed = !(m_Known & bit) || m_VertexBuffers[slot] != buffers[i] || m_VertexStrides[slot] != strides[i];
+    }
+
+    if (!changed)
+    {
+        ++m_Stats.redundantStates;
+        return;
+    }
+
+    for (std::uint32_t i = 0; i < count && startSlot + i < kMaxVertexSlots; ++i)
+    {
+        const std::uint32_t slot = startSlot + i;
+        m_VertexBuffers[slot] = buffers[i];
+        m_VertexStrides[slot] = strides[i];
+        m_Known |= KnownVertexSlot0 << slot;
+    }
+    ++m_Stats.stateChanges;
+    OnSetVertexBuffers(startSlot, count, buffers, strides);
+}
+
+void RenderBackend::SetIndexBuffer(GpuBuffer* buffer, GpuIndexFormat format)
+{
+    if ((m_Known & KnownIndexBuffer) && m_IndexBuffer == buffer && m_IndexFormat == format)
+    {
+        ++m_Stats.redundantStates;
+        return;
+    }
+
+    m_IndexBuffer = buffer;
+    m_IndexFormat = format;
+    m_Known |= KnownIndexBuffer;
+    ++m_Stats.stateChanges;
+    OnSetIndexBuffer(buffer, format);
+}
+
+void RenderBackend::SetTopology(GpuTopology topology)
+{
+    if (Track(m_Topology, topology, KnownTopology))
+    {
+        OnSetTopology(topology);
+    }
+}
+
+void RenderBackend::SetTexture(std::uint32_t slot, GpuTexture* texture)
+{
+    if (slot >= kMaxTextureSlots)
+    {
+        ++m_Stats.stateChanges;
+        OnSetTexture(slot, texture);
+        return;
+    }
+
+    if (Track(m_Textures[slot], texture, KnownTextureSlot0 << slot))
+    {
+        OnSetTexture(slot, texture);
+    }
+}
+
+// - バッファと範囲がすべて同じなら省く（描画ごとに範囲だけを変える使い方を想定）
+void RenderBackend::SetConstantBufferRange(std::uint32_t slot, std::uint8_t stages, GpuBuffer* buffer,
+                                           std::uint32_t offset, std::uint32_t size)
+{
+    assert(offset % kConstantRangeAlignment == 0 && size % kConstantRangeAlignment == 0
+        && "RenderBackend::SetConstantBufferRange：範囲が 256 バイト単位になっていない");
+    assert((size == 0 || SupportsConstantBufferRanges())
+        && "RenderBackend::SetConstantBufferRange：この実装は範囲の設定に対応していない");
+
+    if (slot >= kMaxConstantSlots)
+    {
+        ++m_Stats.stateChanges;
+        OnSetConstantBufferRange(slot, stages, buffer, offset, size);
+        return;
+    }
+
+    const std::uint32_t bit = KnownConstantSlot0 << slot;
+    if ((m_Known & bit) && m_ConstantBuffers[slot] == buffer && m_ConstantOffsets[slot] == offset && m_ConstantSizes[slot] == size)
+    {
+        ++m_Stats.redundantStates;
+        return;
+    }
+
+    m_ConstantBuffers[slot] = buffer;
+    m_ConstantOffsets[slot] = offset;
+    m_ConstantSizes[slot]   = size;
+    m_Known |= bit;
+    ++m_Stats.stateChanges;
+    OnSetConstantBufferRange(slot, stages, buffer, offset, size);
+}
+
+void RenderBackend::SetDepthEnable(bool enable)
+{
+    if (Track(m_DepthEnable, enable, KnownDepth))
+    {
+        OnSetDepthEnable(enable);
+    }
+}
+
+void RenderBackend::SetAlphaToCoverage(bool enable)
+{
+    if (Track(m_AlphaToCoverage, enable, KnownAlphaCoverage))
+    {
+        OnSetAlphaToCoverage(enable);
+    }
+}
+
+void RenderBackend::InvalidateState()
+{
+    m_Known = 0;
+}
+
+// ------------------------------------------------------------------------------
+// 描画
+// ------------------------------------------------------------------------------
+void RenderBackend::Draw(std::uint32_t vertexCount, std::uint32_t startVertex)
+{
+    ++m_Stats.drawCalls;
+    ++m_Stats.instances;
+    OnDraw(vertexCount, startVertex);
+}
+
+void RenderBackend::DrawIndexed(std::uint32_t indexCount, std::uint32_t startIndex, std::int32_t baseVertex)
+{
+    ++m_Stats.drawCalls;
+    ++m_Stats.instances;
+    OnDrawIndexed(indexCount, startIndex, baseVertex);
+}
+
+void RenderBackend::DrawInstanced(std::uint32_t vertexCount, std::uint32_t instanceCount, std::uint32_t startInstance)
+{
+    ++m_Stats.drawCalls;
+    m_Stats.instances += instanceCount;
+    OnDrawInstanced(vertexCount, instanceCount, startInstance);
+}
+
+void RenderBackend::DrawIndexedInstanced(std::uint32_t indexCount, std::uint32_t instanceCount,
+                                         std::uint32_t startIndex, std::uint32_t startInstance)
+{
+    ++m_Stats.drawCalls;
+    m_Stats.instances += instanceCount;
+    OnDrawIndexedInstanced(indexCount, instanceCount, startIndex, startInstance);
+}
+
+// ------------------------------------------------------------------------------
+// 文字
+// ------------------------------------------------------------------------------
+void RenderBackend::FlushText()
+{
+    if (OnFlushText())
+    {
+        InvalidateState();
+    }
+}
@@ -0,0 +1,355 @@
+﻿//------------------------------------------------------------------------------
+// RenderBackend
+//------------------------------------------------------------------------------
+// 役割:
+// GPU リソース（バッファ / テクスチャ / シェーダー）の作成、状態の設定、描画の発行を
+// 抽象化したインターフェース。Renderer / MeshRenderer などの描画経路はこれだけを呼ぶ。
+//
+// 設計意図:
+// 描画経路が ID3D11DeviceContext を直接呼んでいると、GPU と Windows が無い環境では
+// 実行も計測もできない。描画の窓口を 1 つにまとめ、D3D11 実装と記録用実装を差し替えられるようにする。
+// 統計（描画呼び出し数・状態変更数・転送量）と「直前と同じ状態の設定を省く」処理は
+// 実装ごとに書かず、この基底クラスの公開関数でまとめて行う（実装は On〜 だけを持つ）。
+//
+// 構成:
+// - Gpu〜            : リソースの不透明ハンドル（実体は実装ごと。D3D11 では ID3D11〜 そのもの）
+// - Create / Release : リソースの作成・解放（作成時の初期データも転送量に数える）
+// - Update / Map     : バッファの書き換え（書いたバイト数を転送量に数える）
+// - Set〜            : 状態の設定（直前と同じなら実装を呼ばずに省く）
+//                      定数バッファは 1 つのバッファの一部（範囲）を設定できる（対応している実装のみ）
+// - Draw〜           : 描画の発行
+// - SubmitText / FlushText : 画面上の文字（実装が 2D の描画 API を持つ場合のみ。無ければ何もしない）
+// - BeginFrame / EndFrame / GetFrameStats : フレーム単位の統計
+//
+// NOTE:
+// - このヘッダは Windows / D3D11 のヘッダに依存しない（記録用実装は他の環境でも動く）
+// - 文字の描画（Direct2D / DirectWrite）は D3D11 実装の中に閉じる。呼び出し側は SubmitText だけを使う
+// - メインスレッドからのみ呼ぶこと
+// - 外部（Direct2D など）がデバイスの状態を変えた場合は InvalidateState を呼ぶこと
+//------------------------------------------------------------------------------
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// ------------------------------------------------------------------------------
+// リソースの不透明ハンドル（定義は実装側のみ）
+// ------------------------------------------------------------------------------
+struct GpuBuffer;
+struct GpuTexture;
+struct GpuVertexShader;
+struct GpuPixelShader;
+struct GpuInputLayout;
+
+// ------------------------------------------------------------------------------
+// 列挙・記述子
+// ------------------------------------------------------------------------------
+/// バッファの更新方法
+enum class GpuBufferUsage : std::uint8_t
+{
+    Default,    // UpdateBuffer で更新する（または更新しない）
+    Dynamic,    // Map / Unmap で毎フレーム書き換える
+};
+
+/// バッファの用途
+enum class GpuBufferBind : std::uint8_t
+{
+    Vertex,
+    Index,
+    Constant,
+};
+
+/// 頂点要素の形式
+enum class GpuVertexFormat : std::uint8_t
+{
+    Float2,
+    Float3,
+    Float4,
+};
+
+/// インデックスの形式
+enum class GpuIndexFormat : std::uint8_t
+{
+    UInt16,
+    UInt32,
+};
+
+/// プリミティブの形状
+enum class GpuTopology : std::uint8_t
+{
+    TriangleList,
+    TriangleStrip,
+    LineList,
+};
+
+/// 定数バッファを設定するステージ（ビットの組み合わせ）
+enum GpuShaderStage : std::uint8_t
+{
+    GpuShaderStageVertex = 1 << 0,
+    GpuShaderStagePixel  = 1 << 1,
+};
+
+/// バッファの記述
+struct GpuBufferDesc
+{
+    std::uint32_t  size  = 0;                       // バイト数
+    GpuBufferUsage usage = GpuBufferUsage::Default;
+    GpuBufferBind  bind  = GpuBufferBind::Vertex;
+};
+
+/// 頂点入力要素の記述
+struct GpuVertexElement
+{
+    const char*     semantic      = nullptr;        // セマンティクス名
+    std::uint32_t   semanticIndex = 0;
+    GpuVertexFormat format        = GpuVertexFormat::Float3;
+    std::uint32_t   slot          = 0;              // 頂点バッファのスロット
+    std::uint32_t   offset        = 0;              // 要素のバイトオフセット
+    bool            perInstance   = false;          // true：インスタンスごとに 1 つ進む
+};
+
+/// 2D テクスチャの記述
+struct GpuTextureDesc
+{
+    std::uint32_t width     = 0;
+    std::uint32_t height    = 0;
+    std::uint32_t mipLevels = 1;
+    std::uint32_t format    = 0;                    // ピクセル形式（DXGI_FORMAT の値）
+};
+
+/// よく使うピクセル形式（DXGI_FORMAT の値。Windows のヘッダを読まずに指定するため）
+constexpr std::uint32_t kGpuFormatR8G8B8A8Unorm = 28;  // DXGI_FORMAT_R8G8B8A8_UNORM
+
+/// テクスチャの初期データ（ミップレベルごと）
+struct GpuSubresource
+{
+    const void* pixels     = nullptr;
+    std::size_t rowPitch   = 0;                     // 1 行のバイト数
+    std::size_t slicePitch = 0;                     // 1 枚のバイト数
+};
+
+/// フレーム単位の統計
+struct RenderStats
+{
+    std::uint32_t drawCalls       = 0;  // 描画呼び出し数
+    std::uint32_t instances       = 0;  // 描画したインスタンス数（通常の描画は 1）
+    std::uint32_t stateChanges    = 0;  // 実装へ渡した状態変更数
+    std::uint32_t redundantStates = 0;  // 直前と同じため省いた状態変更数
+    std::uint64_t uploadedBytes   = 0;  // CPU → GPU の転送量（バイト）
+    std::uint32_t bufferUpdates   = 0;  // UpdateBuffer / MapDiscard の回数（ドライバへの転送要求数）
+    std::uint32_t createdObjects  = 0;  // 作成したリソース数
+};
+
+/// 描画バックエンドの基底クラス
+class RenderBackend
+{
+public:
+    static constexpr std::uint32_t kMaxVertexSlots  = 2;    // 状態を追跡する頂点バッファのスロット数
+    static constexpr std::uint32_t kMaxTextureSlots = 4;    // 状態を追跡するテクスチャのスロット数
+    static constexpr std::uint32_t kMaxConstantSlots = 5;   // 状態を追跡する定数バッファのスロット数
+    static constexpr std::uint32_t kConstantRangeAlignment = 256;   // 定数バッファの範囲の先頭・大きさの単位（バイト）
+
+    RenderBackend() { InvalidateState(); }
+    virtual ~RenderBackend() = default;
+
+    RenderBackend(const RenderBackend&) = delete;
+    RenderBackend& operator=(const RenderBackend&) = delete;
+
+    /// 実装名（ログ用）
+    virtual const char* GetName() const = 0;
+
+    /// SetConstantBufferRange で 0 以外の範囲を設定できるか
+    virtual bool SupportsConstantBufferRanges() const = 0;
+
+    // ----------------------------------------------------------------------
+    // フレーム
+    // ----------------------------------------------------------------------
+    /// フレーム開始（画面のクリア）。統計をリセットする
+    void BeginFrame();
+
+    /// フレーム終了（画面の表示）。統計を確定する
+    void EndFrame();
+
+    /// 直近に終了したフレームの統計
+    const RenderStats& GetFrameStats() const { return m_LastFrameStats; }
+
+    /// 現在のフレームの統計（途中経過）
+    const RenderStats& GetCurrentStats() const { return m_Stats; }
+
+    // ----------------------------------------------------------------------
+    // リソース
+    // ----------------------------------------------------------------------
+    /// バッファを作成する（initialData は nullptr 可）
+    GpuBuffer* CreateBuffer(const GpuBufferDesc& desc, const void* initialData);
+
+    /// Default バッファの内容を書き換える
+    void UpdateBuffer(GpuBuffer* buffer, const void* data, std::uint32_t size);
+
+    /// Dynamic バッファを書き込み用に開く（以前の内容は破棄される）
+    /// 戻り値：書き込み先（失敗時は nullptr）
+    void* MapDiscard(GpuBuffer* buffer);
+
+    /// MapDiscard を閉じる（writtenBytes は転送量の集計用）
+    void Unmap(GpuBuffer* buffer, std::uint32_t writtenBytes);
+
+    /// 2D テクスチャを作成する（subresources は mipLevels 個）
+    GpuTexture* CreateTexture2D(const GpuTextureDesc& desc, const GpuSubresource* subresources);
+
+    /// 頂点シェーダーと入力レイアウトを作成する
+    /// - outLayout が nullptr なら入力レイアウトは作らない
+    GpuVertexShader* CreateVertexShader(const void* bytecode, std::size_t size,
+        const GpuVertexElement* elements, std::uint32_t elementCount, GpuInputLayout** outLayout);
+
+    /// ピクセルシェーダーを作成する
+    GpuPixelShader* CreatePixelShader(const void* bytecode, std::size_t size);
+
+    /// 解放（nullptr は何もしない。設定中のものなら追跡状態からも外す）
+    void Release(GpuBuffer* buffer);
+    void Release(GpuTexture* texture);
+    void Release(GpuVertexShader* shader);
+    void Release(GpuPixelShader* shader);
+    void Release(GpuInputLayout* layout);
+
+    // ----------------------------------------------------------------------
+    // 状態の設定（直前と同じなら省く）
+    // ----------------------------------------------------------------------
+    void SetInputLayout(GpuInputLayout* layout);
+    void SetVertexShader(GpuVertexShader* shader);
+    void SetPixelShader(GpuPixelShader* shader);
+
+    /// 頂点バッファを startSlot から count 個設定する（オフセットは 0）
+    void SetVertexBuffers(std::uint32_t startSlot, std::uint32_t count, GpuBuffer* const* buffers, const std::uint32_t* strides);
+
+    /// 頂点バッファを 1 つ設定する
+    void SetVertexBuffer(std::uint32_t slot, GpuBuffer* buffer, std::uint32_t stride)
+    {
+        SetVertexBuffers(slot, 1, &buffer, &stride);
+    }
+
+    void SetIndexBuffer(GpuBuffer* buffer, GpuIndexFormat format);
+    void SetTopology(GpuTopology topology);
+
+    /// ピクセルシェーダーのテクスチャを設定する（nullptr で解除）
+    void SetTexture(std::uint32_t slot, GpuTexture* texture);
+
+    /// 定数バッファ全体を設定する
+    void SetConstantBuffer(std::uint32_t slot, std::uint8_t stages, GpuBuffer* buffer)
+    {
+        SetConstantBufferRange(slot, stages, buffer, 0, 0);
+    }
+
+    /// 定数バッファの [offset, offset + size) を設定する（size が 0 ならバッファ全体）
+    /// - offset / size は kConstantRangeAlignment の倍数。0 以外の範囲は SupportsConstantBufferRanges な実装のみ
+    /// - 同じスロットには常に同じ stages で設定すること（追跡は stages を区別しない）
+    void SetConstantBufferRange(std::uint32_t slot, std::uint8_t stages, GpuBuffer* buffer,
+                                std::uint32_t offset, std::uint32_t size);
+
+    void SetDepthEnable(bool enable);
+    void SetAlphaToCoverage(bool enable);
+
+    /// 追跡中の状態を不明扱いにする（次の設定は必ず実装へ渡す）
+    void InvalidateState();
+
+    // ----------------------------------------------------------------------
+    // 描画
+    // ----------------------------------------------------------------------
+    void Draw(std::uint32_t vertexCount, std::uint32_t startVertex);
+    void DrawIndexed(std::uint32_t indexCount, std::uint32_t startIndex, std::int32_t baseVertex);
+    /// startInstance はインスタンスバッファ内の開始位置（複数のまとめ描画で 1 つのバッファを共有するため）
+    void DrawInstanced(std::uint32_t vertexCount, std::uint32_t instanceCount, std::uint32_t startInstance = 0);
+    void DrawIndexedInstanced(std::uint32_t indexCount, std::uint32_t instanceCount,
+                              std::uint32_t startIndex = 0, std::uint32_t startInstance = 0);
+
+    // ----------------------------------------------------------------------
+    // 文字
+    // ----------------------------------------------------------------------
+    /// 文字列を (x, y) に描く予定として積む（描画は FlushText まで遅れる）
+    void SubmitText(const wchar_t* text, std::size_t length, float x, float y) { OnSubmitText(text, length, x, y); }
+
+    /// 積んだ文字列を描く（メッシュの描画の後、EndFrame の前に呼ぶ）
+    /// - 実装が外部の API（Direct2D など）で描いた場合は、追跡中の状態を不明扱いにする
+    void FlushText();
+
+protected:
+    // ----------------------------------------------------------------------
+    // 実装側（統計・重複除去は済んだ状態で呼ばれる）
+    // ----------------------------------------------------------------------
+    virtual void OnBeginFrame() = 0;
+    virtual void OnEndFrame() = 0;
+
+    virtual GpuBuffer* OnCreateBuffer(const GpuBufferDesc& desc, const void* initialData) = 0;
+    virtual void OnUpdateBuffer(GpuBuffer* buffer, const void* data, std::uint32_t size) = 0;
+    virtual void* OnMapDiscard(GpuBuffer* buffer) = 0;
+    virtual void OnUnmap(GpuBuffer* buffer) = 0;
+    virtual GpuTexture* OnCreateTexture2D(const GpuTextureDesc& desc, const GpuSubresource* subresources) = 0;
+    virtual GpuVertexShader* OnCreateVertexShader(const void* bytecode, std::size_t size,
+        const GpuVertexElement* elements, std::uint32_t elementCount, GpuInputLayout** outLayout) = 0;
+    virtual GpuPixelShader* OnCreatePixelShader(const void* bytecode, std::size_t size) = 0;
+
+    virtual void OnRelease(GpuBuffer* buffer) = 0;
+    virtual void OnRelease(GpuTexture* texture) = 0;
+    virtual void OnRelease(GpuVertexShader* shader) = 0;
+    virtual void OnRelease(GpuPixelShader* shader) = 0;
+    virtual void OnRelease(GpuInputLayout* layout) = 0;
+
+    virtual void OnSetInputLayout(GpuInputLayout* layout) = 0;
+    virtual void OnSetVertexShader(GpuVertexShader* shader) = 0;
+    virtual void OnSetPixelShader(GpuPixelShader* shader) = 0;
+    virtual void OnSetVertexBuffers(std::uint32_t startSlot, std::uint32_t count, GpuBuffer* const* buffers, const std::uint32_t* strides) = 0;
+    virtual void OnSetIndexBuffer(GpuBuffer* buffer, GpuIndexFormat format) = 0;
+    virtual void OnSetTopology(GpuTopology topology) = 0;
+    virtual void OnSetTexture(std::uint32_t slot, GpuTexture* texture) = 0;
+    virtual void OnSetConstantBufferRange(std::uint32_t slot, std::uint8_t stages, GpuBuffer* buffer,
+                                          std::uint32_t offset, std::uint32_t size) = 0;
+    virtual void OnSetDepthEnable(bool enable) = 0;
+    virtual void OnSetAlphaToCoverage(bool enable) = 0;
+
+    virtual void OnDraw(std::uint32_t vertexCount, std::uint32_t startVertex) = 0;
+    virtual void OnDrawIndexed(std::uint32_t indexCount, std::uint32_t startIndex, std::int32_t baseVertex) = 0;
+    virtual void OnDrawInstanced(std::uint32_t vertexCount, std::uint32_t instanceCount, std::uint32_t startInstance) = 0;
+    virtual void OnDrawIndexedInstanced(std::uint32_t indexCount, std::uint32_t instanceCount,
+                                        std::uint32_t startIndex, std::uint32_t startInstance) = 0;
+
+    virtual void OnSubmitText(const wchar_t* text, std::size_t length, float x, float y) = 0;
+    /// 戻り値：デバイスの状態を変える API で描いた場合 true
+    virtual bool OnFlushText() = 0;
+
+private:
+    /// 追跡する状態（Known ビットが立っていない項目は不明扱い）
+    enum KnownBit : std::uint32_t
+    {
+        KnownInputLayout   = 1u << 0,
+        KnownVertexShader  = 1u << 1,
+        KnownPixelShader   = 1u << 2,
+        KnownIndexBuffer   = 1u << 3,
+        KnownTopology      = 1u << 4,
+        KnownDepth         = 1u << 5,
+        KnownAlphaCoverage = 1u << 6,
+        KnownVertexSlot0   = 1u << 7,                           // 以降 kMaxVertexSlots 個
+        KnownTextureSlot0  = KnownVertexSlot0 << kMaxVertexSlots,  // 以降 kMaxTextureSlots 個
+        KnownConstantSlot0 = KnownTextureSlot0 << kMaxTextureSlots, // 以降 kMaxConstantSlots 個
+    };
+
+    /// 状態が直前と同じか判定し、違えば記録する
+    /// 戻り値：実装を呼ぶ必要がある場合 true
+    template <class T>
+    bool Track(T& current, T value, std::uint32_t bit);
+
+    RenderStats m_Stats;            // 現在のフレームの統計
+    RenderStats m_LastFrameStats;   // 直近に終了したフレームの統計
+
+    std::uint32_t    m_Known = 0;
+    GpuInputLayout*  m_InputLayout  = nullptr;
+    GpuVertexShader* m_VertexShader = nullptr;
+    GpuPixelShader*  m_PixelShader  = nullptr;
+    GpuBuffer*       m_VertexBuffers[kMaxVertexSlots] = {};
+    std::uint32_t    m_VertexStrides[kMaxVertexSlots] = {};
+    GpuBuffer*       m_IndexBuffer  = nullptr;
+    GpuIndexFormat   m_IndexFormat  = GpuIndexFormat::UInt16;
+    GpuTopology      m_Topology     = GpuTopology::TriangleList;
+    GpuTexture*      m_Textures[kMaxTextureSlots] = {};
+    GpuBuffer*       m_ConstantBuffers[kMaxConstantSlots] = {};
+    std::uint32_t    m_ConstantOffsets[kMaxConstantSlots] = {};
+    std::uint32_t    m_ConstantSizes[kMaxConstantSlots]   = {};
+    bool             m_DepthEnable  = true;
+    bool             m_AlphaToCoverage = false;
+};
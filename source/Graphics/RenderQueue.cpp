@@ -0,0 +1,602 @@
+﻿#define _CRT_SECURE_NO_WARNINGS
+#include "RenderQueue.h"
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+#include <iterator>
+
+// 静的メンバ変数の定義
+std::vector<RenderPacket>            RenderQueue::s_Packets;
+std::vector<RenderQueue::SortEntry>  RenderQueue::s_Entries;
+std::vector<RenderQueue::SortEntry>  RenderQueue::s_Scratch;
+std::vector<RenderQueue::Batch>      RenderQueue::s_Batches;
+GpuBuffer*                           RenderQueue::s_InstanceBuffer   = nullptr;
+std::uint32_t                        RenderQueue::s_InstanceCapacity = 0;
+FrameConstantBuffer                  RenderQueue::s_Constants;
+std::vector<RenderQueue::DrawConstants> RenderQueue::s_DrawConstants;
+std::unordered_map<std::string, InstancedShader> RenderQueue::s_InstancedShaders;
+RenderQueueStats                     RenderQueue::s_Stats;
+
+namespace
+{
+    // キーの各欄のビット数（合計 64）
+    constexpr unsigned kPassBits     = 2;
+    constexpr unsigned kShaderBits   = 14;
+    constexpr unsigned kTextureBits  = 12;
+    constexpr unsigned kMaterialBits = 12;
+    constexpr unsigned kDepthBits    = 24;
+    static_assert(kPassBits + kShaderBits + kTextureBits + kMaterialBits + kDepthBits == 64,
+        "ソートキーの欄の合計が 64bit になっていない");
+
+    constexpr std::uint64_t kDepthMask = (1ull << kDepthBits) - 1;
+
+    // 不透明パスの深度欄のうち、メッシュのハッシュに使う上位ビット数
+    constexpr unsigned kOpaqueMeshBits = 8;
+
+    // インスタンスバッファの最小容量（インスタンス数）
+    constexpr std::uint32_t kMinInstanceCapacity = 256;
+
+    // 定数 1 つ分の大きさ（範囲の単位に合わせる）
+    constexpr std::uint32_t kConstantBlockBytes = RenderBackend::kConstantRangeAlignment;
+    static_assert(sizeof(CBWorld) <= kConstantBlockBytes && sizeof(MATERIAL) <= kConstantBlockBytes,
+        "描画ごとの定数が範囲の単位に収まっていない");
+
+    /// 値を混ぜて上位 bits ビットを取り出す（ポインタの下位ビットは揃っているため）
+    std::uint64_t HashBits(std::uint64_t value, unsigned bits)
+    {
+        return (value * 0x9E3779B97F4A7C15ull) >> (64 - bits);
+    }
+
+    std::uint64_t PointerValue(const void* pointer)
+    {
+        return static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(pointer));
+    }
+
+    /// マテリアルの内容のハッシュ（FNV-1a）
+    std::uint64_t HashMaterial(const MATERIAL& material)
+    {
+        const auto* bytes = reinterpret_cast<const unsigned char*>(&material);
+        std::uint64_t hash = 0xCBF29CE484222325ull;
+        for (std::size_t i = 0; i < sizeof(MATERIAL); ++i)
+        {
+            hash = (hash ^ bytes[i]) * 0x100000001B3ull;
+        }
+        return hash;
+    }
+
+    /// インスタンス描画では Diffuse をインスタンスごとの色として渡すので、
+    /// マテリアルの比較・ハッシュからは外し、定数バッファ側は白にする
+    MATERIAL WithoutDiffuse(const MATERIAL& material)
+    {
+        MATERIAL result = material;
+        result.Diffuse = XMFLOAT4(1.0f, 1.0f, 1.0f, 1.0f);
+        return result;
+    }
+
+    bool SameMaterial(const MATERIAL& a, const MATERIAL& b)
+    {
+        return std::memcmp(&a, &b, sizeof(MATERIAL)) == 0;
+    }
+
+    /// メッシュの識別子（頂点バッファとインデックスバッファ）
+    std::uint64_t MeshIdentity(const RenderPacket& packet)
+    {
+        return PointerValue(packet.vertexBuffer) ^ (PointerValue(packet.indexBuffer) << 1);
+    }
+
+    /// 「〜VS.cso」→「〜InstancedVS.cso」
+    /// 戻り値：末尾が VS.cso でない場合は空文字列
+    std::string MakeInstancedPath(const char* vsFileName)
+    {
+        static constexpr char kSuffix[] = "VS.cso";
+        const std::string path = vsFileName;
+        const std::size_t suffixLength = sizeof(kSuffix) - 1;
+        if (path.size() < suffixLength || path.compare(path.size() - suffixLength, suffixLength, kSuffix) != 0)
+            return std::string();
+
+        return path.substr(0, path.size() - suffixLength) + "InstancedVS.cso";
+    }
+
+    /// 直前に設定した状態（Flush 内でのみ有効）
+    struct BoundState
+    {
+        bool             valid          = false;
+        GpuInputLayout*  layout         = nullptr;
+        GpuVertexShader* vertexShader   = nullptr;
+        GpuPixelShader*  pixelShader    = nullptr;
+        GpuTexture*      texture        = nullptr;
+        MATERIAL         material{};
+        GpuBuffer*       vertexBuffer   = nullptr;
+        std::uint32_t    vertexStride   = 0;
+        GpuBuffer*       instanceBuffer = nullptr;  // スロット 1（インスタンス描画時のみ設定）
+        GpuBuffer*       indexBuffer    = nullptr;
+        GpuIndexFormat   indexFormat    = GpuIndexFormat::UInt16;
+        GpuTopology      topology       = GpuTopology::TriangleList;
+    };
+
+    BoundState s_Bound;
+
+    /// 値が直前と同じなら省いた数を数えて false、違えば更新して true を返す
+    template <class T>
+    bool Changed(T& current, const T& next, std::uint64_t& saved)
+    {
+        if (s_Bound.valid && current == next)
+        {
+            ++saved;
+            return false;
+        }
+        current = next;
+        return true;
+    }
+
+    bool MaterialChanged(const MATERIAL& next, std::uint64_t& saved)
+    {
+        if (s_Bound.valid && SameMaterial(s_Bound.material, next))
+        {
+            ++saved;
+            return false;
+        }
+        s_Bound.material = next;
+        return true;
+    }
+
+    /// ビュー空間の深度を、大小関係を保った 24bit に詰める
+    /// - 正の float はビット列の大小と値の大小が一致するので、下位を落とすだけでよい
+    std::uint64_t QuantizeDepth(float viewZ)
+    {
+        const float clamped = viewZ > 0.0f ? viewZ : 0.0f;
+        std::uint32_t bits;
+        std::memcpy(&bits, &clamped, sizeof(bits));
+        return (bits >> (31 - kDepthBits)) & kDepthMask;
+    }
+}
+
+// ------------------------------------------------------------------------------
+// 終了処理
+// ------------------------------------------------------------------------------
+// - Renderer::Uninit からバックエンドの破棄前に呼ばれる
+void RenderQueue::Uninit()
+{
+    RenderBackend& backend = Renderer::GetBackend();
+
+    for (auto& pair : s_InstancedShaders)
+    {
+        backend.Release(pair.second.shader);
+        backend.Release(pair.second.layout);
+    }
+    s_InstancedShaders.clear();
+
+    backend.Release(s_InstanceBuffer);
+    s_InstanceBuffer   = nullptr;
+    s_InstanceCapacity = 0;
+
+    s_Constants.Release(backend);
+    s_DrawConstants.clear();
+
+    s_Packets.clear();
+    s_Entries.clear();
+}
+
+// ------------------------------------------------------------------------------
+// フレーム開始
+// ------------------------------------------------------------------------------
+void RenderQueue::BeginFrame()
+{
+    s_Stats = RenderQueueStats{};
+}
+
+// ------------------------------------------------------------------------------
+// インスタンス描画版のシェーダー
+// ------------------------------------------------------------------------------
+// - VS パスごとに 1 度だけ探す（見つからなかったことも覚えておく）
+const InstancedShader* RenderQueue::FindInstancedShader(const char* vsFileName)
+{
+    auto found = s_InstancedShaders.find(vsFileName);
+    if (found == s_InstancedShaders.end())
+    {
+        InstancedShader variant;
+
+        const std::string path = MakeInstancedPath(vsFileName);
+        FILE* file = path.empty() ? nullptr : fopen(path.c_str(), "rb");
+        if (file)
+        {
+            fclose(file);
+
+            const std::uint32_t kWorld = offsetof(InstanceData, world);
+            const std::uint32_t kColor = offsetof(InstanceData, color);
+            const GpuVertexElement layout[] =
+            {
+                { "POSITION",      0, GpuVertexFormat::Float3, 0, 0,           false },
+                { "NORMAL",        0, GpuVertexFormat::Float3, 0, 4 * 3,       false },
+                { "COLOR",         0, GpuVertexFormat::Float4, 0, 4 * 6,       false },
+                { "TEXCOORD",      0, GpuVertexFormat::Float2, 0, 4 * 10,      false },
+                { "WORLD",         0, GpuVertexFormat::Float4, 1, kWorld,      true  },
+                { "WORLD",         1, GpuVertexFormat::Float4, 1, kWorld + 16, true  },
+                { "WORLD",         2, GpuVertexFormat::Float4, 1, kWorld + 32, true  },
+                { "WORLD",         3, GpuVertexFormat::Float4, 1, kWorld + 48, true  },
+                { "INSTANCECOLOR", 0, GpuVertexFormat::Float4, 1, kColor,      true  },
+            };
+            Renderer::CreateVertexShader(&variant.shader, &variant.layout, path.c_str(), layout, static_cast<std::uint32_t>(std::size(layout)));
+        }
+
+        found = s_InstancedShaders.emplace(vsFileName, variant).first;
+    }
+
+    return found->second.shader ? &found->second : nullptr;
+}
+
+// ------------------------------------------------------------------------------
+// パケットの追加
+// ------------------------------------------------------------------------------
+void RenderQueue::Submit(const RenderPacket& packet)
+{
+    const std::uint32_t index = static_cast<std::uint32_t>(s_Packets.size());
+    s_Packets.push_back(packet);
+    s_Entries.push_back(SortEntry{ MakeSortKey(packet), index });
+}
+
+// ------------------------------------------------------------------------------
+// ソートキー
+// ------------------------------------------------------------------------------
+// - 不透明   : パス | シェーダー | テクスチャ | マテリアル | メッシュ + 深度（手前から）
+// - 半透明   : パス | 深度（奥から）| シェーダー | テクスチャ | マテリアル
+// - まとめられるパケットは、マテリアル欄に Diffuse を含めない（色違いも隣り合わせる）
+std::uint64_t RenderQueue::MakeSortKey(const RenderPacket& packet)
+{
+    const XMFLOAT4X4& view = Renderer::m_CurrentView;
+    const float viewZ = packet.world._41 * view._13
+                      + packet.world._42 * view._23
+                      + packet.world._43 * view._33
+                      + view._43;
+    const std::uint64_t depth = QuantizeDepth(viewZ);
+
+    const std::uint64_t pass     = static_cast<std::uint64_t>(packet.pass);
+    const std::uint64_t shader   = HashBits(PointerValue(packet.vertexShader)
+                                          ^ (PointerValue(packet.pixelShader) << 1)
+                                          ^ (PointerValue(packet.layout) << 2), kShaderBits);
+    const std::uint64_t texture  = HashBits(PointerValue(packet.texture), kTextureBits);
+    const std::uint64_t material = HashBits(HashMaterial(packet.instanced ? WithoutDiffuse(packet.material)
+                                                                          : packet.material), kMaterialBits);
+
+    if (packet.pass == RenderPass::Transparent)
+    {
+        return (pass << (64 - kPassBits))
+             | ((kDepthMask - depth) << (kShaderBits + kTextureBits + kMaterialBits))
+             | (shader << (kTextureBits + kMaterialBits))
+             | (texture << kMaterialBits)
+             | material;
+    }
+
+    const std::uint64_t mesh = HashBits(MeshIdentity(packet), kOpaqueMeshBits);
+    return (pass << (64 - kPassBits))
+         | (shader << (kTextureBits + kMaterialBits + kDepthBits))
+         | (texture << (kMaterialBits + kDepthBits))
+         | (material << kDepthBits)
+         | (mesh << (kDepthBits - kOpaqueMeshBits))
+         | (depth >> kOpaqueMeshBits);
+}
+
+// ------------------------------------------------------------------------------
+// 基数ソート
+// ------------------------------------------------------------------------------
+// - 安定な LSD 基数ソート（8bit × 8 桁）。同じキーは Submit 順を保つ
+// - ある桁の値が全要素で同じ場合、その桁の並べ替えは飛ばす
+void RenderQueue::RadixSort()
+{
+    const std::size_t count = s_Entries.size();
+    s_Scratch.resize(count);
+
+    for (unsigned shift = 0; shift < 64; shift += 8)
+    {
+        std::uint32_t histogram[256] = {};
+        for (const SortEntry& entry : s_Entries)
+        {
+            ++histogram[(entry.key >> shift) & 0xFF];
+        }
+
+        if (histogram[(s_Entries[0].key >> shift) & 0xFF] == count)
+            continue;
+
+        std::uint32_t offset = 0;
+        for (std::uint32_t& bucket : histogram)
+        {
+            const std::uint32_t n = bucket;
+            bucket = offset;
+            offset += n;
+        }
+
+        for (const SortEntry& entry : s_Entries)
+        {
+            s_Scratch[histogram[(entry.key >> shift) & 0xFF]++] = entry;
+        }
+        s_Entries.swap(s_Scratch);
+    }
+}
+
+// ------------------------------------------------------------------------------
+// まとめ
+// ------------------------------------------------------------------------------
+// - インスタンス描画版のシェーダー・ピクセルシェーダー・テクスチャ・メッシュ・描画範囲・
+//   パス・マテリアル（Diffuse を除く）がすべて同じならまとめられる
+bool RenderQueue::CanInstance(const RenderPacket& a, const RenderPacket& b)
+{
+    return a.instanced && a.instanced == b.instanced
+        && a.pixelShader == b.pixelShader
+        && a.texture == b.texture
+        && a.vertexBuffer == b.vertexBuffer
+        && a.vertexStride == b.vertexStride
+        && a.indexBuffer == b.indexBuffer
+        && a.indexFormat == b.indexFormat
+        && a.count == b.count
+        && a.startIndex == b.startIndex
+        && a.topology == b.topology
+        && a.pass == b.pass
+        && SameMaterial(WithoutDiffuse(a.material), WithoutDiffuse(b.material));
+}
+
+// - 隣り合ってまとめられるパケットが 2 つ以上あればインスタンス描画にする
+// - インスタンスデータはフレーム内のすべてのまとまりで 1 つのバッファに詰め、1 回の Map で書く
+//   （Map できなかった場合は 1 つずつ描く）
+void RenderQueue::BuildBatches()
+{
+    s_Batches.clear();
+
+    const std::uint32_t count = static_cast<std::uint32_t>(s_Entries.size());
+    std::uint32_t instanceCount = 0;
+    for (std::uint32_t first = 0; first < count;)
+    {
+        const RenderPacket& head = s_Packets[s_Entries[first].index];
+
+        std::uint32_t n = 1;
+        while (first + n < count && CanInstance(head, s_Packets[s_Entries[first + n].index]))
+        {
+            ++n;
+        }
+
+        const bool instanced = n >= 2;
+        s_Batches.push_back(Batch{ first, n, instanceCount, instanced });
+        if (instanced)
+        {
+            instanceCount += n;
+        }
+        first += n;
+    }
+
+    if (instanceCount == 0)
+        return;
+
+    RenderBackend& backend = Renderer::GetBackend();
+    if (instanceCount > s_InstanceCapacity)
+    {
+        backend.Release(s_InstanceBuffer);
+        s_InstanceCapacity = std::max(instanceCount, std::max(s_InstanceCapacity * 2, kMinInstanceCapacity));
+
+        GpuBufferDesc desc{};
+        desc.size  = sizeof(InstanceData) * s_InstanceCapacity;
+        desc.usage = GpuBufferUsage::Dynamic;
+        desc.bind  = GpuBufferBind::Vertex;
+        s_InstanceBuffer = backend.CreateBuffer(desc, nullptr);
+    }
+
+    auto* instances = static_cast<InstanceData*>(s_InstanceBuffer ? backend.MapDiscard(s_InstanceBuffer) : nullptr);
+    if (!instances)
+    {
+        for (Batch& batch : s_Batches)
+        {
+            batch.instanced = false;
+        }
+        return;
+    }
+
+    for (const Batch& batch : s_Batches)
+    {
+        if (!batch.instanced)
+            continue;
+
+        for (std::uint32_t i = 0; i < batch.count; ++i)
+        {
+            const RenderPacket& packet = s_Packets[s_Entries[batch.first + i].index];
+            InstanceData& instance = instances[batch.startInstance + i];
+            instance.world = packet.world;
+            instance.color = packet.material.Diffuse;
+        }
+    }
+    backend.Unmap(s_InstanceBuffer, sizeof(InstanceData) * instanceCount);
+}
+
+// ------------------------------------------------------------------------------
+// 実行
+// ------------------------------------------------------------------------------
+// - ソート → まとめ → 順に実行し、キューを空にする
+// - 最初の描画はすべての状態を設定する（キュー外の描画が状態を変えている可能性があるため）
+void RenderQueue::Flush()
+{
+    if (s_Packets.empty())
+        return;
+
+    RadixSort();
+    BuildBatches();
+    const bool ranged = WriteConstants();
+
+    s_Bound = BoundState{};
+    for (const Batch& batch : s_Batches)
+    {
+        if (batch.instanced)
+        {
+            ExecuteInstanced(batch, ranged ? &s_DrawConstants[batch.first] : nullptr);
+            continue;
+        }
+
+        for (std::uint32_t i = 0; i < batch.count; ++i)
+        {
+            const std::uint32_t position = batch.first + i;
+            Execute(s_Packets[s_Entries[position].index], ranged ? &s_DrawConstants[position] : nullptr);
+        }
+    }
+
+    s_Stats.packets += s_Packets.size();
+    s_Packets.clear();
+    s_Entries.clear();
+}
+
+// - 実行と同じ順に走査し、マテリアルは実行時の MaterialChanged と同じ規則（直前と違う場合のみ）で書き込む
+// - 上限は「全パケットがワールド行列とマテリアルを 1 つずつ書く」場合の量
+bool RenderQueue::WriteConstants()
+{
+    RenderBackend& backend = Renderer::GetBackend();
+    if (!backend.SupportsConstantBufferRanges())
+        return false;
+
+    const std::uint32_t maxBytes = static_cast<std::uint32_t>(s_Entries.size()) * 2 * kConstantBlockBytes;
+    if (!s_Constants.Begin(backend, maxBytes))
+        return false;
+
+    s_DrawConstants.resize(s_Entries.size());
+
+    MATERIAL      lastMaterial{};
+    std::uint32_t lastMaterialOffset = 0;
+    bool          hasMaterial = false;
+    auto pushMaterial = [&](const MATERIAL& material)
+    {
+        if (!hasMaterial || !SameMaterial(lastMaterial, material))
+        {
+            lastMaterial       = material;
+            lastMaterialOffset = s_Constants.Push(&material, sizeof(MATERIAL));
+            hasMaterial        = true;
+        }
+        return lastMaterialOffset;
+    };
+
+    for (const Batch& batch : s_Batches)
+    {
+        if (batch.instanced)
+        {
+            const RenderPacket& head = s_Packets[s_Entries[batch.first].index];
+            s_DrawConstants[batch.first].material = pushMaterial(WithoutDiffuse(head.material));
+            continue;
+        }
+
+        for (std::uint32_t i = 0; i < batch.count; ++i)
+        {
+            const std::uint32_t position = batch.first + i;
+            const RenderPacket& packet = s_Packets[s_Entries[position].index];
+
+            CBWorld world;
+            Renderer::MakeWorldConstants(XMLoadFloat4x4(&packet.world), world);
+
+            DrawConstants& constants = s_DrawConstants[position];
+            constants.material = pushMaterial(packet.material);
+            constants.world    = s_Constants.Push(&world, sizeof(world));
+        }
+    }
+
+    s_Constants.End(backend);
+    return true;
+}
+
+// - 状態ごとに「直前と同じなら設定しない」を判定し、省いた数を数える
+// - ワールド行列はパケットごとに異なる前提で毎回設定する
+void RenderQueue::Execute(const RenderPacket& packet, const DrawConstants* constants)
+{
+    RenderBackend& backend = Renderer::GetBackend();
+    std::uint64_t saved = 0;
+
+    if (Changed(s_Bound.layout, packet.layout, saved))             backend.SetInputLayout(packet.layout);
+    if (Changed(s_Bound.vertexShader, packet.vertexShader, saved)) backend.SetVertexShader(packet.vertexShader);
+    if (Changed(s_Bound.pixelShader, packet.pixelShader, saved))   backend.SetPixelShader(packet.pixelShader);
+    if (Changed(s_Bound.texture, packet.texture, saved))           backend.SetTexture(0, packet.texture);
+    if (MaterialChanged(packet.material, saved))
+    {
+        if (constants) Renderer::SetMaterialConstants(s_Constants.GetBuffer(), constants->material);
+        else           Renderer::SetMaterial(packet.material);
+    }
+
+    const bool bufferChanged = Changed(s_Bound.vertexBuffer, packet.vertexBuffer, saved);
+    const bool strideChanged = s_Bound.vertexStride != packet.vertexStride;
+    s_Bound.vertexStride = packet.vertexStride;
+    if (bufferChanged || strideChanged)
+    {
+        backend.SetVertexBuffer(0, packet.vertexBuffer, packet.vertexStride);
+    }
+
+    if (Changed(s_Bound.topology, packet.topology, saved))         backend.SetTopology(packet.topology);
+
+    if (constants) Renderer::SetWorldConstants(s_Constants.GetBuffer(), constants->world);
+    else           Renderer::SetWorldMatrix(XMLoadFloat4x4(&packet.world));
+
+    if (packet.indexBuffer)
+    {
+        const bool indexChanged  = Changed(s_Bound.indexBuffer, packet.indexBuffer, saved);
+        const bool formatChanged = s_Bound.indexFormat != packet.indexFormat;
+        s_Bound.indexFormat = packet.indexFormat;
+        if (indexChanged || formatChanged)
+        {
+            backend.SetIndexBuffer(packet.indexBuffer, packet.indexFormat);
+        }
+
+        backend.DrawIndexed(packet.count, packet.startIndex, 0);
+    }
+    else
+    {
+        backend.Draw(packet.count, 0);
+    }
+
+    s_Bound.valid = true;
+    s_Stats.savedStates += saved;
+}
+
+// - 先頭パケットのメッシュ（と状態）で、まとまりのパケット数だけインスタンス描画する
+// - ワールド行列と色はインスタンスデータから読むので、定数バッファのワールド行列は設定しない
+void RenderQueue::ExecuteInstanced(const Batch& batch, const DrawConstants* constants)
+{
+    RenderBackend& backend = Renderer::GetBackend();
+    const RenderPacket& head = s_Packets[s_Entries[batch.first].index];
+    const MATERIAL material = WithoutDiffuse(head.material);
+    std::uint64_t saved = 0;
+
+    if (Changed(s_Bound.layout, head.instanced->layout, saved))       backend.SetInputLayout(head.instanced->layout);
+    if (Changed(s_Bound.vertexShader, head.instanced->shader, saved)) backend.SetVertexShader(head.instanced->shader);
+    if (Changed(s_Bound.pixelShader, head.pixelShader, saved))        backend.SetPixelShader(head.pixelShader);
+    if (Changed(s_Bound.texture, head.texture, saved))                backend.SetTexture(0, head.texture);
+    if (MaterialChanged(material, saved))
+    {
+        if (constants) Renderer::SetMaterialConstants(s_Constants.GetBuffer(), constants->material);
+        else           Renderer::SetMaterial(material);
+    }
+
+    const bool bufferChanged   = Changed(s_Bound.vertexBuffer, head.vertexBuffer, saved);
+    const bool instanceChanged = Changed(s_Bound.instanceBuffer, s_InstanceBuffer, saved);
+    const bool strideChanged   = s_Bound.vertexStride != head.vertexStride;
+    s_Bound.vertexStride = head.vertexStride;
+    if (bufferChanged || instanceChanged || strideChanged)
+    {
+        GpuBuffer* const buffers[2] = { head.vertexBuffer, s_InstanceBuffer };
+        const std::uint32_t strides[2] = { head.vertexStride, sizeof(InstanceData) };
+        backend.SetVertexBuffers(0, 2, buffers, strides);
+    }
+
+    if (Changed(s_Bound.topology, head.topology, saved))              backend.SetTopology(head.topology);
+
+    if (head.indexBuffer)
+    {
+        const bool indexChanged  = Changed(s_Bound.indexBuffer, head.indexBuffer, saved);
+        const bool formatChanged = s_Bound.indexFormat != head.indexFormat;
+        s_Bound.indexFormat = head.indexFormat;
+        if (indexChanged || formatChanged)
+        {
+            backend.SetIndexBuffer(head.indexBuffer, head.indexFormat);
+        }
+
+        backend.DrawIndexedInstanced(head.count, batch.count, head.startIndex, batch.startInstance);
+    }
+    else
+    {
+        backend.DrawInstanced(head.count, batch.count, batch.startInstance);
+    }
+
+    s_Bound.valid = true;
+    s_Stats.savedStates += saved;
+    s_Stats.instanced   += batch.count;
+    ++s_Stats.batches;
+}
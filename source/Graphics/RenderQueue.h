@@ -0,0 +1,187 @@
+﻿//------------------------------------------------------------------------------
+// RenderQueue
+//------------------------------------------------------------------------------
+// 役割:
+// メッシュ描画を「描画パケット + 64bit のソートキー」として溜め、
+// キーで並べ替えてから、直前のパケットと異なる状態だけを設定して描画する。
+//
+// 設計意図:
+// シーン走査の順に MeshRenderer / ModelRenderer がその場で描くと、
+// 同じシェーダー・テクスチャ・マテリアルの描画が散らばり、毎回同じ状態を設定し直すことになる。
+// 描画をパケットとして受け取り、パス → シェーダー → テクスチャ → マテリアル → 深度 の順の
+// キーで基数ソートすることで、同じ状態の描画を隣り合わせ、状態の設定をまとめて省く。
+// さらに、ソート後に隣り合った「同じメッシュ・同じマテリアル（色を除く）」の描画は
+// ワールド行列と色をインスタンスデータにして 1 回のインスタンス描画にまとめる。
+// 敵や壁のような単位ボックスの描画回数が、オブジェクト数ではなくメッシュの種類数で済む。
+// まとめられなかった描画のワールド行列とマテリアルは、描画前に FrameConstantBuffer へ 1 回で書き込み、
+// 描画ごとには定数バッファの範囲を切り替えるだけにする（描画ごとの定数バッファ更新を無くす）。
+//
+// 構成:
+// - RenderPass        : 描画パス（キーの最上位。不透明 → 半透明の順に描く）
+// - RenderPacket      : 1 回の描画に必要な状態（シェーダー・バッファ・テクスチャ・マテリアル・ワールド行列）
+// - InstancedShader   : インスタンス描画用の頂点シェーダーと入力レイアウト（通常版の VS ごとに 1 つ）
+// - RenderQueueStats  : フレーム内のパケット数・省いた状態設定の数・インスタンス化したパケット数
+// - RenderQueue       : Submit で溜め、Flush でソート → まとめ → 実行する
+//
+// NOTE:
+// - キーのシェーダー / テクスチャ / マテリアル欄はポインタや内容のハッシュ（下位ビット）なので、
+//   別の状態が同じ値になることがある。その場合も実行時は実際の値で比較するので結果は正しい
+//   （並びが少し崩れて省ける数が減るだけ）
+// - 半透明パスは奥から手前の順に描くため、深度をシェーダーより上位に置く
+// - 不透明パスの深度欄は上位をメッシュのハッシュに譲る（同じメッシュを隣り合わせてまとめやすくする）
+// - インスタンス描画版の VS は「〜VS.cso」に対する「〜InstancedVS.cso」。無い VS の描画はまとめない
+// - パケットは Submit 時点のビュー / 射影行列で描かれる。Renderer が行列を書き換える前
+//   （SetViewMatrix / SetProjectionMatrix / SetWorldViewProjection2D）に Flush するため
+//   （Game シーンでは Camera → 3D の物体 → Polygon2D の順なので、2D 行列に切り替わる前に 3D を描き切る）
+// - Flush は上記と Renderer::End で呼ばれる（文字は TextRenderer がその後にまとめて描く）
+// - 定数バッファの範囲設定に対応していないバックエンドでは、描画ごとに Renderer::SetWorldMatrix / SetMaterial で書き換える
+// - メインスレッドからのみ呼ぶこと
+//------------------------------------------------------------------------------
+#pragma once
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Renderer.h"
+#include "FrameConstantBuffer.h"
+
+/// 描画パス（値の小さい順に描く）
+enum class RenderPass : std::uint8_t
+{
+    Opaque,         // 不透明（手前から奥へ）
+    Transparent,    // 半透明（奥から手前へ）
+};
+
+/// インスタンス描画用の頂点シェーダー
+/// - 入力：スロット 0 に VERTEX_3D、スロット 1 にインスタンスごとの WORLD0〜3（行列の各行）と INSTANCECOLOR
+/// - 所有は RenderQueue（Uninit で解放）
+struct InstancedShader
+{
+    GpuVertexShader* shader = nullptr;
+    GpuInputLayout*  layout = nullptr;
+};
+
+/// 1 回の描画に必要な状態
+/// - indexBuffer が nullptr なら Draw（count は頂点数）、あれば DrawIndexed（count はインデックス数）
+/// - 同じメッシュかどうかは頂点 / インデックスバッファで判定する
+///   （MeshRenderer の手続き形状は MeshCache で共有されるので、同じ形状なら同じバッファになる）
+/// - instanced が nullptr のパケットはまとめない
+struct RenderPacket
+{
+    const InstancedShader* instanced = nullptr;
+    GpuInputLayout*  layout       = nullptr;
+    GpuVertexShader* vertexShader = nullptr;
+    GpuPixelShader*  pixelShader  = nullptr;
+    GpuTexture*      texture      = nullptr;    // nullptr ならスロット 0 を解除する
+    GpuBuffer*       vertexBuffer = nullptr;
+    GpuBuffer*       indexBuffer  = nullptr;
+    std::uint32_t    vertexStride = sizeof(VERTEX_3D);
+    std::uint32_t    count        = 0;
+    std::uint32_t    startIndex   = 0;
+    GpuIndexFormat   indexFormat  = GpuIndexFormat::UInt16;
+    GpuTopology      topology     = GpuTopology::TriangleList;
+    RenderPass       pass         = RenderPass::Opaque;
+    MATERIAL         material{};
+    XMFLOAT4X4       world{};
+};
+
+/// フレーム内の統計
+struct RenderQueueStats
+{
+    std::uint64_t packets     = 0;  // 実行したパケット数
+    std::uint64_t savedStates = 0;  // 直前のパケットと同じだったため省いた状態設定の数
+    std::uint64_t instanced   = 0;  // インスタンス描画にまとめたパケット数
+    std::uint64_t batches     = 0;  // インスタンス描画の回数
+};
+
+/// ソート付き描画キュー
+class RenderQueue
+{
+public:
+    /// 終了処理（インスタンス描画用のシェーダーとバッファを解放する）
+    static void Uninit();
+
+    /// フレーム開始（統計を 0 に戻す）
+    static void BeginFrame();
+
+    /// vsFileName のインスタンス描画版を返す（初回のみ読み込む）
+    /// 戻り値：インスタンス描画版が無い場合 nullptr
+    static const InstancedShader* FindInstancedShader(const char* vsFileName);
+
+    /// パケットを追加する（描画は Flush まで遅れる）
+    static void Submit(const RenderPacket& packet);
+
+    /// 溜めたパケットをソートして描画し、キューを空にする
+    static void Flush();
+
+    /// 現在のフレームの統計（Renderer::End の後に読むとそのフレームの合計）
+    static const RenderQueueStats& GetFrameStats() { return s_Stats; }
+
+private:
+    /// ソート用の組（キー + パケット番号）
+    struct SortEntry
+    {
+        std::uint64_t key;
+        std::uint32_t index;
+    };
+
+    /// ソート後の連続したパケットのまとまり
+    struct Batch
+    {
+        std::uint32_t first;            // s_Entries 内の先頭
+        std::uint32_t count;            // パケット数
+        std::uint32_t startInstance;    // インスタンスバッファ内の先頭（インスタンス描画しない場合は未使用）
+        bool          instanced;        // インスタンス描画するか
+    };
+
+    /// 描画ごとの定数の位置（s_Constants 内のバイト位置）
+    /// - material は直前の描画と同じマテリアルなら直前と同じ位置
+    /// - インスタンス描画ではまとまりの先頭に material だけを持つ（ワールド行列はインスタンスデータ）
+    struct DrawConstants
+    {
+        std::uint32_t world;
+        std::uint32_t material;
+    };
+
+    /// インスタンスごとのデータ（シェーダーの WORLD0〜3 / INSTANCECOLOR と同じ並び）
+    struct InstanceData
+    {
+        XMFLOAT4X4 world;
+        XMFLOAT4   color;
+    };
+
+    /// パケットのソートキーを作る（ビュー空間の深度は現在のビュー行列から求める）
+    static std::uint64_t MakeSortKey(const RenderPacket& packet);
+
+    /// キーの下位から 8bit ずつの LSD 基数ソート（全要素で同じ桁は飛ばす）
+    static void RadixSort();
+
+    /// 2 つのパケットを 1 回のインスタンス描画にまとめられるか
+    static bool CanInstance(const RenderPacket& a, const RenderPacket& b);
+
+    /// ソート済みのパケットをまとまりに分け、インスタンスデータを書き込む
+    static void BuildBatches();
+
+    /// まとまりの実行順に、描画ごとの定数を s_Constants へまとめて書き込む
+    /// 戻り値：書き込めた場合 true（範囲設定に対応していない / Map できない場合は false）
+    static bool WriteConstants();
+
+    /// パケットを 1 つ実行する（直前と同じ状態は省く）
+    /// - constants が nullptr なら定数バッファを Renderer::SetWorldMatrix / SetMaterial で書き換える
+    static void Execute(const RenderPacket& packet, const DrawConstants* constants);
+
+    /// まとまりを 1 回のインスタンス描画で実行する
+    static void ExecuteInstanced(const Batch& batch, const DrawConstants* constants);
+
+private:
+    static std::vector<RenderPacket> s_Packets;             // 溜めたパケット（容量はフレームをまたいで再利用）
+    static std::vector<SortEntry>    s_Entries;             // ソート対象
+    static std::vector<SortEntry>    s_Scratch;             // 基数ソートの作業領域
+    static std::vector<Batch>        s_Batches;             // Flush 中のまとまり
+    static GpuBuffer*                s_InstanceBuffer;      // 所有：インスタンスデータ（動的）
+    static std::uint32_t             s_InstanceCapacity;    // s_InstanceBuffer の容量（インスタンス数）
+    static FrameConstantBuffer       s_Constants;           // 描画ごとのワールド行列・マテリアル
+    static std::vector<DrawConstants> s_DrawConstants;      // s_Entries と同じ並びの、定数の位置
+    static std::unordered_map<std::string, InstancedShader> s_InstancedShaders;    // 所有：VS パス → インスタンス描画版
+    static RenderQueueStats          s_Stats;               // フレーム内の統計
+};
@@ -1,44 +1,30 @@
-﻿#pragma comment(lib, "d2d1.lib")
-#pragma comment(lib, "dwrite.lib")
-
-#include "main.h"
-#include "renderer.h"
-#include <io.h>
-
-
-D3D_FEATURE_LEVEL       Renderer::m_FeatureLevel = D3D_FEATURE_LEVEL_11_0;
-
-ID3D11Device*           Renderer::m_Device{};
-ID3D11DeviceContext*    Renderer::m_DeviceContext{};
-IDXGISwapChain*         Renderer::m_SwapChain{};
-ID3D11RenderTargetView* Renderer::m_RenderTargetView{};
-ID3D11DepthStencilView* Renderer::m_DepthStencilView{};
-
-ID3D11Buffer*			Renderer::m_WorldBuffer{};
-ID3D11Buffer*			Renderer::m_ViewBuffer{};
-ID3D11Buffer*			Renderer::m_ProjectionBuffer{};
-ID3D11Buffer*			Renderer::m_MaterialBuffer{};
-ID3D11Buffer*			Renderer::m_LightBuffer{};
-
-
-ID3D11DepthStencilState* Renderer::m_DepthStateEnable{};
-ID3D11DepthStencilState* Renderer::m_DepthStateDisable{};
-
-
-ID3D11BlendState*		Renderer::m_BlendState{};
-ID3D11BlendState*		Renderer::m_BlendStateATC{};
-
-ID2D1Factory* Renderer::m_D2DFactory = nullptr;
-ID2D1RenderTarget* Renderer::m_D2DRT = nullptr;
-IDWriteFactory* Renderer::m_DWriteFactory = nullptr;
-IDWriteTextFormat* Renderer::m_TextFormat = nullptr;
-ID2D1SolidColorBrush* Renderer::m_Brush = nullptr;
-
-static ID3D11Buffer* 		s_DebugVB 		= nullptr;
-static UINT 				s_DebugVBBytes 	= 0;
-static ID3D11VertexShader*	s_DebugLineVS	= nullptr;
-static ID3D11PixelShader*	s_DebugLinePS	= nullptr;
-static ID3D11InputLayout*	s_DebugLineIL	= nullptr;
+﻿#define _CRT_SECURE_NO_WARNINGS
+#include "Renderer.h"
+#include "FrameArena.h"
+#include "RenderQueue.h"
+#include "FrustumCulling.h"
+#include <algorithm>
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+#include <iterator>
+
+
+RenderBackend*			Renderer::m_Backend{};
+std::uint32_t			Renderer::m_ScreenWidth{};
+std::uint32_t			Renderer::m_ScreenHeight{};
+
+GpuBuffer*				Renderer::m_WorldBuffer{};
+GpuBuffer*				Renderer::m_ViewBuffer{};
+GpuBuffer*				Renderer::m_ProjectionBuffer{};
+GpuBuffer*				Renderer::m_MaterialBuffer{};
+GpuBuffer*				Renderer::m_LightBuffer{};
+
+static GpuBuffer* 			s_DebugVB 		= nullptr;
+static std::uint32_t		s_DebugVBBytes 	= 0;
+static GpuVertexShader*		s_DebugLineVS	= nullptr;
+static GpuPixelShader*		s_DebugLinePS	= nullptr;
+static GpuInputLayout*		s_DebugLineIL	= nullptr;
 
 XMFLOAT4X4 Renderer::m_CurrentWorld = {
 	1,0,0,0,
@@ -47,176 +33,80 @@ XMFLOAT4X4 Renderer::m_CurrentWorld = {
 	0,0,0,1
 };
 
-struct CBWorld
-{
-	DirectX::XMFLOAT4X4 World;
-	DirectX::XMFLOAT4X4 WorldInvTranspose;
+XMFLOAT4X4 Renderer::m_CurrentView = {
+	1,0,0,0,
+	0,1,0,0,
+	0,0,1,0,
+	0,0,0,1
 };
 
-void Renderer::Init()
+// 定数バッファのスロット
+static constexpr std::uint32_t kWorldSlot      = 0;
+static constexpr std::uint32_t kViewSlot       = 1;
+static constexpr std::uint32_t kProjectionSlot = 2;
+static constexpr std::uint32_t kMaterialSlot   = 3;
+static constexpr std::uint32_t kLightSlot      = 4;
+
+// 範囲指定で設定するときの大きさ（256 バイト単位に切り上げ）
+static constexpr std::uint32_t RangeSize(std::uint32_t size)
 {
-	HRESULT hr = S_OK;
-
-	DXGI_SWAP_CHAIN_DESC swapChainDesc{};
-	swapChainDesc.BufferCount = 1;
-	swapChainDesc.BufferDesc.Width = SCREEN_WIDTH;
-	swapChainDesc.BufferDesc.Height = SCREEN_HEIGHT;
-	swapChainDesc.BufferDesc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
-	swapChainDesc.BufferDesc.RefreshRate.Numerator = 60;
-	swapChainDesc.BufferDesc.RefreshRate.Denominator = 1;
-	swapChainDesc.BufferUsage = DXGI_USAGE_RENDER_TARGET_OUTPUT;
-	swapChainDesc.OutputWindow = GetWindow();
-	swapChainDesc.SampleDesc.Count = 1;
-	swapChainDesc.SampleDesc.Quality = 0;
-	swapChainDesc.Windowed = TRUE;
-
-	UINT createFlags = D3D11_CREATE_DEVICE_BGRA_SUPPORT;
-	hr = D3D11CreateDeviceAndSwapChain( NULL,
-										D3D_DRIVER_TYPE_HARDWARE,
-										NULL,
-										createFlags,
-										NULL,
-										0,
-										D3D11_SDK_VERSION,
-										&swapChainDesc,
-										&m_SwapChain,
-										&m_Device,
-										&m_FeatureLevel,
-										&m_DeviceContext );
-
-	ID3D11Texture2D* renderTarget{};
-	m_SwapChain->GetBuffer( 0, __uuidof( ID3D11Texture2D ), ( LPVOID* )&renderTarget );
-	m_Device->CreateRenderTargetView( renderTarget, NULL, &m_RenderTargetView );
-	renderTarget->Release();
-
-	ID3D11Texture2D* depthStencile{};
-	D3D11_TEXTURE2D_DESC textureDesc{};
-	textureDesc.Width = swapChainDesc.BufferDesc.Width;
-	textureDesc.Height = swapChainDesc.BufferDesc.Height;
-	textureDesc.MipLevels = 1;
-	textureDesc.ArraySize = 1;
-	textureDesc.Format = DXGI_FORMAT_D16_UNORM;
-	textureDesc.SampleDesc = swapChainDesc.SampleDesc;
-	textureDesc.Usage = D3D11_USAGE_DEFAULT;
-	textureDesc.BindFlags = D3D11_BIND_DEPTH_STENCIL;
-	textureDesc.CPUAccessFlags = 0;
-	textureDesc.MiscFlags = 0;
-	m_Device->CreateTexture2D(&textureDesc, NULL, &depthStencile);
-
-	D3D11_DEPTH_STENCIL_VIEW_DESC depthStencilViewDesc{};
-	depthStencilViewDesc.Format = textureDesc.Format;
-	depthStencilViewDesc.ViewDimension = D3D11_DSV_DIMENSION_TEXTURE2D;
-	depthStencilViewDesc.Flags = 0;
-	m_Device->CreateDepthStencilView(depthStencile, &depthStencilViewDesc, &m_DepthStencilView);
-	depthStencile->Release();
-
-
-	m_DeviceContext->OMSetRenderTargets(1, &m_RenderTargetView, m_DepthStencilView);
-
-	D3D11_VIEWPORT viewport;
-	viewport.Width = (FLOAT)SCREEN_WIDTH;
-	viewport.Height = (FLOAT)SCREEN_HEIGHT;
-	viewport.MinDepth = 0.0f;
-	viewport.MaxDepth = 1.0f;
-	viewport.TopLeftX = 0;
-	viewport.TopLeftY = 0;
-	m_DeviceContext->RSSetViewports( 1, &viewport );
-
-	D3D11_RASTERIZER_DESC rasterizerDesc{};
-	rasterizerDesc.FillMode = D3D11_FILL_SOLID; 
-	rasterizerDesc.CullMode = D3D11_CULL_BACK; 
-	rasterizerDesc.DepthClipEnable = TRUE; 
-	rasterizerDesc.MultisampleEnable = FALSE; 
-
-	ID3D11RasterizerState *rs;
-	m_Device->CreateRasterizerState( &rasterizerDesc, &rs );
-
-	m_DeviceContext->RSSetState( rs );
-
-	D3D11_BLEND_DESC blendDesc{};
-	blendDesc.AlphaToCoverageEnable = FALSE;
-	blendDesc.IndependentBlendEnable = FALSE;
-	blendDesc.RenderTarget[0].BlendEnable = TRUE;
-	blendDesc.RenderTarget[0].SrcBlend = D3D11_BLEND_SRC_ALPHA;
-	blendDesc.RenderTarget[0].DestBlend = D3D11_BLEND_INV_SRC_ALPHA;
-	blendDesc.RenderTarget[0].BlendOp = D3D11_BLEND_OP_ADD;
-	blendDesc.RenderTarget[0].SrcBlendAlpha = D3D11_BLEND_ONE;
-	blendDesc.RenderTarget[0].DestBlendAlpha = D3D11_BLEND_ZERO;
-	blendDesc.RenderTarget[0].BlendOpAlpha = D3D11_BLEND_OP_ADD;
-	blendDesc.RenderTarget[0].RenderTargetWriteMask = D3D11_COLOR_WRITE_ENABLE_ALL;
-
-	m_Device->CreateBlendState( &blendDesc, &m_BlendState );
-
-	blendDesc.AlphaToCoverageEnable = TRUE;
-	m_Device->CreateBlendState( &blendDesc, &m_BlendStateATC );
-
-	float blendFactor[4] = {0.0f, 0.0f, 0.0f, 0.0f};
-	m_DeviceContext->OMSetBlendState(m_BlendState, blendFactor, 0xffffffff );
-
-	D3D11_DEPTH_STENCIL_DESC depthStencilDesc{};
-	depthStencilDesc.DepthEnable = TRUE;
-	depthStencilDesc.DepthWriteMask	= D3D11_DEPTH_WRITE_MASK_ALL;
-	depthStencilDesc.DepthFunc = D3D11_COMPARISON_LESS_EQUAL;
-	depthStencilDesc.StencilEnable = FALSE;
-
-	m_Device->CreateDepthStencilState( &depthStencilDesc, &m_DepthStateEnable );
-
-	//depthStencilDesc.DepthEnable = FALSE;
-	depthStencilDesc.DepthWriteMask	= D3D11_DEPTH_WRITE_MASK_ZERO;
-	m_Device->CreateDepthStencilState( &depthStencilDesc, &m_DepthStateDisable );
-
-	m_DeviceContext->OMSetDepthStencilState( m_DepthStateEnable, NULL );
-
-	D3D11_SAMPLER_DESC samplerDesc{};
-	samplerDesc.Filter = D3D11_FILTER_ANISOTROPIC;
-	samplerDesc.AddressU = D3D11_TEXTURE_ADDRESS_WRAP;
-	samplerDesc.AddressV = D3D11_TEXTURE_ADDRESS_WRAP;
-	samplerDesc.AddressW = D3D11_TEXTURE_ADDRESS_WRAP;
-	samplerDesc.MaxAnisotropy = 4;
-	samplerDesc.MaxLOD = D3D11_FLOAT32_MAX;
-
-	ID3D11SamplerState* samplerState{};
-	m_Device->CreateSamplerState( &samplerDesc, &samplerState );
-
-	m_DeviceContext->PSSetSamplers( 0, 1, &samplerState );
-
-	D3D11_BUFFER_DESC bufferDesc{};
-	bufferDesc.Usage = D3D11_USAGE_DEFAULT;
-	bufferDesc.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
-	bufferDesc.CPUAccessFlags = 0;
-	bufferDesc.MiscFlags = 0;
-	bufferDesc.StructureByteStride = sizeof(float);
+	return (size + RenderBackend::kConstantRangeAlignment - 1) / RenderBackend::kConstantRangeAlignment * RenderBackend::kConstantRangeAlignment;
+}
 
-	// World
-	bufferDesc.ByteWidth = sizeof(CBWorld);
-	m_Device->CreateBuffer( &bufferDesc, NULL, &m_WorldBuffer );
-	m_DeviceContext->VSSetConstantBuffers( 0, 1, &m_WorldBuffer);
+/// 定数バッファを作成してスロットへ設定する
+static GpuBuffer* CreateConstantBuffer(RenderBackend& backend, std::uint32_t size, std::uint32_t slot, std::uint8_t stages)
+{
+	GpuBufferDesc desc{};
+	desc.size = size;
+	desc.usage = GpuBufferUsage::Default;
+	desc.bind = GpuBufferBind::Constant;
+
+	GpuBuffer* buffer = backend.CreateBuffer(desc, nullptr);
+	backend.SetConstantBuffer(slot, stages, buffer);
+	return buffer;
+}
 
-	// View
-	bufferDesc.ByteWidth = sizeof(DirectX::XMFLOAT4X4);
-	m_Device->CreateBuffer( &bufferDesc, NULL, &m_ViewBuffer );
-	m_DeviceContext->VSSetConstantBuffers( 1, 1, &m_ViewBuffer );
+/// シェーダーファイルを読み込む
+/// 戻り値：読めなかった場合は空（バックエンドのシェーダー作成が失敗し、nullptr になる）
+static FrameVector<unsigned char> ReadShaderFile(const char* FileName)
+{
+	FILE* file = fopen(FileName, "rb");
+	assert(file);
+	if (!file)
+		return FrameVector<unsigned char>();
 
-	// Projection
-	bufferDesc.ByteWidth = sizeof(DirectX::XMFLOAT4X4);
-	m_Device->CreateBuffer( &bufferDesc, NULL, &m_ProjectionBuffer );
-	m_DeviceContext->VSSetConstantBuffers( 2, 1, &m_ProjectionBuffer );
+	fseek(file, 0, SEEK_END);
+	const long fsize = ftell(file);
+	fseek(file, 0, SEEK_SET);
+
+	FrameVector<unsigned char> buffer(fsize);
+	fread(buffer.data(), fsize, 1, file);
+	fclose(file);
+	return buffer;
+}
 
+// - 文字（Direct2D）とデバイスはバックエンドが持つので、ここでは定数バッファと既定のライト / マテリアルだけを作る
+void Renderer::Init(RenderBackend* backend, std::uint32_t screenWidth, std::uint32_t screenHeight)
+{
+	assert(backend);
+	m_Backend = backend;
+	m_ScreenWidth = screenWidth;
+	m_ScreenHeight = screenHeight;
 
-	bufferDesc.ByteWidth = sizeof(MATERIAL);
+	// World
+	m_WorldBuffer = CreateConstantBuffer(*m_Backend, sizeof(CBWorld), kWorldSlot, GpuShaderStageVertex);
 
-	m_Device->CreateBuffer( &bufferDesc, NULL, &m_MaterialBuffer );
-	m_DeviceContext->VSSetConstantBuffers( 3, 1, &m_MaterialBuffer );
-	m_DeviceContext->PSSetConstantBuffers( 3, 1, &m_MaterialBuffer );
+	// View
+	m_ViewBuffer = CreateConstantBuffer(*m_Backend, sizeof(DirectX::XMFLOAT4X4), kViewSlot, GpuShaderStageVertex);
 
+	// Projection
+	m_ProjectionBuffer = CreateConstantBuffer(*m_Backend, sizeof(DirectX::XMFLOAT4X4), kProjectionSlot, GpuShaderStageVertex);
 
-	bufferDesc.ByteWidth = sizeof(LIGHT);
 
-	m_Device->CreateBuffer( &bufferDesc, NULL, &m_LightBuffer );
-	m_DeviceContext->VSSetConstantBuffers( 4, 1, &m_LightBuffer );
-	m_DeviceContext->PSSetConstantBuffers( 4, 1, &m_LightBuffer );
+	m_MaterialBuffer = CreateConstantBuffer(*m_Backend, sizeof(MATERIAL), kMaterialSlot, GpuShaderStageVertex | GpuShaderStagePixel);
 
 
+	m_LightBuffer = CreateConstantBuffer(*m_Backend, sizeof(LIGHT), kLightSlot, GpuShaderStageVertex | GpuShaderStagePixel);
 
 
 
@@ -233,307 +123,224 @@ void Renderer::Init()
 	material.Diffuse = XMFLOAT4(1.0f, 1.0f, 1.0f, 1.0f);
 	material.Ambient = XMFLOAT4(1.0f, 1.0f, 1.0f, 1.0f);
 	SetMaterial(material);
-
-
-
-
-
-	hr = D2D1CreateFactory(D2D1_FACTORY_TYPE_SINGLE_THREADED, &m_D2DFactory);
-	assert(SUCCEEDED(hr));
-
-	IDXGISurface* backBuffer = nullptr;
-	hr = m_SwapChain->GetBuffer(0, __uuidof(IDXGISurface), reinterpret_cast<void**>(&backBuffer));
-	assert(SUCCEEDED(hr));
-
-	D2D1_RENDER_TARGET_PROPERTIES props =
-		D2D1::RenderTargetProperties(
-			D2D1_RENDER_TARGET_TYPE_DEFAULT,
-			D2D1::PixelFormat(DXGI_FORMAT_UNKNOWN, D2D1_ALPHA_MODE_PREMULTIPLIED)
-		);
-	hr = m_D2DFactory->CreateDxgiSurfaceRenderTarget(backBuffer, &props, &m_D2DRT);
-	backBuffer->Release();
-	assert(SUCCEEDED(hr));
-
-	hr = DWriteCreateFactory(DWRITE_FACTORY_TYPE_SHARED,
-		__uuidof(IDWriteFactory),
-		reinterpret_cast<IUnknown**>(&m_DWriteFactory));
-	assert(SUCCEEDED(hr));
-
-	hr = m_DWriteFactory->CreateTextFormat(
-		L"Segoe UI",
-		nullptr,
-		DWRITE_FONT_WEIGHT_NORMAL,
-		DWRITE_FONT_STYLE_NORMAL,
-		DWRITE_FONT_STRETCH_NORMAL,
-		24.0f,
-		L"",
-		&m_TextFormat
-	);
-	assert(SUCCEEDED(hr));
-
-	hr = m_D2DRT->CreateSolidColorBrush(D2D1::ColorF(D2D1::ColorF::White), &m_Brush);
-	assert(SUCCEEDED(hr));
-
-
 }
 
 void Renderer::Uninit()
 {
-
-	m_WorldBuffer->Release();
-	m_ViewBuffer->Release();
-	m_ProjectionBuffer->Release();
-	m_LightBuffer->Release();
-	m_MaterialBuffer->Release();
-
-
-	m_DeviceContext->ClearState();
-	m_RenderTargetView->Release();
-	m_SwapChain->Release();
-	m_DeviceContext->Release();
-	m_Device->Release();
-
-    if (m_Brush)         { m_Brush->Release();         m_Brush = nullptr; }
-    if (m_TextFormat)    { m_TextFormat->Release();    m_TextFormat = nullptr; }
-    if (m_DWriteFactory) { m_DWriteFactory->Release(); m_DWriteFactory = nullptr; }
-    if (m_D2DRT)         { m_D2DRT->Release();         m_D2DRT = nullptr; }
-    if (m_D2DFactory)    { m_D2DFactory->Release();    m_D2DFactory = nullptr; }
-
+	RenderQueue::Uninit();
+
+	m_Backend->Release(m_WorldBuffer);
+	m_Backend->Release(m_ViewBuffer);
+	m_Backend->Release(m_ProjectionBuffer);
+	m_Backend->Release(m_LightBuffer);
+	m_Backend->Release(m_MaterialBuffer);
+
+	m_Backend->Release(s_DebugVB);
+	m_Backend->Release(s_DebugLineIL);
+	m_Backend->Release(s_DebugLineVS);
+	m_Backend->Release(s_DebugLinePS);
+	s_DebugVB = nullptr;
+	s_DebugVBBytes = 0;
+	s_DebugLineIL = nullptr;
+	s_DebugLineVS = nullptr;
+	s_DebugLinePS = nullptr;
+
+	delete m_Backend;
+	m_Backend = nullptr;
 }
 
 void Renderer::Begin()
 {
-	float clearColor[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
-	m_DeviceContext->ClearRenderTargetView( m_RenderTargetView, clearColor );
-	m_DeviceContext->ClearDepthStencilView( m_DepthStencilView, D3D11_CLEAR_DEPTH, 1.0f, 0);
+	m_Backend->BeginFrame();
+	RenderQueue::BeginFrame();
+	FrustumCulling::BeginFrame();
 }
 
 void Renderer::End()
 {
-	m_SwapChain->Present( 1, 0 );
+	// 溜めたメッシュ描画をソートして描く
+	RenderQueue::Flush();
+
+	// 文字はメッシュより手前に、まとめて描く（D3D11 では 1 回の BeginDraw / EndDraw）
+	m_Backend->FlushText();
+
+	m_Backend->EndFrame();
 }
 
 void Renderer::SetDepthEnable( bool Enable )
 {
-	if( Enable )
-		m_DeviceContext->OMSetDepthStencilState( m_DepthStateEnable, NULL );
-	else
-		m_DeviceContext->OMSetDepthStencilState( m_DepthStateDisable, NULL );
-
+	m_Backend->SetDepthEnable(Enable);
 }
 
 void Renderer::SetATCEnable( bool Enable )
 {
-	float blendFactor[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
-
-	if (Enable)
-		m_DeviceContext->OMSetBlendState(m_BlendStateATC, blendFactor, 0xffffffff);
-	else
-		m_DeviceContext->OMSetBlendState(m_BlendState, blendFactor, 0xffffffff);
-
+	m_Backend->SetAlphaToCoverage(Enable);
 }
 
+// - 先に 3D の描画を済ませる（Flush は定数バッファの範囲を設定するので、SetWorldMatrix より前に呼ぶ）
 void Renderer::SetWorldViewProjection2D()
 {
+	RenderQueue::Flush();
+
 	SetWorldMatrix(XMMatrixIdentity());
 	SetViewMatrix(XMMatrixIdentity());
 
 	XMMATRIX projection;
-	projection = XMMatrixOrthographicOffCenterLH(0.0f, SCREEN_WIDTH, SCREEN_HEIGHT, 0.0f, 0.0f, 1.0f);
+	projection = XMMatrixOrthographicOffCenterLH(0.0f, static_cast<float>(m_ScreenWidth), static_cast<float>(m_ScreenHeight), 0.0f, 0.0f, 1.0f);
 	SetProjectionMatrix(projection);
 }
 
+// - RenderQueue が範囲指定の定数バッファを設定している場合があるので、自前のバッファを設定し直す
+//   （同じなら RenderBackend が省く）
 void Renderer::SetWorldMatrix(XMMATRIX WorldMatrix)
 {
 	XMStoreFloat4x4(&m_CurrentWorld, WorldMatrix);
 
 	CBWorld cb{};
+	MakeWorldConstants(WorldMatrix, cb);
 
-	XMStoreFloat4x4(&cb.World, XMMatrixTranspose(WorldMatrix));
+	m_Backend->SetConstantBuffer(kWorldSlot, GpuShaderStageVertex, m_WorldBuffer);
+	m_Backend->UpdateBuffer(m_WorldBuffer, &cb, sizeof(cb));
+}
+
+void Renderer::MakeWorldConstants(XMMATRIX WorldMatrix, CBWorld& Out)
+{
+	XMStoreFloat4x4(&Out.World, XMMatrixTranspose(WorldMatrix));
 
 	XMMATRIX invWorld = XMMatrixInverse(nullptr, WorldMatrix);
-	XMStoreFloat4x4(&cb.WorldInvTranspose, XMMatrixTranspose(invWorld));
+	XMStoreFloat4x4(&Out.WorldInvTranspose, XMMatrixTranspose(invWorld));
+}
+
+void Renderer::SetWorldConstants(GpuBuffer* Buffer, std::uint32_t Offset)
+{
+	m_Backend->SetConstantBufferRange(kWorldSlot, GpuShaderStageVertex, Buffer, Offset, RangeSize(sizeof(CBWorld)));
+}
 
-	m_DeviceContext->UpdateSubresource(m_WorldBuffer, 0, NULL, &cb, 0, 0);
+void Renderer::SetMaterialConstants(GpuBuffer* Buffer, std::uint32_t Offset)
+{
+	m_Backend->SetConstantBufferRange(kMaterialSlot, GpuShaderStageVertex | GpuShaderStagePixel, Buffer, Offset, RangeSize(sizeof(MATERIAL)));
 }
 
+// - 溜めた描画は Submit 時点のビュー / 射影行列で描く必要があるので、書き換える前に Flush する
+//   （フレーム先頭の Camera::Draw では空なので何もしない）
 void Renderer::SetViewMatrix(XMMATRIX ViewMatrix)
 {
+	RenderQueue::Flush();
+
+	XMStoreFloat4x4(&m_CurrentView, ViewMatrix);
+
 	XMFLOAT4X4 viewf;
 	XMStoreFloat4x4(&viewf, XMMatrixTranspose(ViewMatrix));
-	m_DeviceContext->UpdateSubresource(m_ViewBuffer, 0, NULL, &viewf, 0, 0);
+	m_Backend->UpdateBuffer(m_ViewBuffer, &viewf, sizeof(viewf));
 }
 
 void Renderer::SetProjectionMatrix(XMMATRIX ProjectionMatrix)
 {
+	RenderQueue::Flush();
+
 	XMFLOAT4X4 projectionf;
 	XMStoreFloat4x4(&projectionf, XMMatrixTranspose(ProjectionMatrix));
-	m_DeviceContext->UpdateSubresource(m_ProjectionBuffer, 0, NULL, &projectionf, 0, 0);
+	m_Backend->UpdateBuffer(m_ProjectionBuffer, &projectionf, sizeof(projectionf));
 
 }
 
 void Renderer::SetMaterial( MATERIAL Material )
 {
-	m_DeviceContext->UpdateSubresource( m_MaterialBuffer, 0, NULL, &Material, 0, 0 );
+	m_Backend->SetConstantBuffer(kMaterialSlot, GpuShaderStageVertex | GpuShaderStagePixel, m_MaterialBuffer);
+	m_Backend->UpdateBuffer(m_MaterialBuffer, &Material, sizeof(Material));
 
 }
 
 void Renderer::SetLight( LIGHT Light )
 {
-	m_DeviceContext->UpdateSubresource(m_LightBuffer, 0, NULL, &Light, 0, 0);
+	m_Backend->UpdateBuffer(m_LightBuffer, &Light, sizeof(Light));
 }
 
-void Renderer::CreateVertexShader( ID3D11VertexShader** VertexShader, ID3D11InputLayout** VertexLayout, const char* FileName )
+void Renderer::CreateVertexShader( GpuVertexShader** VertexShader, GpuInputLayout** VertexLayout, const char* FileName )
 {
-
-	FILE* file;
-	long int fsize;
-
-	file = fopen(FileName, "rb");
-	assert(file);
-
-	fsize = _filelength(_fileno(file));
-	unsigned char* buffer = new unsigned char[fsize];
-	fread(buffer, fsize, 1, file);
-	fclose(file);
-
-	m_Device->CreateVertexShader(buffer, fsize, NULL, VertexShader);
-
-
-	D3D11_INPUT_ELEMENT_DESC layout[] =
+	const GpuVertexElement layout[] =
 	{
-		{ "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 0, D3D11_INPUT_PER_VERTEX_DATA, 0 },
-		{ "NORMAL",   0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 4 * 3, D3D11_INPUT_PER_VERTEX_DATA, 0 },
-		{ "COLOR",    0, DXGI_FORMAT_R32G32B32A32_FLOAT, 0, 4 * 6, D3D11_INPUT_PER_VERTEX_DATA, 0 },
-		{ "TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT, 0, 4 * 10, D3D11_INPUT_PER_VERTEX_DATA, 0 }
+		{ "POSITION", 0, GpuVertexFormat::Float3, 0, 0 },
+		{ "NORMAL",   0, GpuVertexFormat::Float3, 0, 4 * 3 },
+		{ "COLOR",    0, GpuVertexFormat::Float4, 0, 4 * 6 },
+		{ "TEXCOORD", 0, GpuVertexFormat::Float2, 0, 4 * 10 }
 	};
-	UINT numElements = ARRAYSIZE(layout);
-
-	m_Device->CreateInputLayout(layout,
-		numElements,
-		buffer,
-		fsize,
-		VertexLayout);
 
-	delete[] buffer;
+	CreateVertexShader(VertexShader, VertexLayout, FileName, layout, static_cast<std::uint32_t>(std::size(layout)));
 }
 
-void Renderer::CreatePixelShader( ID3D11PixelShader** PixelShader, const char* FileName )
+void Renderer::CreateVertexShader( GpuVertexShader** VertexShader, GpuInputLayout** VertexLayout, const char* FileName,
+	const GpuVertexElement* Layout, std::uint32_t NumElements )
 {
-	FILE* file;
-	long int fsize;
+	const FrameVector<unsigned char> buffer = ReadShaderFile(FileName);
 
-	file = fopen(FileName, "rb");
-	assert(file);
-
-	fsize = _filelength(_fileno(file));
-	unsigned char* buffer = new unsigned char[fsize];
-	fread(buffer, fsize, 1, file);
-	fclose(file);
+	*VertexShader = m_Backend->CreateVertexShader(buffer.data(), buffer.size(), Layout, NumElements, VertexLayout);
+}
 
-	m_Device->CreatePixelShader(buffer, fsize, NULL, PixelShader);
+void Renderer::CreatePixelShader( GpuPixelShader** PixelShader, const char* FileName )
+{
+	const FrameVector<unsigned char> buffer = ReadShaderFile(FileName);
 
-	delete[] buffer;
+	*PixelShader = m_Backend->CreatePixelShader(buffer.data(), buffer.size());
 }
 
 void Renderer::DrawText(const std::wstring& text, float x, float y)
 {
-	m_D2DRT->BeginDraw();
-
-	D2D1_RECT_F layout = D2D1::RectF(x, y, x + 800, y + 200);
-	m_D2DRT->DrawText(
-		text.c_str(),
-		static_cast<UINT32>(text.length()),
-		m_TextFormat,
-		layout,
-		m_Brush
-	);
-
-	m_D2DRT->EndDraw();
+	DrawText(text.c_str(), text.length(), x, y);
+}
+
+void Renderer::DrawText(const wchar_t* text, std::size_t length, float x, float y)
+{
+	// 描画は Renderer::End でまとめて行う（D3D11 では同じ内容の文字列はレイアウトを使い回す）
+	m_Backend->SubmitText(text, length, x, y);
 }
 
 static void EnsureDebugLinePipeline()
 {
-	const char* vsPath = "shader\\bin\\DebugLineVS.cso";
-	const char* psPath = "shader\\bin\\DebugLinePS.cso";
-
-	FILE* fp = fopen(vsPath, "rb"); assert(fp);
-	fseek(fp, 0, SEEK_END); long vsSize = ftell(fp); fseek(fp, 0, SEEK_SET);
-	std::vector<unsigned char> vsBlob(vsSize);
-	fread(vsBlob.data(), 1, vsSize, fp); fclose(fp);
-
-	Renderer::GetDevice()->CreateVertexShader(vsBlob.data(), vsSize, nullptr, &s_DebugLineVS);
-
-	D3D11_INPUT_ELEMENT_DESC il[] = {
-        { "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT,    0, 0,                 D3D11_INPUT_PER_VERTEX_DATA, 0 },
-        { "COLOR",    0, DXGI_FORMAT_R32G32B32A32_FLOAT, 0, sizeof(float)*3,   D3D11_INPUT_PER_VERTEX_DATA, 0 },
-    };
-    Renderer::GetDevice()->CreateInputLayout(il, _countof(il), vsBlob.data(), vsSize, &s_DebugLineIL);
-
-    fp = fopen(psPath, "rb"); assert(fp);
-    fseek(fp, 0, SEEK_END); long psSize = ftell(fp); fseek(fp, 0, SEEK_SET);
-    std::vector<unsigned char> psBlob(psSize);
-    fread(psBlob.data(), 1, psSize, fp); fclose(fp);
-    Renderer::GetDevice()->CreatePixelShader(psBlob.data(), psSize, nullptr, &s_DebugLinePS);
+	// 作成済みなら何もしない（毎回作り直すとリークする）
+	if (s_DebugLineVS && s_DebugLineIL && s_DebugLinePS) return;
+
+	const GpuVertexElement il[] = {
+		{ "POSITION", 0, GpuVertexFormat::Float3, 0, 0 },
+		{ "COLOR",    0, GpuVertexFormat::Float4, 0, sizeof(float)*3 },
+	};
+	Renderer::CreateVertexShader(&s_DebugLineVS, &s_DebugLineIL, "shader\\bin\\DebugLineVS.cso", il, static_cast<std::uint32_t>(std::size(il)));
+	Renderer::CreatePixelShader(&s_DebugLinePS, "shader\\bin\\DebugLinePS.cso");
 }
 
-void Renderer::DrawDebugLines(const DebugLineVertex* vertices, UINT vertexCount)
+// - 以降の描画は各自が必要な状態を設定し直す（バックエンドが同じ状態の設定を省く）ので、
+//   以前の状態の退避・復元は行わない
+void Renderer::DrawDebugLines(const DebugLineVertex* vertices, std::uint32_t vertexCount)
 {
     if (!vertices || vertexCount == 0) return;
 
     EnsureDebugLinePipeline();
 
-    auto* dev = GetDevice();
-    auto* ctx = GetDeviceContext();
-
-    ID3D11InputLayout*     	 prevIL  = nullptr;
-    ID3D11VertexShader*    	 prevVS  = nullptr;
-    ID3D11PixelShader*     	 prevPS  = nullptr;
-    D3D11_PRIMITIVE_TOPOLOGY prevTopo;
-
-    ctx->IAGetInputLayout(&prevIL);
-    ctx->VSGetShader(&prevVS, nullptr, nullptr);
-    ctx->PSGetShader(&prevPS, nullptr, nullptr);
-    ctx->IAGetPrimitiveTopology(&prevTopo);
-
-	XMMATRIX prevWorld = XMLoadFloat4x4(&m_CurrentWorld);
-
-    const UINT bytesNeeded = sizeof(DebugLineVertex) * vertexCount;
+    const std::uint32_t bytesNeeded = sizeof(DebugLineVertex) * vertexCount;
     if (!s_DebugVB || s_DebugVBBytes < bytesNeeded)
     {
-        if (s_DebugVB) { s_DebugVB->Release(); s_DebugVB = nullptr; }
-        s_DebugVBBytes = std::max<UINT>(bytesNeeded, 4096);
-
-        D3D11_BUFFER_DESC bd{};
-        bd.Usage = D3D11_USAGE_DYNAMIC;
-        bd.ByteWidth = s_DebugVBBytes;
-        bd.BindFlags = D3D11_BIND_VERTEX_BUFFER;
-        bd.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
-        dev->CreateBuffer(&bd, nullptr, &s_DebugVB);
+        m_Backend->Release(s_DebugVB);
+        s_DebugVBBytes = std::max<std::uint32_t>(bytesNeeded, 4096);
+
+        GpuBufferDesc desc{};
+        desc.size = s_DebugVBBytes;
+        desc.usage = GpuBufferUsage::Dynamic;
+        desc.bind = GpuBufferBind::Vertex;
+        s_DebugVB = m_Backend->CreateBuffer(desc, nullptr);
     }
 
-    D3D11_MAPPED_SUBRESOURCE msr{};
-    ctx->Map(s_DebugVB, 0, D3D11_MAP_WRITE_DISCARD, 0, &msr);
-    memcpy(msr.pData, vertices, bytesNeeded);
-    ctx->Unmap(s_DebugVB, 0);
+    void* mapped = m_Backend->MapDiscard(s_DebugVB);
+    if (!mapped) return;
+    memcpy(mapped, vertices, bytesNeeded);
+    m_Backend->Unmap(s_DebugVB, bytesNeeded);
 
-    UINT stride = sizeof(DebugLineVertex), offset = 0;
-    ctx->IASetInputLayout(s_DebugLineIL);
-    ctx->IASetVertexBuffers(0, 1, &s_DebugVB, &stride, &offset);
-    ctx->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_LINELIST);
-    ctx->VSSetShader(s_DebugLineVS, nullptr, 0);
-    ctx->PSSetShader(s_DebugLinePS, nullptr, 0);
+    m_Backend->SetInputLayout(s_DebugLineIL);
+    m_Backend->SetVertexBuffer(0, s_DebugVB, sizeof(DebugLineVertex));
+    m_Backend->SetTopology(GpuTopology::LineList);
+    m_Backend->SetVertexShader(s_DebugLineVS);
+    m_Backend->SetPixelShader(s_DebugLinePS);
 
 	SetWorldMatrix(XMMatrixIdentity());
 
-    ctx->Draw(vertexCount, 0);
-
-    ctx->IASetInputLayout(prevIL);
-    ctx->VSSetShader(prevVS, nullptr, 0);
-    ctx->PSSetShader(prevPS, nullptr, 0);
-    ctx->IASetPrimitiveTopology(prevTopo);
-
-    if (prevIL) prevIL->Release();
-    if (prevVS) prevVS->Release();
-    if (prevPS) prevPS->Release();
+    m_Backend->Draw(vertexCount, 0);
 }
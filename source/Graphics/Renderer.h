@@ -1,11 +1,29 @@
 ﻿#pragma once
 
-#include <d3d11.h>
-#include <dxgi.h>
+// NOTE: このヘッダと Renderer.cpp は Windows のヘッダに依存しない（tools/RenderBench が他の環境でビルドする）。
+//       ウィンドウからのバックエンド作成と DirectXTex の画像は RendererWin32.cpp、文字の描画は D3D11RenderBackend にある
+#include <cstddef>
+#include <cstdint>
 #include <DirectXMath.h>
-#include <d2d1.h>
-#include <dwrite.h>
 #include <string>
+#include "RenderBackend.h"
+
+using namespace DirectX;
+
+namespace DirectX { class ScratchImage; }
+
+// windows.h の DrawText マクロ（DrawTextW / DrawTextA）で Renderer::DrawText の名前が変わらないようにする
+// - Windows では先に windows.h を読んでからマクロを消す（後で読まれてもインクルードガードで再定義されない）。
+//   読む順で宣言側と呼び出し側の名前がずれないように、ここで必ず消しておく
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#endif
+#ifdef DrawText
+#undef DrawText
+#endif
 
 // ------------------------------------------------------------------------------
 // 構造体定義
@@ -31,17 +49,26 @@ struct MATERIAL
 	XMFLOAT4	Specular;
 	XMFLOAT4	Emission;
 	float		Shininess;
-	BOOL		TextureEnable;
+	std::int32_t	TextureEnable;	// BOOL（HLSL の bool と同じ 4 バイト）
 	float		Dummy[2];
 };
 
+/// <summary>
+/// ワールド行列の定数バッファ（シェーダーへ渡すため転置済み）
+/// </summary>
+struct CBWorld
+{
+	DirectX::XMFLOAT4X4 World;
+	DirectX::XMFLOAT4X4 WorldInvTranspose;
+};
+
 /// <summary>
 /// ライト構造体
 /// </summary>
 struct LIGHT
 {
-	BOOL		Enable;
-	BOOL		Dummy[3];
+	std::int32_t	Enable;		// BOOL（同上）
+	std::int32_t	Dummy[3];
 	XMFLOAT4	Direction;
 	XMFLOAT4	Diffuse;
 	XMFLOAT4	Ambient;
@@ -56,52 +83,49 @@ struct DebugLineVertex
 	DirectX::XMFLOAT4 Color;
 };
 
+/// <summary>
+/// 描画バックエンドの種類
+/// </summary>
+enum class RenderBackendType
+{
+	D3D11,		// Direct3D 11（通常）
+	Recording,	// GPU を使わず統計だけ取る（描画経路の計測用）
+};
+
 class Renderer
 {
 private:
 
-	static D3D_FEATURE_LEVEL       m_FeatureLevel;
-
-	static ID3D11Device* m_Device;
-	static ID3D11DeviceContext* m_DeviceContext;
-	static IDXGISwapChain* m_SwapChain;
-	static ID3D11RenderTargetView* m_RenderTargetView;
-	static ID3D11DepthStencilView* m_DepthStencilView;
-
-	static ID3D11Buffer* m_WorldBuffer;
-	static ID3D11Buffer* m_ViewBuffer;
-	static ID3D11Buffer* m_ProjectionBuffer;
-	static ID3D11Buffer* m_MaterialBuffer;
-	static ID3D11Buffer* m_LightBuffer;
-
-
-	static ID3D11DepthStencilState* m_DepthStateEnable;
-	static ID3D11DepthStencilState* m_DepthStateDisable;
-
-	static ID3D11BlendState* m_BlendState;
-	static ID3D11BlendState* m_BlendStateATC;
-
-
-	// 追加：Direct2D／DirectWrite 用メンバ
-	static ID2D1Factory* m_D2DFactory;
-	static ID2D1RenderTarget* m_D2DRT;
-	static IDWriteFactory* m_DWriteFactory;
-	static IDWriteTextFormat* m_TextFormat;
-	static ID2D1SolidColorBrush* m_Brush;
+	static RenderBackendType m_BackendType;
+	static RenderBackend* m_Backend;	// 所有：描画バックエンド
+	static std::uint32_t m_ScreenWidth;
+	static std::uint32_t m_ScreenHeight;
 
+	static GpuBuffer* m_WorldBuffer;
+	static GpuBuffer* m_ViewBuffer;
+	static GpuBuffer* m_ProjectionBuffer;
+	static GpuBuffer* m_MaterialBuffer;
+	static GpuBuffer* m_LightBuffer;
 
 
 public:
 	// ------------------------------------------------------------------------------
 	// 関数定義
 	// ------------------------------------------------------------------------------
+	/// 描画バックエンドの種類を指定する（Init より前に呼ぶこと）
+	static void SetBackendType(RenderBackendType type) { m_BackendType = type; }
+
+	/// ウィンドウに合わせてバックエンドを作り、下の Init を呼ぶ（Windows のみ。RendererWin32.cpp）
 	static void Init();
+	/// 作成済みのバックエンドで初期化する（所有権を受け取る。tools/RenderBench は記録用バックエンドで呼ぶ）
+	static void Init(RenderBackend* backend, std::uint32_t screenWidth, std::uint32_t screenHeight);
 	static void Uninit();
 	static void Begin();
 	static void End();
 
 	static void SetDepthEnable(bool Enable);
 	static void SetATCEnable(bool Enable);
+	/// ビュー / 射影行列を設定する（RenderQueue に溜めた描画は、書き換える前の行列で先に描かれる）
 	static void SetWorldViewProjection2D();
 	static void SetWorldMatrix(XMMATRIX WorldMatrix);
 	static void SetViewMatrix(XMMATRIX ViewMatrix);
@@ -109,22 +133,39 @@ public:
 	static void SetMaterial(MATERIAL Material);
 	static void SetLight(LIGHT Light);
 
-	static ID3D11Device* GetDevice(void) { return m_Device; }
-	static ID3D11DeviceContext* GetDeviceContext(void) { return m_DeviceContext; }
+	/// ワールド行列の定数バッファの中身を作る
+	static void MakeWorldConstants(XMMATRIX WorldMatrix, CBWorld& Out);
+	/// 書き込み済みの定数バッファの範囲を、ワールド行列 / マテリアルとして設定する
+	/// （SupportsConstantBufferRanges なバックエンドのみ。次の SetWorldMatrix / SetMaterial で元に戻る）
+	static void SetWorldConstants(GpuBuffer* Buffer, std::uint32_t Offset);
+	static void SetMaterialConstants(GpuBuffer* Buffer, std::uint32_t Offset);
+
+	/// 描画バックエンド（リソース作成・状態設定・描画はすべてここを通す）
+	static RenderBackend& GetBackend(void) { return *m_Backend; }
+
 
 
+	static void CreateVertexShader(GpuVertexShader** VertexShader, GpuInputLayout** VertexLayout, const char* FileName);
+	/// 入力レイアウト指定版（インスタンス描画など VERTEX_3D 以外の入力を持つシェーダー用）
+	static void CreateVertexShader(GpuVertexShader** VertexShader, GpuInputLayout** VertexLayout, const char* FileName,
+		const GpuVertexElement* Layout, std::uint32_t NumElements);
+	static void CreatePixelShader(GpuPixelShader** PixelShader, const char* FileName);
 
-	static void CreateVertexShader(ID3D11VertexShader** VertexShader, ID3D11InputLayout** VertexLayout, const char* FileName);
-	static void CreatePixelShader(ID3D11PixelShader** PixelShader, const char* FileName);
+	/// デコード済み画像（DirectXTex）からテクスチャを作成する（先頭の画像のミップのみ使う。Windows のみ）
+	static GpuTexture* CreateTexture(const DirectX::ScratchImage& Decoded);
 
 	// 追加：テキスト描画
+	/// 描画は Renderer::End でまとめて行われ、メッシュより手前に出る（バックエンドの SubmitText / FlushText）
 	static void DrawText(const std::wstring& text, float x, float y);
+	/// 長さ指定版（FrameWString など std::wstring 以外の文字列から呼ぶ）
+	static void DrawText(const wchar_t* text, std::size_t length, float x, float y);
 
 	// デバッグ線
-	static void DrawDebugLines(const DebugLineVertex* vertices, UINT vertexCount);
+	static void DrawDebugLines(const DebugLineVertex* vertices, std::uint32_t vertexCount);
 
 	// ------------------------------------------------------------------------------
 	// 変数定義
 	// ------------------------------------------------------------------------------
 	static XMFLOAT4X4 m_CurrentWorld; // 現在のワールド行列
+	static XMFLOAT4X4 m_CurrentView;  // 現在のビュー行列（RenderQueue の深度計算用）
 };
@@ -0,0 +1,53 @@
+﻿// Renderer のうち Windows でしか作れない部分
+// - ウィンドウに合わせたバックエンドの作成（D3D11 はウィンドウが要る / -nullrender では記録用）
+// - DirectXTex の画像からのテクスチャ作成（ModelRenderer / AnimationModel / Polygon2D の WIC 読み込み用）
+// NOTE: それ以外の Renderer は Renderer.cpp（Windows のヘッダに依存しない）にある
+#include "main.h"
+#include "Renderer.h"
+#include "FrameArena.h"
+#include "D3D11RenderBackend.h"
+#include "RecordingRenderBackend.h"
+
+
+RenderBackendType		Renderer::m_BackendType = RenderBackendType::D3D11;
+
+
+void Renderer::Init()
+{
+	RenderBackend* backend = nullptr;
+	if (m_BackendType == RenderBackendType::Recording)
+	{
+		backend = new RecordingRenderBackend;
+	}
+	else
+	{
+		D3D11RenderBackend* d3d11 = new D3D11RenderBackend;
+		const bool initialized = d3d11->Init(GetWindow(), SCREEN_WIDTH, SCREEN_HEIGHT);
+		assert(initialized);
+		backend = d3d11;
+	}
+
+	Init(backend, SCREEN_WIDTH, SCREEN_HEIGHT);
+}
+
+GpuTexture* Renderer::CreateTexture(const ScratchImage& Decoded)
+{
+	const TexMetadata& metadata = Decoded.GetMetadata();
+
+	GpuTextureDesc desc{};
+	desc.width = static_cast<std::uint32_t>(metadata.width);
+	desc.height = static_cast<std::uint32_t>(metadata.height);
+	desc.mipLevels = static_cast<std::uint32_t>(metadata.mipLevels);
+	desc.format = static_cast<std::uint32_t>(metadata.format);
+
+	FrameVector<GpuSubresource> subresources(desc.mipLevels);
+	for (std::uint32_t mip = 0; mip < desc.mipLevels; ++mip)
+	{
+		const Image* image = Decoded.GetImage(mip, 0, 0);
+		subresources[mip].pixels = image->pixels;
+		subresources[mip].rowPitch = image->rowPitch;
+		subresources[mip].slicePitch = image->slicePitch;
+	}
+
+	return m_Backend->CreateTexture2D(desc, subresources.data());
+}
@@ -0,0 +1,164 @@
+﻿#include "ShaderCache.h"
+#include <cassert>
+#include <cstdio>
+
+// 静的メンバ変数の定義
+std::unordered_map<std::string, SharedVertexShader> ShaderCache::s_VertexShaders;
+std::unordered_map<std::string, SharedPixelShader>  ShaderCache::s_PixelShaders;
+
+namespace
+{
+    /// FNV-1a でバイト列を混ぜる
+    std::uint64_t HashBytes(std::uint64_t hash, const void* data, std::size_t size)
+    {
+        const auto* bytes = static_cast<const unsigned char*>(data);
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            hash = (hash ^ bytes[i]) * 0x100000001B3ull;
+        }
+        return hash;
+    }
+}
+
+// ------------------------------------------------------------------------------
+// 取得
+// ------------------------------------------------------------------------------
+// - 未登録の場合のみ .cso を読んでシェーダーを作る（失敗したパスは failed として覚え、読み直さない）
+SharedVertexShader* ShaderCache::AcquireVertexShader(const char* path)
+{
+    SharedVertexShader& entry = s_VertexShaders[path];
+    if (!entry.shader && !entry.failed)
+    {
+        Renderer::CreateVertexShader(&entry.shader, &entry.layout, path);
+        entry.failed = !entry.shader;
+    }
+
+    ++entry.refCount;
+    return &entry;
+}
+
+SharedVertexShader* ShaderCache::AcquireVertexShader(const char* path, const GpuVertexElement* layout, std::uint32_t numElements)
+{
+    SharedVertexShader& entry = s_VertexShaders[MakeLayoutKey(path, layout, numElements)];
+    if (!entry.shader && !entry.failed)
+    {
+        Renderer::CreateVertexShader(&entry.shader, &entry.layout, path, layout, numElements);
+        entry.failed = !entry.shader;
+    }
+
+    ++entry.refCount;
+    return &entry;
+}
+
+SharedPixelShader* ShaderCache::AcquirePixelShader(const char* path)
+{
+    SharedPixelShader& entry = s_PixelShaders[path];
+    if (!entry.shader && !entry.failed)
+    {
+        Renderer::CreatePixelShader(&entry.shader, path);
+        entry.failed = !entry.shader;
+    }
+
+    ++entry.refCount;
+    return &entry;
+}
+
+// - セマンティクスは名前の文字列で混ぜる（ポインタは呼び出し元ごとに異なるため）
+std::string ShaderCache::MakeLayoutKey(const char* path, const GpuVertexElement* layout, std::uint32_t numElements)
+{
+    std::uint64_t hash = 0xCBF29CE484222325ull;
+    for (std::uint32_t i = 0; i < numElements; ++i)
+    {
+        const GpuVertexElement& element = layout[i];
+        hash = HashBytes(hash, element.semantic, std::char_traits<char>::length(element.semantic));
+        hash = HashBytes(hash, &element.semanticIndex, sizeof(element.semanticIndex));
+        hash = HashBytes(hash, &element.format, sizeof(element.format));
+        hash = HashBytes(hash, &element.slot, sizeof(element.slot));
+        hash = HashBytes(hash, &element.offset, sizeof(element.offset));
+        hash = HashBytes(hash, &element.perInstance, sizeof(element.perInstance));
+    }
+
+    char suffix[24];
+    std::snprintf(suffix, sizeof(suffix), "#%016llx", static_cast<unsigned long long>(hash));
+    return std::string(path) + suffix;
+}
+
+// ------------------------------------------------------------------------------
+// 解放
+// ------------------------------------------------------------------------------
+void ShaderCache::Release(SharedVertexShader* shader)
+{
+    if (!shader)
+        return;
+
+    assert(shader->refCount > 0 && "ShaderCache::Release：参照カウントが 0 の頂点シェーダーを解放した");
+    --shader->refCount;
+}
+
+void ShaderCache::Release(SharedPixelShader* shader)
+{
+    if (!shader)
+        return;
+
+    assert(shader->refCount > 0 && "ShaderCache::Release：参照カウントが 0 のピクセルシェーダーを解放した");
+    --shader->refCount;
+}
+
+// - シーン差し替え後に呼び、新シーンで使われないシェーダーを手放す
+std::size_t ShaderCache::PurgeUnused()
+{
+    RenderBackend& backend = Renderer::GetBackend();
+    std::size_t purged = 0;
+
+    for (auto it = s_VertexShaders.begin(); it != s_VertexShaders.end();)
+    {
+        if (it->second.refCount == 0)
+        {
+            backend.Release(it->second.shader);
+            backend.Release(it->second.layout);
+            it = s_VertexShaders.erase(it);
+            ++purged;
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    for (auto it = s_PixelShaders.begin(); it != s_PixelShaders.end();)
+    {
+        if (it->second.refCount == 0)
+        {
+            backend.Release(it->second.shader);
+            it = s_PixelShaders.erase(it);
+            ++purged;
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    return purged;
+}
+
+// - 終了時は全コンポーネントが解放済みのはずなので、参照が残っていれば解放漏れ
+void ShaderCache::Uninit()
+{
+    RenderBackend& backend = Renderer::GetBackend();
+
+    for (auto& pair : s_VertexShaders)
+    {
+        assert(pair.second.refCount == 0 && "ShaderCache::Uninit：参照が残っている頂点シェーダーがある");
+        backend.Release(pair.second.shader);
+        backend.Release(pair.second.layout);
+    }
+    s_VertexShaders.clear();
+
+    for (auto& pair : s_PixelShaders)
+    {
+        assert(pair.second.refCount == 0 && "ShaderCache::Uninit：参照が残っているピクセルシェーダーがある");
+        backend.Release(pair.second.shader);
+    }
+    s_PixelShaders.clear();
+}
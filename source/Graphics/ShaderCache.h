@@ -0,0 +1,85 @@
+﻿//------------------------------------------------------------------------------
+// ShaderCache
+//------------------------------------------------------------------------------
+// 役割:
+// 頂点シェーダー（＋入力レイアウト）とピクセルシェーダーを .cso のパスごとに 1 つだけ作り、
+// 参照カウントで共有する。
+//
+// 設計意図:
+// MeshRenderer / ModelRenderer の LoadShader がコンポーネントごとに Renderer::Create〜 を呼ぶと、
+// 敵の出現のたびに同じ .cso を読み直し、ドライバでシェーダーを作り直すことになる。
+// パスごとに共有すれば、ファイル読み込みとシェーダー作成は最初の 1 回だけで済む。
+//
+// 構成:
+// - SharedVertexShader  : 頂点シェーダーと入力レイアウト、参照カウント
+// - SharedPixelShader   : ピクセルシェーダー、参照カウント
+// - Acquire〜           : 未登録なら作って登録し、参照を 1 つ増やして返す
+// - Release             : 参照を 1 つ減らす（0 になってもすぐには解放しない）
+// - PurgeUnused         : 参照 0 のシェーダーを解放する（シーン差し替え後に呼ぶ）
+// - Uninit              : すべて解放する（Renderer::Uninit より前に呼ぶこと）
+//
+// NOTE:
+// - 入力レイアウトを指定した頂点シェーダーは、パスとレイアウトの内容の組で区別する
+// - 作成に失敗したパスも登録したまま failed として覚え、以降の Acquire では作り直さない
+//   （shader は nullptr のまま返す。PurgeUnused で参照 0 になれば消え、次の Acquire で再び試す）
+// - メインスレッドからのみ呼ぶこと
+//------------------------------------------------------------------------------
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include "Renderer.h"
+
+/// 共有される頂点シェーダー
+struct SharedVertexShader
+{
+    GpuVertexShader* shader   = nullptr;
+    GpuInputLayout*  layout   = nullptr;
+    std::uint32_t    refCount = 0;
+    bool             failed   = false;  // 作成に失敗した（.cso を読み直さない）
+};
+
+/// 共有されるピクセルシェーダー
+struct SharedPixelShader
+{
+    GpuPixelShader* shader   = nullptr;
+    std::uint32_t   refCount = 0;
+    bool            failed   = false;   // 作成に失敗した（.cso を読み直さない）
+};
+
+/// シェーダーのキャッシュ
+class ShaderCache
+{
+public:
+    /// 頂点シェーダーを取得する（入力レイアウトは VERTEX_3D）
+    static SharedVertexShader* AcquireVertexShader(const char* path);
+
+    /// 頂点シェーダーを取得する（入力レイアウト指定版）
+    static SharedVertexShader* AcquireVertexShader(const char* path, const GpuVertexElement* layout, std::uint32_t numElements);
+
+    /// ピクセルシェーダーを取得する
+    static SharedPixelShader* AcquirePixelShader(const char* path);
+
+    /// 参照を 1 つ減らす（nullptr は無視）
+    static void Release(SharedVertexShader* shader);
+    static void Release(SharedPixelShader* shader);
+
+    /// 参照 0 のシェーダーを解放する
+    /// 戻り値：解放したシェーダーの数
+    static std::size_t PurgeUnused();
+
+    /// すべてのシェーダーを解放する
+    static void Uninit();
+
+    /// 登録中のシェーダーの数（頂点 + ピクセル）
+    static std::size_t GetShaderCount() { return s_VertexShaders.size() + s_PixelShaders.size(); }
+
+private:
+    /// 入力レイアウト指定版のキー（パス + レイアウトの内容のハッシュ）
+    static std::string MakeLayoutKey(const char* path, const GpuVertexElement* layout, std::uint32_t numElements);
+
+private:
+    static std::unordered_map<std::string, SharedVertexShader> s_VertexShaders;  // 所有：キー → 頂点シェーダー（要素のアドレスは不変）
+    static std::unordered_map<std::string, SharedPixelShader>  s_PixelShaders;   // 所有：パス → ピクセルシェーダー
+};
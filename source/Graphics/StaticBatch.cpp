@@ -0,0 +1,230 @@
+﻿#include "StaticBatch.h"
+#include "MeshRenderer.h"
+#include "RenderQueue.h"
+#include <cassert>
+
+// ------------------------------------------------------------------------------
+// 候補の受け付け
+// ------------------------------------------------------------------------------
+bool StaticBatch::Add(MeshRenderer* mesh)
+{
+    assert(!m_Built && "StaticBatch::Add：Build の後に取り込もうとした");
+    if (m_Built || !mesh || mesh->m_StaticBatched)
+        return false;
+
+    const SharedMesh* shared = mesh->m_SharedMesh;
+    if (!shared || shared->vertices.empty() || !mesh->m_SharedVertexShader || !mesh->m_SharedPixelShader)
+        return false;
+    if (mesh->GetTopology() != GpuTopology::TriangleList || mesh->m_Color.w < 1.0f)
+        return false;
+
+    // インスタンス描画できるものは RenderQueue に任せる（結合すると状態変更が増える）
+    if (mesh->m_InstancedShader)
+        return false;
+
+    m_Candidates.push_back(mesh);
+    return true;
+}
+
+// ------------------------------------------------------------------------------
+// まとまりの決定と GPU バッファの作成
+// ------------------------------------------------------------------------------
+// - 候補をシェーダー・テクスチャごとに分け、2 つ以上あるまとまりだけを取り込む
+//   （1 つだけなら結合しても描画は減らない。候補は数個〜数十個の想定なので線形探索で分ける）
+void StaticBatch::Build()
+{
+    assert(!m_Built && "StaticBatch::Build：2 回呼ばれた");
+    if (m_Built)
+        return;
+
+    std::vector<bool> assigned(m_Candidates.size(), false);
+    std::vector<MeshRenderer*> pieces;
+    for (std::size_t i = 0; i < m_Candidates.size(); ++i)
+    {
+        if (assigned[i])
+            continue;
+
+        pieces.clear();
+        for (std::size_t j = i; j < m_Candidates.size(); ++j)
+        {
+            if (!assigned[j] && IsSameGroup(*m_Candidates[i], *m_Candidates[j]))
+            {
+                pieces.push_back(m_Candidates[j]);
+                assigned[j] = true;
+            }
+        }
+
+        if (pieces.size() < 2)
+            continue;
+
+        m_Groups.emplace_back();
+        StaticBatchGroup& group = m_Groups.back();
+        for (MeshRenderer* piece : pieces)
+        {
+            Merge(group, piece);
+        }
+    }
+    std::vector<MeshRenderer*>().swap(m_Candidates);
+
+    RenderBackend& backend = Renderer::GetBackend();
+    for (StaticBatchGroup& group : m_Groups)
+    {
+        GpuBufferDesc desc{};
+        desc.size = static_cast<std::uint32_t>(sizeof(VERTEX_3D) * group.vertices.size());
+        desc.bind = GpuBufferBind::Vertex;
+        group.vertexBuffer = backend.CreateBuffer(desc, group.vertices.data());
+
+        desc.size = static_cast<std::uint32_t>(sizeof(std::uint32_t) * group.indices.size());
+        desc.bind = GpuBufferBind::Index;
+        group.indexBuffer = backend.CreateBuffer(desc, group.indices.data());
+        group.indexCount  = static_cast<std::uint32_t>(group.indices.size());
+
+        // GPU へ渡したので CPU 側の配列は手放す
+        std::vector<VERTEX_3D>().swap(group.vertices);
+        std::vector<std::uint32_t>().swap(group.indices);
+    }
+    m_Built = true;
+}
+
+// ------------------------------------------------------------------------------
+// 描画
+// ------------------------------------------------------------------------------
+// - 頂点はワールド座標なのでワールド行列は単位行列、色は頂点に焼き込んだのでマテリアルは白
+// - バッファはまとまりごとに固有なのでインスタンス化はしない
+// - 取り込み元がすべて視錐台の外なら積まない
+void StaticBatch::Draw()
+{
+    if (!m_Built)
+        return;
+
+    RenderPacket packet;
+    packet.indexFormat = GpuIndexFormat::UInt32;
+    packet.topology    = GpuTopology::TriangleList;
+    packet.pass        = RenderPass::Opaque;
+    packet.material.Diffuse = { 1.0f, 1.0f, 1.0f, 1.0f };
+    packet.material.Ambient = { 1.0f, 1.0f, 1.0f, 1.0f };
+    XMStoreFloat4x4(&packet.world, XMMatrixIdentity());
+
+    for (const StaticBatchGroup& group : m_Groups)
+    {
+        if (!IsAnyPieceVisible(group))
+            continue;
+
+        packet.layout       = group.vertexShader->layout;
+        packet.vertexShader = group.vertexShader->shader;
+        packet.pixelShader  = group.pixelShader->shader;
+        packet.texture      = group.texture ? TextureCache::GetTexture(group.texture) : nullptr;
+        packet.vertexBuffer = group.vertexBuffer;
+        packet.indexBuffer  = group.indexBuffer;
+        packet.count        = group.indexCount;
+        packet.material.TextureEnable = group.textureEnable;
+
+        RenderQueue::Submit(packet);
+    }
+}
+
+// ------------------------------------------------------------------------------
+// 終了処理
+// ------------------------------------------------------------------------------
+void StaticBatch::Uninit()
+{
+    m_Candidates.clear();
+    if (m_Groups.empty())
+        return;
+
+    RenderBackend& backend = Renderer::GetBackend();
+    for (StaticBatchGroup& group : m_Groups)
+    {
+        backend.Release(group.vertexBuffer);
+        backend.Release(group.indexBuffer);
+        ShaderCache::Release(group.vertexShader);
+        ShaderCache::Release(group.pixelShader);
+        TextureCache::Release(group.texture);
+    }
+    m_Groups.clear();
+    m_Built = false;
+}
+
+// ------------------------------------------------------------------------------
+// 内部処理
+// ------------------------------------------------------------------------------
+bool StaticBatch::IsSameGroup(const MeshRenderer& a, const MeshRenderer& b)
+{
+    return a.m_SharedVertexShader == b.m_SharedVertexShader &&
+           a.m_SharedPixelShader == b.m_SharedPixelShader &&
+           a.m_Texture == b.m_Texture &&
+           a.m_EnableTexture == b.m_EnableTexture;
+}
+
+// - 位置はワールド行列、法線はその逆転置で変換する（非一様スケールの壁でも陰影が崩れない）
+// - インデックスを持たない形状は 0, 1, 2, ... を補う
+// - mesh のシェーダー / テクスチャの参照は、空のまとまりならそのまま引き継ぎ、そうでなければ返す
+// - 形状と境界球は mesh に残す（まとまりを描くかどうかの判定に使う）
+void StaticBatch::Merge(StaticBatchGroup& group, MeshRenderer* mesh)
+{
+    if (group.pieces.empty())
+    {
+        group.vertexShader  = mesh->m_SharedVertexShader;
+        group.pixelShader   = mesh->m_SharedPixelShader;
+        group.texture       = mesh->m_Texture;
+        group.textureEnable = mesh->m_EnableTexture;
+    }
+    else
+    {
+        ShaderCache::Release(mesh->m_SharedVertexShader);
+        ShaderCache::Release(mesh->m_SharedPixelShader);
+        TextureCache::Release(mesh->m_Texture);
+    }
+    group.pieces.push_back(mesh);
+
+    // 頂点の変換
+    const SharedMesh* shared = mesh->m_SharedMesh;
+    const Vector3& localScale = mesh->m_LocalScale;
+    const XMMATRIX world = XMMatrixScaling(localScale.x, localScale.y, localScale.z) * mesh->m_Transform->GetWorldMatrix();
+    const XMMATRIX normalMatrix = XMMatrixTranspose(XMMatrixInverse(nullptr, world));
+    const XMVECTOR color = XMLoadFloat4(&mesh->m_Color);
+
+    const std::uint32_t baseVertex = static_cast<std::uint32_t>(group.vertices.size());
+    group.vertices.reserve(group.vertices.size() + shared->vertices.size());
+    for (const VERTEX_3D& source : shared->vertices)
+    {
+        VERTEX_3D vertex = source;
+        XMStoreFloat3(&vertex.Position, XMVector3TransformCoord(XMLoadFloat3(&source.Position), world));
+        XMStoreFloat3(&vertex.Normal, XMVector3Normalize(XMVector3TransformNormal(XMLoadFloat3(&source.Normal), normalMatrix)));
+        XMStoreFloat4(&vertex.Diffuse, XMVectorMultiply(XMLoadFloat4(&source.Diffuse), color));
+        group.vertices.push_back(vertex);
+    }
+
+    // インデックスの付け替え
+    if (shared->indices.empty())
+    {
+        for (std::uint32_t i = 0; i < shared->vertices.size(); ++i)
+        {
+            group.indices.push_back(baseVertex + i);
+        }
+    }
+    else
+    {
+        for (std::uint16_t index : shared->indices)
+        {
+            group.indices.push_back(baseVertex + index);
+        }
+    }
+
+    // 参照は引き継ぎ済み / 返却済みなので、mesh 側は手放すだけにする（ShaderCache::Release は nullptr を無視する）
+    mesh->m_SharedVertexShader = nullptr;
+    mesh->m_SharedPixelShader  = nullptr;
+    mesh->m_Texture            = nullptr;
+    mesh->ReleaseShader();
+    mesh->m_StaticBatched = true;
+}
+
+bool StaticBatch::IsAnyPieceVisible(const StaticBatchGroup& group)
+{
+    for (const MeshRenderer* piece : group.pieces)
+    {
+        if (piece->m_Bounds.IsVisible())
+            return true;
+    }
+    return false;
+}
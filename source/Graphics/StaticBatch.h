@@ -0,0 +1,109 @@
+﻿//------------------------------------------------------------------------------
+// StaticBatch
+//------------------------------------------------------------------------------
+// 役割:
+// 動かない MeshRenderer（台の壁・ガイドなど）の形状をワールド座標へ変換してから
+// 「シェーダー・テクスチャが同じもの」ごとに 1 組の頂点 / インデックスバッファへまとめ、1 回の描画で描く。
+//
+// 設計意図:
+// インスタンス描画版の VS があるメッシュは、RenderQueue がメッシュごとに 1 回の描画へまとめる。
+// それを結合に置き換えると、インスタンス描画の 1 回が通常の描画 1 回になるだけで、
+// 結合したバッファ・ワールド行列の設定が増える（RenderBench で状態変更 11 → 20、描画は 5 → 4 にしか減らない）。
+// そのため取り込むのは「インスタンス描画版の VS が無い」ためにパケットごとに描かれるものに限る。
+// 位置は読み込み後に変わらないので、読み込み時に頂点を変換して結合しておけば、
+// 描画はマテリアルの種類数で済み、ワールド行列の更新も要らない。
+// 当たり判定は子 GameObject の ColliderGroup にそのまま残す（見た目だけをまとめる）。
+//
+// 構成:
+// - StaticBatchGroup : シェーダー・テクスチャが同じ形状をまとめた頂点 / インデックスと GPU バッファ
+// - Add              : MeshRenderer を取り込みの候補にする
+// - Build            : 候補をまとまりに分け、2 つ以上あるまとまりだけを取り込んで GPU バッファを作る
+// - Draw             : 見えるまとまりごとに RenderQueue へ 1 パケット積む
+//
+// NOTE:
+// - 色（MeshRenderer::m_Color）は頂点色へ掛けて焼き込む（BaseLitPS はマテリアル色 × 頂点色）。
+//   色だけが違うものも同じまとまりになる
+// - インスタンス描画版の VS がある・半透明・TriangleList 以外・MeshCache の形状を持たない MeshRenderer は
+//   候補にしない（Add が false を返す）
+// - 取り込まなかった候補は今まで通り自分で描画する（インスタンス描画・視錐台カリングもそのまま）
+// - 取り込み後に元の Transform を動かしても見た目は追従しない
+// - 取り込んだ MeshRenderer は形状と境界球を持ち続け、まとまりはそのどれかが見える場合だけ描く
+//   （取り込んだ MeshRenderer を StaticBatch より先に破棄しないこと）
+// - 取り込んだ MeshRenderer のシェーダー / テクスチャの参照は StaticBatch が引き継ぎ、Uninit で返す
+//------------------------------------------------------------------------------
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "component.h"
+#include "Renderer.h"
+
+class MeshRenderer;
+struct SharedVertexShader;
+struct SharedPixelShader;
+struct SharedTexture;
+
+/// シェーダー・テクスチャが同じ形状のまとまり
+struct StaticBatchGroup
+{
+    SharedVertexShader* vertexShader = nullptr;     // 参照 1 つを所有（Uninit で返す）
+    SharedPixelShader*  pixelShader  = nullptr;     // 同上
+    SharedTexture*      texture      = nullptr;     // 同上（テクスチャなしは nullptr）
+    bool                textureEnable = false;
+
+    std::vector<const MeshRenderer*> pieces;        // 非所有：取り込んだ MeshRenderer（境界球で見えるかを判定する）
+
+    std::vector<VERTEX_3D>     vertices;            // ワールド座標へ変換済みの頂点（Build で手放す）
+    std::vector<std::uint32_t> indices;             // 同上
+
+    GpuBuffer*    vertexBuffer = nullptr;           // 所有
+    GpuBuffer*    indexBuffer  = nullptr;           // 所有
+    std::uint32_t indexCount   = 0;
+};
+
+/// 静的な形状の結合描画
+class StaticBatch : public Component
+{
+public:
+    using Component::Component;
+
+    ~StaticBatch() override { Uninit(); }
+
+    // ----------------------------------------------------------------------
+    // ライフサイクル
+    // ----------------------------------------------------------------------
+    /// GPU バッファと、引き継いだシェーダー / テクスチャの参照を返す
+    void Uninit() override;
+
+    /// 見えるまとまりごとに 1 パケットを RenderQueue へ積む（Build 前は何もしない）
+    void Draw() override;
+
+    // ----------------------------------------------------------------------
+    // 構築
+    // ----------------------------------------------------------------------
+    /// mesh を取り込みの候補にする（取り込むかどうかは Build で決める）
+    /// 戻り値：候補にした場合 true（候補にできない mesh は今まで通り自分で描画する）
+    bool Add(MeshRenderer* mesh);
+
+    /// 候補をまとまりに分け、2 つ以上あるまとまりだけを取り込んで GPU バッファを作る
+    /// （Add をすべて終えてから 1 回呼ぶ）
+    /// - 取り込んだ mesh は形状を現在のワールド行列で変換して結合し、以後は自分で描画しない
+    void Build();
+
+    /// まとまりの数（= 1 フレームの描画パケット数の上限）
+    std::size_t GetGroupCount() const { return m_Groups.size(); }
+
+private:
+    /// a と b が同じまとまりに入るか（シェーダー・テクスチャが同じ）
+    static bool IsSameGroup(const MeshRenderer& a, const MeshRenderer& b);
+
+    /// mesh の形状をワールド座標へ変換して group へ結合し、シェーダー / テクスチャの参照を group へ移す
+    static void Merge(StaticBatchGroup& group, MeshRenderer* mesh);
+
+    /// group の取り込み元のどれかが視錐台の中にあるか
+    static bool IsAnyPieceVisible(const StaticBatchGroup& group);
+
+private:
+    std::vector<MeshRenderer*>    m_Candidates;    // 非所有：Add で受け付けた候補（Build で空にする）
+    std::vector<StaticBatchGroup> m_Groups;
+    bool m_Built = false;
+};
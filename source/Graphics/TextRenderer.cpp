@@ -0,0 +1,158 @@
+﻿#include "main.h"
+#include "TextRenderer.h"
+#include <cassert>
+
+// 静的メンバ変数の定義
+IDWriteFactory*    TextRenderer::s_Factory = nullptr;
+IDWriteTextFormat* TextRenderer::s_Format  = nullptr;
+std::unordered_map<std::uint64_t, TextRenderer::CachedLayout> TextRenderer::s_Layouts;
+std::vector<TextRenderer::TextDraw> TextRenderer::s_Draws;
+std::vector<IDWriteTextLayout*> TextRenderer::s_Retired;
+std::uint64_t TextRenderer::s_Frame = 0;
+TextStats     TextRenderer::s_Stats;
+TextStats     TextRenderer::s_Pending;
+
+namespace
+{
+    constexpr float kLayoutWidth  = 800.0f;     // レイアウトの最大幅（従来の DrawText の矩形と同じ）
+    constexpr float kLayoutHeight = 200.0f;     // レイアウトの最大高さ（同上）
+
+    /// FNV-1a で文字列を混ぜる
+    std::uint64_t HashText(const wchar_t* text, std::size_t length)
+    {
+        std::uint64_t hash = 0xCBF29CE484222325ull;
+        const auto* bytes = reinterpret_cast<const unsigned char*>(text);
+        for (std::size_t i = 0; i < length * sizeof(wchar_t); ++i)
+        {
+            hash = (hash ^ bytes[i]) * 0x100000001B3ull;
+        }
+        return hash;
+    }
+}
+
+// ------------------------------------------------------------------------------
+// 初期化・終了
+// ------------------------------------------------------------------------------
+void TextRenderer::Init(IDWriteFactory* factory, IDWriteTextFormat* format)
+{
+    s_Factory = factory;
+    s_Format  = format;
+}
+
+void TextRenderer::Uninit()
+{
+    for (auto& pair : s_Layouts)
+    {
+        pair.second.layout->Release();
+    }
+    s_Layouts.clear();
+    s_Draws.clear();
+    ReleaseRetired();
+    s_Factory = nullptr;
+    s_Format  = nullptr;
+}
+
+// ------------------------------------------------------------------------------
+// 描画予定の追加
+// ------------------------------------------------------------------------------
+// - 同じ内容のレイアウトがあればそれを使う（文字列の整形は内容が変わったときだけ）
+void TextRenderer::Submit(const wchar_t* text, std::size_t length, float x, float y)
+{
+    if (!s_Factory || !s_Format || !text || length == 0)
+        return;
+
+    IDWriteTextLayout* layout = FindOrCreateLayout(text, length);
+    if (!layout)
+        return;
+
+    s_Draws.push_back({ layout, x, y });
+}
+
+// ------------------------------------------------------------------------------
+// 一括描画
+// ------------------------------------------------------------------------------
+// - 描画予定が無いフレームは BeginDraw しない
+// - 描画後、使われなくなったレイアウトを捨てて統計を確定する
+bool TextRenderer::Flush(ID2D1RenderTarget* target, ID2D1Brush* brush)
+{
+    const bool draw = target && brush && !s_Draws.empty();
+    if (draw)
+    {
+        target->BeginDraw();
+        for (const TextDraw& item : s_Draws)
+        {
+            target->DrawTextLayout(D2D1::Point2F(item.x, item.y), item.layout, brush);
+        }
+        target->EndDraw();
+    }
+
+    s_Pending.draws = draw ? static_cast<std::uint32_t>(s_Draws.size()) : 0;
+    s_Draws.clear();
+    ReleaseRetired();
+
+    EvictUnused();
+    s_Pending.layoutsCached = static_cast<std::uint32_t>(s_Layouts.size());
+    s_Stats   = s_Pending;
+    s_Pending = TextStats{};
+    ++s_Frame;
+    return draw;
+}
+
+// ------------------------------------------------------------------------------
+// 内部処理
+// ------------------------------------------------------------------------------
+IDWriteTextLayout* TextRenderer::FindOrCreateLayout(const wchar_t* text, std::size_t length)
+{
+    CachedLayout& entry = s_Layouts[HashText(text, length)];
+    if (entry.layout)
+    {
+        if (entry.text.compare(0, std::wstring::npos, text, length) == 0)
+        {
+            entry.lastUsed = s_Frame;
+            return entry.layout;
+        }
+
+        // ハッシュの衝突：今回の内容で作り直す（古い方はこのフレームの描画予定にあり得るので Flush 後に解放する）
+        s_Retired.push_back(entry.layout);
+        entry.layout = nullptr;
+    }
+
+    const HRESULT hr = s_Factory->CreateTextLayout(
+        text, static_cast<UINT32>(length), s_Format, kLayoutWidth, kLayoutHeight, &entry.layout);
+    if (FAILED(hr))
+    {
+        assert(false && "TextRenderer：テキストレイアウトの作成に失敗した");
+        s_Layouts.erase(HashText(text, length));
+        return nullptr;
+    }
+
+    entry.text.assign(text, length);
+    entry.lastUsed = s_Frame;
+    ++s_Pending.layoutsCreated;
+    return entry.layout;
+}
+
+void TextRenderer::ReleaseRetired()
+{
+    for (IDWriteTextLayout* layout : s_Retired)
+    {
+        layout->Release();
+    }
+    s_Retired.clear();
+}
+
+void TextRenderer::EvictUnused()
+{
+    for (auto it = s_Layouts.begin(); it != s_Layouts.end();)
+    {
+        if (s_Frame - it->second.lastUsed >= kEvictFrames)
+        {
+            it->second.layout->Release();
+            it = s_Layouts.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
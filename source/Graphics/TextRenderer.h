@@ -0,0 +1,100 @@
+﻿//------------------------------------------------------------------------------
+// TextRenderer
+//------------------------------------------------------------------------------
+// 役割:
+// Renderer::DrawText で渡された文字列（D3D11RenderBackend の SubmitText 経由）を、内容をキーにした DirectWrite のテキストレイアウトとして保持し、
+// フレームの最後に 1 回の BeginDraw / EndDraw でまとめて描く。
+//
+// 設計意図:
+// これまでは DrawText のたびに RenderQueue の Flush → BeginDraw → DrawText（毎回レイアウト計算）→ EndDraw を行い、
+// HUD の文字列が増えるほど D2D の開始 / 終了と、それに伴う描画状態の無効化が増えていた。
+// スコアや HP の文字列は値が変わったときにしか変わらないので、整形済みのレイアウトを内容で引いて使い回し、
+// 描画は 1 フレーム 1 回にまとめる。
+//
+// 構成:
+// - Init / Uninit : DirectWrite のファクトリと書式を受け取る / レイアウトをすべて解放する（D3D11RenderBackend が呼ぶ）
+// - Submit        : 文字列のレイアウトを引き（無ければ作り）、描画予定に積む
+// - Flush         : 積んだ文字列を 1 回の BeginDraw / EndDraw で描き、しばらく使われないレイアウトを捨てる
+// - TextStats     : フレーム内の描画数・作成したレイアウト数・保持しているレイアウト数
+//
+// NOTE:
+// - キーは内容の FNV-1a ハッシュ。衝突した場合は中身を比べて作り直す（結果は正しい）
+// - kEvictFrames フレーム使われなかったレイアウトは解放する（変化し続ける値で際限なく増えないように）
+// - 文字はメッシュの描画（RenderQueue::Flush）の後、フレームの最後に描くので常に手前に出る
+// - メインスレッドからのみ呼ぶこと
+//------------------------------------------------------------------------------
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <d2d1.h>
+#include <dwrite.h>
+
+/// フレーム内の統計
+struct TextStats
+{
+    std::uint32_t draws          = 0;   // 描いた文字列の数
+    std::uint32_t layoutsCreated = 0;   // 新しく作ったレイアウトの数（値が変わらなければ 0）
+    std::uint32_t layoutsCached  = 0;   // 保持しているレイアウトの数
+};
+
+/// 文字列のレイアウトキャッシュと一括描画
+class TextRenderer
+{
+public:
+    static constexpr std::uint64_t kEvictFrames = 120;  // この数のフレーム使われなかったレイアウトは解放する
+
+    /// 初期化（factory / format は非所有。Uninit まで有効であること）
+    static void Init(IDWriteFactory* factory, IDWriteTextFormat* format);
+
+    /// すべてのレイアウトを解放する（factory / format を解放する前に呼ぶこと）
+    static void Uninit();
+
+    /// 文字列を (x, y) に描く予定として積む（描画は Flush まで遅れる）
+    static void Submit(const wchar_t* text, std::size_t length, float x, float y);
+
+    /// 積んだ文字列を target に brush で描き、描画予定を空にする
+    /// 戻り値：D2D で描いた場合 true（呼び出し側で描画状態を無効化すること）
+    static bool Flush(ID2D1RenderTarget* target, ID2D1Brush* brush);
+
+    /// 直前の Flush までのフレームの統計
+    static const TextStats& GetFrameStats() { return s_Stats; }
+
+private:
+    /// 保持しているレイアウト
+    struct CachedLayout
+    {
+        std::wstring       text;                // 衝突の確認用
+        IDWriteTextLayout* layout   = nullptr;  // 所有
+        std::uint64_t      lastUsed = 0;        // 最後に使ったフレーム
+    };
+
+    /// 描画予定
+    struct TextDraw
+    {
+        IDWriteTextLayout* layout;              // 非所有（s_Layouts のもの）
+        float              x;
+        float              y;
+    };
+
+    /// 内容のレイアウトを引く（無い / 衝突した場合は作る）
+    static IDWriteTextLayout* FindOrCreateLayout(const wchar_t* text, std::size_t length);
+
+    /// kEvictFrames フレーム使われなかったレイアウトを解放する
+    static void EvictUnused();
+
+    /// 衝突で差し替えたレイアウトを解放する
+    static void ReleaseRetired();
+
+private:
+    static IDWriteFactory*    s_Factory;                                // 非所有
+    static IDWriteTextFormat* s_Format;                                 // 非所有
+    static std::unordered_map<std::uint64_t, CachedLayout> s_Layouts;   // 所有：内容のハッシュ → レイアウト
+    static std::vector<TextDraw> s_Draws;                               // このフレームの描画予定（容量はフレームをまたいで再利用）
+    static std::vector<IDWriteTextLayout*> s_Retired;                   // 所有：衝突で差し替えた、Flush 後に解放するレイアウト
+    static std::uint64_t s_Frame;                                       // Flush ごとに進むフレーム番号
+    static TextStats     s_Stats;                                       // 直前のフレームの統計
+    static TextStats     s_Pending;                                     // 集計中のフレームの統計
+};
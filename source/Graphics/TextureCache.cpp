@@ -0,0 +1,194 @@
+﻿#include "TextureCache.h"
+#include <cassert>
+
+// 静的メンバ変数の定義
+std::unordered_map<std::wstring, SharedTexture> TextureCache::s_Textures;
+GpuTexture*                              TextureCache::s_Placeholder = nullptr;
+TextureDecodeFunction                    TextureCache::s_Decode      = nullptr;
+std::vector<std::thread>                 TextureCache::s_DecodeThreads;
+std::mutex                               TextureCache::s_Mutex;
+std::condition_variable                  TextureCache::s_Wake;
+std::deque<std::wstring>                 TextureCache::s_Requests;
+std::vector<TextureCache::DecodedImage>  TextureCache::s_Decoded;
+bool                                     TextureCache::s_Stopping = false;
+
+// ------------------------------------------------------------------------------
+// 初期化・終了
+// ------------------------------------------------------------------------------
+// - 代用テクスチャは白なので、転送前はマテリアルの色だけで描かれる
+void TextureCache::Init(TextureDecodeFunction decode)
+{
+    const std::uint32_t white = 0xFFFFFFFFu;
+
+    GpuTextureDesc desc{};
+    desc.width     = 1;
+    desc.height    = 1;
+    desc.mipLevels = 1;
+    desc.format    = kGpuFormatR8G8B8A8Unorm;
+
+    GpuSubresource subresource{};
+    subresource.pixels     = &white;
+    subresource.rowPitch   = sizeof(white);
+    subresource.slicePitch = sizeof(white);
+
+    s_Placeholder = Renderer::GetBackend().CreateTexture2D(desc, &subresource);
+
+    s_Decode   = decode;
+    s_Stopping = false;
+    for (unsigned i = 0; s_Decode && i < kDecodeThreadCount; ++i)
+    {
+        s_DecodeThreads.emplace_back(DecodeThreadMain);
+    }
+}
+
+// - デコード中の画像は完了を待ってから破棄する（途中で止めない）
+// - 終了時は全 MeshRenderer が解放済みのはずなので、参照が残っていれば解放漏れ
+void TextureCache::Uninit()
+{
+    {
+        std::lock_guard<std::mutex> lock(s_Mutex);
+        s_Stopping = true;
+        s_Requests.clear();
+    }
+    s_Wake.notify_all();
+
+    for (std::thread& thread : s_DecodeThreads)
+    {
+        thread.join();
+    }
+    s_DecodeThreads.clear();
+    s_Decoded.clear();
+
+    RenderBackend& backend = Renderer::GetBackend();
+    for (auto& pair : s_Textures)
+    {
+        assert(pair.second.refCount == 0 && "TextureCache::Uninit：参照が残っているテクスチャがある");
+        backend.Release(pair.second.texture);
+    }
+    s_Textures.clear();
+
+    backend.Release(s_Placeholder);
+    s_Placeholder = nullptr;
+    s_Decode      = nullptr;
+}
+
+// ------------------------------------------------------------------------------
+// 取得・解放
+// ------------------------------------------------------------------------------
+// - 未登録の場合は要求を積むだけで戻る（デコードと転送は後で行われる）
+// - デコード関数が無い場合は要求せず、すぐに失敗扱いにする
+SharedTexture* TextureCache::Acquire(const std::wstring& path)
+{
+    auto inserted = s_Textures.try_emplace(path);
+    SharedTexture& entry = inserted.first->second;
+
+    if (inserted.second && !s_Decode)
+    {
+        entry.state = TextureState::Failed;
+    }
+    else if (inserted.second)
+    {
+        {
+            std::lock_guard<std::mutex> lock(s_Mutex);
+            s_Requests.push_back(path);
+        }
+        s_Wake.notify_one();
+    }
+
+    ++entry.refCount;
+    return &entry;
+}
+
+void TextureCache::Release(SharedTexture* texture)
+{
+    if (!texture)
+        return;
+
+    assert(texture->refCount > 0 && "TextureCache::Release：参照カウントが 0 のテクスチャを解放した");
+    --texture->refCount;
+}
+
+// - シーン差し替え後に呼び、新シーンで使われないテクスチャを手放す
+// - デコード中のものは、結果を受け取る先が無くならないよう残す（次回以降に解放される）
+std::size_t TextureCache::PurgeUnused()
+{
+    RenderBackend& backend = Renderer::GetBackend();
+    std::size_t purged = 0;
+
+    for (auto it = s_Textures.begin(); it != s_Textures.end();)
+    {
+        if (it->second.refCount == 0 && it->second.state != TextureState::Decoding)
+        {
+            backend.Release(it->second.texture);
+            it = s_Textures.erase(it);
+            ++purged;
+        }
+        else
+        {
+            ++it;
+        }
+    }
+    return purged;
+}
+
+// ------------------------------------------------------------------------------
+// 転送
+// ------------------------------------------------------------------------------
+// - ロックはデコード済みの一覧を取り出す間だけ持ち、転送はロックの外で行う
+std::size_t TextureCache::Update()
+{
+    std::vector<DecodedImage> decoded;
+    {
+        std::lock_guard<std::mutex> lock(s_Mutex);
+        if (s_Decoded.empty())
+            return 0;
+
+        decoded.swap(s_Decoded);
+    }
+
+    std::size_t uploaded = 0;
+    for (DecodedImage& result : decoded)
+    {
+        auto found = s_Textures.find(result.path);
+        assert(found != s_Textures.end() && "TextureCache::Update：デコード中のテクスチャが解放されている");
+        SharedTexture& entry = found->second;
+
+        if (result.succeeded)
+        {
+            entry.texture = Renderer::GetBackend().CreateTexture2D(result.texture.desc, result.texture.subresources.data());
+        }
+
+        entry.state = entry.texture ? TextureState::Ready : TextureState::Failed;
+        if (entry.texture)
+        {
+            ++uploaded;
+        }
+    }
+    return uploaded;
+}
+
+// ------------------------------------------------------------------------------
+// デコード用スレッド
+// ------------------------------------------------------------------------------
+// - デコードに必要なスレッドごとの準備（WIC の COM など）はデコード関数側で行う
+void TextureCache::DecodeThreadMain()
+{
+    for (;;)
+    {
+        DecodedImage result;
+        {
+            std::unique_lock<std::mutex> lock(s_Mutex);
+            s_Wake.wait(lock, [] { return s_Stopping || !s_Requests.empty(); });
+            if (s_Stopping)
+                break;
+
+            result.path = std::move(s_Requests.front());
+            s_Requests.pop_front();
+        }
+
+        result.succeeded = s_Decode(result.path, result.texture);
+
+        std::lock_guard<std::mutex> lock(s_Mutex);
+        s_Decoded.push_back(std::move(result));
+    }
+}
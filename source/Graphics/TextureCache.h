@@ -0,0 +1,132 @@
+﻿//------------------------------------------------------------------------------
+// TextureCache
+//------------------------------------------------------------------------------
+// 役割:
+// 画像ファイルのテクスチャをパスごとに 1 つだけ作り、参照カウントで共有する。
+// 画像のデコードはデコード用スレッドで行い、終わるまでは 1x1 の白いテクスチャで代用する。
+//
+// 設計意図:
+// MeshRenderer::SetTexture がコンポーネントごとに WIC デコードとテクスチャ作成を行うと、
+// 同じ画像を何度もデコードし、そのたびにメインスレッドが止まる（壁 4 枚とガイド 2 本で 6 回、
+// 衝撃波は出現ごと）。パスごとに共有し、デコードを別スレッドへ逃がすことで、
+// 出現処理は「登録済みなら参照を増やすだけ / 未登録なら要求を積むだけ」で戻る。
+//
+// 構成:
+// - SharedTexture  : テクスチャ（転送前は nullptr）、状態、参照カウント
+// - Acquire        : 未登録なら登録してデコードを要求し、参照を 1 つ増やして返す（待たない）
+// - GetTexture     : 描画に使うテクスチャ（転送前 / 失敗時は代用テクスチャ）
+// - Update         : デコードが終わった画像を GPU へ転送する（毎フレーム、メインスレッドで呼ぶ）
+// - Release        : 参照を 1 つ減らす（0 になってもすぐには解放しない）
+// - PurgeUnused    : 参照 0 のテクスチャを解放する（シーン差し替え後に呼ぶ）
+// - Init / Uninit  : 代用テクスチャとデコード用スレッドの作成 / 停止と全解放
+// - DecodedTexture : デコード関数が返す画像（GPU へ渡す記述とミップごとのピクセル）
+//
+// NOTE:
+// - デコード自体は Init に渡す関数が行う（ゲームでは WIC の DecodeWicTexture。COM の初期化もそちら）。
+//   このファイルは Windows のヘッダに依存しない
+// - デコード関数を渡さない場合（tools/RenderBench）、要求はすぐに失敗扱いになり代用テクスチャで描く
+// - GPU への転送（テクスチャ作成）はメインスレッドの Update でのみ行う
+// - Update 以外の関数もメインスレッドからのみ呼ぶこと
+//------------------------------------------------------------------------------
+#pragma once
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "Renderer.h"
+
+/// テクスチャの状態
+enum class TextureState : std::uint8_t
+{
+    Decoding,   // デコード待ち / デコード中（代用テクスチャで描く）
+    Ready,      // 転送済み
+    Failed,     // 読み込み失敗（代用テクスチャのまま）
+};
+
+/// デコード済みの画像
+struct DecodedTexture
+{
+    GpuTextureDesc              desc;
+    std::vector<GpuSubresource> subresources;   // desc.mipLevels 個（ピクセルは storage が持つ）
+    std::shared_ptr<void>       storage;        // ピクセルの所有者（型はデコード関数ごと）
+};
+
+/// 画像ファイルをデコードする関数（デコード用スレッドから呼ばれる）
+/// 戻り値：成功した場合 true
+using TextureDecodeFunction = bool (*)(const std::wstring& path, DecodedTexture& out);
+
+/// 共有されるテクスチャ
+struct SharedTexture
+{
+    GpuTexture*   texture  = nullptr;   // 転送前 / 失敗時は nullptr
+    TextureState  state    = TextureState::Decoding;
+    std::uint32_t refCount = 0;
+};
+
+/// テクスチャのキャッシュ
+class TextureCache
+{
+public:
+    /// 代用テクスチャを作り、デコード用スレッドを起動する（Renderer::Init の後に呼ぶ）
+    /// - decode が nullptr ならスレッドは起動せず、Acquire したテクスチャは失敗扱いになる
+    static void Init(TextureDecodeFunction decode);
+
+    /// デコード用スレッドを止め、すべてのテクスチャを解放する（Renderer::Uninit より前に呼ぶ）
+    static void Uninit();
+
+    /// テクスチャを取得する（未登録ならデコードを要求する。デコードの完了は待たない）
+    static SharedTexture* Acquire(const std::wstring& path);
+
+    /// 参照を 1 つ減らす（nullptr は無視）
+    static void Release(SharedTexture* texture);
+
+    /// 描画に使うテクスチャ（転送前 / 失敗時は代用テクスチャ）
+    static GpuTexture* GetTexture(const SharedTexture* texture)
+    {
+        return texture && texture->texture ? texture->texture : s_Placeholder;
+    }
+
+    /// デコードが終わった画像を GPU へ転送する
+    /// 戻り値：転送したテクスチャの数
+    static std::size_t Update();
+
+    /// 参照 0 のテクスチャを解放する（デコード中のものは残す）
+    /// 戻り値：解放したテクスチャの数
+    static std::size_t PurgeUnused();
+
+    /// 登録中のテクスチャの数
+    static std::size_t GetTextureCount() { return s_Textures.size(); }
+
+private:
+    /// デコード結果（デコード用スレッド → メインスレッド）
+    struct DecodedImage
+    {
+        std::wstring   path;
+        DecodedTexture texture;
+        bool           succeeded = false;
+    };
+
+    /// デコード用スレッドの本体
+    static void DecodeThreadMain();
+
+private:
+    static constexpr unsigned kDecodeThreadCount = 2;   // デコード用スレッドの数
+
+    static std::unordered_map<std::wstring, SharedTexture> s_Textures;    // 所有：パス → テクスチャ（要素のアドレスは不変）
+    static GpuTexture*                s_Placeholder;    // 所有：代用テクスチャ（1x1 の白）
+    static TextureDecodeFunction      s_Decode;         // デコード関数（nullptr ならデコードしない）
+
+    // デコード用スレッドとの受け渡し（s_Mutex で保護）
+    static std::vector<std::thread>   s_DecodeThreads;
+    static std::mutex                 s_Mutex;
+    static std::condition_variable    s_Wake;           // 要求の追加 / 停止の通知
+    static std::deque<std::wstring>   s_Requests;       // デコード待ちのパス
+    static std::vector<DecodedImage>  s_Decoded;        // デコード済み（転送待ち）
+    static bool                       s_Stopping;       // 停止要求
+};
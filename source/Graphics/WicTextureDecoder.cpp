@@ -0,0 +1,48 @@
+﻿#include "main.h"
+#include "WicTextureDecoder.h"
+
+namespace
+{
+    /// スレッドごとの COM の初期化（スレッドの終了時に解除する）
+    struct ComScope
+    {
+        HRESULT hr = CoInitializeEx(nullptr, COINIT_MULTITHREADED);
+        ~ComScope()
+        {
+            if (SUCCEEDED(hr))
+            {
+                CoUninitialize();
+            }
+        }
+    };
+}
+
+// ------------------------------------------------------------------------------
+// デコード
+// ------------------------------------------------------------------------------
+bool DecodeWicTexture(const std::wstring& path, DecodedTexture& out)
+{
+    thread_local ComScope com;
+
+    auto image = std::make_shared<ScratchImage>();
+    TexMetadata metadata{};
+    if (FAILED(LoadFromWICFile(path.c_str(), WIC_FLAGS_NONE, &metadata, *image)))
+        return false;
+
+    out.desc.width     = static_cast<std::uint32_t>(metadata.width);
+    out.desc.height    = static_cast<std::uint32_t>(metadata.height);
+    out.desc.mipLevels = static_cast<std::uint32_t>(metadata.mipLevels);
+    out.desc.format    = static_cast<std::uint32_t>(metadata.format);
+
+    out.subresources.resize(out.desc.mipLevels);
+    for (std::uint32_t mip = 0; mip < out.desc.mipLevels; ++mip)
+    {
+        const Image* source = image->GetImage(mip, 0, 0);
+        out.subresources[mip].pixels     = source->pixels;
+        out.subresources[mip].rowPitch   = source->rowPitch;
+        out.subresources[mip].slicePitch = source->slicePitch;
+    }
+
+    out.storage = std::move(image);
+    return true;
+}
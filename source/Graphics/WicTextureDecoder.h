@@ -0,0 +1,25 @@
+﻿//------------------------------------------------------------------------------
+// WicTextureDecoder
+//------------------------------------------------------------------------------
+// 役割:
+// TextureCache のデコード用スレッドから呼ばれ、画像ファイルを WIC（DirectXTex の LoadFromWICFile）で読み込む。
+//
+// 設計意図:
+// TextureCache 自体は Windows のヘッダに依存させず（tools/RenderBench でも使うため）、
+// WIC と COM に触れる部分だけをこのファイルに分ける。
+//
+// 構成:
+// - DecodeWicTexture : TextureDecodeFunction の実装（GameManager が TextureCache::Init に渡す）
+//
+// NOTE:
+// - 呼び出したスレッドで COM（マルチスレッド）を一度だけ初期化し、スレッドの終了時に解除する
+// - ピクセルは DecodedTexture::storage が持つ ScratchImage の中にある（転送が終わるまで生かす）
+// - Windows のみ
+//------------------------------------------------------------------------------
+#pragma once
+#include <string>
+#include "TextureCache.h"
+
+/// path を WIC でデコードする（先頭の画像のミップのみ）
+/// 戻り値：成功した場合 true
+bool DecodeWicTexture(const std::wstring& path, DecodedTexture& out);
@@ -3,11 +3,15 @@
 #include <stdio.h>
 #include <stdarg.h>
 #include <shlwapi.h>
+#include <algorithm>
+#include <cmath>
 #pragma comment(lib, "shlwapi.lib")
 
 #include "main.h"
 #include "renderer.h"
 #include "modelRenderer.h"
+#include "RenderQueue.h"
+#include "ShaderCache.h"
 #include "gameobject.h"
 
 using namespace DirectX;
@@ -37,18 +41,24 @@ static void NormalizePathSeparators(char* path)
 
 // 静的メンバ変数の初期化（モデルプール）
 std::unordered_map<std::string, MODEL*> ModelRenderer::m_ModelPool;
+std::unordered_map<std::string, MODEL_DECODED*> ModelRenderer::s_DecodedModels;
+std::mutex ModelRenderer::s_ModelMutex;
 
 // ------------------------------------------------------------------------------
 // ライフサイクルメソッド
 // ------------------------------------------------------------------------------
 // - Owner から Transform を取得して参照保持する
 // - シェーダー未設定ならデフォルトシェーダーを読み込む
+// - 視錐台カリング用の境界球を登録する（半径は Load で決まる）
 void ModelRenderer::Init()
 {
     m_Transform = &m_Owner->m_Transform;
 
     assert(m_Transform && "ModelRenderer::Init: Transform component not found in Owner GameObject");
 
+    m_Bounds.Register(m_Transform);
+    UpdateBoundingRadius();
+
     if (!m_VertexShader || !m_PixelShader || !m_VertexLayout)
     {
         LoadShader(kDefaultVSPath, kDefaultPSPath);
@@ -58,7 +68,7 @@ void ModelRenderer::Init()
 // ------------------------------------------------------------------------------
 // 終了処理
 // ------------------------------------------------------------------------------
-// - シェーダーを解放する
+// - シェーダーを ShaderCache に返し、境界球の登録を解除する
 // - モデルはプール管理のためここでは解放しない
 void ModelRenderer::Uninit()
 {
@@ -66,73 +76,74 @@ void ModelRenderer::Uninit()
     assert(m_PixelShader && "ModelRenderer::Uninit: PixelShader is null");
     assert(m_VertexLayout && "ModelRenderer::Uninit: VertexLayout is null");
 
-    m_VertexShader->Release();
+    ShaderCache::Release(m_SharedVertexShader);
+    m_SharedVertexShader = nullptr;
     m_VertexShader = nullptr;
+    m_VertexLayout = nullptr;
 
-    m_PixelShader->Release();
+    ShaderCache::Release(m_SharedPixelShader);
+    m_SharedPixelShader = nullptr;
     m_PixelShader = nullptr;
 
-    m_VertexLayout->Release();
-    m_VertexLayout = nullptr;
-
     m_Model = nullptr;
+    m_Bounds.Unregister();
 }
 
 // ------------------------------------------------------------------------------
 // シェーダー読み込み
 // ------------------------------------------------------------------------------
-// - 頂点シェーダー（＋入力レイアウト）とピクセルシェーダーを作成する
+// - 頂点シェーダー（＋入力レイアウト）とピクセルシェーダーを ShaderCache から借りる
+//   （同じパスのシェーダーはすべての ModelRenderer / MeshRenderer で共有される）
 void ModelRenderer::LoadShader(const char* vsFilePath, const char* psFilePath)
 {
-    Renderer::CreateVertexShader(&m_VertexShader, &m_VertexLayout, vsFilePath);
-    Renderer::CreatePixelShader(&m_PixelShader, psFilePath);
+    ShaderCache::Release(m_SharedVertexShader);
+    ShaderCache::Release(m_SharedPixelShader);
+
+    m_SharedVertexShader = ShaderCache::AcquireVertexShader(vsFilePath);
+    m_SharedPixelShader  = ShaderCache::AcquirePixelShader(psFilePath);
+    m_VertexShader = m_SharedVertexShader->shader;
+    m_VertexLayout = m_SharedVertexShader->layout;
+    m_PixelShader  = m_SharedPixelShader->shader;
+    m_InstancedShader = RenderQueue::FindInstancedShader(vsFilePath);
 }
 
 // ------------------------------------------------------------------------------
 // 描画処理
 // ------------------------------------------------------------------------------
-// - ワールド行列を設定して VB/IB をバインド
-// - サブセットごとに Material / Texture を設定して DrawIndexed
+// - サブセットごとに Material / Texture を持つパケットを RenderQueue へ積む
+// - 描画は Renderer::End でソートしてから行われる
 void ModelRenderer::Draw()
 {
     assert(m_Model && "ModelRenderer::Draw: Model is null");
     assert(m_Transform && "ModelRenderer::Draw: Transform is null");
 
-    auto* ctx = Renderer::GetDeviceContext();
+    // 視錐台の外なら積まない（判定は Camera::Draw でまとめて行われている）
+    if (!m_Bounds.IsVisible())
+        return;
 
     XMMATRIX localScaleMatrix = XMMatrixScaling(m_LocalScale.x, m_LocalScale.y, m_LocalScale.z);
     XMMATRIX worldMatrix = localScaleMatrix * m_Transform->GetWorldMatrix();
-    Renderer::SetWorldMatrix(worldMatrix);
-
-    UINT stride = sizeof(VERTEX_3D);
-    UINT offset = 0;
-    ctx->IASetVertexBuffers(0, 1, &m_Model->VertexBuffer, &stride, &offset);
 
-    ctx->IASetIndexBuffer(m_Model->IndexBuffer, DXGI_FORMAT_R32_UINT, 0);
-    ctx->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
-
-    if (m_VertexLayout) ctx->IASetInputLayout(m_VertexLayout);
-    if (m_VertexShader) ctx->VSSetShader(m_VertexShader, nullptr, 0);
-    if (m_PixelShader)  ctx->PSSetShader(m_PixelShader, nullptr, 0);
+    RenderPacket packet;
+    packet.instanced    = m_InstancedShader;
+    packet.layout       = m_VertexLayout;
+    packet.vertexShader = m_VertexShader;
+    packet.pixelShader  = m_PixelShader;
+    packet.vertexBuffer = m_Model->VertexBuffer;
+    packet.indexBuffer  = m_Model->IndexBuffer;
+    packet.indexFormat  = GpuIndexFormat::UInt32;
+    packet.topology     = GpuTopology::TriangleList;
+    XMStoreFloat4x4(&packet.world, worldMatrix);
 
     for (unsigned int i = 0; i < m_Model->SubsetNum; i++)
     {
-        Renderer::SetMaterial(m_Model->SubsetArray[i].Material.Material);
-
-        if (m_Model->SubsetArray[i].Material.Texture)
-        {
-            ctx->PSSetShaderResources(0, 1, &m_Model->SubsetArray[i].Material.Texture);
-        }
-        else
-        {
-            ID3D11ShaderResourceView* nullSrv = nullptr;
-            ctx->PSSetShaderResources(0, 1, &nullSrv);
-        }
+        packet.material   = m_Model->SubsetArray[i].Material.Material;
+        packet.texture    = m_Model->SubsetArray[i].Material.Texture;   // テクスチャなしは nullptr で解除する
+        packet.count      = m_Model->SubsetArray[i].IndexNum;
+        packet.startIndex = m_Model->SubsetArray[i].StartIndex;
+        packet.pass       = packet.material.Diffuse.w < 1.0f ? RenderPass::Transparent : RenderPass::Opaque;
 
-        ctx->DrawIndexed(
-            m_Model->SubsetArray[i].IndexNum,
-            m_Model->SubsetArray[i].StartIndex,
-            0);
+        RenderQueue::Submit(packet);
     }
 }
 
@@ -140,18 +151,41 @@ void ModelRenderer::Draw()
 // モデルの事前読み込み
 // ------------------------------------------------------------------------------
 // - 既にプールに存在する場合は何もしない
-// - 存在しない場合はロードしてプールへ登録する
+// - 存在しない場合はロードしてプールへ登録する（転送待ちがあれば転送だけ行う）
 void ModelRenderer::Preload(const char* FileName)
 {
-    if (m_ModelPool.count(FileName) > 0)
+    AcquireModel(FileName);
+}
+
+// ------------------------------------------------------------------------------
+// CPU 側のデコードのみ先行実行
+// ------------------------------------------------------------------------------
+// - プール / 転送待ちに既にあれば何もしない
+// - デコード中はロックを持たない（メインスレッドの Load を止めないため）
+// NOTE: 同じファイルを同時にデコードした場合は後着の結果を捨てる
+void ModelRenderer::Decode(const char* FileName)
+{
     {
-        return;
+        std::lock_guard<std::mutex> lock(s_ModelMutex);
+        if (m_ModelPool.count(FileName) > 0 || s_DecodedModels.count(FileName) > 0)
+        {
+            return;
+        }
     }
 
-    MODEL* model = new MODEL;
-    LoadModel(FileName, model);
+    MODEL_DECODED* decoded = new MODEL_DECODED;
+    DecodeModel(FileName, decoded);
 
-    m_ModelPool[FileName] = model;
+    std::lock_guard<std::mutex> lock(s_ModelMutex);
+    if (m_ModelPool.count(FileName) > 0 || s_DecodedModels.count(FileName) > 0)
+    {
+        delete[] decoded->Obj.VertexArray;
+        delete[] decoded->Obj.IndexArray;
+        delete[] decoded->Obj.SubsetArray;
+        delete decoded;
+        return;
+    }
+    s_DecodedModels[FileName] = decoded;
 }
 
 // ------------------------------------------------------------------------------
@@ -159,17 +193,20 @@ void ModelRenderer::Preload(const char* FileName)
 // ------------------------------------------------------------------------------
 // - Vertex/IndexBuffer, Texture(SRV), SubsetArray を解放する
 // - 最後に MODEL を delete してプールを空にする
+// - 転送されずに残ったデコード済みデータも解放する
 void ModelRenderer::UnloadAll()
 {
+    std::lock_guard<std::mutex> lock(s_ModelMutex);
+
     for (std::pair<const std::string, MODEL*> pair : m_ModelPool)
     {
-        pair.second->VertexBuffer->Release();
-        pair.second->IndexBuffer->Release();
+        RenderBackend& backend = Renderer::GetBackend();
+        backend.Release(pair.second->VertexBuffer);
+        backend.Release(pair.second->IndexBuffer);
 
         for (unsigned int i = 0; i < pair.second->SubsetNum; i++)
         {
-            if (pair.second->SubsetArray[i].Material.Texture)
-                pair.second->SubsetArray[i].Material.Texture->Release();
+            backend.Release(pair.second->SubsetArray[i].Material.Texture);
         }
 
         delete[] pair.second->SubsetArray;
@@ -177,6 +214,16 @@ void ModelRenderer::UnloadAll()
     }
 
     m_ModelPool.clear();
+
+    for (std::pair<const std::string, MODEL_DECODED*> pair : s_DecodedModels)
+    {
+        delete[] pair.second->Obj.VertexArray;
+        delete[] pair.second->Obj.IndexArray;
+        delete[] pair.second->Obj.SubsetArray;
+        delete pair.second;
+    }
+
+    s_DecodedModels.clear();
 }
 
 // ------------------------------------------------------------------------------
@@ -186,53 +233,148 @@ void ModelRenderer::UnloadAll()
 // - 存在しない場合はロードしてプールへ登録する
 void ModelRenderer::Load(const char* FileName)
 {
-    if (m_ModelPool.count(FileName) > 0)
-    {
-        m_Model = m_ModelPool[FileName];
+    m_Model = AcquireModel(FileName);
+    UpdateBoundingRadius();
+}
+
+// ------------------------------------------------------------------------------
+// 境界球の半径
+// ------------------------------------------------------------------------------
+// - モデルの半径にローカルスケールの最大成分を掛ける（Transform のスケールは判定時に掛ける）
+// - モデル未設定の間は 0（原点の点として判定される）
+void ModelRenderer::UpdateBoundingRadius()
+{
+    if (!m_Bounds.IsRegistered())
         return;
+
+    const float modelRadius = m_Model ? m_Model->BoundingRadius : 0.0f;
+    const float maxScale = std::max({ std::fabs(m_LocalScale.x), std::fabs(m_LocalScale.y), std::fabs(m_LocalScale.z) });
+    m_Bounds.SetLocalRadius(modelRadius * maxScale);
+}
+
+// ------------------------------------------------------------------------------
+// プールからの取得（なければ作成）
+// ------------------------------------------------------------------------------
+// - プールにあればそれを返す
+// - 転送待ち（Decode 済み）があれば GPU 転送だけ行う
+// - どちらもなければここでデコードから行う（従来の同期読み込み）
+// NOTE: デバイスを使うためメインスレッドから呼ぶこと
+MODEL* ModelRenderer::AcquireModel(const char* FileName)
+{
+    MODEL_DECODED* decoded = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(s_ModelMutex);
+
+        auto it = m_ModelPool.find(FileName);
+        if (it != m_ModelPool.end())
+        {
+            return it->second;
+        }
+
+        auto decodedIt = s_DecodedModels.find(FileName);
+        if (decodedIt != s_DecodedModels.end())
+        {
+            decoded = decodedIt->second;
+            s_DecodedModels.erase(decodedIt);
+        }
     }
 
-    m_Model = new MODEL;
-    LoadModel(FileName, m_Model);
+    MODEL* model = new MODEL;
+    if (decoded)
+    {
+        UploadModel(decoded, model);
+        delete decoded;
+    }
+    else
+    {
+        LoadModel(FileName, model);
+    }
 
-    m_ModelPool[FileName] = m_Model;
+    std::lock_guard<std::mutex> lock(s_ModelMutex);
+    m_ModelPool[FileName] = model;
+    return model;
 }
 
 // ------------------------------------------------------------------------------
 // モデル読み込み（実体）
 // ------------------------------------------------------------------------------
-// - OBJ を読み込み（LoadObj）、VB/IB を生成する
-// - サブセットごとに TextureName を見て WIC で画像を読み込み SRV を作る
-// - TextureEnable は SRV の有無で決める
+// - デコード（CPU）→ 転送（GPU）を続けて行う
 void ModelRenderer::LoadModel(const char* FileName, MODEL* Model)
 {
-    MODEL_OBJ modelObj;
-    LoadObj(FileName, &modelObj);
+    MODEL_DECODED decoded;
+    DecodeModel(FileName, &decoded);
+    UploadModel(&decoded, Model);
+}
+
+// ------------------------------------------------------------------------------
+// デコード（CPU 側）
+// ------------------------------------------------------------------------------
+// - OBJ を読み込み（LoadObj）、サブセットごとに TextureName を見て WIC で画像をデコードする
+// NOTE: デバイス / コンテキストには触れないので、任意のスレッドから呼べる
+//       （LoadObj 内の strtok は MSVC CRT ではスレッドごとの状態を持つ）
+void ModelRenderer::DecodeModel(const char* FileName, MODEL_DECODED* Decoded)
+{
+    LoadObj(FileName, &Decoded->Obj);
+
+    Decoded->Images.resize(Decoded->Obj.SubsetNum);
+    for (unsigned int i = 0; i < Decoded->Obj.SubsetNum; i++)
+    {
+        // テクスチャ読み込み（TextureName が空ならスキップ）
+        const char* texName = Decoded->Obj.SubsetArray[i].Material.TextureName;
+        if (texName[0] != '\0')
+        {
+            TexMetadata metadata{};
+            wchar_t wc[256]{};
+            mbstowcs(wc, texName, _countof(wc));
+
+            if (FAILED(LoadFromWICFile(wc, WIC_FLAGS_NONE, &metadata, Decoded->Images[i])))
+            {
+                Decoded->Images[i].Release();
+            }
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------
+// 転送（GPU 側）
+// ------------------------------------------------------------------------------
+// - VB/IB を生成し、デコード済み画像から SRV を作る
+// - 頂点から境界球の半径を求める
+// - TextureEnable は SRV の有無で決める
+// - 転送後、デコード側の配列と画像を解放する
+void ModelRenderer::UploadModel(MODEL_DECODED* Decoded, MODEL* Model)
+{
+    MODEL_OBJ& modelObj = Decoded->Obj;
+
+    RenderBackend& backend = Renderer::GetBackend();
 
     // 頂点バッファ生成
     {
-        D3D11_BUFFER_DESC bd{};
-        bd.Usage = D3D11_USAGE_DEFAULT;
-        bd.ByteWidth = sizeof(VERTEX_3D) * modelObj.VertexNum;
-        bd.BindFlags = D3D11_BIND_VERTEX_BUFFER;
+        GpuBufferDesc desc{};
+        desc.size = sizeof(VERTEX_3D) * modelObj.VertexNum;
+        desc.bind = GpuBufferBind::Vertex;
 
-        D3D11_SUBRESOURCE_DATA sd{};
-        sd.pSysMem = modelObj.VertexArray;
+        Model->VertexBuffer = backend.CreateBuffer(desc, modelObj.VertexArray);
+    }
 
-        Renderer::GetDevice()->CreateBuffer(&bd, &sd, &Model->VertexBuffer);
+    // 境界球の半径（視錐台カリング用）
+    {
+        float radiusSq = 0.0f;
+        for (unsigned int i = 0; i < modelObj.VertexNum; i++)
+        {
+            const XMFLOAT3& p = modelObj.VertexArray[i].Position;
+            radiusSq = std::max(radiusSq, p.x * p.x + p.y * p.y + p.z * p.z);
+        }
+        Model->BoundingRadius = std::sqrt(radiusSq);
     }
 
     // インデックスバッファ生成
     {
-        D3D11_BUFFER_DESC bd{};
-        bd.Usage = D3D11_USAGE_DEFAULT;
-        bd.ByteWidth = sizeof(unsigned int) * modelObj.IndexNum;
-        bd.BindFlags = D3D11_BIND_INDEX_BUFFER;
-
-        D3D11_SUBRESOURCE_DATA sd{};
-        sd.pSysMem = modelObj.IndexArray;
+        GpuBufferDesc desc{};
+        desc.size = sizeof(unsigned int) * modelObj.IndexNum;
+        desc.bind = GpuBufferBind::Index;
 
-        Renderer::GetDevice()->CreateBuffer(&bd, &sd, &Model->IndexBuffer);
+        Model->IndexBuffer = backend.CreateBuffer(desc, modelObj.IndexArray);
     }
 
     // サブセット設定
@@ -248,22 +390,11 @@ void ModelRenderer::LoadModel(const char* FileName, MODEL* Model)
             Model->SubsetArray[i].Material.Material = modelObj.SubsetArray[i].Material.Material;
             Model->SubsetArray[i].Material.Texture  = nullptr;
 
-            // テクスチャ読み込み（TextureName が空ならスキップ）
-            const char* texName = modelObj.SubsetArray[i].Material.TextureName;
-            if (texName[0] != '\0')
+            // デコード済みテクスチャがあれば SRV を作成
+            const ScratchImage& image = Decoded->Images[i];
+            if (image.GetImageCount() > 0)
             {
-                TexMetadata metadata{};
-                ScratchImage image{};
-                wchar_t wc[256]{};
-                mbstowcs(wc, texName, _countof(wc));
-
-                if (SUCCEEDED(LoadFromWICFile(wc, WIC_FLAGS_NONE, &metadata, image)))
-                {
-                    CreateShaderResourceView(
-                        Renderer::GetDevice(),
-                        image.GetImages(), image.GetImageCount(), metadata,
-                        &Model->SubsetArray[i].Material.Texture);
-                }
+                Model->SubsetArray[i].Material.Texture = Renderer::CreateTexture(image);
             }
 
             // TextureEnable 設定（SRV の有無）
@@ -275,6 +406,8 @@ void ModelRenderer::LoadModel(const char* FileName, MODEL* Model)
     delete[] modelObj.VertexArray;
     delete[] modelObj.IndexArray;
     delete[] modelObj.SubsetArray;
+    modelObj = MODEL_OBJ{};
+    Decoded->Images.clear();
 }
 
 // ------------------------------------------------------------------------------
@@ -2,15 +2,22 @@
 #pragma once
 
 #include "main.h"
+#include "RenderBackend.h"
 #include "component.h"
+#include "FrustumCulling.h"
 #include "Transform.h"
 #include "vector3.h"
 #include <string>
 #include <unordered_map>
+#include <vector>
+#include <mutex>
 
 using namespace DirectX;
 
 class GameObject;
+struct InstancedShader;
+struct SharedVertexShader;
+struct SharedPixelShader;
 
 // ------------------------------------------------------------------------------
 // ------------------------------------------------------------------------------
@@ -20,7 +27,7 @@ struct MODEL_MATERIAL
     char                      Name[256];
     MATERIAL                  Material;
     char                      TextureName[256];
-    ID3D11ShaderResourceView* Texture;
+    GpuTexture*               Texture;
 };
 
 struct SUBSET
@@ -42,13 +49,24 @@ struct MODEL_OBJ
     unsigned int   SubsetNum;
 };
 
+/// CPU 側でデコード済み（GPU 転送前）のモデル
+/// - OBJ の頂点/インデックス/サブセットと、サブセットごとのデコード済みテクスチャ
+/// - Images[i] が空（GetImageCount() == 0）のサブセットはテクスチャなし
+struct MODEL_DECODED
+{
+    MODEL_OBJ                 Obj{};
+    std::vector<ScratchImage> Images;
+};
+
 struct MODEL
 {
-    ID3D11Buffer*  VertexBuffer;
-    ID3D11Buffer*  IndexBuffer;
+    GpuBuffer*     VertexBuffer;
+    GpuBuffer*     IndexBuffer;
 
     SUBSET*        SubsetArray;
     unsigned int   SubsetNum;
+
+    float          BoundingRadius;     // 原点から最も遠い頂点までの距離（視錐台カリング用）
 };
 
 class ModelRenderer : public Component
@@ -68,6 +86,13 @@ public:
     // ----------------------------------------------------------------------
     static void Preload(const char* FileName);
 
+    /// OBJ 解析とテクスチャデコード（CPU 側の処理）だけを先に行う
+    /// - 任意のスレッドから呼べる（シーンのバックグラウンド読み込み用）
+    /// - 結果は GPU 転送待ちとして保持され、次の Load / Preload で転送だけ行われる
+    /// - 既にプール / 転送待ちにある場合は何もしない
+    /// NOTE: 呼び出しスレッドで COM（WIC）が初期化されていること
+    static void Decode(const char* FileName);
+
     /// - Vertex/IndexBuffer
     /// - SubsetArray
     static void UnloadAll();
@@ -80,7 +105,7 @@ public:
 
     void LoadShader(const char* vsFilePath, const char* psFilePath);
 
-    void SetLocalScale(float x, float y, float z) { m_LocalScale = { x, y, z }; }
+    void SetLocalScale(float x, float y, float z) { m_LocalScale = { x, y, z }; UpdateBoundingRadius(); }
 
     void Draw() override;
 
@@ -89,10 +114,22 @@ private:
     // ----------------------------------------------------------------------
     static void LoadModel(const char* FileName, MODEL* Model);
 
+    /// OBJ / MTL の解析とテクスチャのデコード（デバイスを使わない）
+    static void DecodeModel(const char* FileName, MODEL_DECODED* Decoded);
+
+    /// デコード済みデータから VB/IB/SRV を作成し、デコード側のメモリを解放する
+    static void UploadModel(MODEL_DECODED* Decoded, MODEL* Model);
+
+    /// プールから取得し、なければ（転送待ちがあれば転送だけ、なければ読み込みから）作成する
+    static MODEL* AcquireModel(const char* FileName);
+
     static void LoadObj(const char* FileName, MODEL_OBJ* ModelObj);
 
     static void LoadMaterial(const char* FileName, MODEL_MATERIAL** MaterialArray, unsigned int* MaterialNum);
 
+    /// 境界球の半径をモデルとローカルスケールから求め直す
+    void UpdateBoundingRadius();
+
 private:
     // ----------------------------------------------------------------------
     // ----------------------------------------------------------------------
@@ -104,15 +141,21 @@ private:
     // ----------------------------------------------------------------------
     Transform* m_Transform = nullptr;
     Vector3    m_LocalScale = { 1.0f, 1.0f, 1.0f };
+    CullingBounds m_Bounds;             // 視錐台カリング用の境界球
 
     // ----------------------------------------------------------------------
     // ----------------------------------------------------------------------
     static std::unordered_map<std::string, MODEL*> m_ModelPool;
+    static std::unordered_map<std::string, MODEL_DECODED*> s_DecodedModels;   // 所有：GPU 転送待ち
+    static std::mutex s_ModelMutex;                                             // m_ModelPool / s_DecodedModels の排他
     MODEL* m_Model = nullptr;
 
     // ----------------------------------------------------------------------
     // ----------------------------------------------------------------------
-    ID3D11VertexShader* m_VertexShader = nullptr;
-    ID3D11PixelShader*  m_PixelShader  = nullptr;
-    ID3D11InputLayout*  m_VertexLayout = nullptr;
+    GpuVertexShader* m_VertexShader = nullptr;
+    GpuPixelShader*  m_PixelShader  = nullptr;
+    GpuInputLayout*  m_VertexLayout = nullptr;
+    const InstancedShader* m_InstancedShader = nullptr;  // 非所有：インスタンス描画版の VS（無ければ nullptr）
+    SharedVertexShader* m_SharedVertexShader = nullptr;  // 非所有：ShaderCache の VS（m_VertexShader / m_VertexLayout はここから借りる）
+    SharedPixelShader*  m_SharedPixelShader  = nullptr;  // 非所有：ShaderCache の PS（m_PixelShader はここから借りる）
 };
@@ -30,23 +30,17 @@ void Polygon2D::Init()
     vertex[3].TexCoord = XMFLOAT2(1.0f, 1.0f);
 
     // 頂点バッファ生成
-    D3D11_BUFFER_DESC bd{};
-    bd.Usage = D3D11_USAGE_DEFAULT;
-    bd.ByteWidth = sizeof(VERTEX_3D) * 4;
-    bd.BindFlags = D3D11_BIND_VERTEX_BUFFER;
-    bd.CPUAccessFlags = 0;
+    GpuBufferDesc desc{};
+    desc.size = sizeof(VERTEX_3D) * 4;
+    desc.bind = GpuBufferBind::Vertex;
 
-    D3D11_SUBRESOURCE_DATA sd{};
-    sd.pSysMem = vertex;
-
-    Renderer::GetDevice()->CreateBuffer(&bd, &sd, &m_VertexBuffer);
+    m_VertexBuffer = Renderer::GetBackend().CreateBuffer(desc, vertex);
 
     // テクスチャ読み込み
     TexMetadata metadata;
     ScratchImage image;
     LoadFromWICFile(L"asset\\texture\\pati.jpg", WIC_FLAGS_NONE, &metadata, image);
-    CreateShaderResourceView(Renderer::GetDevice(), image.GetImages(),
-                             image.GetImageCount(), metadata, &m_Texture);
+    m_Texture = Renderer::CreateTexture(image);
     assert(m_Texture);
 
     Renderer::CreateVertexShader(&m_VertexShader, &m_VertexLayout,
@@ -58,13 +52,15 @@ void Polygon2D::Init()
 
 void Polygon2D::Uninit()
 {
-    m_Texture->Release();
+    RenderBackend& backend = Renderer::GetBackend();
+
+    backend.Release(m_Texture);
 
-    m_VertexBuffer->Release();
+    backend.Release(m_VertexBuffer);
 
-    m_VertexLayout->Release();
-    m_VertexShader->Release();
-    m_PixelShader->Release();
+    backend.Release(m_VertexLayout);
+    backend.Release(m_VertexShader);
+    backend.Release(m_PixelShader);
 }
 
 void Polygon2D::Update(float deltaTime)
@@ -74,27 +70,27 @@ void Polygon2D::Update(float deltaTime)
 
 void Polygon2D::Draw()
 {
+    RenderBackend& backend = Renderer::GetBackend();
+
     // 入力レイアウト設定
-    Renderer::GetDeviceContext()->IASetInputLayout(m_VertexLayout);
+    backend.SetInputLayout(m_VertexLayout);
 
     // シェーダー設定
-    Renderer::GetDeviceContext()->VSSetShader(m_VertexShader, NULL, 0);
-    Renderer::GetDeviceContext()->PSSetShader(m_PixelShader, NULL, 0);
+    backend.SetVertexShader(m_VertexShader);
+    backend.SetPixelShader(m_PixelShader);
 
     // マトリクス設定
     Renderer::SetWorldViewProjection2D();
 
     // 頂点バッファ設定
-    UINT stride = sizeof(VERTEX_3D);
-    UINT offset = 0;
-    Renderer::GetDeviceContext()->IASetVertexBuffers(0, 1, &m_VertexBuffer, &stride, &offset);
+    backend.SetVertexBuffer(0, m_VertexBuffer, sizeof(VERTEX_3D));
 
     // テクスチャ設定
-    Renderer::GetDeviceContext()->PSSetShaderResources(0, 1, &m_Texture);
+    backend.SetTexture(0, m_Texture);
 
     // プリミティブ形状設定
-    Renderer::GetDeviceContext()->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLESTRIP);
+    backend.SetTopology(GpuTopology::TriangleStrip);
 
     // 描画
-    // Renderer::GetDeviceContext()->Draw(4, 0);
+    // backend.Draw(4, 0);
 }
\ No newline at end of file
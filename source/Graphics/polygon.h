@@ -1,15 +1,16 @@
 ﻿#pragma once
 
 #include "gameobject.h"
+#include "RenderBackend.h"
 
 class Polygon2D : public GameObject
 {
 private:
-    ID3D11Buffer* m_VertexBuffer = nullptr;
-    ID3D11VertexShader* m_VertexShader = nullptr;
-    ID3D11PixelShader* m_PixelShader = nullptr;
-    ID3D11InputLayout* m_VertexLayout = nullptr;
-    ID3D11ShaderResourceView* m_Texture;
+    GpuBuffer* m_VertexBuffer = nullptr;
+    GpuVertexShader* m_VertexShader = nullptr;
+    GpuPixelShader* m_PixelShader = nullptr;
+    GpuInputLayout* m_VertexLayout = nullptr;
+    GpuTexture* m_Texture = nullptr;
 
 public:
     void Init() override;
@@ -348,10 +348,10 @@ static bool BoxVsSphere(BoxCollider* b, SphereCollider* s,
     RigidBody* rigidBody = owner->GetComponent<RigidBody>();
     bool usedCCD = false;
 
-    if (rigidBody && !rigidBody->m_IsKinematic)
+    if (rigidBody && !rigidBody->IsKinematic())
     {
         // 球中心の前フレーム位置＆今フレーム位置
-        Vector3 p0 = rigidBody->m_PreviousPosition + s->m_center;
+        Vector3 p0 = rigidBody->GetPreviousPosition() + s->m_center;
         Vector3 p1 = owner->m_Transform.Position + s->m_center;
 
         Vector3 delta   = p1 - p0;
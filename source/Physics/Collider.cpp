@@ -1,36 +1,51 @@
 ﻿#include "Collider.h"
 #include "GameObject.h"
 
-// ----------------------------------------------------------------------
-// GameObjectに転送するイベント 
-// ----------------------------------------------------------------------
-void Collider::InvokeOnCollisionEnter(const CollisionInfo& info)
+namespace
 {
-    if (m_Owner) m_Owner->OnCollisionEnter(info);
+    /// Collider のハンドル表
+    /// NOTE: 関数内 static にして、初期化/破棄順序が他の静的オブジェクトに依存しないようにする
+    SlotMap<Collider*, ColliderHandleTag>& GetHandleRegistry()
+    {
+        static SlotMap<Collider*, ColliderHandleTag> s_Registry;
+        return s_Registry;
+    }
 }
 
-void Collider::InvokeOnCollisionStay(const CollisionInfo& info)
+// ----------------------------------------------------------------------
+// 生成・破棄 / ハンドル
+// ----------------------------------------------------------------------
+Collider::Collider()
 {
-    if (m_Owner) m_Owner->OnCollisionStay(info);
+    m_Handle = GetHandleRegistry().Insert(this);
 }
 
-void Collider::InvokeOnCollisionExit(const CollisionInfo& info)
+Collider::~Collider()
 {
-    if (m_Owner) m_Owner->OnCollisionExit(info);
+    GetHandleRegistry().Erase(m_Handle);
 }
 
-// / トリガー用イベント転送
-void Collider::InvokeOnTriggerEnter(const CollisionInfo& info)
+Collider* Collider::Resolve(ColliderHandle handle)
 {
-    if (m_Owner) m_Owner->OnTriggerEnter(info);
+    Collider** collider = GetHandleRegistry().Find(handle);
+    return collider ? *collider : nullptr;
 }
 
-void Collider::InvokeOnTriggerStay(const CollisionInfo& info)
+// ----------------------------------------------------------------------
+// GameObjectに転送するイベント 
+// ----------------------------------------------------------------------
+void Collider::InvokeEvent(CollisionEventType type, const CollisionInfo& info)
 {
-    if (m_Owner) m_Owner->OnTriggerStay(info);
-}
+    if (!m_Owner) return;
 
-void Collider::InvokeOnTriggerExit(const CollisionInfo& info)
-{
-    if (m_Owner) m_Owner->OnTriggerExit(info);
+    switch (type)
+    {
+    case CollisionEventType::CollisionEnter: m_Owner->OnCollisionEnter(info); break;
+    case CollisionEventType::CollisionStay:  m_Owner->OnCollisionStay(info);  break;
+    case CollisionEventType::CollisionExit:  m_Owner->OnCollisionExit(info);  break;
+    case CollisionEventType::TriggerEnter:   m_Owner->OnTriggerEnter(info);   break;
+    case CollisionEventType::TriggerStay:    m_Owner->OnTriggerStay(info);    break;
+    case CollisionEventType::TriggerExit:    m_Owner->OnTriggerExit(info);    break;
+    default: break;
+    }
 }
\ No newline at end of file
@@ -13,8 +13,9 @@
 // 構成:
 // - Transform 参照           : ワールド座標計算に使用（非所有）
 // - 衝突判定インターフェース : CheckCollision（純粋仮想）
-// - 衝突イベント中継         : OnCollision / OnTrigger 系を GameObject へ転送
+// - 衝突イベント中継         : 溜めたイベント（CollisionEvent）を GameObject の OnCollision / OnTrigger 系へ転送
 // - デバッグ描画             : DebugDraw（任意実装）
+// - ハンドル                 : 生成時に世代付きハンドルを発行（衝突ペアのキーに使用）
 //
 // NOTE:
 // Collider 自身は空間管理や衝突解決を行わない。
@@ -26,9 +27,19 @@
 #include "Transform.h"
 #include "Component.h"
 #include "CollisionInfo.h"
+#include "CollisionEvent.h"
 #include <memory>
+#include <vector>
+#include <cstdint>
+#include "FrameArena.h"
+#include "SlotMap.h"
 
 class GameObject;
+class Collider;
+
+/// Collider の世代付きハンドル
+struct ColliderHandleTag;
+using ColliderHandle = Handle<ColliderHandleTag>;
 
 /// コライダーの基底クラス
 /// - Component として GameObject に所属する
@@ -37,8 +48,35 @@ class GameObject;
 class Collider : public Component
 {
 public:
+    /// 派生 Collider も GetComponent<Collider>() で引けるようにする
+    using LookupBaseType = Collider;
+
+    /// 生成時にハンドルを発行する
+    Collider();
+
     /// 仮想デストラクタ（派生 Collider を安全に破棄するため）
-    virtual ~Collider() = default;
+    /// - ハンドルを無効化する
+    virtual ~Collider();
+
+    // ハンドルを 1 つだけ持たせるためコピー禁止
+    Collider(const Collider&) = delete;
+    Collider& operator=(const Collider&) = delete;
+
+    // ----------------------------------------------------------------------
+    // ハンドル
+    // ----------------------------------------------------------------------
+    /// この Collider のハンドル
+    ColliderHandle GetHandle() const { return m_Handle; }
+
+    /// ハンドルから Collider を引く
+    /// 戻り値：破棄済み / 無効なハンドルなら nullptr
+    static Collider* Resolve(ColliderHandle handle);
+
+    /// 衝突判定に参加したフレームを記録する（GameManager::CheckCollisions から呼ばれる）
+    void MarkCollected(std::uint32_t frame) { m_CollectedFrame = frame; }
+
+    /// 指定フレームの衝突判定に参加したか
+    bool WasCollected(std::uint32_t frame) const { return m_CollectedFrame == frame; }
 
     // ----------------------------------------------------------------------
     // 位置・判定
@@ -70,22 +108,20 @@ public:
         CollisionInfo& outSelf,
         CollisionInfo& outOther) = 0;
 
+    /// 衝突判定に参加する Collider を outColliders へ追加する
+    /// - 単体の Collider は自身を追加する
+    /// - ColliderGroup は中の Collider を展開して追加する（override）
+    virtual void CollectColliders(FrameVector<Collider*>& outColliders)
+    {
+        outColliders.push_back(this);
+    }
+
     // ----------------------------------------------------------------------
     // 衝突イベント中継
     // ----------------------------------------------------------------------
-    /// GameObject へ衝突開始イベントを転送する
-    void InvokeOnCollisionEnter(const CollisionInfo& info);
-    /// GameObject へ衝突継続イベントを転送する
-    void InvokeOnCollisionStay(const CollisionInfo& info);
-    /// GameObject へ衝突終了イベントを転送する
-    void InvokeOnCollisionExit(const CollisionInfo& info);
-
-    /// GameObject へトリガー開始イベントを転送する
-    void InvokeOnTriggerEnter(const CollisionInfo& info);
-    /// GameObject へトリガー継続イベントを転送する
-    void InvokeOnTriggerStay(const CollisionInfo& info);
-    /// GameObject へトリガー終了イベントを転送する
-    void InvokeOnTriggerExit(const CollisionInfo& info);
+    /// 所属 GameObject へ、種別に対応するコールバック（OnCollisionEnter など）を呼ぶ
+    /// NOTE: 通知の要否（コールバックマスク）は呼び出し側で判定済みであること
+    void InvokeEvent(CollisionEventType type, const CollisionInfo& info);
 
     // ----------------------------------------------------------------------
     // デバッグ
@@ -110,4 +146,8 @@ public:
     GameObject* m_Owner     = nullptr;   // 非所有：所属する GameObject
 
     bool m_IsTrigger        = false;     // トリガーフラグ
+
+private:
+    ColliderHandle m_Handle;                 // 自身のハンドル
+    std::uint32_t  m_CollectedFrame = 0;     // 最後に衝突判定へ参加したフレーム
 };
\ No newline at end of file
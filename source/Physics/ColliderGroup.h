@@ -76,6 +76,20 @@ public:
         return hit;
     }
 
+    /// <summary>
+    /// 中のコライダーをフラットに展開して収集する
+    /// </summary>
+    void CollectColliders(FrameVector<Collider*>& outColliders) override
+    {
+        for (auto& c : colliders)
+        {
+            if (c)
+            {
+                outColliders.push_back(c.get());
+            }
+        }
+    }
+
     /// <summary>
     /// デバッグ描画
     /// </summary>
@@ -0,0 +1,60 @@
+﻿//------------------------------------------------------------------------------
+// CollisionEvent
+//------------------------------------------------------------------------------
+// 役割:
+// 衝突判定で発生した Enter / Stay / Exit（衝突・トリガー）を、
+// 後でまとめて通知するためのイベント型と、受信コールバックのビットマスク。
+//
+// 設計意図:
+// 判定ループの途中でゲーム側のコールバックを呼ぶと、ハンドラが位置などを書き換え、
+// 残りのペアの判定結果がその書き換えに依存してしまう（並列化もできない）。
+// 判定中はイベントを溜めるだけにし、全ペアの判定が終わってから一括で通知する。
+// また大半の GameObject はコールバックを override していないため、
+// クラスごとの「受け取るイベント」マスクで空の仮想呼び出しごと省く。
+//
+// 構成:
+// - CollisionEventType    : イベント種別（マスクのビット番号を兼ねる）
+// - CollisionCallbackMask : 受け取るイベント種別のビット集合
+// - CollisionEvent        : 種別 + 受信側から見た衝突情報
+//
+// NOTE:
+// - マスクの算出は GameObject::CollisionCallbackMaskOf<T>()（override の有無から求める）
+//------------------------------------------------------------------------------
+#pragma once
+#include <cstdint>
+#include "CollisionInfo.h"
+
+/// 衝突イベント種別
+enum class CollisionEventType : std::uint8_t
+{
+    CollisionEnter,
+    CollisionStay,
+    CollisionExit,
+    TriggerEnter,
+    TriggerStay,
+    TriggerExit,
+
+    Count
+};
+
+/// 受け取るイベント種別のビット集合
+using CollisionCallbackMask = std::uint8_t;
+
+/// 種別に対応するビット
+constexpr CollisionCallbackMask ToCallbackBit(CollisionEventType type)
+{
+    return static_cast<CollisionCallbackMask>(1u << static_cast<std::uint8_t>(type));
+}
+
+/// すべてのイベントを受け取るマスク（クラスが分からない場合の既定値）
+constexpr CollisionCallbackMask kAllCollisionCallbacks =
+    static_cast<CollisionCallbackMask>((1u << static_cast<std::uint8_t>(CollisionEventType::Count)) - 1);
+
+/// 通知待ちの衝突イベント
+/// - receiver の Owner へ、receiver から見た info を通知する
+struct CollisionEvent
+{
+    CollisionEventType type     = CollisionEventType::CollisionEnter;
+    Collider*          receiver = nullptr;  // 非所有：受信側の Collider
+    CollisionInfo      info;
+};
@@ -0,0 +1,245 @@
+﻿#include "PhysicsWorld.h"
+#include "RigidBody.h"
+#include "Transform.h"
+
+// システム関連
+#include <DirectXMath.h>
+#include <algorithm>
+#include <cassert>
+
+using namespace DirectX;
+
+// 静的メンバ変数の定義
+PhysicsBodyArrays PhysicsWorld::s_Bodies;
+std::uint32_t     PhysicsWorld::s_BodyCount = 0;
+
+namespace
+{
+    /// 配列の先頭 index から 4 要素を読み込む
+    inline XMVECTOR Load4(const std::vector<float>& values, std::uint32_t index)
+    {
+        return XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(values.data() + index));
+    }
+
+    /// 配列の先頭 index から 4 要素を書き込む
+    inline void Store4(std::vector<float>& values, std::uint32_t index, FXMVECTOR v)
+    {
+        XMStoreFloat4(reinterpret_cast<XMFLOAT4*>(values.data() + index), v);
+    }
+
+    /// float 配列すべてに同じ処理を行う（伸長・移動・0 埋め用）
+    template <typename Func>
+    void ForEachFloatArray(PhysicsBodyArrays& b, Func&& func)
+    {
+        std::vector<float>* arrays[] = {
+            &b.posX, &b.posY, &b.posZ, &b.velX, &b.velY, &b.velZ, &b.prevX, &b.prevY, &b.prevZ,
+            &b.gravityX, &b.gravityY, &b.gravityZ, &b.restitution, &b.mass,
+            &b.accelX, &b.accelY, &b.accelZ, &b.keepX, &b.keepY, &b.keepZ, &b.active };
+        for (std::vector<float>* values : arrays)
+        {
+            func(*values);
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------
+// ボディ登録
+// ------------------------------------------------------------------------------
+// - 既定値は従来の RigidBody メンバ初期値と同じ
+// - 登録直後に積分用マスクを計算する
+std::uint32_t PhysicsWorld::CreateBody(RigidBody* owner, Transform* transform)
+{
+    assert(owner && transform);
+
+    const std::uint32_t index = s_BodyCount++;
+    ResizeArrays(s_BodyCount);
+
+    PhysicsBodyArrays& b = s_Bodies;
+    b.posX[index] = transform->Position.x;
+    b.posY[index] = transform->Position.y;
+    b.posZ[index] = transform->Position.z;
+    b.prevX[index] = transform->Position.x;
+    b.prevY[index] = transform->Position.y;
+    b.prevZ[index] = transform->Position.z;
+    b.velX[index] = b.velY[index] = b.velZ[index] = 0.0f;
+
+    b.gravityX[index] = 0.0f;
+    b.gravityY[index] = -9.8f;
+    b.gravityZ[index] = 0.0f;
+    b.restitution[index] = 0.8f;
+    b.mass[index]        = 1.0f;
+    b.freezeFlags[index] = static_cast<std::uint32_t>(FreezeFlags::None);
+    b.useGravity[index]  = 1;
+    b.kinematic[index]   = 0;
+
+    b.owners[index]     = owner;
+    b.transforms[index] = transform;
+
+    RefreshDerived(index);
+    return index;
+}
+
+// ------------------------------------------------------------------------------
+// ボディ解除
+// ------------------------------------------------------------------------------
+// - 末尾のボディを空いた添字へ詰め、配列を密に保つ
+// - 移動したボディの持ち主（RigidBody）の添字を書き換える
+void PhysicsWorld::DestroyBody(std::uint32_t index)
+{
+    assert(index < s_BodyCount);
+    if (index >= s_BodyCount) return;
+
+    const std::uint32_t last = s_BodyCount - 1;
+    if (index != last)
+    {
+        MoveBody(last, index);
+        s_Bodies.owners[index]->SetBodyIndex(index);
+    }
+
+    ClearBody(last);
+    --s_BodyCount;
+}
+
+// ------------------------------------------------------------------------------
+// 一括積分
+// ------------------------------------------------------------------------------
+// 1. Transform から位置を取得（ゲーム側が直接動かした位置を反映する）
+// 2. 4 体ずつ積分（分岐なし）
+//      prev = p（active の場合のみ）
+//      v    = (v + accel * dt) * keep
+//      p    = p + v * dt * active
+// 3. Transform へ位置を書き戻す
+// NOTE: フリーズ軸は keep = 0 のため速度が 0 になり、位置も変化しない
+//       （従来の「積分後に元の位置へ戻して速度を 0 にする」と同じ結果）
+// NOTE: 回転は積分していないため、回転フリーズは現状何もしない
+void PhysicsWorld::Step(float deltaTime)
+{
+    if (s_BodyCount == 0) return;
+
+    PhysicsBodyArrays& b = s_Bodies;
+
+    // 1. 位置取得
+    for (std::uint32_t i = 0; i < s_BodyCount; ++i)
+    {
+        const Transform* transform = b.transforms[i];
+        b.posX[i] = transform->Position.x;
+        b.posY[i] = transform->Position.y;
+        b.posZ[i] = transform->Position.z;
+    }
+
+    // 2. 一括積分（配列はパディング済みなので端数処理は不要）
+    const XMVECTOR dt = XMVectorReplicate(deltaTime);
+    for (std::uint32_t i = 0; i < s_BodyCount; i += kSimdWidth)
+    {
+        const XMVECTOR active = Load4(b.active, i);
+        const XMVECTOR activeMask = XMVectorGreater(active, XMVectorZero());
+        const XMVECTOR stepScale = XMVectorMultiply(active, dt);
+
+        // 前ステップ位置：active なら現在位置、そうでなければ維持
+        const XMVECTOR px = Load4(b.posX, i);
+        const XMVECTOR py = Load4(b.posY, i);
+        const XMVECTOR pz = Load4(b.posZ, i);
+        Store4(b.prevX, i, XMVectorSelect(Load4(b.prevX, i), px, activeMask));
+        Store4(b.prevY, i, XMVectorSelect(Load4(b.prevY, i), py, activeMask));
+        Store4(b.prevZ, i, XMVectorSelect(Load4(b.prevZ, i), pz, activeMask));
+
+        // 速度：重力加算とフリーズ軸の無効化
+        const XMVECTOR vx = XMVectorMultiply(XMVectorMultiplyAdd(Load4(b.accelX, i), dt, Load4(b.velX, i)), Load4(b.keepX, i));
+        const XMVECTOR vy = XMVectorMultiply(XMVectorMultiplyAdd(Load4(b.accelY, i), dt, Load4(b.velY, i)), Load4(b.keepY, i));
+        const XMVECTOR vz = XMVectorMultiply(XMVectorMultiplyAdd(Load4(b.accelZ, i), dt, Load4(b.velZ, i)), Load4(b.keepZ, i));
+        Store4(b.velX, i, vx);
+        Store4(b.velY, i, vy);
+        Store4(b.velZ, i, vz);
+
+        // 位置
+        Store4(b.posX, i, XMVectorMultiplyAdd(vx, stepScale, px));
+        Store4(b.posY, i, XMVectorMultiplyAdd(vy, stepScale, py));
+        Store4(b.posZ, i, XMVectorMultiplyAdd(vz, stepScale, pz));
+    }
+
+    // 3. 書き戻し
+    for (std::uint32_t i = 0; i < s_BodyCount; ++i)
+    {
+        Transform* transform = b.transforms[i];
+        transform->Position.x = b.posX[i];
+        transform->Position.y = b.posY[i];
+        transform->Position.z = b.posZ[i];
+    }
+}
+
+// ------------------------------------------------------------------------------
+// 積分用マスクの再計算
+// ------------------------------------------------------------------------------
+// - キネマティック：active = 0、速度は保持（keep = 1）、加速度 0
+// - それ以外      ：フリーズ軸は keep = 0 / accel = 0、重力無効なら accel = 0
+void PhysicsWorld::RefreshDerived(std::uint32_t index)
+{
+    assert(index < s_BodyCount);
+    if (index >= s_BodyCount) return;
+
+    PhysicsBodyArrays& b = s_Bodies;
+    const FreezeFlags flags = static_cast<FreezeFlags>(b.freezeFlags[index]);
+
+    if (b.kinematic[index])
+    {
+        b.active[index] = 0.0f;
+        b.keepX[index] = b.keepY[index] = b.keepZ[index] = 1.0f;
+        b.accelX[index] = b.accelY[index] = b.accelZ[index] = 0.0f;
+        return;
+    }
+
+    b.active[index] = 1.0f;
+    b.keepX[index] = HasFlag(flags, FreezeFlags::PosX) ? 0.0f : 1.0f;
+    b.keepY[index] = HasFlag(flags, FreezeFlags::PosY) ? 0.0f : 1.0f;
+    b.keepZ[index] = HasFlag(flags, FreezeFlags::PosZ) ? 0.0f : 1.0f;
+
+    const float gravityScale = b.useGravity[index] ? 1.0f : 0.0f;
+    b.accelX[index] = b.gravityX[index] * gravityScale * b.keepX[index];
+    b.accelY[index] = b.gravityY[index] * gravityScale * b.keepY[index];
+    b.accelZ[index] = b.gravityZ[index] * gravityScale * b.keepZ[index];
+}
+
+// ------------------------------------------------------------------------------
+// 内部処理
+// ------------------------------------------------------------------------------
+// 配列の長さを SIMD 幅の倍数にそろえる（追加分は 0 埋め＝積分しても影響なし）
+void PhysicsWorld::ResizeArrays(std::uint32_t count)
+{
+    const std::uint32_t padded = (count + kSimdWidth - 1) / kSimdWidth * kSimdWidth;
+    if (s_Bodies.posX.size() >= padded) return;
+
+    // 伸長は倍々（大量のデブリ生成時に毎回再確保しないため）
+    const std::size_t newSize = std::max<std::size_t>(padded, s_Bodies.posX.size() * 2);
+
+    PhysicsBodyArrays& b = s_Bodies;
+    ForEachFloatArray(b, [newSize](std::vector<float>& values) { values.resize(newSize, 0.0f); });
+    b.freezeFlags.resize(newSize, 0);
+    b.useGravity.resize(newSize, 0);
+    b.kinematic.resize(newSize, 0);
+    b.owners.resize(newSize, nullptr);
+    b.transforms.resize(newSize, nullptr);
+}
+
+// 添字 to へ from の内容を移す
+void PhysicsWorld::MoveBody(std::uint32_t from, std::uint32_t to)
+{
+    PhysicsBodyArrays& b = s_Bodies;
+    ForEachFloatArray(b, [from, to](std::vector<float>& values) { values[to] = values[from]; });
+    b.freezeFlags[to] = b.freezeFlags[from];
+    b.useGravity[to]  = b.useGravity[from];
+    b.kinematic[to]   = b.kinematic[from];
+    b.owners[to]      = b.owners[from];
+    b.transforms[to]  = b.transforms[from];
+}
+
+// 添字 index を 0 埋めする
+void PhysicsWorld::ClearBody(std::uint32_t index)
+{
+    PhysicsBodyArrays& b = s_Bodies;
+    ForEachFloatArray(b, [index](std::vector<float>& values) { values[index] = 0.0f; });
+    b.freezeFlags[index] = 0;
+    b.useGravity[index]  = 0;
+    b.kinematic[index]   = 0;
+    b.owners[index]      = nullptr;
+    b.transforms[index]  = nullptr;
+}
@@ -0,0 +1,112 @@
+﻿//------------------------------------------------------------------------------
+// PhysicsWorld
+//------------------------------------------------------------------------------
+// 役割:
+// RigidBody の物理状態（位置・速度・重力・反発係数・軸フリーズ）を
+// 連続した配列（SoA）で一括管理し、1 ステップ分の積分をまとめて行う。
+//
+// 設計意図:
+// RigidBody ごとの仮想 Update と FreezeFlags の分岐、Transform への散らばった
+// アクセスをやめ、同じ種類のデータを隣接させて 4 体ずつ SIMD で積分する。
+// フリーズ軸や重力無効・キネマティックはパラメータ変更時に 0/1 のマスクへ
+// 変換しておき、積分ループ自体は分岐なしで回す。
+// RigidBody は配列上の添字を持つだけの薄いハンドルとして振る舞う。
+//
+// 構成:
+// - PhysicsBodyArrays : 物理状態の SoA 配列（SIMD 幅に合わせて末尾をパディング）
+// - CreateBody / DestroyBody : 登録と解除（解除は末尾要素との入れ替えで O(1)）
+// - Step              : Transform からの位置取得 → 一括積分 → Transform への書き戻し
+// - RefreshDerived    : パラメータから積分用マスクを再計算
+//
+// NOTE:
+// - Step はシーン内 GameObject の Update より前に 1 回だけ呼ぶ前提
+//   （ゲーム側が Update 内で行う位置補正を、積分で上書きしないため）
+// - 位置の正は Transform 側。Step の前後で Transform と同期する
+// - メインスレッドからのみ操作すること
+//------------------------------------------------------------------------------
+#pragma once
+#include <cstdint>
+#include <vector>
+
+class RigidBody;
+struct Transform;
+
+/// 物理ボディの SoA 配列
+/// - 添字 i が 1 つのボディを表す
+/// - 末尾はパディング（SIMD 幅の倍数まで 0 埋め）されている
+struct PhysicsBodyArrays
+{
+    // 状態
+    std::vector<float> posX, posY, posZ;                // 位置（Step 中のみ有効な作業領域）
+    std::vector<float> velX, velY, velZ;                // 速度
+    std::vector<float> prevX, prevY, prevZ;             // 前ステップの位置（CCD 用）
+
+    // パラメータ
+    std::vector<float> gravityX, gravityY, gravityZ;    // 重力ベクトル
+    std::vector<float> restitution;                     // 反発係数
+    std::vector<float> mass;                            // 質量（現在は未使用）
+    std::vector<std::uint32_t> freezeFlags;             // 軸フリーズフラグ（FreezeFlags の値）
+    std::vector<std::uint8_t>  useGravity;              // 重力の影響を受けるか
+    std::vector<std::uint8_t>  kinematic;               // キネマティックか
+
+    // 積分用（パラメータから RefreshDerived で導出）
+    std::vector<float> accelX, accelY, accelZ;          // 実効加速度（無効・フリーズ軸は 0）
+    std::vector<float> keepX, keepY, keepZ;             // 速度保持マスク（フリーズ軸は 0）
+    std::vector<float> active;                          // 1：積分する / 0：キネマティック
+
+    // 参照（非所有）
+    std::vector<RigidBody*> owners;                     // 添字の持ち主
+    std::vector<Transform*> transforms;                 // 位置の同期先
+};
+
+/// 物理ボディを SoA で管理し、一括で積分する
+class PhysicsWorld
+{
+public:
+    static constexpr std::uint32_t kInvalidBody = 0xFFFFFFFFu;  // 未登録を表す添字
+    static constexpr std::uint32_t kSimdWidth   = 4;            // 一括積分の幅
+
+    // ----------------------------------------------------------------------
+    // 登録
+    // ----------------------------------------------------------------------
+    /// ボディを登録し、添字を返す
+    /// - owner     : 添字の持ち主（解除時の入れ替えで添字を更新するため）
+    /// - transform : 位置の同期先（非所有）
+    static std::uint32_t CreateBody(RigidBody* owner, Transform* transform);
+
+    /// ボディを解除する
+    /// - 末尾のボディを空いた添字へ移し、その持ち主の添字を更新する
+    static void DestroyBody(std::uint32_t index);
+
+    // ----------------------------------------------------------------------
+    // シミュレーション
+    // ----------------------------------------------------------------------
+    /// 全ボディを deltaTime だけ積分する
+    static void Step(float deltaTime);
+
+    /// パラメータ（重力・フリーズ・キネマティック）から積分用マスクを再計算する
+    static void RefreshDerived(std::uint32_t index);
+
+    // ----------------------------------------------------------------------
+    // 参照
+    // ----------------------------------------------------------------------
+    /// SoA 配列への参照（RigidBody のアクセサから使用する）
+    static PhysicsBodyArrays& GetBodies() { return s_Bodies; }
+
+    /// 登録中のボディ数
+    static std::uint32_t GetBodyCount() { return s_BodyCount; }
+
+private:
+    /// 配列の長さを count 以上の SIMD 幅の倍数にそろえる
+    static void ResizeArrays(std::uint32_t count);
+
+    /// 添字 to へ from の内容を移す
+    static void MoveBody(std::uint32_t from, std::uint32_t to);
+
+    /// 添字 index を 0 埋めする（パディング領域を積分しても影響がない状態にする）
+    static void ClearBody(std::uint32_t index);
+
+private:
+    static PhysicsBodyArrays s_Bodies;      // SoA 配列
+    static std::uint32_t     s_BodyCount;   // 登録中のボディ数
+};
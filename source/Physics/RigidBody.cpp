@@ -1,92 +1,195 @@
 ﻿#include "RigidBody.h"
 #include "GameObject.h"
 #include "SphereCollider.h"
-
-void RigidBody::Update(float deltaTime)
+#include "PhysicsWorld.h"
+#include "Snapshot.h"
+#include <cassert>
+
+// ----------------------------------------------------------------------
+// 生成・破棄
+// ----------------------------------------------------------------------
+// - Init で PhysicsWorld へ登録し、破棄時に解除する
+// NOTE: 積分は PhysicsWorld::Step で全ボディまとめて行うため Update は持たない
+void RigidBody::Init()
 {
-    if (!m_Owner || m_IsKinematic) return;
-
-    // Tranformへの参照
-    Transform& transform = m_Owner->m_Transform;
+    if (!m_Owner || m_BodyIndex != PhysicsWorld::kInvalidBody) return;
 
-    // フリーズ前の位置・回転を保存
-    const Vector3 originalPos = transform.Position;
-    const Vector3 originalRot = transform.Rotation;
+    m_BodyIndex = PhysicsWorld::CreateBody(this, &m_Owner->m_Transform);
+}
 
-    // CCD用に前フレームの位置を保存
-    if (m_IsFirstUpdate)
-    {
-        // 初回更新時は現在位置を前フレーム位置として保存
-        m_PreviousPosition = transform.Position;
-        m_IsFirstUpdate = false;
-    }
-    else
+RigidBody::~RigidBody()
+{
+    if (m_BodyIndex != PhysicsWorld::kInvalidBody)
     {
-        // 2回目以降は前フレーム位置を更新
-        m_PreviousPosition = transform.Position;
+        PhysicsWorld::DestroyBody(m_BodyIndex);
+        m_BodyIndex = PhysicsWorld::kInvalidBody;
     }
+}
 
-    // ----------------------------------------------------------------------
-    // 重力適用
-    //  ・m_Gravityは任意方向
-    //  ・フリーズされている軸成分は、0にしてから加算
-    // ---------------------------------------------------------------------- 
-    if (m_UseGravity)
-    {
-        Vector3 gravity = m_Gravity;
+// ----------------------------------------------------------------------
+// アクセサ（PhysicsWorld の SoA 配列を参照する）
+// ----------------------------------------------------------------------
+Vector3 RigidBody::GetVelocity() const
+{
+    assert(m_BodyIndex != PhysicsWorld::kInvalidBody);
+    const PhysicsBodyArrays& b = PhysicsWorld::GetBodies();
+    return Vector3(b.velX[m_BodyIndex], b.velY[m_BodyIndex], b.velZ[m_BodyIndex]);
+}
 
-        if (HasFlag(m_FreezeFlags, FreezeFlags::PosX) ) gravity.x = 0.0f;
-        if (HasFlag(m_FreezeFlags, FreezeFlags::PosY) ) gravity.y = 0.0f;
-        if (HasFlag(m_FreezeFlags, FreezeFlags::PosZ) ) gravity.z = 0.0f;
+void RigidBody::SetVelocity(const Vector3& velocity)
+{
+    assert(m_BodyIndex != PhysicsWorld::kInvalidBody);
+    PhysicsBodyArrays& b = PhysicsWorld::GetBodies();
+    b.velX[m_BodyIndex] = velocity.x;
+    b.velY[m_BodyIndex] = velocity.y;
+    b.velZ[m_BodyIndex] = velocity.z;
+}
 
-        m_Velocity += gravity * deltaTime;
-    }
+Vector3 RigidBody::GetPreviousPosition() const
+{
+    assert(m_BodyIndex != PhysicsWorld::kInvalidBody);
+    const PhysicsBodyArrays& b = PhysicsWorld::GetBodies();
+    return Vector3(b.prevX[m_BodyIndex], b.prevY[m_BodyIndex], b.prevZ[m_BodyIndex]);
+}
 
-    // 位置を速度分だけ更新
-    transform.Position += m_Velocity * deltaTime;
-    // ----------------------------------------------------------------------
-    // 軸フリーズ適用
-    //  ・位置は更新前の値に戻す
-    //  ・該当軸の速度を0にする
-    // ----------------------------------------------------------------------
-    if (HasFlag(m_FreezeFlags, FreezeFlags::PosX))
-    {
-        transform.Position.x = originalPos.x;
-        m_Velocity.x = 0.0f;
-    }
-    if (HasFlag(m_FreezeFlags, FreezeFlags::PosY))
-    {
-        transform.Position.y = originalPos.y;
-        m_Velocity.y = 0.0f;
-    }
-    if (HasFlag(m_FreezeFlags, FreezeFlags::PosZ))
-    {
-        transform.Position.z = originalPos.z;
-        m_Velocity.z = 0.0f;
-    }
+void RigidBody::SetPreviousPosition(const Vector3& position)
+{
+    assert(m_BodyIndex != PhysicsWorld::kInvalidBody);
+    PhysicsBodyArrays& b = PhysicsWorld::GetBodies();
+    b.prevX[m_BodyIndex] = position.x;
+    b.prevY[m_BodyIndex] = position.y;
+    b.prevZ[m_BodyIndex] = position.z;
+}
 
-    // 現状では角速度を持っていないので、回転フリーズは
-    // 「他の処理で回転を変化させた場合に元に戻す」だけ実装
-    if (HasFlag(m_FreezeFlags, FreezeFlags::RotX))
-    {
-        transform.Rotation.x = originalRot.x;
-        // TODO: 将来角速度を実装したらここで0にする
-    }
-    if (HasFlag(m_FreezeFlags, FreezeFlags::RotY))
-    {
-        transform.Rotation.y = originalRot.y;
-    }
-    if (HasFlag(m_FreezeFlags, FreezeFlags::RotZ))
-    {
-        transform.Rotation.z = originalRot.z;
-    }
+Vector3 RigidBody::GetGravity() const
+{
+    assert(m_BodyIndex != PhysicsWorld::kInvalidBody);
+    const PhysicsBodyArrays& b = PhysicsWorld::GetBodies();
+    return Vector3(b.gravityX[m_BodyIndex], b.gravityY[m_BodyIndex], b.gravityZ[m_BodyIndex]);
+}
+
+void RigidBody::SetGravity(const Vector3& gravity)
+{
+    assert(m_BodyIndex != PhysicsWorld::kInvalidBody);
+    PhysicsBodyArrays& b = PhysicsWorld::GetBodies();
+    b.gravityX[m_BodyIndex] = gravity.x;
+    b.gravityY[m_BodyIndex] = gravity.y;
+    b.gravityZ[m_BodyIndex] = gravity.z;
+    PhysicsWorld::RefreshDerived(m_BodyIndex);
+}
+
+float RigidBody::GetRestitution() const
+{
+    assert(m_BodyIndex != PhysicsWorld::kInvalidBody);
+    return PhysicsWorld::GetBodies().restitution[m_BodyIndex];
+}
+
+void RigidBody::SetRestitution(float restitution)
+{
+    assert(m_BodyIndex != PhysicsWorld::kInvalidBody);
+    PhysicsWorld::GetBodies().restitution[m_BodyIndex] = restitution;
+}
+
+float RigidBody::GetMass() const
+{
+    assert(m_BodyIndex != PhysicsWorld::kInvalidBody);
+    return PhysicsWorld::GetBodies().mass[m_BodyIndex];
+}
+
+void RigidBody::SetMass(float mass)
+{
+    assert(m_BodyIndex != PhysicsWorld::kInvalidBody);
+    PhysicsWorld::GetBodies().mass[m_BodyIndex] = mass;
+}
+
+bool RigidBody::GetUseGravity() const
+{
+    assert(m_BodyIndex != PhysicsWorld::kInvalidBody);
+    return PhysicsWorld::GetBodies().useGravity[m_BodyIndex] != 0;
+}
+
+void RigidBody::SetUseGravity(bool useGravity)
+{
+    assert(m_BodyIndex != PhysicsWorld::kInvalidBody);
+    PhysicsWorld::GetBodies().useGravity[m_BodyIndex] = useGravity ? 1 : 0;
+    PhysicsWorld::RefreshDerived(m_BodyIndex);
+}
+
+bool RigidBody::IsKinematic() const
+{
+    assert(m_BodyIndex != PhysicsWorld::kInvalidBody);
+    return PhysicsWorld::GetBodies().kinematic[m_BodyIndex] != 0;
+}
+
+void RigidBody::SetKinematic(bool isKinematic)
+{
+    assert(m_BodyIndex != PhysicsWorld::kInvalidBody);
+    PhysicsWorld::GetBodies().kinematic[m_BodyIndex] = isKinematic ? 1 : 0;
+    PhysicsWorld::RefreshDerived(m_BodyIndex);
+}
+
+FreezeFlags RigidBody::GetFreezeFlags() const
+{
+    assert(m_BodyIndex != PhysicsWorld::kInvalidBody);
+    return static_cast<FreezeFlags>(PhysicsWorld::GetBodies().freezeFlags[m_BodyIndex]);
+}
+
+void RigidBody::SetFreezeFlags(FreezeFlags flags)
+{
+    assert(m_BodyIndex != PhysicsWorld::kInvalidBody);
+    PhysicsWorld::GetBodies().freezeFlags[m_BodyIndex] = static_cast<uint32_t>(flags);
+    PhysicsWorld::RefreshDerived(m_BodyIndex);
+}
+
+// ----------------------------------------------------------------------
+// スナップショット
+// ----------------------------------------------------------------------
+// - SoA 配列の値をそのまま書き出す（位置は Transform 側で保存される）
+// - 読み戻し後に導出値（実効加速度など）を作り直す
+void RigidBody::WriteState(SnapshotWriter& writer) const
+{
+    assert(m_BodyIndex != PhysicsWorld::kInvalidBody);
+    const PhysicsBodyArrays& b = PhysicsWorld::GetBodies();
+    const uint32_t i = m_BodyIndex;
+
+    writer.Write(b.velX[i]);     writer.Write(b.velY[i]);     writer.Write(b.velZ[i]);
+    writer.Write(b.prevX[i]);    writer.Write(b.prevY[i]);    writer.Write(b.prevZ[i]);
+    writer.Write(b.gravityX[i]); writer.Write(b.gravityY[i]); writer.Write(b.gravityZ[i]);
+    writer.Write(b.restitution[i]);
+    writer.Write(b.mass[i]);
+    writer.Write(b.freezeFlags[i]);
+    writer.Write(b.useGravity[i]);
+    writer.Write(b.kinematic[i]);
+}
+
+void RigidBody::ReadState(SnapshotReader& reader)
+{
+    assert(m_BodyIndex != PhysicsWorld::kInvalidBody);
+    PhysicsBodyArrays& b = PhysicsWorld::GetBodies();
+    const uint32_t i = m_BodyIndex;
+
+    reader.Read(b.velX[i]);     reader.Read(b.velY[i]);     reader.Read(b.velZ[i]);
+    reader.Read(b.prevX[i]);    reader.Read(b.prevY[i]);    reader.Read(b.prevZ[i]);
+    reader.Read(b.gravityX[i]); reader.Read(b.gravityY[i]); reader.Read(b.gravityZ[i]);
+    reader.Read(b.restitution[i]);
+    reader.Read(b.mass[i]);
+    reader.Read(b.freezeFlags[i]);
+    reader.Read(b.useGravity[i]);
+    reader.Read(b.kinematic[i]);
+
+    PhysicsWorld::RefreshDerived(i);
 }
 
+// ----------------------------------------------------------------------
+// 衝突時のデフォルト処理
+// ----------------------------------------------------------------------
 void RigidBody::ResolveCollision(const CollisionInfo& info)
 {
-    if (!m_Owner || m_IsKinematic) return;
+    if (!m_Owner || m_BodyIndex == PhysicsWorld::kInvalidBody || IsKinematic()) return;
 
     Vector3& pos = m_Owner->m_Transform.Position;
+    Vector3 velocity = GetVelocity();
+    const float restitution = GetRestitution();
 
     // --- 1. CCDヒット: 位置もここで直してから速度反射 ---
     if (info.isCCDHit)
@@ -105,11 +208,11 @@ void RigidBody::ResolveCollision(const CollisionInfo& info)
         }
 
         // 速度反射
-        float vn = m_Velocity.Dot(info.normal);
+        float vn = velocity.Dot(info.normal);
         if (vn < 0.0f)
         {
             // 反発後の法線速度
-            float newVn = -vn * m_Restitution;
+            float newVn = -vn * restitution;
 
             // 小さい反発はカット
             const float kRestThreshold = 0.2f;
@@ -120,7 +223,8 @@ void RigidBody::ResolveCollision(const CollisionInfo& info)
 
             // v_nをnewVnに置き換える
             float delta = newVn - vn;
-            m_Velocity += info.normal * delta;
+            velocity += info.normal * delta;
+            SetVelocity(velocity);
         }
         return;
     }
@@ -132,10 +236,10 @@ void RigidBody::ResolveCollision(const CollisionInfo& info)
         pos += info.normal * info.penetration;
     }
 
-    float vn = m_Velocity.Dot(info.normal);
+    float vn = velocity.Dot(info.normal);
     if (vn < 0.0f)
     {
-        float newVn = -vn * m_Restitution;
+        float newVn = -vn * restitution;
 
         const float kRestThreshold = 0.2f;
         if (newVn < kRestThreshold)
@@ -144,6 +248,7 @@ void RigidBody::ResolveCollision(const CollisionInfo& info)
         }
 
         float delta = newVn - vn;
-        m_Velocity += info.normal * delta;
+        velocity += info.normal * delta;
+        SetVelocity(velocity);
     }
 }
\ No newline at end of file
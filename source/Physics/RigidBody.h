@@ -41,6 +41,8 @@
 /// <summary>
 /// 剛体コンポーネント
 /// 物理挙動を担当する。デフォルト衝突処理用
+/// 状態は PhysicsWorld の SoA 配列にあり、RigidBody はその添字を持つ薄いハンドル
+/// （積分は PhysicsWorld::Step で一括して行う）
 /// </summary>
 class RigidBody : public Component
 {
@@ -48,10 +50,12 @@ public:
     // ----------------------------------------------------------------------
     // 関数定義
     // ----------------------------------------------------------------------
+    ~RigidBody() override;
+
     /// <summary>
-    /// 更新処理
+    /// 初期化処理（PhysicsWorld へ登録する）
     /// </summary>
-    void Update(float deltaTime) override;
+    void Init() override;
 
     /// <summary>
     /// 衝突時のデフォルト処理
@@ -61,28 +65,71 @@ public:
     /// <summary>
     /// 軸フリーズフラグの設定
     /// </summary>
-    void SetFreezeFlags(FreezeFlags flags) { m_FreezeFlags = flags; }
+    void SetFreezeFlags(FreezeFlags flags);
 
     /// <summary>
     /// 軸フリーズフラグの取得
     /// </summary>
-    FreezeFlags GetFreezeFlags() const { return m_FreezeFlags; }
+    FreezeFlags GetFreezeFlags() const;
 
-    // ----------------------------------------------------------------------
-    // 変数定義
-    // ----------------------------------------------------------------------
-    Vector3 m_Velocity         = { 0.0f, 0.0f, 0.0f };  // 速度ベクトル
-    Vector3 m_PreviousPosition = { 0.0f, 0.0f, 0.0f };  // 前フレームの位置
-    Vector3 m_Gravity          = { 0.0f, -9.8f, 0.0f }; // 重力ベクトル
-    float m_Restitution        = 0.8f;                  // 反発係数 (1で完全反発、0で非反発)
-    float m_Mass               = 1.0f;                  // 質量（現在は未使用）
-    bool m_UseGravity          = true;                  // 重力の影響を受けるかどうか
-    bool m_IsKinematic         = false;                 // キネマティックフラグ (trueなら物理演算の影響を受けない)
-    bool m_IsFirstUpdate       = true;                  // 初回更新フラグ
+    /// <summary>
+    /// 速度ベクトル
+    /// </summary>
+    Vector3 GetVelocity() const;
+    void SetVelocity(const Vector3& velocity);
+    void AddVelocity(const Vector3& delta) { SetVelocity(GetVelocity() + delta); }
+
+    /// <summary>
+    /// 前ステップの位置（CCD用）
+    /// </summary>
+    Vector3 GetPreviousPosition() const;
+    void SetPreviousPosition(const Vector3& position);
+
+    /// <summary>
+    /// 重力ベクトル
+    /// </summary>
+    Vector3 GetGravity() const;
+    void SetGravity(const Vector3& gravity);
+
+    /// <summary>
+    /// 反発係数 (1で完全反発、0で非反発)
+    /// </summary>
+    float GetRestitution() const;
+    void SetRestitution(float restitution);
+
+    /// <summary>
+    /// 質量（現在は未使用）
+    /// </summary>
+    float GetMass() const;
+    void SetMass(float mass);
+
+    /// <summary>
+    /// 重力の影響を受けるかどうか
+    /// </summary>
+    bool GetUseGravity() const;
+    void SetUseGravity(bool useGravity);
+
+    /// <summary>
+    /// キネマティックフラグ (trueなら物理演算の影響を受けない)
+    /// </summary>
+    bool IsKinematic() const;
+    void SetKinematic(bool isKinematic);
+
+    /// <summary>
+    /// PhysicsWorld 上の添字（PhysicsWorld が入れ替え時に更新する）
+    /// </summary>
+    uint32_t GetBodyIndex() const { return m_BodyIndex; }
+    void SetBodyIndex(uint32_t index) { m_BodyIndex = index; }
+
+    /// <summary>
+    /// スナップショット（速度・前ステップ位置・パラメータ）
+    /// </summary>
+    void WriteState(SnapshotWriter& writer) const override;
+    void ReadState(SnapshotReader& reader) override;
 
 private:
     // ----------------------------------------------------------------------
     // 変数定義
     // ----------------------------------------------------------------------
-    FreezeFlags m_FreezeFlags = FreezeFlags::None;     // 軸フリーズフラグ
-};
\ No newline at end of file
+    uint32_t m_BodyIndex = 0xFFFFFFFFu;     // PhysicsWorld 上の添字（未登録時は無効値）
+};
@@ -71,10 +71,10 @@ static bool SphereVsBox(SphereCollider* s, BoxCollider* b,
     bool useCCD = false;
     Vector3 p0, p1;
 
-    if (rigidBody && !rigidBody->m_IsKinematic)
+    if (rigidBody && !rigidBody->IsKinematic())
     {
         // 球の中心の「前フレーム位置」と「今フレーム位置」
-        p0 = rigidBody->m_PreviousPosition + s->m_center;   // 前フレーム中心
+        p0 = rigidBody->GetPreviousPosition() + s->m_center;   // 前フレーム中心
         p1 = owner->m_Transform.Position + s->m_center;     // 今フレーム中心
 
         Vector3 delta = p1 - p0;
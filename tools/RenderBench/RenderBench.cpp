@@ -0,0 +1,352 @@
+﻿//------------------------------------------------------------------------------
+// RenderBench
+//------------------------------------------------------------------------------
+// 役割:
+// RecordingRenderBackend（GPU を使わない描画バックエンド）に合成したシーンを描かせ、
+// 1 フレームあたりの描画呼び出し数・状態変更数・転送量を表示する。
+//
+// 設計意図:
+// 描画経路の最適化（インスタンス化・定数バッファの範囲指定・視錐台カリング・静的な形状の結合）の効果を、
+// Windows や GPU の無い環境でもゲーム本体と同じコード（Renderer / RenderQueue / MeshRenderer / StaticBatch）で比べる。
+// ゲームのシーンは Win32 のウィンドウ・入力・音声に依存するので、ここでは形と配置だけを真似たシーンを組み立てる。
+//
+// 構成:
+// - BenchOptions : コマンドライン引数（フレーム数・敵の数・比較のために外す最適化）
+// - BenchScene   : 敵（箱 / 球）・半透明の板・画面外の物体・台の壁を MeshRenderer で作る
+// - main         : 初期化 → 指定フレーム数の描画 → 最初のフレームと 2 フレーム目以降の平均の表示 → 終了処理
+//
+// NOTE:
+// - シェーダーは中身の無い .cso を一時ディレクトリに書いて読み込ませる（記録用バックエンドは中身を見ない）
+// - テクスチャは画像を読まず、パスごとに 1x1 の白いテクスチャを作る
+//   （ゲームと同じく、テクスチャの違う描画は同じインスタンス描画にまとまらない）
+// - 終了時、記録用バックエンドは解放漏れを assert で確かめる
+//------------------------------------------------------------------------------
+#include "FrameArena.h"
+#include "Renderer.h"
+#include "RecordingRenderBackend.h"
+#include "RenderQueue.h"
+#include "MeshCache.h"
+#include "ShaderCache.h"
+#include "TextureCache.h"
+#include "FrustumCulling.h"
+#include "MeshRenderer.h"
+#include "StaticBatch.h"
+#include "Transform.h"
+
+// システム関連
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace
+{
+    constexpr std::uint32_t kScreenWidth  = 1280;
+    constexpr std::uint32_t kScreenHeight = 720;
+
+    /// コマンドライン引数
+    struct BenchOptions
+    {
+        std::uint32_t frames       = 300;   // 描画するフレーム数
+        std::uint32_t enemies      = 200;   // 敵の数（箱と球が半分ずつ）
+        bool          cbRanges     = true;  // 定数バッファの範囲指定を使う（D3D11.1 相当）
+        bool          staticBatch  = true;  // 台の壁を StaticBatch の候補にする
+        bool          cull         = true;  // 視錐台カリングを行う
+        bool          instancing   = true;  // インスタンス描画版のシェーダーを置く（無ければ 1 パケット 1 描画）
+    };
+
+    /// フレームの統計の合計（平均を出すため）
+    struct StatsSum
+    {
+        RenderStats      backend;
+        RenderQueueStats queue;
+        std::uint64_t    culled = 0;
+        std::uint32_t    frames = 0;
+    };
+
+    void PrintUsage()
+    {
+        std::puts("usage: RenderBench [--frames N] [--enemies N] [--no-cb-ranges] [--no-static-batch] [--no-cull] [--no-instancing]");
+    }
+
+    bool ParseOptions(int argc, char** argv, BenchOptions& out)
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            const char* arg = argv[i];
+            const bool hasValue = i + 1 < argc;
+            if (std::strcmp(arg, "--frames") == 0 && hasValue)
+                out.frames = static_cast<std::uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+            else if (std::strcmp(arg, "--enemies") == 0 && hasValue)
+                out.enemies = static_cast<std::uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+            else if (std::strcmp(arg, "--no-cb-ranges") == 0)
+                out.cbRanges = false;
+            else if (std::strcmp(arg, "--no-static-batch") == 0)
+                out.staticBatch = false;
+            else if (std::strcmp(arg, "--no-cull") == 0)
+                out.cull = false;
+            else if (std::strcmp(arg, "--no-instancing") == 0)
+                out.instancing = false;
+            else
+                return false;
+        }
+        return out.frames > 0;
+    }
+
+    /// 中身の無いシェーダーファイルを書く（記録用バックエンドは大きさしか見ない）
+    void WriteDummyShader(const std::filesystem::path& path)
+    {
+        FILE* file = std::fopen(path.string().c_str(), "wb");
+        if (!file)
+            return;
+        const unsigned char bytecode[16] = {};
+        std::fwrite(bytecode, sizeof(bytecode), 1, file);
+        std::fclose(file);
+    }
+
+    /// 画像を読まずに 1x1 の白いテクスチャを作る（デコード用スレッドから呼ばれる）
+    bool DecodeSolidTexture(const std::wstring& path, DecodedTexture& out)
+    {
+        auto pixel = std::make_shared<std::uint32_t>(0xFFFFFFFFu);
+        out.desc.width     = 1;
+        out.desc.height    = 1;
+        out.desc.mipLevels = 1;
+        out.desc.format    = kGpuFormatR8G8B8A8Unorm;
+        out.subresources.assign(1, GpuSubresource{ pixel.get(), sizeof(std::uint32_t), sizeof(std::uint32_t) });
+        out.storage = pixel;
+        return true;
+    }
+
+    /// 合成したシーン
+    class BenchScene
+    {
+    public:
+        BenchScene(const BenchOptions& options, const std::string& vsPath, const std::string& psPath)
+            : m_VSPath(vsPath), m_PSPath(psPath)
+        {
+            // 敵：円周上に並べた箱と球（同じシェーダーなのでインスタンス化の対象）
+            for (std::uint32_t i = 0; i < options.enemies; ++i)
+            {
+                const float angle  = XM_2PI * static_cast<float>(i) / static_cast<float>(options.enemies);
+                const float radius = 10.0f + static_cast<float>(i % 5) * 3.0f;
+                MeshRenderer* mesh = Add({ std::cos(angle) * radius, 1.0f, std::sin(angle) * radius + 20.0f });
+                if (i % 2 == 0)
+                {
+                    mesh->CreateUnitBox();
+                    mesh->m_Color = XMFLOAT4(1.0f, 0.3f, 0.3f, 1.0f);
+                }
+                else
+                {
+                    mesh->CreateUnitSphere();
+                    mesh->SetTexture(L"asset\\texture\\enemy.png");
+                }
+                m_Enemies.push_back(mesh);
+            }
+
+            // 半透明の板（奥から手前へ並べ替えられる）
+            for (int i = 0; i < 8; ++i)
+            {
+                MeshRenderer* mesh = Add({ static_cast<float>(i - 4) * 4.0f, 0.5f, 15.0f + static_cast<float>(i) });
+                mesh->CreateUnitPlane();
+                mesh->m_Color = XMFLOAT4(0.3f, 0.6f, 1.0f, 0.5f);
+            }
+
+            // カメラの後ろの物体（カリングで消える）
+            for (int i = 0; i < 32; ++i)
+            {
+                MeshRenderer* mesh = Add({ static_cast<float>(i % 8) * 3.0f - 12.0f, 1.0f, -40.0f - static_cast<float>(i / 8) * 3.0f });
+                mesh->CreateUnitBox();
+            }
+
+            // 台の壁（動かないので StaticBatch の候補。インスタンス描画版の VS が無い場合だけ結合される）
+            const Vector3 walls[][2] =
+            {
+                { { -30.0f, 1.0f, 20.0f }, { 1.0f, 2.0f, 60.0f } },
+                { {  30.0f, 1.0f, 20.0f }, { 1.0f, 2.0f, 60.0f } },
+                { {   0.0f, 1.0f, 50.0f }, { 60.0f, 2.0f, 1.0f } },
+                { {   0.0f, 1.0f, -10.0f }, { 60.0f, 2.0f, 1.0f } },
+                { { -15.0f, 1.0f,  0.0f }, { 8.0f, 2.0f, 1.0f } },
+                { {  15.0f, 1.0f,  0.0f }, { 8.0f, 2.0f, 1.0f } },
+            };
+            for (const auto& wall : walls)
+            {
+                MeshRenderer* mesh = Add(wall[0]);
+                mesh->SetTexture(L"asset\\texture\\Wall2.png");
+                mesh->CreateUnitBox();
+                mesh->SetLocalScale(wall[1].x, wall[1].y, wall[1].z);
+                mesh->m_Color = XMFLOAT4(0.8f, 0.8f, 0.8f, 1.0f);
+                if (options.staticBatch)
+                {
+                    m_Batch.Add(mesh);
+                }
+            }
+            if (options.staticBatch)
+            {
+                m_Batch.Build();
+            }
+        }
+
+        ~BenchScene()
+        {
+            for (std::unique_ptr<MeshRenderer>& mesh : m_Meshes)
+            {
+                mesh->Uninit();
+            }
+            m_Meshes.clear();
+            m_Batch.Uninit();
+        }
+
+        /// 敵を動かす（ワールド行列が毎フレーム変わるように）
+        void Update(std::uint32_t frame)
+        {
+            for (std::size_t i = 0; i < m_Enemies.size(); ++i)
+            {
+                Transform& transform = m_Transforms[i];
+                transform.Rotation.y = static_cast<float>((frame + i) % 360);
+                transform.Position.y = 1.0f + 0.5f * std::sin(static_cast<float>(frame + i) * 0.1f);
+            }
+        }
+
+        void Draw()
+        {
+            for (std::unique_ptr<MeshRenderer>& mesh : m_Meshes)
+            {
+                mesh->Draw();
+            }
+            m_Batch.Draw();
+        }
+
+    private:
+        /// position に置いた MeshRenderer を作る（形状は呼び出し側で作る）
+        MeshRenderer* Add(const Vector3& position)
+        {
+            m_Transforms.emplace_back();
+            Transform& transform = m_Transforms.back();
+            transform.Position = position;
+
+            m_Meshes.push_back(std::make_unique<MeshRenderer>());
+            MeshRenderer* mesh = m_Meshes.back().get();
+            mesh->m_Transform = &transform;
+            mesh->LoadShader(m_VSPath.c_str(), m_PSPath.c_str());
+            mesh->Init();
+            return mesh;
+        }
+
+    private:
+        std::string                                m_VSPath;
+        std::string                                m_PSPath;
+        std::deque<Transform>                      m_Transforms;   // 要素の位置が変わらないよう deque
+        std::vector<std::unique_ptr<MeshRenderer>> m_Meshes;
+        std::vector<MeshRenderer*>                 m_Enemies;      // 非所有：m_Meshes の先頭から敵の数だけ
+        StaticBatch                                m_Batch;
+    };
+
+    void Accumulate(StatsSum& sum, const RenderStats& backend, const RenderQueueStats& queue, std::uint32_t culled)
+    {
+        sum.backend.drawCalls       += backend.drawCalls;
+        sum.backend.instances       += backend.instances;
+        sum.backend.stateChanges    += backend.stateChanges;
+        sum.backend.redundantStates += backend.redundantStates;
+        sum.backend.uploadedBytes   += backend.uploadedBytes;
+        sum.backend.bufferUpdates   += backend.bufferUpdates;
+        sum.queue.packets           += queue.packets;
+        sum.queue.savedStates       += queue.savedStates;
+        sum.queue.instanced         += queue.instanced;
+        sum.queue.batches           += queue.batches;
+        sum.culled                  += culled;
+        ++sum.frames;
+    }
+
+    void PrintStats(const char* label, const StatsSum& sum)
+    {
+        if (sum.frames == 0)
+            return;
+
+        const double n = static_cast<double>(sum.frames);
+        std::printf("%-14s draws %8.1f  instances %8.1f  states %8.1f  redundant %8.1f  uploaded %10.1f B  updates %6.1f"
+                    "  | packets %8.1f  saved %8.1f  instanced %8.1f  culled %6.1f\n",
+            label,
+            sum.backend.drawCalls / n, sum.backend.instances / n, sum.backend.stateChanges / n,
+            sum.backend.redundantStates / n, static_cast<double>(sum.backend.uploadedBytes) / n, sum.backend.bufferUpdates / n,
+            static_cast<double>(sum.queue.packets) / n, static_cast<double>(sum.queue.savedStates) / n,
+            static_cast<double>(sum.queue.instanced) / n, static_cast<double>(sum.culled) / n);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    BenchOptions options;
+    if (!ParseOptions(argc, argv, options))
+    {
+        PrintUsage();
+        return 1;
+    }
+
+    // シェーダー（中身の無い .cso。インスタンス描画版は置いた場合だけ RenderQueue が見つける）
+    const std::filesystem::path shaderDir = std::filesystem::temp_directory_path() / "RenderBench";
+    std::filesystem::create_directories(shaderDir);
+    WriteDummyShader(shaderDir / "SceneVS.cso");
+    std::filesystem::remove(shaderDir / "SceneInstancedVS.cso");
+    if (options.instancing)
+    {
+        WriteDummyShader(shaderDir / "SceneInstancedVS.cso");
+    }
+    WriteDummyShader(shaderDir / "ScenePS.cso");
+
+    FrameArena::InitMainThread();
+    RecordingRenderBackend* backend = new RecordingRenderBackend(options.cbRanges);
+    Renderer::Init(backend, kScreenWidth, kScreenHeight);
+    TextureCache::Init(DecodeSolidTexture);
+
+    {
+        BenchScene scene(options, (shaderDir / "SceneVS.cso").string(), (shaderDir / "ScenePS.cso").string());
+
+        const XMFLOAT3 eye{ 0.0f, 25.0f, -20.0f };
+        const XMFLOAT3 target{ 0.0f, 0.0f, 20.0f };
+        const XMFLOAT3 up{ 0.0f, 1.0f, 0.0f };
+        const XMMATRIX view = XMMatrixLookAtLH(XMLoadFloat3(&eye), XMLoadFloat3(&target), XMLoadFloat3(&up));
+        const XMMATRIX projection = XMMatrixPerspectiveFovLH(
+            XMConvertToRadians(45.0f), static_cast<float>(kScreenWidth) / kScreenHeight, 1.0f, 1000.0f);
+
+        StatsSum first;
+        StatsSum steady;
+        for (std::uint32_t frame = 0; frame < options.frames; ++frame)
+        {
+            FrameArena::BeginFrame();
+            TextureCache::Update();
+            scene.Update(frame);
+
+            Renderer::Begin();
+            Renderer::SetProjectionMatrix(projection);
+            Renderer::SetViewMatrix(view);
+            if (options.cull)
+            {
+                FrustumCulling::Cull(view * projection);
+            }
+            scene.Draw();
+            Renderer::SetWorldViewProjection2D();   // Game シーンの Polygon2D と同じく、3D の物体の後で 2D の行列に切り替える
+            Renderer::End();
+
+            Accumulate(frame == 0 ? first : steady, backend->GetFrameStats(), RenderQueue::GetFrameStats(),
+                FrustumCulling::GetCulledCount());
+        }
+
+        std::printf("RenderBench: backend=%s frames=%u enemies=%u cb-ranges=%s static-batch=%s cull=%s instancing=%s\n",
+            backend->GetName(), options.frames, options.enemies,
+            options.cbRanges ? "on" : "off", options.staticBatch ? "on" : "off", options.cull ? "on" : "off", options.instancing ? "on" : "off");
+        PrintStats("first frame", first);
+        PrintStats("steady (avg)", steady);
+    }
+
+    MeshCache::Uninit();
+    ShaderCache::Uninit();
+    TextureCache::Uninit();
+    Renderer::Uninit();
+    return 0;
+}